@@ -0,0 +1,87 @@
+#include <QJsonObject>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+#include "stdiolink/host/driver.h"
+#include "stdiolink/platform/platform_utils.h"
+
+using namespace stdiolink;
+
+namespace {
+
+constexpr int kWaitMs = 5000;
+
+/// 启动 keepalive 桩 Driver；失败时跳过基准而不是中断整轮运行
+std::unique_ptr<Driver> startStub(benchmark::State& state, const QString& name) {
+    auto driver = std::make_unique<Driver>();
+    if (!driver->start(PlatformUtils::executablePath(".", name), {"--profile=keepalive"})) {
+        state.SkipWithError("failed to start stub driver");
+        return nullptr;
+    }
+    return driver;
+}
+
+bool waitDone(Task& task) {
+    Message msg;
+    while (task.waitNext(msg, kWaitMs)) {
+        if (msg.status != "event") {
+            return msg.status == "done";
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// 单条请求往返：stdin 写入、Driver 处理、stdout 回读与解析
+static void BM_DriverRoundTrip(benchmark::State& state, const char* driverName, const char* cmd) {
+    auto driver = startStub(state, driverName);
+    if (!driver) {
+        return;
+    }
+    const QJsonObject data{{"v", 1}};
+    for (auto _ : state) {
+        Task task = driver->request(cmd, data);
+        if (!waitDone(task)) {
+            state.SkipWithError("request did not complete");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_DriverRoundTrip, echo, "test_driver", "echo")
+    ->Unit(benchmark::kMicrosecond);
+// test_slow_command_driver 带元数据，额外覆盖 DriverCore 的自动参数验证路径
+BENCHMARK_CAPTURE(BM_DriverRoundTrip, meta_ping, "test_slow_command_driver", "ping")
+    ->Unit(benchmark::kMicrosecond);
+
+// 流水线往返：同一进程上保持 N 条在途请求，衡量按 id 路由的吞吐上限
+static void BM_DriverPipelined(benchmark::State& state) {
+    auto driver = startStub(state, "test_driver");
+    if (!driver) {
+        return;
+    }
+    driver->setPipeliningEnabled(true);
+    const int depth = static_cast<int>(state.range(0));
+    const QJsonObject data{{"v", 1}};
+    std::vector<Task> tasks;
+    tasks.reserve(static_cast<size_t>(depth));
+
+    for (auto _ : state) {
+        tasks.clear();
+        for (int i = 0; i < depth; ++i) {
+            tasks.push_back(driver->request("echo", data));
+        }
+        bool ok = true;
+        for (Task& task : tasks) {
+            ok = waitDone(task) && ok;
+        }
+        if (!ok) {
+            state.SkipWithError("pipelined request did not complete");
+            break;
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * depth);
+}
+BENCHMARK(BM_DriverPipelined)->Arg(1)->Arg(16)->Unit(benchmark::kMicrosecond);
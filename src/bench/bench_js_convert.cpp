@@ -0,0 +1,57 @@
+#include <QJsonArray>
+#include <QJsonObject>
+#include <benchmark/benchmark.h>
+#include <quickjs.h>
+
+#include "utils/js_convert.h"
+
+namespace {
+
+QJsonObject makeNested(int points) {
+    QJsonArray rows;
+    for (int i = 0; i < points; ++i) {
+        rows.append(QJsonObject{{"id", i}, {"name", QString("tag_%1").arg(i)}, {"value", i * 0.25},
+                                {"ok", (i % 2) == 0}});
+    }
+    return QJsonObject{{"device", "plc-01"}, {"rows", rows}};
+}
+
+/// 每个基准独立的 JSRuntime/JSContext，避免 GC 状态跨基准干扰
+class JsContextScope {
+public:
+    JsContextScope() : m_rt(JS_NewRuntime()), m_ctx(JS_NewContext(m_rt)) {}
+    ~JsContextScope() {
+        JS_FreeContext(m_ctx);
+        JS_FreeRuntime(m_rt);
+    }
+    JSContext* ctx() const { return m_ctx; }
+
+private:
+    JSRuntime* m_rt;
+    JSContext* m_ctx;
+};
+
+} // namespace
+
+static void BM_QJsonToJsValue(benchmark::State& state) {
+    JsContextScope scope;
+    const QJsonObject obj = makeNested(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        JSValue val = qjsonToJsValue(scope.ctx(), obj);
+        benchmark::DoNotOptimize(val);
+        JS_FreeValue(scope.ctx(), val);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_QJsonToJsValue)->Arg(16)->Arg(1024);
+
+static void BM_JsValueToQJson(benchmark::State& state) {
+    JsContextScope scope;
+    JSValue val = qjsonToJsValue(scope.ctx(), makeNested(static_cast<int>(state.range(0))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(jsValueToQJson(scope.ctx(), val));
+    }
+    JS_FreeValue(scope.ctx(), val);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_JsValueToQJson)->Arg(16)->Arg(1024);
@@ -0,0 +1,43 @@
+#include <QCoreApplication>
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool hasFlag(int argc, char** argv, const char* prefix) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], prefix, std::strlen(prefix)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // Driver 往返基准依赖 QProcess，需要 QCoreApplication
+    QCoreApplication app(argc, argv);
+
+    // 未显式指定输出时默认写 JSON，便于 CI 归档与回归对比
+    std::vector<char*> args(argv, argv + argc);
+    std::string outArg = "--benchmark_out=stdiolink_bench.json";
+    std::string formatArg = "--benchmark_out_format=json";
+    if (!hasFlag(argc, argv, "--benchmark_out=")) {
+        args.push_back(outArg.data());
+        if (!hasFlag(argc, argv, "--benchmark_out_format=")) {
+            args.push_back(formatArg.data());
+        }
+    }
+    int benchArgc = static_cast<int>(args.size());
+
+    benchmark::Initialize(&benchArgc, args.data());
+    if (benchmark::ReportUnrecognizedArguments(benchArgc, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
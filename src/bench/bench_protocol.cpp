@@ -0,0 +1,150 @@
+#include <QJsonArray>
+#include <QJsonObject>
+#include <benchmark/benchmark.h>
+
+#include "stdiolink/driver/meta_builder.h"
+#include "stdiolink/protocol/jsonl_parser.h"
+#include "stdiolink/protocol/jsonl_serializer.h"
+#include "stdiolink/protocol/meta_validator.h"
+
+using namespace stdiolink;
+using namespace stdiolink::meta;
+
+namespace {
+
+// 典型采集结果：若干标量 + 一段数值数组，数组长度由基准参数控制
+QJsonObject makePayload(int points) {
+    QJsonArray samples;
+    for (int i = 0; i < points; ++i) {
+        samples.append(i * 0.5);
+    }
+    return QJsonObject{{"device", "plc-01"},
+                       {"ok", true},
+                       {"seq", 42},
+                       {"samples", samples}};
+}
+
+CommandMeta makeCommand() {
+    return CommandBuilder("scan")
+        .param(FieldBuilder("host", FieldType::String).required().pattern("^[a-z0-9.-]+$"))
+        .param(FieldBuilder("port", FieldType::Int).defaultValue(502).range(1, 65535))
+        .param(FieldBuilder("mode", FieldType::Enum)
+                   .enumValues(QStringList{"rtu", "tcp"})
+                   .defaultValue("tcp"))
+        .param(FieldBuilder("retry", FieldType::Object)
+                   .addField(FieldBuilder("count", FieldType::Int).defaultValue(3))
+                   .addField(FieldBuilder("delayMs", FieldType::Int).defaultValue(100)))
+        .param(FieldBuilder("tags", FieldType::Array)
+                   .maxItems(64)
+                   .items(FieldBuilder("tag", FieldType::String).pattern("^[A-Z_]+$")))
+        .build();
+}
+
+QJsonObject makeParams() {
+    QJsonArray tags;
+    for (int i = 0; i < 16; ++i) {
+        tags.append(QString("TAG_%1").arg(QChar('A' + i)));
+    }
+    return QJsonObject{{"host", "plc.local"}, {"tags", tags}};
+}
+
+} // namespace
+
+static void BM_SerializeResponse(benchmark::State& state) {
+    const QJsonObject payload = makePayload(static_cast<int>(state.range(0)));
+    qint64 bytes = 0;
+    for (auto _ : state) {
+        QByteArray line = serializeResponse("done", 0, payload, "req-1");
+        bytes += line.size();
+        benchmark::DoNotOptimize(line);
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_SerializeResponse)->Arg(0)->Arg(64)->Arg(4096);
+
+static void BM_AppendResponse(benchmark::State& state) {
+    const QJsonObject payload = makePayload(static_cast<int>(state.range(0)));
+    QByteArray out;
+    qint64 bytes = 0;
+    for (auto _ : state) {
+        out.clear();
+        appendResponse(out, "done", 0, payload, "req-1");
+        bytes += out.size();
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_AppendResponse)->Arg(0)->Arg(64)->Arg(4096);
+
+static void BM_ParseResponse(benchmark::State& state) {
+    QByteArray line = serializeResponse("done", 0, makePayload(static_cast<int>(state.range(0))),
+                                        "req-1");
+    line.chop(1);  // parseResponse 接收不含换行的单行
+    for (auto _ : state) {
+        Message msg;
+        benchmark::DoNotOptimize(parseResponse(line, msg));
+        benchmark::DoNotOptimize(msg);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * line.size());
+}
+BENCHMARK(BM_ParseResponse)->Arg(0)->Arg(64)->Arg(4096);
+
+static void BM_ParseResponseWithPayload(benchmark::State& state) {
+    QByteArray line = serializeResponse("done", 0, makePayload(static_cast<int>(state.range(0))),
+                                        "req-1");
+    line.chop(1);
+    for (auto _ : state) {
+        Message msg;
+        parseResponse(line, msg);
+        // 强制物化惰性 payload，衡量完整解码成本
+        benchmark::DoNotOptimize(msg.payload.toObject());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * line.size());
+}
+BENCHMARK(BM_ParseResponseWithPayload)->Arg(0)->Arg(64)->Arg(4096);
+
+static void BM_JsonlParserFraming(benchmark::State& state) {
+    // 一个块中含 N 行，按 4 KiB 分片喂入，模拟 readyRead 的随机切分
+    const int lines = static_cast<int>(state.range(0));
+    QByteArray stream;
+    for (int i = 0; i < lines; ++i) {
+        stream += serializeResponse("event", 0, QJsonObject{{"i", i}}, "req-1");
+    }
+    constexpr int kChunk = 4096;
+
+    for (auto _ : state) {
+        JsonlParser parser;
+        int count = 0;
+        for (qsizetype off = 0; off < stream.size(); off += kChunk) {
+            parser.append(stream.mid(off, kChunk));
+            QByteArrayView view;
+            while (parser.nextLine(view)) {
+                ++count;
+            }
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * lines);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * stream.size());
+}
+BENCHMARK(BM_JsonlParserFraming)->Arg(256)->Arg(4096);
+
+static void BM_FillAndValidateLegacy(benchmark::State& state) {
+    const CommandMeta cmd = makeCommand();
+    const QJsonObject params = makeParams();
+    for (auto _ : state) {
+        QJsonObject filled = DefaultFiller::fillDefaults(params, cmd);
+        benchmark::DoNotOptimize(MetaValidator::validateParams(filled, cmd));
+    }
+}
+BENCHMARK(BM_FillAndValidateLegacy);
+
+static void BM_FillAndValidatePlan(benchmark::State& state) {
+    const CommandValidationPlan plan(makeCommand());
+    const QJsonObject params = makeParams();
+    for (auto _ : state) {
+        QJsonObject filled = params;
+        benchmark::DoNotOptimize(plan.fillAndValidate(filled));
+    }
+}
+BENCHMARK(BM_FillAndValidatePlan);
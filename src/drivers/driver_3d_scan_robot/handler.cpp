@@ -88,6 +88,13 @@ static void addLongTaskParams(CommandBuilder& cb) {
       .param(connectionParam("inter_command_delay_ms"));
 }
 
+// 扫描数据输出方式，默认保持 data_base64 以兼容按 JSON 字段取数据的调用方
+static FieldBuilder blobParam() {
+    return FieldBuilder("blob", FieldType::Bool)
+        .defaultValue(false)
+        .description(QString::fromUtf8("true=Host 支持时以二进制侧信道帧附件输出原始数据（不含 data_base64）"));
+}
+
 // ── 参数解析辅助 ────────────────────────────────────────
 
 static RadarTransportParams parseTransportParams(const QJsonObject& p) {
@@ -155,6 +162,24 @@ static QJsonObject stateFlagsFromRaw(quint32 rawState) {
     };
 }
 
+// 请求带 blob=true 且 Host 支持二进制侧信道帧时原始扫描数据作为附件输出，否则沿用 data_base64 字段
+static void respondScanResult(IResponder& responder, const QString& taskCommand,
+                              const ScanAggregateResult& scanResult, bool wantBlob) {
+    QJsonObject result{
+        {"task_counter", scanResult.taskCounter},
+        {"task_command", taskCommand},
+        {"result_code", static_cast<qint64>(scanResult.resultCode)},
+        {"segment_count", scanResult.segmentCount},
+        {"byte_count", scanResult.byteCount}
+    };
+    if (wantBlob && responder.supportsBlobFrames()) {
+        responder.doneBlob(0, result, scanResult.data);
+        return;
+    }
+    result["data_base64"] = QString::fromLatin1(scanResult.data.toBase64());
+    responder.done(0, result);
+}
+
 // ── Handler 实现 ────────────────────────────────────────
 
 ThreeDScanRobotHandler::ThreeDScanRobotHandler() {
@@ -621,14 +646,7 @@ void ThreeDScanRobotHandler::handle(const QString& cmd, const QJsonValue& data,
             }
         }
 
-        responder.done(0, QJsonObject{
-            {"task_counter", scanResult.taskCounter},
-            {"task_command", "scan_line"},
-            {"result_code", static_cast<qint64>(scanResult.resultCode)},
-            {"segment_count", scanResult.segmentCount},
-            {"byte_count", scanResult.byteCount},
-            {"data_base64", QString::fromLatin1(scanResult.data.toBase64())}
-        });
+        respondScanResult(responder, "scan_line", scanResult, p["blob"].toBool(false));
         return;
     }
 
@@ -679,14 +697,7 @@ void ThreeDScanRobotHandler::handle(const QString& cmd, const QJsonValue& data,
             return;
         }
 
-        responder.done(0, QJsonObject{
-            {"task_counter", scanResult.taskCounter},
-            {"task_command", "scan_frame"},
-            {"result_code", static_cast<qint64>(scanResult.resultCode)},
-            {"segment_count", scanResult.segmentCount},
-            {"byte_count", scanResult.byteCount},
-            {"data_base64", QString::fromLatin1(scanResult.data.toBase64())}
-        });
+        respondScanResult(responder, "scan_frame", scanResult, p["blob"].toBool(false));
         return;
     }
 
@@ -704,14 +715,7 @@ void ThreeDScanRobotHandler::handle(const QString& cmd, const QJsonValue& data,
             return;
         }
 
-        responder.done(0, QJsonObject{
-            {"task_counter", scanResult.taskCounter},
-            {"task_command", "get_data"},
-            {"result_code", static_cast<qint64>(scanResult.resultCode)},
-            {"segment_count", scanResult.segmentCount},
-            {"byte_count", scanResult.byteCount},
-            {"data_base64", QString::fromLatin1(scanResult.data.toBase64())}
-        });
+        respondScanResult(responder, "get_data", scanResult, p["blob"].toBool(false));
         return;
     }
 
@@ -959,6 +963,7 @@ void ThreeDScanRobotHandler::buildMeta() {
         .description(QString::fromUtf8("单线扫描（指令 10）：固定 X 角度，沿 Y 轴扫描，"
                      "完成后自动拉取点云数据"));
     addLongTaskParams(scanLineCmd);
+    scanLineCmd.param(blobParam());
     scanLineCmd.param(FieldBuilder("angle_x", FieldType::Double).required()
         .defaultValue(0).range(0, 186).description(QString::fromUtf8("固定 X 角度（°），编码 ×100")));
     scanLineCmd.param(FieldBuilder("begin_y", FieldType::Double).required()
@@ -980,6 +985,7 @@ void ThreeDScanRobotHandler::buildMeta() {
         .description(QString::fromUtf8("帧扫描（指令 11）：X/Y 二维区域扫描，"
                      "完成后自动拉取点云数据"));
     addLongTaskParams(scanFrameCmd);
+    scanFrameCmd.param(blobParam());
     scanFrameCmd.param(FieldBuilder("begin_x", FieldType::Double).required()
         .defaultValue(0).range(0, 186).description(QString::fromUtf8("X 起始角度（°），编码 ×100")));
     scanFrameCmd.param(FieldBuilder("end_x", FieldType::Double).required()
@@ -1005,6 +1011,7 @@ void ThreeDScanRobotHandler::buildMeta() {
         .description(QString::fromUtf8("手动拉取指定长度的扫描分段数据（无状态，需知道 total_bytes）"));
     addConnectionParams(getDataCmd);
     getDataCmd.param(connectionParam("inter_command_delay_ms"));
+    getDataCmd.param(blobParam());
     getDataCmd.param(FieldBuilder("total_bytes", FieldType::Int).required()
         .range(1, 999999).description(QString::fromUtf8("预期拉取的数据总字节数")));
 
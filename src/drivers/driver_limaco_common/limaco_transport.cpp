@@ -1,11 +1,10 @@
 #include "driver_limaco_common/limaco_transport.h"
 
-#include <QHash>
-
 #include <memory>
 
 #include "driver_modbusrtu/modbus_rtu_client.h"
 #include "driver_modbusrtu_serial/modbus_rtu_serial_client.h"
+#include "stdiolink/driver/fieldbus_transport.h"
 
 using stdiolink::IResponder;
 using stdiolink::meta::CommandBuilder;
@@ -16,94 +15,75 @@ namespace limaco_driver {
 
 namespace {
 
-using modbus::ConnectionKey;
 using modbus::ModbusResult;
 using modbus::ModbusRtuClient;
 
-struct TcpConnectionManager {
+// 链路复用、空闲关闭与重连退避交给 stdiolink 的 FieldbusPool
+class TcpConnectionManager {
+public:
+    using Pool = stdiolink::FieldbusPool<ModbusRtuClient>;
+
     static TcpConnectionManager& instance() {
         static TcpConnectionManager manager;
         return manager;
     }
 
-    ModbusRtuClient* getClient(const QString& host, quint16 port) {
-        const ConnectionKey key{host, port};
-        auto it = m_connections.find(key);
-        if (it != m_connections.end() && it.value()->isConnected()) {
-            return it.value().get();
-        }
-
-        auto client = std::make_shared<ModbusRtuClient>();
-        if (!client->connectToServer(host, port)) {
-            return nullptr;
-        }
-
-        ModbusRtuClient* rawClient = client.get();
-        m_connections.insert(key, client);
-        return rawClient;
+    Pool::Lease getClient(const QString& host, quint16 port, QString& errorMessage) {
+        return m_pool.acquire(QString("%1:%2").arg(host).arg(port), QString(),
+            [&](QString& err) -> std::shared_ptr<ModbusRtuClient> {
+                auto client = std::make_shared<ModbusRtuClient>();
+                if (!client->connectToServer(host, port)) {
+                    err = QString("Failed to connect to %1:%2").arg(host).arg(port);
+                    return nullptr;
+                }
+                return client;
+            },
+            errorMessage);
     }
 
 private:
-    QHash<ConnectionKey, std::shared_ptr<ModbusRtuClient>> m_connections;
-};
+    TcpConnectionManager()
+        : m_pool([](ModbusRtuClient& client) { return client.isConnected(); }) {
+        m_pool.setProbe([](ModbusRtuClient& client) { return client.probe(); });
+    }
 
-struct SerialConnectionInfo {
-    std::shared_ptr<ModbusRtuSerialClient> client;
-    int baudRate = 9600;
-    int dataBits = 8;
-    QString stopBits = "1";
-    QString parity = "even";
+    Pool m_pool;
 };
 
 class SerialConnectionManager {
 public:
+    using Pool = stdiolink::FieldbusPool<ModbusRtuSerialClient>;
+
     static SerialConnectionManager& instance() {
         static SerialConnectionManager manager;
         return manager;
     }
 
-    ModbusRtuSerialClient* getClient(const QString& portName,
-                                     int baudRate,
-                                     int dataBits,
-                                     const QString& stopBits,
-                                     const QString& parity,
-                                     QString& errorMessage) {
-        auto it = m_connections.find(portName);
-        if (it != m_connections.end()) {
-            const SerialConnectionInfo& info = it.value();
-            if (info.client->isOpen()) {
-                if (info.baudRate != baudRate
-                    || info.dataBits != dataBits
-                    || info.stopBits != stopBits
-                    || info.parity != parity) {
-                    errorMessage = QString(
-                        "Serial port %1 is already open with different parameters")
-                        .arg(portName);
+    Pool::Lease getClient(const QString& portName,
+                          int baudRate,
+                          int dataBits,
+                          const QString& stopBits,
+                          const QString& parity,
+                          QString& errorMessage) {
+        const QString signature = QString("%1,%2,%3,%4")
+            .arg(baudRate).arg(dataBits).arg(stopBits, parity);
+        return m_pool.acquire(portName, signature,
+            [&](QString& err) -> std::shared_ptr<ModbusRtuSerialClient> {
+                auto client = std::make_shared<ModbusRtuSerialClient>();
+                if (!client->open(portName, baudRate, dataBits, stopBits, parity)) {
+                    err = QString("Failed to open serial port %1").arg(portName);
                     return nullptr;
                 }
-                return info.client.get();
-            }
-            m_connections.erase(it);
-        }
-
-        auto client = std::make_shared<ModbusRtuSerialClient>();
-        if (!client->open(portName, baudRate, dataBits, stopBits, parity)) {
-            errorMessage = QString("Failed to open serial port %1").arg(portName);
-            return nullptr;
-        }
-
-        SerialConnectionInfo info;
-        info.client = client;
-        info.baudRate = baudRate;
-        info.dataBits = dataBits;
-        info.stopBits = stopBits;
-        info.parity = parity;
-        m_connections.insert(portName, info);
-        return client.get();
+                return client;
+            },
+            errorMessage);
     }
 
 private:
-    QHash<QString, SerialConnectionInfo> m_connections;
+    SerialConnectionManager()
+        : m_pool([](ModbusRtuSerialClient& client) { return client.isOpen(); }) {}
+
+    Pool m_pool;
 };
 
 bool isOneOf(const QString& value, const QStringList& values) {
@@ -202,13 +182,11 @@ bool LimacoModbusTransport::readHoldingRegisters(const QJsonObject& params,
     }
 
     if (options.transport == "tcp") {
-        ModbusRtuClient* client = TcpConnectionManager::instance()
-            .getClient(options.host, static_cast<quint16>(options.port));
+        QString errorMessage;
+        auto client = TcpConnectionManager::instance()
+            .getClient(options.host, static_cast<quint16>(options.port), errorMessage);
         if (!client) {
-            respondIoError(
-                responder,
-                1,
-                QString("Failed to connect to %1:%2").arg(options.host).arg(options.port));
+            respondIoError(responder, 1, errorMessage);
             return false;
         }
 
@@ -225,7 +203,7 @@ bool LimacoModbusTransport::readHoldingRegisters(const QJsonObject& params,
     }
 
     QString errorMessage;
-    ModbusRtuSerialClient* client = SerialConnectionManager::instance().getClient(
+    auto client = SerialConnectionManager::instance().getClient(
         options.portName,
         options.baudRate,
         options.dataBits,
@@ -261,13 +239,11 @@ bool LimacoModbusTransport::writeMultipleRegisters(const QJsonObject& params,
     }
 
     if (options.transport == "tcp") {
-        ModbusRtuClient* client = TcpConnectionManager::instance()
-            .getClient(options.host, static_cast<quint16>(options.port));
+        QString errorMessage;
+        auto client = TcpConnectionManager::instance()
+            .getClient(options.host, static_cast<quint16>(options.port), errorMessage);
         if (!client) {
-            respondIoError(
-                responder,
-                1,
-                QString("Failed to connect to %1:%2").arg(options.host).arg(options.port));
+            respondIoError(responder, 1, errorMessage);
             return false;
         }
 
@@ -282,7 +258,7 @@ bool LimacoModbusTransport::writeMultipleRegisters(const QJsonObject& params,
     }
 
     QString errorMessage;
-    ModbusRtuSerialClient* client = SerialConnectionManager::instance().getClient(
+    auto client = SerialConnectionManager::instance().getClient(
         options.portName,
         options.baudRate,
         options.dataBits,
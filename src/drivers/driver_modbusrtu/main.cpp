@@ -1,12 +1,19 @@
 #include <QCoreApplication>
+#include <QDateTime>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QTimer>
 #include <memory>
+#include <vector>
 
 #include "stdiolink/driver/driver_core.h"
+#include "stdiolink/driver/fieldbus_transport.h"
 #include "stdiolink/driver/meta_builder.h"
 #include "stdiolink/driver/meta_command_handler.h"
+#include "stdiolink/driver/stdio_responder.h"
 #include "modbus_rtu_client.h"
 #include "modbus_types.h"
 
@@ -14,44 +21,87 @@ using namespace stdiolink;
 using namespace stdiolink::meta;
 using namespace modbus;
 
+static QStringList dataTypeEnum();
+static QStringList byteOrderEnum();
+
 /**
- * 连接管理器 - 自动缓存连接
+ * 连接管理器 - 按 host:port 复用连接
+ *
+ * 由 FieldbusPool 负责空闲关闭、空闲后探活与重连退避；
+ * 订阅轮询经其端点队列排队，与 stdin 命令交替执行。
  */
 class ConnectionManager {
 public:
+    using Pool = FieldbusPool<ModbusRtuClient>;
+
     static ConnectionManager& instance() {
         static ConnectionManager mgr;
         return mgr;
     }
 
-    ModbusRtuClient* getClient(const QString& host, quint16 port, int timeout) {
-        ConnectionKey key{host, port};
-
-        auto it = m_connections.find(key);
-        if (it != m_connections.end() && it.value()->isConnected()) {
-            return it.value().get();
-        }
+    static QString endpoint(const QString& host, quint16 port) {
+        return QString("%1:%2").arg(host).arg(port);
+    }
 
-        auto client = std::make_shared<ModbusRtuClient>(timeout);
-        if (client->connectToServer(host, port)) {
-            ModbusRtuClient* ptr = client.get();
-            m_connections[key] = std::move(client);
-            return ptr;
+    Pool::Lease getClient(const QString& host, quint16 port, int timeout, QString& error) {
+        Pool::Lease lease = m_pool.acquire(endpoint(host, port), QString(),
+            [&](QString& err) -> std::shared_ptr<ModbusRtuClient> {
+                auto client = std::make_shared<ModbusRtuClient>(timeout);
+                if (!client->connectToServer(host, port)) {
+                    err = "Failed to connect to " + host;
+                    return nullptr;
+                }
+                return client;
+            },
+            error);
+        if (lease) {
+            lease->setTimeout(timeout);
         }
-        return nullptr;
+        return lease;
     }
 
-    void disconnectAll() {
-        m_connections.clear();
-    }
+    Pool& pool() { return m_pool; }
 
 private:
-    ConnectionManager() = default;
-    ~ConnectionManager() { disconnectAll(); }
+    ConnectionManager()
+        : m_pool([](ModbusRtuClient& client) { return client.isConnected(); }) {
+        m_pool.setProbe([](ModbusRtuClient& client) { return client.probe(); });
+    }
+
+    Pool m_pool;
+};
+
+/**
+ * 订阅：驱动侧按标签周期轮询，只以 event 帧推送变化的值
+ */
+struct Subscription {
+    // 周期相同的标签合并规划读请求，共用一个定时器
+    struct PollGroup {
+        int intervalMs = 1000;
+        QVector<int> tagIndices;    // 在 Subscription::tags 中的下标
+        QVector<TagSpec> tags;
+        QVector<ReadBlock> blocks;
+        std::unique_ptr<QTimer> timer;
+        bool queued = false;        // 已排入端点队列、尚未执行，定时器再触发时跳过
+    };
 
-    QHash<ConnectionKey, std::shared_ptr<ModbusRtuClient>> m_connections;
+    QString id;
+    QString host;
+    quint16 port = 502;
+    int timeout = 3000;
+    uint8_t unitId = 1;
+    QVector<TagSpec> tags;
+    QVector<double> deadbands;
+    QVector<QJsonValue> lastValues; // 最近一次上报的值，Undefined 表示尚未上报
+    QVector<QString> lastErrors;    // 最近一次上报的错误，空表示正常
+    std::vector<PollGroup> groups;
+    std::unique_ptr<StdioResponder> responder;
+    qint64 events = 0;
 };
 
+static constexpr int kMinSubscribeIntervalMs = 50;
+static constexpr int kMaxSubscribeIntervalMs = 3600000;
+
 /**
  * Modbus RTU Over TCP Driver Handler
  */
@@ -67,26 +117,39 @@ private:
     void buildMeta();
 
     // 辅助函数
-    ModbusRtuClient* getClient(const QJsonObject& p, IResponder& resp);
+    ConnectionManager::Pool::Lease getClient(const QJsonObject& p, IResponder& resp);
     QJsonArray coilsToJson(const QVector<bool>& coils);
     QJsonArray registersToJson(const QVector<uint16_t>& regs,
                                const QString& dataType, const QString& byteOrder);
+    bool parseTags(const QJsonObject& p, QVector<TagSpec>& tags, QString& error);
+    QJsonValue decodeTag(const TagSpec& tag, const ModbusResult& result, int offset);
+    QString readBlocks(ModbusRtuClient* client, const QVector<TagSpec>& tags,
+                       const QVector<ReadBlock>& blocks, QJsonObject& values, QJsonObject& errors);
+    void readTags(ModbusRtuClient* client, const QVector<TagSpec>& tags, int maxGap, IResponder& resp);
+    bool buildSubscription(const QJsonObject& p, const QVector<TagSpec>& tags,
+                           Subscription& sub, QString& error);
+    void startSubscription(std::shared_ptr<Subscription> sub);
+    void unsubscribe(const QJsonObject& p, IResponder& resp);
+    void poll(Subscription& sub, Subscription::PollGroup& group);
 
     DriverMeta m_meta;
+    QHash<QString, std::shared_ptr<Subscription>> m_subscriptions;
+    int m_nextSubscriptionId = 1;
 };
 
 // 获取客户端连接
-ModbusRtuClient* ModbusRtuHandler::getClient(const QJsonObject& p, IResponder& resp)
+ConnectionManager::Pool::Lease ModbusRtuHandler::getClient(const QJsonObject& p, IResponder& resp)
 {
     QString host = p["host"].toString();
     int port = p["port"].toInt(502);
     int timeout = p["timeout"].toInt(3000);
 
-    auto* client = ConnectionManager::instance().getClient(host, port, timeout);
-    if (!client) {
-        resp.error(1, QJsonObject{{"message", "Failed to connect to " + host}});
+    QString error;
+    auto lease = ConnectionManager::instance().getClient(host, port, timeout, error);
+    if (!lease) {
+        resp.error(1, QJsonObject{{"message", error}});
     }
-    return client;
+    return lease;
 }
 
 // 线圈数组转 JSON
@@ -140,24 +203,399 @@ QJsonArray ModbusRtuHandler::registersToJson(const QVector<uint16_t>& regs,
     return arr;
 }
 
+// 解析轮询组标签，byte_order 未指定时取命令级默认值
+bool ModbusRtuHandler::parseTags(const QJsonObject& p, QVector<TagSpec>& tags, QString& error)
+{
+    const QJsonArray arr = p["tags"].toArray();
+    if (arr.isEmpty()) {
+        error = "tags must be a non-empty array";
+        return false;
+    }
+    const QString defaultByteOrder = p["byte_order"].toString("big_endian");
+
+    QSet<QString> names;
+    for (int i = 0; i < arr.size(); ++i) {
+        const QJsonObject t = arr[i].toObject();
+        TagSpec tag;
+        tag.name = t["name"].toString();
+        if (tag.name.isEmpty() || names.contains(tag.name)) {
+            error = QString("tags[%1]: name must be a unique non-empty string").arg(i);
+            return false;
+        }
+        names.insert(tag.name);
+
+        if (!parseTagArea(t["area"].toString("holding_register"), tag.area)) {
+            error = QString("tags[%1]: unknown area '%2'").arg(i).arg(t["area"].toString());
+            return false;
+        }
+        const QString dataType = t["data_type"].toString("uint16");
+        const QString byteOrder = t["byte_order"].toString(defaultByteOrder);
+        if (!dataTypeEnum().contains(dataType) || !byteOrderEnum().contains(byteOrder)) {
+            error = QString("tags[%1]: invalid data_type or byte_order").arg(i);
+            return false;
+        }
+        tag.dataType = parseDataType(dataType);
+        tag.byteOrder = parseByteOrder(byteOrder);
+
+        const int address = t["address"].toInt(-1);
+        if (address < 0 || address + tag.width() > 65536) {
+            error = QString("tags[%1]: address out of range").arg(i);
+            return false;
+        }
+        tag.address = static_cast<uint16_t>(address);
+        tag.scale = t["scale"].toDouble(1.0);
+        tag.offset = t["offset"].toDouble(0.0);
+        tags.append(tag);
+    }
+    return true;
+}
+
+// 按标签类型解码，配置了 scale/offset 时输出工程量
+QJsonValue ModbusRtuHandler::decodeTag(const TagSpec& tag, const ModbusResult& result, int offset)
+{
+    if (tag.isBit()) {
+        return result.coils.value(offset);
+    }
+
+    ByteOrderConverter conv(tag.byteOrder);
+    const QVector<uint16_t>& regs = result.registers;
+    double value = 0.0;
+    qint64 integer = 0;
+    bool isInteger = true;
+    switch (tag.dataType) {
+    case DataType::Int16:
+        integer = conv.toInt16(regs, offset);
+        break;
+    case DataType::UInt16:
+        integer = conv.toUInt16(regs, offset);
+        break;
+    case DataType::Int32:
+        integer = conv.toInt32(regs, offset);
+        break;
+    case DataType::UInt32:
+        integer = static_cast<qint64>(conv.toUInt32(regs, offset));
+        break;
+    case DataType::Int64:
+        integer = static_cast<qint64>(conv.toInt64(regs, offset));
+        break;
+    case DataType::UInt64:
+        integer = static_cast<qint64>(conv.toUInt64(regs, offset));
+        break;
+    case DataType::Float32:
+        value = conv.toFloat32(regs, offset);
+        isInteger = false;
+        break;
+    case DataType::Float64:
+        value = conv.toFloat64(regs, offset);
+        isInteger = false;
+        break;
+    }
+
+    if (tag.scale == 1.0 && tag.offset == 0.0) {
+        return isInteger ? QJsonValue(integer) : QJsonValue(value);
+    }
+    if (isInteger) {
+        value = static_cast<double>(integer);
+    }
+    return value * tag.scale + tag.offset;
+}
+
+// 读取已规划的块：成功的标签写入 values，失败的写入 errors，返回最后一个错误信息
+QString ModbusRtuHandler::readBlocks(ModbusRtuClient* client, const QVector<TagSpec>& tags,
+                                     const QVector<ReadBlock>& blocks, QJsonObject& values, QJsonObject& errors)
+{
+    QString lastError;
+    for (const ReadBlock& block : blocks) {
+        ModbusResult result;
+        if (!lastError.isEmpty() && !client->isConnected()) {
+            // 连接已断开，剩余块不再逐个等待超时
+            result.errorMessage = lastError;
+        } else {
+            switch (block.area) {
+            case TagArea::Coil:
+                result = client->readCoils(block.start, block.count);
+                break;
+            case TagArea::DiscreteInput:
+                result = client->readDiscreteInputs(block.start, block.count);
+                break;
+            case TagArea::HoldingRegister:
+                result = client->readHoldingRegisters(block.start, block.count);
+                break;
+            case TagArea::InputRegister:
+                result = client->readInputRegisters(block.start, block.count);
+                break;
+            }
+        }
+
+        for (int index : block.tagIndices) {
+            const TagSpec& tag = tags[index];
+            if (result.success) {
+                values[tag.name] = decodeTag(tag, result, tag.address - block.start);
+            } else {
+                errors[tag.name] = result.errorMessage;
+            }
+        }
+        if (!result.success) {
+            lastError = result.errorMessage;
+        }
+    }
+
+    return lastError;
+}
+
+// 轮询组：合并为最少的读请求，逐块读取后一次性返回全部标签
+void ModbusRtuHandler::readTags(ModbusRtuClient* client, const QVector<TagSpec>& tags, int maxGap, IResponder& resp)
+{
+    const QVector<ReadBlock> blocks = planReadBlocks(tags, maxGap);
+
+    QJsonObject values;
+    QJsonObject errors;
+    const QString lastError = readBlocks(client, tags, blocks, values, errors);
+
+    if (values.isEmpty()) {
+        resp.error(2, QJsonObject{{"message", lastError}, {"requests", blocks.size()}});
+        return;
+    }
+    QJsonObject out{{"values", values}, {"requests", blocks.size()}};
+    if (!errors.isEmpty()) {
+        out["errors"] = errors;
+    }
+    resp.done(0, out);
+}
+
+// 解析订阅参数：按 interval_ms 将标签分组，每组独立规划读请求
+bool ModbusRtuHandler::buildSubscription(const QJsonObject& p, const QVector<TagSpec>& tags,
+                                         Subscription& sub, QString& error)
+{
+    const QJsonArray arr = p["tags"].toArray();
+    const int defaultInterval = p["interval_ms"].toInt(1000);
+    const double defaultDeadband = p["deadband"].toDouble(0.0);
+
+    QMap<int, QVector<int>> byInterval;
+    for (int i = 0; i < tags.size(); ++i) {
+        const QJsonObject t = arr[i].toObject();
+        const int interval = t["interval_ms"].toInt(defaultInterval);
+        if (interval < kMinSubscribeIntervalMs || interval > kMaxSubscribeIntervalMs) {
+            error = QString("tags[%1]: interval_ms out of range").arg(i);
+            return false;
+        }
+        const double deadband = t["deadband"].toDouble(defaultDeadband);
+        if (deadband < 0) {
+            error = QString("tags[%1]: deadband must be non-negative").arg(i);
+            return false;
+        }
+        byInterval[interval].append(i);
+        sub.deadbands.append(deadband);
+    }
+
+    const int maxGap = p["max_gap"].toInt(0);
+    for (auto it = byInterval.cbegin(); it != byInterval.cend(); ++it) {
+        Subscription::PollGroup group;
+        group.intervalMs = it.key();
+        group.tagIndices = it.value();
+        for (int index : group.tagIndices) {
+            group.tags.append(tags[index]);
+        }
+        group.blocks = planReadBlocks(group.tags, maxGap);
+        sub.groups.push_back(std::move(group));
+    }
+
+    sub.host = p["host"].toString();
+    sub.port = static_cast<quint16>(p["port"].toInt(502));
+    sub.timeout = p["timeout"].toInt(3000);
+    sub.unitId = static_cast<uint8_t>(p["unit_id"].toInt(1));
+    sub.tags = tags;
+    sub.lastValues.fill(QJsonValue(QJsonValue::Undefined), tags.size());
+    sub.lastErrors.fill(QString(), tags.size());
+    return true;
+}
+
+// 启动订阅：先推送一帧完整快照，再由各组定时器按周期轮询
+void ModbusRtuHandler::startSubscription(std::shared_ptr<Subscription> sub)
+{
+    sub->id = QString("sub-%1").arg(m_nextSubscriptionId++);
+    // 默认构造捕获当前请求 ID，之后定时器触发的事件帧与最终 done 都回显该 ID
+    sub->responder = std::make_unique<StdioResponder>();
+
+    QJsonArray intervals;
+    qsizetype requests = 0;
+    for (const Subscription::PollGroup& group : sub->groups) {
+        intervals.append(group.intervalMs);
+        requests += group.blocks.size();
+    }
+    sub->responder->event("subscribed", 0, QJsonObject{
+        {"subscription", sub->id},
+        {"tags", sub->tags.size()},
+        {"intervals", intervals},
+        {"requests", requests}});
+
+    Subscription* raw = sub.get();
+    const std::weak_ptr<Subscription> weak = sub;
+    const QString endpoint = ConnectionManager::endpoint(raw->host, raw->port);
+    m_subscriptions.insert(sub->id, std::move(sub));
+    for (Subscription::PollGroup& group : raw->groups) {
+        Subscription::PollGroup* g = &group;
+        group.timer = std::make_unique<QTimer>();
+        group.timer->setInterval(group.intervalMs);
+        // 周期轮询以低优先级排入端点队列：同一连接上的多个订阅轮流执行，
+        // 上一轮尚未执行时不重复排队；取消订阅后残留的排队任务直接丢弃
+        QObject::connect(group.timer.get(), &QTimer::timeout, group.timer.get(),
+                         [this, weak, g, endpoint]() {
+            if (g->queued) {
+                return;
+            }
+            g->queued = true;
+            ConnectionManager::instance().pool().post(
+                endpoint, FieldbusTransport::Priority::Low, [this, weak, g]() {
+                    const std::shared_ptr<Subscription> live = weak.lock();
+                    if (!live) {
+                        return;
+                    }
+                    g->queued = false;
+                    poll(*live, *g);
+                });
+        });
+        poll(*raw, group);
+        group.timer->start();
+    }
+}
+
+// 取消订阅：未指定 subscription 时取消全部；被取消的订阅以 done 结束其事件流
+void ModbusRtuHandler::unsubscribe(const QJsonObject& p, IResponder& resp)
+{
+    const QString id = p["subscription"].toString();
+    QStringList ids;
+    if (id.isEmpty()) {
+        ids = m_subscriptions.keys();
+        ids.sort();
+    } else if (m_subscriptions.contains(id)) {
+        ids.append(id);
+    } else {
+        resp.error(3, QJsonObject{{"message", "Unknown subscription: " + id}});
+        return;
+    }
+
+    QJsonArray cancelled;
+    for (const QString& subId : ids) {
+        const std::shared_ptr<Subscription> sub = m_subscriptions.take(subId);
+        for (Subscription::PollGroup& group : sub->groups) {
+            group.timer->stop();
+        }
+        sub->responder->done(0, QJsonObject{
+            {"subscription", subId},
+            {"events", sub->events},
+            {"reason", "unsubscribed"}});
+        cancelled.append(subId);
+    }
+    resp.done(0, QJsonObject{{"cancelled", cancelled}});
+}
+
+// 轮询一组标签，只推送变化：首次取值、超出死区或由失败恢复；错误信息变化时才再次上报
+void ModbusRtuHandler::poll(Subscription& sub, Subscription::PollGroup& group)
+{
+    QJsonObject values;
+    QJsonObject errors;
+    QString error;
+    auto client = ConnectionManager::instance().getClient(sub.host, sub.port, sub.timeout, error);
+    if (!client) {
+        for (const TagSpec& tag : group.tags) {
+            errors[tag.name] = error;
+        }
+    } else {
+        client->setUnitId(sub.unitId);
+        readBlocks(client.get(), group.tags, group.blocks, values, errors);
+    }
+
+    QJsonObject changed;
+    QJsonObject failed;
+    for (int index : group.tagIndices) {
+        const QString& name = sub.tags[index].name;
+        if (values.contains(name)) {
+            const QJsonValue value = values.value(name);
+            if (tagValueChanged(sub.lastValues[index], value, sub.deadbands[index])) {
+                changed[name] = value;
+                sub.lastValues[index] = value;
+            }
+            sub.lastErrors[index].clear();
+            continue;
+        }
+
+        const QString message = errors[name].toString();
+        if (message != sub.lastErrors[index]) {
+            failed[name] = message;
+            sub.lastErrors[index] = message;
+        }
+        sub.lastValues[index] = QJsonValue(QJsonValue::Undefined);
+    }
+    if (changed.isEmpty() && failed.isEmpty()) {
+        return;
+    }
+
+    QJsonObject payload{
+        {"subscription", sub.id},
+        {"ts", QDateTime::currentMSecsSinceEpoch()},
+        {"values", changed}};
+    if (!failed.isEmpty()) {
+        payload["errors"] = failed;
+    }
+    sub.responder->event("data", 0, payload);
+    ++sub.events;
+}
+
 // 命令处理
 void ModbusRtuHandler::handle(const QString& cmd, const QJsonValue& data, IResponder& resp)
 {
     QJsonObject p = data.toObject();
 
     if (cmd == "status") {
-        resp.done(0, QJsonObject{{"status", "ready"}});
+        resp.done(0, QJsonObject{
+            {"status", "ready"},
+            {"links", ConnectionManager::instance().pool().statsJson()}});
         return;
     }
 
+    if (cmd == "unsubscribe") {
+        unsubscribe(p, resp);
+        return;
+    }
+
+    // 轮询组/订阅先校验标签，避免无效请求建立连接
+    QVector<TagSpec> tags;
+    std::shared_ptr<Subscription> subscription;
+    if (cmd == "subscribe" && StdioResponder::currentRequestId().isEmpty()) {
+        // 无请求 ID 时事件帧无法与后续请求区分，Host 会把下一次请求视为取代本订阅
+        resp.error(3, QJsonObject{{"message",
+            "subscribe requires a request id: enable pipelining on the host"}});
+        return;
+    }
+    if (cmd == "read_tags" || cmd == "subscribe") {
+        QString error;
+        bool ok = parseTags(p, tags, error);
+        if (ok && cmd == "subscribe") {
+            subscription = std::make_shared<Subscription>();
+            ok = buildSubscription(p, tags, *subscription, error);
+        }
+        if (!ok) {
+            resp.error(3, QJsonObject{{"message", error}});
+            return;
+        }
+    }
+
     // 获取连接
-    auto* client = getClient(p, resp);
-    if (!client) return;
+    auto lease = getClient(p, resp);
+    if (!lease) return;
+    auto* client = lease.get();
 
     int unitId = p["unit_id"].toInt(1);
     client->setUnitId(unitId);
 
-    if (cmd == "read_coils") {
+    if (cmd == "read_tags") {
+        readTags(client, tags, p["max_gap"].toInt(0), resp);
+    }
+    else if (cmd == "subscribe") {
+        startSubscription(std::move(subscription));
+    }
+    else if (cmd == "read_coils") {
         int addr = p["address"].toInt();
         int count = p["count"].toInt(1);
         auto result = client->readCoils(addr, count);
@@ -349,6 +787,42 @@ static QStringList byteOrderEnum() {
     return {"big_endian", "little_endian", "big_endian_byte_swap", "little_endian_byte_swap"};
 }
 
+// 标签项结构；订阅额外支持逐标签的轮询周期与死区
+static FieldBuilder tagItem(bool subscription) {
+    FieldBuilder tag = FieldBuilder("tag", FieldType::Object)
+        .addField(FieldBuilder("name", FieldType::String)
+            .description("标签名，结果按此名称返回，须唯一"))
+        .addField(FieldBuilder("area", FieldType::Enum)
+            .defaultValue("holding_register")
+            .enumValues(QStringList{"coil", "discrete_input", "holding_register", "input_register"})
+            .description("数据区"))
+        .addField(FieldBuilder("address", FieldType::Int)
+            .range(0, 65535)
+            .description("起始地址（0-65535）"))
+        .addField(FieldBuilder("data_type", FieldType::Enum)
+            .defaultValue("uint16").enumValues(dataTypeEnum())
+            .description("寄存器解码类型，线圈/离散输入忽略"))
+        .addField(FieldBuilder("byte_order", FieldType::Enum)
+            .enumValues(byteOrderEnum())
+            .description("多寄存器字节序，缺省取命令级 byte_order"))
+        .addField(FieldBuilder("scale", FieldType::Double)
+            .defaultValue(1.0)
+            .description("工程量系数：value = raw * scale + offset"))
+        .addField(FieldBuilder("offset", FieldType::Double)
+            .defaultValue(0.0)
+            .description("工程量偏移"));
+    if (subscription) {
+        tag.addField(FieldBuilder("interval_ms", FieldType::Int)
+                .range(kMinSubscribeIntervalMs, kMaxSubscribeIntervalMs)
+                .unit("ms")
+                .description("轮询周期，缺省取命令级 interval_ms"))
+            .addField(FieldBuilder("deadband", FieldType::Double)
+                .min(0)
+                .description("死区：与上次上报值之差超过该值才推送，缺省取命令级 deadband"));
+    }
+    return tag.requiredKeys(QStringList{"name", "address"});
+}
+
 void ModbusRtuHandler::buildMeta()
 {
     auto readHolding = CommandBuilder("read_holding_registers")
@@ -389,13 +863,77 @@ void ModbusRtuHandler::buildMeta()
         QJsonObject{{"host", "127.0.0.1"}, {"port", 502}, {"unit_id", 1},
                     {"address", 100}, {"value", 1000}});
 
+    auto readTagsCmd = CommandBuilder("read_tags")
+        .description("轮询组：按标签列表批量读取，相邻/重叠地址自动合并为最少的读请求（寄存器每次 ≤125、线圈每次 ≤2000），返回 {values: {标签名: 值}, requests, errors?}")
+        .param(connectionParam("host"))
+        .param(connectionParam("port"))
+        .param(connectionParam("unit_id"))
+        .param(connectionParam("timeout"))
+        .param(FieldBuilder("tags", FieldType::Array)
+            .required().minItems(1)
+            .description("标签列表")
+            .items(tagItem(false)))
+        .param(FieldBuilder("byte_order", FieldType::Enum)
+            .defaultValue("big_endian").enumValues(byteOrderEnum())
+            .description("标签未指定 byte_order 时使用的默认字节序"))
+        .param(FieldBuilder("max_gap", FieldType::Int)
+            .defaultValue(0).range(0, 100)
+            .advanced()
+            .description("允许跨越读取的未用地址数；设备对未映射地址报异常时保持 0"));
+    readTagsCmd.example("一次读取温度、压力和运行状态", QStringList{"stdio", "console"},
+        QJsonObject{{"host", "127.0.0.1"}, {"port", 502}, {"unit_id", 1},
+                    {"tags", QJsonArray{
+                        QJsonObject{{"name", "temperature"}, {"address", 0}, {"data_type", "int16"}, {"scale", 0.1}},
+                        QJsonObject{{"name", "pressure"}, {"address", 1}, {"data_type", "float32"}},
+                        QJsonObject{{"name", "running"}, {"area", "coil"}, {"address", 0}}}}});
+
+    auto subscribeCmd = CommandBuilder("subscribe")
+        .description("订阅：驱动侧按标签周期轮询，只在值变化（超出死区）或读取失败状态变化时推送 data 事件，直到 unsubscribe；需以 --profile=keepalive 启动且 Host 开启流水线（请求须带 id）")
+        .param(connectionParam("host"))
+        .param(connectionParam("port"))
+        .param(connectionParam("unit_id"))
+        .param(connectionParam("timeout"))
+        .param(FieldBuilder("tags", FieldType::Array)
+            .required().minItems(1)
+            .description("标签列表，周期相同的标签合并规划读请求")
+            .items(tagItem(true)))
+        .param(FieldBuilder("interval_ms", FieldType::Int)
+            .defaultValue(1000).range(kMinSubscribeIntervalMs, kMaxSubscribeIntervalMs)
+            .unit("ms")
+            .description("标签未指定 interval_ms 时使用的轮询周期"))
+        .param(FieldBuilder("deadband", FieldType::Double)
+            .defaultValue(0.0).min(0)
+            .description("标签未指定 deadband 时使用的死区，0 表示任何变化都推送"))
+        .param(FieldBuilder("byte_order", FieldType::Enum)
+            .defaultValue("big_endian").enumValues(byteOrderEnum())
+            .description("标签未指定 byte_order 时使用的默认字节序"))
+        .param(FieldBuilder("max_gap", FieldType::Int)
+            .defaultValue(0).range(0, 100)
+            .advanced()
+            .description("允许跨越读取的未用地址数；设备对未映射地址报异常时保持 0"))
+        .event("subscribed", "订阅已建立：{subscription, tags, intervals, requests}")
+        .event("data", "变化的标签：{subscription, ts, values: {标签名: 值}, errors?: {标签名: 错误}}");
+    subscribeCmd.example("温度每 500ms 轮询、变化超过 0.5 才推送，运行状态每秒轮询", QStringList{"stdio"},
+        QJsonObject{{"host", "127.0.0.1"}, {"port", 502}, {"unit_id", 1},
+                    {"tags", QJsonArray{
+                        QJsonObject{{"name", "temperature"}, {"address", 0}, {"data_type", "int16"}, {"scale", 0.1},
+                                    {"interval_ms", 500}, {"deadband", 0.5}},
+                        QJsonObject{{"name", "running"}, {"area", "coil"}, {"address", 0}}}}});
+
+    auto unsubscribeCmd = CommandBuilder("unsubscribe")
+        .description("取消订阅，被取消的 subscribe 请求以 done 结束（{subscription, events, reason}），本命令返回 {cancelled: [...]}")
+        .param(FieldBuilder("subscription", FieldType::String)
+            .description("subscribe 返回的订阅 ID，缺省取消全部订阅"));
+    unsubscribeCmd.example("取消订阅 sub-1", QStringList{"stdio", "console"},
+        QJsonObject{{"subscription", "sub-1"}});
+
     m_meta = DriverMetaBuilder()
         .schemaVersion("1.0")
         .info("modbus.rtu", "ModbusRTU Over TCP Master", "1.0.0",
               "Modbus RTU Over TCP 主站驱动，使用 RTU 帧格式（带 CRC16）通过 TCP 与远端网关通信")
         .vendor("stdiolink")
         .command(CommandBuilder("status")
-            .description("获取驱动存活状态，固定返回 ready")
+            .description("获取驱动存活状态（固定返回 ready）及各连接的复用、排队与往返耗时统计")
             .example("查询驱动状态", QStringList{"stdio", "console"}, QJsonObject{}))
         .command(CommandBuilder("read_coils")
             .description("读取线圈状态（功能码 0x01），返回 bool 数组")
@@ -411,6 +949,9 @@ void ModbusRtuHandler::buildMeta()
                 .description("连续读取的数量"))
             .example("读取地址 0 起的 8 个线圈", QStringList{"stdio", "console"}, QJsonObject{{"host", "127.0.0.1"}, {"port", 502}, {"unit_id", 1}, {"address", 0}, {"count", 8}}))
         .command(readHolding)
+        .command(readTagsCmd)
+        .command(subscribeCmd)
+        .command(unsubscribeCmd)
         .command(CommandBuilder("write_coil")
             .description("写单个线圈（功能码 0x05），true=ON / false=OFF")
             .param(connectionParam("host"))
@@ -0,0 +1,267 @@
+#include "modbus_data_area.h"
+
+#include <QMutexLocker>
+#include <QThread>
+#include <algorithm>
+
+namespace modbus {
+
+namespace {
+
+constexpr int kBitsPerWord = 64;
+
+// 从按 Modbus 格式打包的字节流中取出自 bitPos 起的 n (<= 64) 个位，低位在前
+quint64 gatherBits(const uchar* src, int bitPos, int n) {
+    quint64 value = 0;
+    int got = 0;
+    while (got < n) {
+        const int byteIndex = (bitPos + got) / 8;
+        const int bitOffset = (bitPos + got) % 8;
+        const int take = std::min(8 - bitOffset, n - got);
+        const quint64 chunk = (static_cast<quint64>(src[byteIndex]) >> bitOffset)
+                              & ((1ULL << take) - 1);
+        value |= chunk << got;
+        got += take;
+    }
+    return value;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// ModbusDataArea
+
+ModbusDataArea::ModbusDataArea(int size)
+    : m_size(std::max(0, size))
+    , m_words((m_size + kBitsPerWord - 1) / kBitsPerWord)
+    , m_coils(std::make_unique<Word[]>(m_words))
+    , m_discreteInputs(std::make_unique<Word[]>(m_words))
+    , m_holdingRegisters(std::make_unique<Register[]>(m_size))
+    , m_inputRegisters(std::make_unique<Register[]>(m_size)) {}
+
+bool ModbusDataArea::inRange(quint16 address, int count) const {
+    return count >= 0 && static_cast<int>(address) + count <= m_size;
+}
+
+const ModbusDataArea::Word* ModbusDataArea::bits(BitTable table) const {
+    return table == BitTable::Coils ? m_coils.get() : m_discreteInputs.get();
+}
+
+ModbusDataArea::Word* ModbusDataArea::bits(BitTable table) {
+    return table == BitTable::Coils ? m_coils.get() : m_discreteInputs.get();
+}
+
+const ModbusDataArea::Register* ModbusDataArea::registers(RegisterTable table) const {
+    return table == RegisterTable::Holding ? m_holdingRegisters.get() : m_inputRegisters.get();
+}
+
+ModbusDataArea::Register* ModbusDataArea::registers(RegisterTable table) {
+    return table == RegisterTable::Holding ? m_holdingRegisters.get() : m_inputRegisters.get();
+}
+
+void ModbusDataArea::beginWrite() {
+    m_writeMutex.lock();
+    m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void ModbusDataArea::endWrite() {
+    m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    m_writeMutex.unlock();
+}
+
+template <typename Copy>
+void ModbusDataArea::readConsistent(Copy copy) const {
+    for (;;) {
+        const quint64 before = m_sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            QThread::yieldCurrentThread();
+            continue;
+        }
+        copy();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) == before) {
+            return;
+        }
+    }
+}
+
+bool ModbusDataArea::readBits(BitTable table, quint16 address, int count,
+                              QByteArray& packed) const {
+    if (!inRange(address, count)) {
+        return false;
+    }
+    const Word* words = bits(table);
+    const int byteCount = (count + 7) / 8;
+    packed.resize(byteCount);
+    char* out = packed.data();
+
+    readConsistent([&]() {
+        for (int i = 0; i < byteCount; ++i) {
+            const int pos = address + i * 8;
+            const int word = pos / kBitsPerWord;
+            const int offset = pos % kBitsPerWord;
+            quint64 value = words[word].load(std::memory_order_relaxed) >> offset;
+            if (offset > kBitsPerWord - 8 && word + 1 < m_words) {
+                value |= words[word + 1].load(std::memory_order_relaxed)
+                         << (kBitsPerWord - offset);
+            }
+            const int n = std::min(8, count - i * 8);
+            out[i] = static_cast<char>(value & ((1U << n) - 1));
+        }
+    });
+    return true;
+}
+
+bool ModbusDataArea::writeBits(BitTable table, quint16 address, int count,
+                               const QByteArray& packed) {
+    if (!inRange(address, count) || packed.size() < (count + 7) / 8) {
+        return false;
+    }
+    const auto* src = reinterpret_cast<const uchar*>(packed.constData());
+    Word* words = bits(table);
+
+    beginWrite();
+    int done = 0;
+    while (done < count) {
+        const int pos = address + done;
+        const int word = pos / kBitsPerWord;
+        const int offset = pos % kBitsPerWord;
+        const int n = std::min(kBitsPerWord - offset, count - done);
+        const quint64 mask = (n == kBitsPerWord ? ~0ULL : ((1ULL << n) - 1)) << offset;
+        const quint64 value = gatherBits(src, done, n) << offset;
+        const quint64 old = words[word].load(std::memory_order_relaxed);
+        words[word].store((old & ~mask) | value, std::memory_order_relaxed);
+        done += n;
+    }
+    endWrite();
+    return true;
+}
+
+bool ModbusDataArea::readRegisters(RegisterTable table, quint16 address, int count,
+                                   quint16* out) const {
+    if (!inRange(address, count)) {
+        return false;
+    }
+    const Register* regs = registers(table) + address;
+    readConsistent([&]() {
+        for (int i = 0; i < count; ++i) {
+            out[i] = regs[i].load(std::memory_order_relaxed);
+        }
+    });
+    return true;
+}
+
+bool ModbusDataArea::writeRegisters(RegisterTable table, quint16 address, int count,
+                                    const quint16* values) {
+    if (!inRange(address, count)) {
+        return false;
+    }
+    Register* regs = registers(table) + address;
+    beginWrite();
+    for (int i = 0; i < count; ++i) {
+        regs[i].store(values[i], std::memory_order_relaxed);
+    }
+    endWrite();
+    return true;
+}
+
+bool ModbusDataArea::readRegistersBigEndian(RegisterTable table, quint16 address, int count,
+                                            QByteArray& out) const {
+    if (!inRange(address, count)) {
+        return false;
+    }
+    const Register* regs = registers(table) + address;
+    out.resize(count * 2);
+    auto* bytes = reinterpret_cast<uchar*>(out.data());
+    readConsistent([&]() {
+        for (int i = 0; i < count; ++i) {
+            const quint16 value = regs[i].load(std::memory_order_relaxed);
+            bytes[i * 2] = static_cast<uchar>(value >> 8);
+            bytes[i * 2 + 1] = static_cast<uchar>(value & 0xFF);
+        }
+    });
+    return true;
+}
+
+bool ModbusDataArea::writeRegistersBigEndian(RegisterTable table, quint16 address, int count,
+                                             const char* data) {
+    if (!inRange(address, count)) {
+        return false;
+    }
+    const auto* bytes = reinterpret_cast<const uchar*>(data);
+    Register* regs = registers(table) + address;
+    beginWrite();
+    for (int i = 0; i < count; ++i) {
+        regs[i].store(static_cast<quint16>((bytes[i * 2] << 8) | bytes[i * 2 + 1]),
+                      std::memory_order_relaxed);
+    }
+    endWrite();
+    return true;
+}
+
+bool ModbusDataArea::getBit(BitTable table, quint16 address, bool& value) const {
+    if (!inRange(address, 1)) {
+        return false;
+    }
+    const quint64 word = bits(table)[address / kBitsPerWord].load(std::memory_order_acquire);
+    value = (word >> (address % kBitsPerWord)) & 1U;
+    return true;
+}
+
+bool ModbusDataArea::setBit(BitTable table, quint16 address, bool value) {
+    return writeBits(table, address, 1, QByteArray(1, value ? '\x01' : '\x00'));
+}
+
+bool ModbusDataArea::getRegister(RegisterTable table, quint16 address, quint16& value) const {
+    if (!inRange(address, 1)) {
+        return false;
+    }
+    value = registers(table)[address].load(std::memory_order_acquire);
+    return true;
+}
+
+bool ModbusDataArea::setRegister(RegisterTable table, quint16 address, quint16 value) {
+    return writeRegisters(table, address, 1, &value);
+}
+
+// ---------------------------------------------------------------------------
+// ModbusUnitTable
+
+bool ModbusUnitTable::add(quint8 unitId, int size) {
+    QMutexLocker locker(&m_writeMutex);
+    if (std::atomic_load(&m_slots[unitId])) {
+        return false;
+    }
+    std::atomic_store(&m_slots[unitId], std::make_shared<ModbusDataArea>(size));
+    return true;
+}
+
+bool ModbusUnitTable::remove(quint8 unitId) {
+    QMutexLocker locker(&m_writeMutex);
+    if (!std::atomic_load(&m_slots[unitId])) {
+        return false;
+    }
+    std::atomic_store(&m_slots[unitId], std::shared_ptr<ModbusDataArea>());
+    return true;
+}
+
+bool ModbusUnitTable::contains(quint8 unitId) const {
+    return find(unitId) != nullptr;
+}
+
+std::shared_ptr<ModbusDataArea> ModbusUnitTable::find(quint8 unitId) const {
+    return std::atomic_load(&m_slots[unitId]);
+}
+
+QList<quint8> ModbusUnitTable::units() const {
+    QList<quint8> ids;
+    for (int id = 0; id < static_cast<int>(m_slots.size()); ++id) {
+        if (std::atomic_load(&m_slots[id])) {
+            ids.append(static_cast<quint8>(id));
+        }
+    }
+    return ids;
+}
+
+} // namespace modbus
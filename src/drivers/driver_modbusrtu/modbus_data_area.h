@@ -0,0 +1,116 @@
+#ifndef MODBUS_DATA_AREA_H
+#define MODBUS_DATA_AREA_H
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QVector>
+#include <array>
+#include <atomic>
+#include <memory>
+
+namespace modbus {
+
+/**
+ * 从站单元数据区
+ *
+ * 线圈与离散输入按位打包在 64 位字中（地址 n 对应第 n/64 字的第 n%64 位），
+ * 保持/输入寄存器为连续的 16 位数组。
+ *
+ * 并发模型为序列锁（seqlock）：写入方之间以互斥锁串行化，写入前后各递增一次序列号；
+ * 读取方不加锁，读取前后序列号一致且为偶数即得到某次写入完成后的一致快照，否则重读。
+ * 读取不会阻塞写入，写入也不等待读取。元素以 relaxed 原子访问，批量读写即逐元素拷贝，
+ * 一次批量写入只占用一个写区间。
+ */
+class ModbusDataArea {
+public:
+    enum class BitTable { Coils, DiscreteInputs };
+    enum class RegisterTable { Holding, Input };
+
+    explicit ModbusDataArea(int size = 10000);
+
+    ModbusDataArea(const ModbusDataArea&) = delete;
+    ModbusDataArea& operator=(const ModbusDataArea&) = delete;
+
+    int size() const { return m_size; }
+
+    /** 已完成的写入次数 */
+    quint64 version() const { return m_sequence.load(std::memory_order_acquire) / 2; }
+
+    /**
+     * 读取 count 个位，按 Modbus 响应格式打包：每字节低位在前，末字节高位补 0
+     * @return 地址越界返回 false
+     */
+    bool readBits(BitTable table, quint16 address, int count, QByteArray& packed) const;
+
+    /** 按 Modbus 请求格式（每字节低位在前）写入 count 个位 */
+    bool writeBits(BitTable table, quint16 address, int count, const QByteArray& packed);
+
+    bool readRegisters(RegisterTable table, quint16 address, int count, quint16* out) const;
+    bool writeRegisters(RegisterTable table, quint16 address, int count, const quint16* values);
+
+    /** 读取寄存器并按大端字节序编码，即 Modbus 读寄存器响应的数据部分 */
+    bool readRegistersBigEndian(RegisterTable table, quint16 address, int count,
+                                QByteArray& out) const;
+
+    /** 写入以大端字节序编码的寄存器，即 Modbus 写多个寄存器请求的数据部分 */
+    bool writeRegistersBigEndian(RegisterTable table, quint16 address, int count,
+                                 const char* data);
+
+    bool getBit(BitTable table, quint16 address, bool& value) const;
+    bool setBit(BitTable table, quint16 address, bool value);
+    bool getRegister(RegisterTable table, quint16 address, quint16& value) const;
+    bool setRegister(RegisterTable table, quint16 address, quint16 value);
+
+private:
+    using Word = std::atomic<quint64>;
+    using Register = std::atomic<quint16>;
+
+    bool inRange(quint16 address, int count) const;
+    const Word* bits(BitTable table) const;
+    Word* bits(BitTable table);
+    const Register* registers(RegisterTable table) const;
+    Register* registers(RegisterTable table);
+
+    void beginWrite();
+    void endWrite();
+
+    // 读取方：反复执行 copy 直到期间没有写入
+    template <typename Copy>
+    void readConsistent(Copy copy) const;
+
+    int m_size = 0;
+    int m_words = 0;
+    std::unique_ptr<Word[]> m_coils;
+    std::unique_ptr<Word[]> m_discreteInputs;
+    std::unique_ptr<Register[]> m_holdingRegisters;
+    std::unique_ptr<Register[]> m_inputRegisters;
+
+    std::atomic<quint64> m_sequence{0};  // 奇数表示写入进行中
+    QMutex m_writeMutex;
+};
+
+/**
+ * 单元表：unitId (0-255) 到数据区的映射
+ *
+ * 每个 unitId 一个槽位，增删单元时以 std::atomic_load/atomic_store 替换槽位中的 shared_ptr
+ * （驱动以 C++17 编译，std::atomic<std::shared_ptr> 不可用）；
+ * 查找只做一次原子加载，不与数据读写或其他单元的查找争用同一把锁。
+ * 已被移除的单元在最后一个持有者释放后回收。
+ */
+class ModbusUnitTable {
+public:
+    bool add(quint8 unitId, int size);
+    bool remove(quint8 unitId);
+    bool contains(quint8 unitId) const;
+    std::shared_ptr<ModbusDataArea> find(quint8 unitId) const;
+    QList<quint8> units() const;
+
+private:
+    std::array<std::shared_ptr<ModbusDataArea>, 256> m_slots;
+    QMutex m_writeMutex;  // 只串行化增删
+};
+
+} // namespace modbus
+
+#endif // MODBUS_DATA_AREA_H
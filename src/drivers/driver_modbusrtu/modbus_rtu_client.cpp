@@ -88,6 +88,15 @@ bool ModbusRtuClient::isConnected() const
     return m_socket.state() == QAbstractSocket::ConnectedState;
 }
 
+bool ModbusRtuClient::probe()
+{
+    if (m_socket.state() == QAbstractSocket::ConnectedState) {
+        m_socket.waitForReadyRead(0);
+        m_socket.readAll();
+    }
+    return isConnected();
+}
+
 bool ModbusRtuClient::verifyCRC(const QByteArray& frame)
 {
     if (frame.size() < 4) return false;
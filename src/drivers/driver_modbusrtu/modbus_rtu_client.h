@@ -54,6 +54,8 @@ public:
     bool connectToServer(const QString& host, quint16 port);
     void disconnect();
     bool isConnected() const;
+    // 空闲探活：刷新套接字状态以发现对端已关闭，并丢弃空闲期间收到的残留字节
+    bool probe();
 
     // 设置
     void setTimeout(int ms) { m_timeout = ms; }
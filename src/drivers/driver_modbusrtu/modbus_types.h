@@ -2,6 +2,7 @@
 #define MODBUS_TYPES_H
 
 #include <QByteArray>
+#include <QJsonValue>
 #include <QString>
 #include <QVector>
 #include <cstdint>
@@ -82,6 +83,71 @@ DataType parseDataType(const QString& str);
  */
 QString exceptionMessage(ExceptionCode code);
 
+/**
+ * 单次读请求的协议上限（Modbus 应用协议规范 V1.1b3）
+ */
+constexpr int kMaxReadRegisters = 125;
+constexpr int kMaxReadBits = 2000;
+
+/**
+ * 轮询组标签所在的数据区
+ */
+enum class TagArea {
+    Coil,
+    DiscreteInput,
+    HoldingRegister,
+    InputRegister
+};
+
+/**
+ * 从字符串解析数据区，未知字符串返回 false
+ */
+bool parseTagArea(const QString& str, TagArea& area);
+
+/**
+ * 轮询组中的单个标签
+ */
+struct TagSpec {
+    QString name;
+    TagArea area = TagArea::HoldingRegister;
+    uint16_t address = 0;
+    DataType dataType = DataType::UInt16;   // 线圈 / 离散输入忽略
+    ByteOrder byteOrder = ByteOrder::BigEndian;
+    double scale = 1.0;
+    double offset = 0.0;
+
+    bool isBit() const { return area == TagArea::Coil || area == TagArea::DiscreteInput; }
+    int width() const { return isBit() ? 1 : registersPerType(dataType); }
+};
+
+/**
+ * 合并后的一次读请求，tagIndices 为落在该区间内的标签下标
+ */
+struct ReadBlock {
+    TagArea area = TagArea::HoldingRegister;
+    uint16_t start = 0;
+    uint16_t count = 0;
+    QVector<int> tagIndices;
+};
+
+/**
+ * 将标签按数据区合并为最少的读请求
+ *
+ * 区间重叠或相邻（间隔不超过 maxGap 个地址）时合并，合并后超过单次请求
+ * 上限（寄存器 125 / 线圈 2000）则另起一块；单个标签不会被拆到两个请求中。
+ * 调用方须保证 address + width() 不超过 65536。
+ */
+QVector<ReadBlock> planReadBlocks(const QVector<TagSpec>& tags, int maxGap = 0);
+
+/**
+ * 订阅变化检测：与最近一次上报的值比较
+ *
+ * last 为 Undefined（尚未上报）或类型不同时视为变化；数值按
+ * |current - last| > deadband 判断，deadband 为 0 时任何变化都上报；
+ * 其他类型按值比较。
+ */
+bool tagValueChanged(const QJsonValue& last, const QJsonValue& current, double deadband);
+
 /**
  * 字节序转换器
  */
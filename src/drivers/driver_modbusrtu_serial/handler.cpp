@@ -60,41 +60,28 @@ static FieldBuilder serialParam(const QString& name) {
         .description("单次读写超时（毫秒），默认 3000");
 }
 
-ModbusRtuSerialClient* SerialConnectionManager::getConnection(
+SerialConnectionManager::SerialConnectionManager()
+    : m_pool([](ModbusRtuSerialClient& client) { return client.isOpen(); }) {}
+
+SerialConnectionManager::Pool::Lease SerialConnectionManager::getConnection(
         const QString& portName, int baudRate, int dataBits,
         const QString& stopBits, const QString& parity,
         QString& errorMsg) {
-    auto it = m_connections.find(portName);
-    if (it != m_connections.end()) {
-        auto& info = it.value();
-        if (info.client->isOpen()) {
-            if (info.baudRate != baudRate || info.dataBits != dataBits ||
-                info.stopBits != stopBits || info.parity != parity) {
-                errorMsg = QString("Port %1 already open with different parameters").arg(portName);
+    const QString signature = QString("%1,%2,%3,%4")
+        .arg(baudRate).arg(dataBits).arg(stopBits, parity);
+    return m_pool.acquire(portName, signature,
+        [&](QString& err) -> std::shared_ptr<ModbusRtuSerialClient> {
+            auto client = std::make_shared<ModbusRtuSerialClient>();
+            if (!client->open(portName, baudRate, dataBits, stopBits, parity)) {
+                err = QString("Failed to open serial port %1").arg(portName);
                 return nullptr;
             }
-            return info.client.get();
-        }
-        m_connections.erase(it);
-    }
-
-    auto client = std::make_shared<ModbusRtuSerialClient>();
-    if (!client->open(portName, baudRate, dataBits, stopBits, parity)) {
-        errorMsg = QString("Failed to open serial port %1").arg(portName);
-        return nullptr;
-    }
-
-    ConnectionInfo ci;
-    ci.client = client;
-    ci.baudRate = baudRate;
-    ci.dataBits = dataBits;
-    ci.stopBits = stopBits;
-    ci.parity = parity;
-    m_connections[portName] = ci;
-    return client.get();
+            return client;
+        },
+        errorMsg);
 }
 
-ModbusRtuSerialClient* ModbusRtuSerialHandler::getClient(const QJsonObject& p, IResponder& resp) {
+SerialConnectionManager::Pool::Lease ModbusRtuSerialHandler::getClient(const QJsonObject& p, IResponder& resp) {
     QString portName = p["port_name"].toString();
     int baudRate = p["baud_rate"].toInt(9600);
     int dataBits = p["data_bits"].toInt(8);
@@ -102,12 +89,12 @@ ModbusRtuSerialClient* ModbusRtuSerialHandler::getClient(const QJsonObject& p, I
     QString parity = p["parity"].toString("none");
 
     QString errorMsg;
-    auto* client = SerialConnectionManager::instance()
+    auto lease = SerialConnectionManager::instance()
         .getConnection(portName, baudRate, dataBits, stopBits, parity, errorMsg);
-    if (!client) {
+    if (!lease) {
         resp.error(1, QJsonObject{{"message", errorMsg}});
     }
-    return client;
+    return lease;
 }
 
 QJsonArray ModbusRtuSerialHandler::coilsToJson(const QVector<bool>& coils) {
@@ -143,7 +130,9 @@ void ModbusRtuSerialHandler::handle(const QString& cmd, const QJsonValue& data,
     QJsonObject p = data.toObject();
 
     if (cmd == "status") {
-        resp.done(0, QJsonObject{{"status", "ready"}});
+        resp.done(0, QJsonObject{
+            {"status", "ready"},
+            {"links", SerialConnectionManager::instance().pool().statsJson()}});
         return;
     }
 
@@ -168,8 +157,9 @@ void ModbusRtuSerialHandler::handle(const QString& cmd, const QJsonValue& data,
         }
     }
 
-    auto* client = getClient(p, resp);
-    if (!client) return;
+    auto lease = getClient(p, resp);
+    if (!lease) return;
+    auto* client = lease.get();
 
     if (cmd == "read_coils") {
         int addr = p["address"].toInt();
@@ -362,7 +352,7 @@ void ModbusRtuSerialHandler::buildMeta() {
               "Modbus RTU 串口主站驱动，通过 RS485 串口直连 Modbus 从站设备")
         .vendor("stdiolink")
         .command(CommandBuilder("status")
-            .description("获取驱动存活状态，固定返回 ready")
+            .description("获取驱动存活状态（固定返回 ready）及各串口的复用、排队与往返耗时统计")
             .example("查询驱动状态", QStringList{"stdio", "console"}, QJsonObject{}))
         .command(CommandBuilder("read_coils")
             .description("读取线圈状态（功能码 0x01），返回 bool 数组")
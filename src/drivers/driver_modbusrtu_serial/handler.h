@@ -1,6 +1,7 @@
 #pragma once
 
 #include "modbus_rtu_serial_client.h"
+#include "stdiolink/driver/fieldbus_transport.h"
 #include "stdiolink/driver/meta_command_handler.h"
 #include <QMap>
 #include <memory>
@@ -8,30 +9,31 @@
 using namespace stdiolink;
 using namespace stdiolink::meta;
 
+/**
+ * 串口连接管理器 - 按串口名复用已打开的串口
+ *
+ * 由 FieldbusPool 负责空闲关闭与重连退避；串口打开期间以不同参数访问会被拒绝。
+ */
 class SerialConnectionManager {
 public:
+    using Pool = FieldbusPool<ModbusRtuSerialClient>;
+
     static SerialConnectionManager& instance() {
         static SerialConnectionManager mgr;
         return mgr;
     }
 
-    ModbusRtuSerialClient* getConnection(
+    Pool::Lease getConnection(
         const QString& portName, int baudRate, int dataBits,
         const QString& stopBits, const QString& parity,
         QString& errorMsg);
 
+    Pool& pool() { return m_pool; }
+
 private:
-    SerialConnectionManager() = default;
-    ~SerialConnectionManager() { m_connections.clear(); }
-
-    struct ConnectionInfo {
-        std::shared_ptr<ModbusRtuSerialClient> client;
-        int baudRate;
-        int dataBits;
-        QString stopBits;
-        QString parity;
-    };
-    QMap<QString, ConnectionInfo> m_connections;
+    SerialConnectionManager();
+
+    Pool m_pool;
 };
 
 class ModbusRtuSerialHandler : public IMetaCommandHandler {
@@ -43,7 +45,7 @@ public:
 
 private:
     void buildMeta();
-    ModbusRtuSerialClient* getClient(const QJsonObject& p, IResponder& resp);
+    SerialConnectionManager::Pool::Lease getClient(const QJsonObject& p, IResponder& resp);
     QJsonArray coilsToJson(const QVector<bool>& coils);
     QJsonArray registersToJson(const QVector<uint16_t>& regs,
                                const QString& dataType, const QString& byteOrder);
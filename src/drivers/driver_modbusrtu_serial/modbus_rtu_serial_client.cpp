@@ -1,7 +1,6 @@
 #include "modbus_rtu_serial_client.h"
 #include <QDataStream>
 #include <QElapsedTimer>
-#include <QThread>
 #include <QtMath>
 
 static const uint16_t crc16Table[256] = {
@@ -90,6 +89,8 @@ bool ModbusRtuSerialClient::open(const QString& portName, int baudRate,
     bool hasParity = (parity != "none");
     double stopBitsVal = (stopBits == "1.5") ? 1.5 : stopBits.toDouble();
     m_t35Ms = calculateT35(baudRate, dataBits, hasParity, stopBitsVal);
+    m_pacer.setGapUs(qRound64(m_t35Ms * 1000));
+    m_pacer.reset();
     return true;
 }
 
@@ -126,8 +127,8 @@ bool ModbusRtuSerialClient::verifyCRC(const QByteArray& frame) {
 }
 
 QByteArray ModbusRtuSerialClient::sendRequest(const QByteArray& request, int timeout) {
-    // T3.5 pre-send silence
-    QThread::usleep(static_cast<unsigned long>(m_t35Ms * 1000));
+    // T3.5 pre-send silence: only the part not already covered since the last frame
+    m_pacer.waitForGap();
 
     // Clear any stale data in RX buffer before sending
     m_serial->clear(QSerialPort::Input);
@@ -151,6 +152,7 @@ QByteArray ModbusRtuSerialClient::sendRequest(const QByteArray& request, int tim
             break;
         }
     }
+    m_pacer.markFrameEnd();
     return response;
 }
 
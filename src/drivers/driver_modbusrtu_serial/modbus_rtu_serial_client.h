@@ -6,6 +6,7 @@
 #include <QString>
 #include <QVector>
 #include "modbus_types.h"
+#include "stdiolink/driver/fieldbus_transport.h"
 
 using namespace modbus;
 
@@ -57,6 +58,7 @@ private:
 
     QSerialPort* m_serial = nullptr;
     double m_t35Ms = 3.646;
+    stdiolink::FieldbusPacer m_pacer;  // 帧间至少保持 T3.5 静默
 };
 
 #endif // MODBUS_RTU_SERIAL_CLIENT_H
@@ -1,6 +1,10 @@
 #include "modbus_rtu_serial_server.h"
 #include <QtMath>
 
+using modbus::ModbusDataArea;
+using BitTable = ModbusDataArea::BitTable;
+using RegisterTable = ModbusDataArea::RegisterTable;
+
 enum SerialFunctionCode {
     SFC_READ_COILS = 0x01,
     SFC_READ_DISCRETE_INPUTS = 0x02,
@@ -143,27 +147,19 @@ QString ModbusRtuSerialServer::portName() const {
 }
 
 bool ModbusRtuSerialServer::addUnit(quint8 unitId, int dataAreaSize) {
-    QMutexLocker locker(&m_mutex);
-    if (m_unitDataAreas.contains(unitId)) return false;
-    m_unitDataAreas.insert(unitId, QSharedPointer<SerialModbusDataArea>::create(dataAreaSize));
-    return true;
+    return m_units.add(unitId, dataAreaSize);
 }
 
 bool ModbusRtuSerialServer::removeUnit(quint8 unitId) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    m_unitDataAreas.remove(unitId);
-    return true;
+    return m_units.remove(unitId);
 }
 
 bool ModbusRtuSerialServer::hasUnit(quint8 unitId) const {
-    QMutexLocker locker(&m_mutex);
-    return m_unitDataAreas.contains(unitId);
+    return m_units.contains(unitId);
 }
 
 QList<quint8> ModbusRtuSerialServer::getUnits() const {
-    QMutexLocker locker(&m_mutex);
-    return m_unitDataAreas.keys();
+    return m_units.units();
 }
 
 void ModbusRtuSerialServer::onReadyRead() {
@@ -198,29 +194,26 @@ void ModbusRtuSerialServer::onFrameTimeout() {
 }
 
 void ModbusRtuSerialServer::applyBroadcastWrite(quint8 fc, const QByteArray& data,
-        QSharedPointer<SerialModbusDataArea> dataArea) {
+        ModbusDataArea& dataArea) {
     // Broadcast writes are best-effort: silently skip if address out of range
     if (fc == SFC_WRITE_SINGLE_COIL && data.size() >= 4) {
         quint16 addr = bytesToUInt16(data, 0);
         quint16 val = bytesToUInt16(data, 2);
-        if (addr < dataArea->coils.size() && (val == 0x0000 || val == 0xFF00))
-            dataArea->coils[addr] = (val == 0xFF00);
+        if (val == 0x0000 || val == 0xFF00)
+            dataArea.setBit(BitTable::Coils, addr, val == 0xFF00);
     }
     else if (fc == SFC_WRITE_SINGLE_REGISTER && data.size() >= 4) {
         quint16 addr = bytesToUInt16(data, 0);
         quint16 val = bytesToUInt16(data, 2);
-        if (addr < dataArea->holdingRegisters.size())
-            dataArea->holdingRegisters[addr] = val;
+        dataArea.setRegister(RegisterTable::Holding, addr, val);
     }
     else if (fc == SFC_WRITE_MULTIPLE_COILS && data.size() >= 5) {
         quint16 startAddr = bytesToUInt16(data, 0);
         quint16 qty = bytesToUInt16(data, 2);
         quint8 byteCount = static_cast<quint8>(data[4]);
         if (qty >= 1 && qty <= 1968 && byteCount == (qty + 7) / 8
-            && data.size() >= 5 + byteCount
-            && startAddr + qty <= dataArea->coils.size()) {
-            for (int i = 0; i < qty; i++)
-                dataArea->coils[startAddr + i] = (data[5 + i / 8] >> (i % 8)) & 0x01;
+            && data.size() >= 5 + byteCount) {
+            dataArea.writeBits(BitTable::Coils, startAddr, qty, data.mid(5, byteCount));
         }
     }
     else if (fc == SFC_WRITE_MULTIPLE_REGISTERS && data.size() >= 5) {
@@ -228,10 +221,9 @@ void ModbusRtuSerialServer::applyBroadcastWrite(quint8 fc, const QByteArray& dat
         quint16 qty = bytesToUInt16(data, 2);
         quint8 byteCount = static_cast<quint8>(data[4]);
         if (qty >= 1 && qty <= 123 && byteCount == qty * 2
-            && data.size() >= 5 + byteCount
-            && startAddr + qty <= dataArea->holdingRegisters.size()) {
-            for (int i = 0; i < qty; i++)
-                dataArea->holdingRegisters[startAddr + i] = bytesToUInt16(data, 5 + i * 2);
+            && data.size() >= 5 + byteCount) {
+            dataArea.writeRegistersBigEndian(RegisterTable::Holding, startAddr, qty,
+                                             data.constData() + 5);
         }
     }
 }
@@ -247,22 +239,20 @@ QByteArray ModbusRtuSerialServer::processRtuRequest(const QByteArray& frame) {
     if (unitId == 0) {
         if (fc == SFC_WRITE_SINGLE_COIL || fc == SFC_WRITE_SINGLE_REGISTER ||
             fc == SFC_WRITE_MULTIPLE_COILS || fc == SFC_WRITE_MULTIPLE_REGISTERS) {
-            QMutexLocker locker(&m_mutex);
-            for (auto it = m_unitDataAreas.begin(); it != m_unitDataAreas.end(); ++it) {
-                applyBroadcastWrite(fc, data, it.value());
+            for (quint8 id : m_units.units()) {
+                if (const auto unit = m_units.find(id)) {
+                    applyBroadcastWrite(fc, data, *unit);
+                }
             }
         }
         return QByteArray();
     }
 
     // Unit ID mismatch: silent (RTU standard)
-    QSharedPointer<SerialModbusDataArea> dataArea;
-    {
-        QMutexLocker locker(&m_mutex);
-        if (!m_unitDataAreas.contains(unitId))
-            return QByteArray();
-        dataArea = m_unitDataAreas[unitId];
-    }
+    const std::shared_ptr<ModbusDataArea> unit = m_units.find(unitId);
+    if (!unit)
+        return QByteArray();
+    ModbusDataArea& dataArea = *unit;
 
     QByteArray pdu;
 
@@ -271,20 +261,12 @@ QByteArray ModbusRtuSerialServer::processRtuRequest(const QByteArray& frame) {
         if (data.size() < 4) return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_VALUE);
         quint16 startAddr = bytesToUInt16(data, 0);
         quint16 qty = bytesToUInt16(data, 2);
-        QMutexLocker locker(&m_mutex);
-        if (qty < 1 || qty > 2000 || startAddr + qty > dataArea->coils.size())
+        QByteArray bits;
+        if (qty < 1 || qty > 2000 || !dataArea.readBits(BitTable::Coils, startAddr, qty, bits))
             return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_ADDRESS);
         pdu.append(static_cast<char>(fc));
-        int byteCount = (qty + 7) / 8;
-        pdu.append(static_cast<char>(byteCount));
-        for (int i = 0; i < byteCount; i++) {
-            quint8 byte = 0;
-            for (int bit = 0; bit < 8 && (i * 8 + bit) < qty; bit++) {
-                if (dataArea->coils[startAddr + i * 8 + bit]) byte |= (1 << bit);
-            }
-            pdu.append(static_cast<char>(byte));
-        }
-        locker.unlock();
+        pdu.append(static_cast<char>(bits.size()));
+        pdu.append(bits);
         emit dataRead(unitId, fc, startAddr, qty);
         break;
     }
@@ -292,20 +274,12 @@ QByteArray ModbusRtuSerialServer::processRtuRequest(const QByteArray& frame) {
         if (data.size() < 4) return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_VALUE);
         quint16 startAddr = bytesToUInt16(data, 0);
         quint16 qty = bytesToUInt16(data, 2);
-        QMutexLocker locker(&m_mutex);
-        if (qty < 1 || qty > 2000 || startAddr + qty > dataArea->discreteInputs.size())
+        QByteArray bits;
+        if (qty < 1 || qty > 2000 || !dataArea.readBits(BitTable::DiscreteInputs, startAddr, qty, bits))
             return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_ADDRESS);
         pdu.append(static_cast<char>(fc));
-        int byteCount = (qty + 7) / 8;
-        pdu.append(static_cast<char>(byteCount));
-        for (int i = 0; i < byteCount; i++) {
-            quint8 byte = 0;
-            for (int bit = 0; bit < 8 && (i * 8 + bit) < qty; bit++) {
-                if (dataArea->discreteInputs[startAddr + i * 8 + bit]) byte |= (1 << bit);
-            }
-            pdu.append(static_cast<char>(byte));
-        }
-        locker.unlock();
+        pdu.append(static_cast<char>(bits.size()));
+        pdu.append(bits);
         emit dataRead(unitId, fc, startAddr, qty);
         break;
     }
@@ -313,14 +287,13 @@ QByteArray ModbusRtuSerialServer::processRtuRequest(const QByteArray& frame) {
         if (data.size() < 4) return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_VALUE);
         quint16 startAddr = bytesToUInt16(data, 0);
         quint16 qty = bytesToUInt16(data, 2);
-        QMutexLocker locker(&m_mutex);
-        if (qty < 1 || qty > 125 || startAddr + qty > dataArea->holdingRegisters.size())
+        QByteArray values;
+        if (qty < 1 || qty > 125
+            || !dataArea.readRegistersBigEndian(RegisterTable::Holding, startAddr, qty, values))
             return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_ADDRESS);
         pdu.append(static_cast<char>(fc));
         pdu.append(static_cast<char>(qty * 2));
-        for (int i = 0; i < qty; i++)
-            pdu.append(uint16ToBytes(dataArea->holdingRegisters[startAddr + i]));
-        locker.unlock();
+        pdu.append(values);
         emit dataRead(unitId, fc, startAddr, qty);
         break;
     }
@@ -328,14 +301,13 @@ QByteArray ModbusRtuSerialServer::processRtuRequest(const QByteArray& frame) {
         if (data.size() < 4) return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_VALUE);
         quint16 startAddr = bytesToUInt16(data, 0);
         quint16 qty = bytesToUInt16(data, 2);
-        QMutexLocker locker(&m_mutex);
-        if (qty < 1 || qty > 125 || startAddr + qty > dataArea->inputRegisters.size())
+        QByteArray values;
+        if (qty < 1 || qty > 125
+            || !dataArea.readRegistersBigEndian(RegisterTable::Input, startAddr, qty, values))
             return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_ADDRESS);
         pdu.append(static_cast<char>(fc));
         pdu.append(static_cast<char>(qty * 2));
-        for (int i = 0; i < qty; i++)
-            pdu.append(uint16ToBytes(dataArea->inputRegisters[startAddr + i]));
-        locker.unlock();
+        pdu.append(values);
         emit dataRead(unitId, fc, startAddr, qty);
         break;
     }
@@ -343,13 +315,11 @@ QByteArray ModbusRtuSerialServer::processRtuRequest(const QByteArray& frame) {
         if (data.size() < 4) return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_VALUE);
         quint16 addr = bytesToUInt16(data, 0);
         quint16 val = bytesToUInt16(data, 2);
-        QMutexLocker locker(&m_mutex);
-        if (addr >= dataArea->coils.size())
+        if (addr >= dataArea.size())
             return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_ADDRESS);
         if (val != 0x0000 && val != 0xFF00)
             return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_VALUE);
-        dataArea->coils[addr] = (val == 0xFF00);
-        locker.unlock();
+        dataArea.setBit(BitTable::Coils, addr, val == 0xFF00);
         emit dataWritten(unitId, fc, addr, 1);
         pdu.append(static_cast<char>(fc));
         pdu.append(uint16ToBytes(addr));
@@ -360,11 +330,8 @@ QByteArray ModbusRtuSerialServer::processRtuRequest(const QByteArray& frame) {
         if (data.size() < 4) return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_VALUE);
         quint16 addr = bytesToUInt16(data, 0);
         quint16 val = bytesToUInt16(data, 2);
-        QMutexLocker locker(&m_mutex);
-        if (addr >= dataArea->holdingRegisters.size())
+        if (!dataArea.setRegister(RegisterTable::Holding, addr, val))
             return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_ADDRESS);
-        dataArea->holdingRegisters[addr] = val;
-        locker.unlock();
         emit dataWritten(unitId, fc, addr, 1);
         pdu.append(static_cast<char>(fc));
         pdu.append(uint16ToBytes(addr));
@@ -378,15 +345,8 @@ QByteArray ModbusRtuSerialServer::processRtuRequest(const QByteArray& frame) {
         quint8 byteCount = static_cast<quint8>(data[4]);
         if (qty < 1 || qty > 1968 || byteCount != (qty + 7) / 8 || data.size() < 5 + byteCount)
             return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_VALUE);
-        QMutexLocker locker(&m_mutex);
-        if (startAddr + qty > dataArea->coils.size())
+        if (!dataArea.writeBits(BitTable::Coils, startAddr, qty, data.mid(5, byteCount)))
             return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_ADDRESS);
-        for (int i = 0; i < qty; i++) {
-            int byteIdx = i / 8;
-            int bitIdx = i % 8;
-            dataArea->coils[startAddr + i] = (data[5 + byteIdx] >> bitIdx) & 0x01;
-        }
-        locker.unlock();
         emit dataWritten(unitId, fc, startAddr, qty);
         pdu.append(static_cast<char>(fc));
         pdu.append(uint16ToBytes(startAddr));
@@ -400,12 +360,9 @@ QByteArray ModbusRtuSerialServer::processRtuRequest(const QByteArray& frame) {
         quint8 byteCount = static_cast<quint8>(data[4]);
         if (qty < 1 || qty > 123 || byteCount != qty * 2 || data.size() < 5 + byteCount)
             return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_VALUE);
-        QMutexLocker locker(&m_mutex);
-        if (startAddr + qty > dataArea->holdingRegisters.size())
+        if (!dataArea.writeRegistersBigEndian(RegisterTable::Holding, startAddr, qty,
+                                              data.constData() + 5))
             return createRtuExceptionResponse(unitId, fc, SFC_ILLEGAL_DATA_ADDRESS);
-        for (int i = 0; i < qty; i++)
-            dataArea->holdingRegisters[startAddr + i] = bytesToUInt16(data, 5 + i * 2);
-        locker.unlock();
         emit dataWritten(unitId, fc, startAddr, qty);
         pdu.append(static_cast<char>(fc));
         pdu.append(uint16ToBytes(startAddr));
@@ -438,73 +395,76 @@ QByteArray ModbusRtuSerialServer::uint16ToBytes(quint16 value) const {
 }
 
 bool ModbusRtuSerialServer::setCoil(quint8 unitId, quint16 address, bool value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->coils.size()) return false;
-    da->coils[address] = value;
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->setBit(BitTable::Coils, address, value);
 }
 
 bool ModbusRtuSerialServer::getCoil(quint8 unitId, quint16 address, bool& value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->coils.size()) return false;
-    value = da->coils[address];
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->getBit(BitTable::Coils, address, value);
 }
 
 bool ModbusRtuSerialServer::setDiscreteInput(quint8 unitId, quint16 address, bool value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->discreteInputs.size()) return false;
-    da->discreteInputs[address] = value;
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->setBit(BitTable::DiscreteInputs, address, value);
 }
 
 bool ModbusRtuSerialServer::getDiscreteInput(quint8 unitId, quint16 address, bool& value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->discreteInputs.size()) return false;
-    value = da->discreteInputs[address];
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->getBit(BitTable::DiscreteInputs, address, value);
 }
 
 bool ModbusRtuSerialServer::setHoldingRegister(quint8 unitId, quint16 address, quint16 value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->holdingRegisters.size()) return false;
-    da->holdingRegisters[address] = value;
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->setRegister(RegisterTable::Holding, address, value);
 }
 
 bool ModbusRtuSerialServer::getHoldingRegister(quint8 unitId, quint16 address, quint16& value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->holdingRegisters.size()) return false;
-    value = da->holdingRegisters[address];
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->getRegister(RegisterTable::Holding, address, value);
 }
 
 bool ModbusRtuSerialServer::setInputRegister(quint8 unitId, quint16 address, quint16 value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->inputRegisters.size()) return false;
-    da->inputRegisters[address] = value;
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->setRegister(RegisterTable::Input, address, value);
 }
 
 bool ModbusRtuSerialServer::getInputRegister(quint8 unitId, quint16 address, quint16& value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->inputRegisters.size()) return false;
-    value = da->inputRegisters[address];
-    return true;
-}
\ No newline at end of file
+    const auto unit = m_units.find(unitId);
+    return unit && unit->getRegister(RegisterTable::Input, address, value);
+}
+
+bool ModbusRtuSerialServer::setHoldingRegisters(quint8 unitId, quint16 address,
+        const QVector<quint16>& values) {
+    const auto unit = m_units.find(unitId);
+    return unit && unit->writeRegisters(RegisterTable::Holding, address,
+                                        static_cast<int>(values.size()), values.constData());
+}
+
+bool ModbusRtuSerialServer::getHoldingRegisters(quint8 unitId, quint16 address, int count,
+        QVector<quint16>& values) {
+    const auto unit = m_units.find(unitId);
+    if (!unit || count < 0) return false;
+    values.resize(count);
+    return unit->readRegisters(RegisterTable::Holding, address, count, values.data());
+}
+
+bool ModbusRtuSerialServer::setInputRegisters(quint8 unitId, quint16 address,
+        const QVector<quint16>& values) {
+    const auto unit = m_units.find(unitId);
+    return unit && unit->writeRegisters(RegisterTable::Input, address,
+                                        static_cast<int>(values.size()), values.constData());
+}
+
+bool ModbusRtuSerialServer::getInputRegisters(quint8 unitId, quint16 address, int count,
+        QVector<quint16>& values) {
+    const auto unit = m_units.find(unitId);
+    if (!unit || count < 0) return false;
+    values.resize(count);
+    return unit->readRegisters(RegisterTable::Input, address, count, values.data());
+}
+
+int ModbusRtuSerialServer::dataAreaSize(quint8 unitId) const {
+    const auto unit = m_units.find(unitId);
+    return unit ? unit->size() : 0;
+}
@@ -1,26 +1,10 @@
 #pragma once
 
-#include <QMap>
-#include <QMutex>
 #include <QObject>
 #include <QSerialPort>
-#include <QSharedPointer>
 #include <QTimer>
 #include <QVector>
-
-struct SerialModbusDataArea {
-    QVector<bool> coils;
-    QVector<bool> discreteInputs;
-    QVector<quint16> holdingRegisters;
-    QVector<quint16> inputRegisters;
-
-    explicit SerialModbusDataArea(int size = 10000) {
-        coils = QVector<bool>(size, false);
-        discreteInputs = QVector<bool>(size, false);
-        holdingRegisters = QVector<quint16>(size, 0);
-        inputRegisters = QVector<quint16>(size, 0);
-    }
-};
+#include "modbus_data_area.h"
 
 class ModbusRtuSerialServer : public QObject {
     Q_OBJECT
@@ -50,6 +34,15 @@ public:
     bool setInputRegister(quint8 unitId, quint16 address, quint16 value);
     bool getInputRegister(quint8 unitId, quint16 address, quint16& value);
 
+    // 连续寄存器批量读写：整段为一次写入、读取得到一致快照，越界时不做任何修改
+    bool setHoldingRegisters(quint8 unitId, quint16 address, const QVector<quint16>& values);
+    bool getHoldingRegisters(quint8 unitId, quint16 address, int count, QVector<quint16>& values);
+    bool setInputRegisters(quint8 unitId, quint16 address, const QVector<quint16>& values);
+    bool getInputRegisters(quint8 unitId, quint16 address, int count, QVector<quint16>& values);
+
+    /** 单元数据区大小，单元不存在返回 0 */
+    int dataAreaSize(quint8 unitId) const;
+
     static uint16_t calculateCRC16(const QByteArray& data);
     static QByteArray buildRtuResponse(quint8 unitId, const QByteArray& pdu);
     static double calculateT35(int baudRate, int dataBits,
@@ -68,7 +61,7 @@ private slots:
 private:
     QByteArray processRtuRequest(const QByteArray& frame);
     void applyBroadcastWrite(quint8 fc, const QByteArray& data,
-                             QSharedPointer<SerialModbusDataArea> dataArea);
+                             modbus::ModbusDataArea& dataArea);
     QByteArray createRtuExceptionResponse(quint8 unitId, quint8 fc, quint8 exceptionCode);
     quint16 bytesToUInt16(const QByteArray& data, int offset) const;
     QByteArray uint16ToBytes(quint16 value) const;
@@ -77,6 +70,5 @@ private:
     QTimer m_frameTimer;
     QByteArray m_recvBuffer;
     double m_t35Ms = 3.646;
-    QMap<quint8, QSharedPointer<SerialModbusDataArea>> m_unitDataAreas;
-    mutable QMutex m_mutex;
+    modbus::ModbusUnitTable m_units;
 };
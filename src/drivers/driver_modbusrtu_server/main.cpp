@@ -1,11 +1,14 @@
 #include "handler.h"
 #include "stdiolink/driver/driver_core.h"
+#include "stdiolink/driver/stdio_responder.h"
 #include <QCoreApplication>
 
 using namespace stdiolink;
 
 int main(int argc, char* argv[]) {
     QCoreApplication app(argc, argv);
+    // 每个客户端请求都会产生 data_read/data_written 事件，合并写出以减少 write(2)
+    StdioResponder::setFlushPolicy({true, 64 * 1024, 5});
     ModbusRtuServerHandler handler;
     DriverCore core;
     core.setMetaHandler(&handler);
@@ -1,5 +1,9 @@
 #include "modbus_rtu_server.h"
 
+using modbus::ModbusDataArea;
+using BitTable = ModbusDataArea::BitTable;
+using RegisterTable = ModbusDataArea::RegisterTable;
+
 enum RtuFunctionCode {
     READ_COILS = 0x01,
     READ_DISCRETE_INPUTS = 0x02,
@@ -107,27 +111,19 @@ void ModbusRtuServer::stopServer() {
 }
 
 bool ModbusRtuServer::addUnit(quint8 unitId, int dataAreaSize) {
-    QMutexLocker locker(&m_mutex);
-    if (m_unitDataAreas.contains(unitId)) return false;
-    m_unitDataAreas.insert(unitId, QSharedPointer<ModbusDataArea_Rtu>::create(dataAreaSize));
-    return true;
+    return m_units.add(unitId, dataAreaSize);
 }
 
 bool ModbusRtuServer::removeUnit(quint8 unitId) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    m_unitDataAreas.remove(unitId);
-    return true;
+    return m_units.remove(unitId);
 }
 
 bool ModbusRtuServer::hasUnit(quint8 unitId) const {
-    QMutexLocker locker(&m_mutex);
-    return m_unitDataAreas.contains(unitId);
+    return m_units.contains(unitId);
 }
 
 QList<quint8> ModbusRtuServer::getUnits() const {
-    QMutexLocker locker(&m_mutex);
-    return m_unitDataAreas.keys();
+    return m_units.units();
 }
 
 void ModbusRtuServer::incomingConnection(qintptr socketDescriptor) {
@@ -233,14 +229,12 @@ QByteArray ModbusRtuServer::processRtuRequest(const QByteArray& frame) {
     quint8 fc = static_cast<quint8>(frame[1]);
     QByteArray data = frame.mid(2, frame.size() - 4); // strip unitId, fc, crc
 
-    QSharedPointer<ModbusDataArea_Rtu> dataArea;
-    {
-        QMutexLocker locker(&m_mutex);
-        if (!m_unitDataAreas.contains(unitId)) {
-            return createRtuExceptionResponse(unitId, fc, RTU_GATEWAY_TARGET_DEVICE_FAILED);
-        }
-        dataArea = m_unitDataAreas[unitId];
+    // 持有 shared_ptr 保证处理期间单元即使被移除数据区仍然有效
+    const std::shared_ptr<ModbusDataArea> unit = m_units.find(unitId);
+    if (!unit) {
+        return createRtuExceptionResponse(unitId, fc, RTU_GATEWAY_TARGET_DEVICE_FAILED);
     }
+    ModbusDataArea& dataArea = *unit;
 
     QByteArray pdu;
 
@@ -249,20 +243,12 @@ QByteArray ModbusRtuServer::processRtuRequest(const QByteArray& frame) {
         if (data.size() < 4) return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_VALUE);
         quint16 startAddr = bytesToUInt16(data, 0);
         quint16 qty = bytesToUInt16(data, 2);
-        QMutexLocker locker(&m_mutex);
-        if (qty < 1 || qty > 2000 || startAddr + qty > dataArea->coils.size())
+        QByteArray bits;
+        if (qty < 1 || qty > 2000 || !dataArea.readBits(BitTable::Coils, startAddr, qty, bits))
             return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_ADDRESS);
         pdu.append(static_cast<char>(fc));
-        int byteCount = (qty + 7) / 8;
-        pdu.append(static_cast<char>(byteCount));
-        for (int i = 0; i < byteCount; i++) {
-            quint8 byte = 0;
-            for (int bit = 0; bit < 8 && (i * 8 + bit) < qty; bit++) {
-                if (dataArea->coils[startAddr + i * 8 + bit]) byte |= (1 << bit);
-            }
-            pdu.append(static_cast<char>(byte));
-        }
-        locker.unlock();
+        pdu.append(static_cast<char>(bits.size()));
+        pdu.append(bits);
         emit dataRead(unitId, fc, startAddr, qty);
         break;
     }
@@ -270,20 +256,12 @@ QByteArray ModbusRtuServer::processRtuRequest(const QByteArray& frame) {
         if (data.size() < 4) return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_VALUE);
         quint16 startAddr = bytesToUInt16(data, 0);
         quint16 qty = bytesToUInt16(data, 2);
-        QMutexLocker locker(&m_mutex);
-        if (qty < 1 || qty > 2000 || startAddr + qty > dataArea->discreteInputs.size())
+        QByteArray bits;
+        if (qty < 1 || qty > 2000 || !dataArea.readBits(BitTable::DiscreteInputs, startAddr, qty, bits))
             return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_ADDRESS);
         pdu.append(static_cast<char>(fc));
-        int byteCount = (qty + 7) / 8;
-        pdu.append(static_cast<char>(byteCount));
-        for (int i = 0; i < byteCount; i++) {
-            quint8 byte = 0;
-            for (int bit = 0; bit < 8 && (i * 8 + bit) < qty; bit++) {
-                if (dataArea->discreteInputs[startAddr + i * 8 + bit]) byte |= (1 << bit);
-            }
-            pdu.append(static_cast<char>(byte));
-        }
-        locker.unlock();
+        pdu.append(static_cast<char>(bits.size()));
+        pdu.append(bits);
         emit dataRead(unitId, fc, startAddr, qty);
         break;
     }
@@ -291,14 +269,13 @@ QByteArray ModbusRtuServer::processRtuRequest(const QByteArray& frame) {
         if (data.size() < 4) return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_VALUE);
         quint16 startAddr = bytesToUInt16(data, 0);
         quint16 qty = bytesToUInt16(data, 2);
-        QMutexLocker locker(&m_mutex);
-        if (qty < 1 || qty > 125 || startAddr + qty > dataArea->holdingRegisters.size())
+        QByteArray values;
+        if (qty < 1 || qty > 125
+            || !dataArea.readRegistersBigEndian(RegisterTable::Holding, startAddr, qty, values))
             return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_ADDRESS);
         pdu.append(static_cast<char>(fc));
         pdu.append(static_cast<char>(qty * 2));
-        for (int i = 0; i < qty; i++)
-            pdu.append(uint16ToBytes(dataArea->holdingRegisters[startAddr + i]));
-        locker.unlock();
+        pdu.append(values);
         emit dataRead(unitId, fc, startAddr, qty);
         break;
     }
@@ -306,14 +283,13 @@ QByteArray ModbusRtuServer::processRtuRequest(const QByteArray& frame) {
         if (data.size() < 4) return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_VALUE);
         quint16 startAddr = bytesToUInt16(data, 0);
         quint16 qty = bytesToUInt16(data, 2);
-        QMutexLocker locker(&m_mutex);
-        if (qty < 1 || qty > 125 || startAddr + qty > dataArea->inputRegisters.size())
+        QByteArray values;
+        if (qty < 1 || qty > 125
+            || !dataArea.readRegistersBigEndian(RegisterTable::Input, startAddr, qty, values))
             return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_ADDRESS);
         pdu.append(static_cast<char>(fc));
         pdu.append(static_cast<char>(qty * 2));
-        for (int i = 0; i < qty; i++)
-            pdu.append(uint16ToBytes(dataArea->inputRegisters[startAddr + i]));
-        locker.unlock();
+        pdu.append(values);
         emit dataRead(unitId, fc, startAddr, qty);
         break;
     }
@@ -321,13 +297,11 @@ QByteArray ModbusRtuServer::processRtuRequest(const QByteArray& frame) {
         if (data.size() < 4) return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_VALUE);
         quint16 addr = bytesToUInt16(data, 0);
         quint16 val = bytesToUInt16(data, 2);
-        QMutexLocker locker(&m_mutex);
-        if (addr >= dataArea->coils.size())
+        if (addr >= dataArea.size())
             return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_ADDRESS);
         if (val != 0x0000 && val != 0xFF00)
             return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_VALUE);
-        dataArea->coils[addr] = (val == 0xFF00);
-        locker.unlock();
+        dataArea.setBit(BitTable::Coils, addr, val == 0xFF00);
         emit dataWritten(unitId, fc, addr, 1);
         pdu.append(static_cast<char>(fc));
         pdu.append(uint16ToBytes(addr));
@@ -338,11 +312,8 @@ QByteArray ModbusRtuServer::processRtuRequest(const QByteArray& frame) {
         if (data.size() < 4) return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_VALUE);
         quint16 addr = bytesToUInt16(data, 0);
         quint16 val = bytesToUInt16(data, 2);
-        QMutexLocker locker(&m_mutex);
-        if (addr >= dataArea->holdingRegisters.size())
+        if (!dataArea.setRegister(RegisterTable::Holding, addr, val))
             return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_ADDRESS);
-        dataArea->holdingRegisters[addr] = val;
-        locker.unlock();
         emit dataWritten(unitId, fc, addr, 1);
         pdu.append(static_cast<char>(fc));
         pdu.append(uint16ToBytes(addr));
@@ -356,15 +327,8 @@ QByteArray ModbusRtuServer::processRtuRequest(const QByteArray& frame) {
         quint8 byteCount = static_cast<quint8>(data[4]);
         if (qty < 1 || qty > 1968 || byteCount != (qty + 7) / 8 || data.size() < 5 + byteCount)
             return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_VALUE);
-        QMutexLocker locker(&m_mutex);
-        if (startAddr + qty > dataArea->coils.size())
+        if (!dataArea.writeBits(BitTable::Coils, startAddr, qty, data.mid(5, byteCount)))
             return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_ADDRESS);
-        for (int i = 0; i < qty; i++) {
-            int byteIdx = i / 8;
-            int bitIdx = i % 8;
-            dataArea->coils[startAddr + i] = (data[5 + byteIdx] >> bitIdx) & 0x01;
-        }
-        locker.unlock();
         emit dataWritten(unitId, fc, startAddr, qty);
         pdu.append(static_cast<char>(fc));
         pdu.append(uint16ToBytes(startAddr));
@@ -378,12 +342,9 @@ QByteArray ModbusRtuServer::processRtuRequest(const QByteArray& frame) {
         quint8 byteCount = static_cast<quint8>(data[4]);
         if (qty < 1 || qty > 123 || byteCount != qty * 2 || data.size() < 5 + byteCount)
             return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_VALUE);
-        QMutexLocker locker(&m_mutex);
-        if (startAddr + qty > dataArea->holdingRegisters.size())
+        if (!dataArea.writeRegistersBigEndian(RegisterTable::Holding, startAddr, qty,
+                                              data.constData() + 5))
             return createRtuExceptionResponse(unitId, fc, RTU_ILLEGAL_DATA_ADDRESS);
-        for (int i = 0; i < qty; i++)
-            dataArea->holdingRegisters[startAddr + i] = bytesToUInt16(data, 5 + i * 2);
-        locker.unlock();
         emit dataWritten(unitId, fc, startAddr, qty);
         pdu.append(static_cast<char>(fc));
         pdu.append(uint16ToBytes(startAddr));
@@ -416,73 +377,76 @@ QByteArray ModbusRtuServer::uint16ToBytes(quint16 value) const {
 }
 
 bool ModbusRtuServer::setCoil(quint8 unitId, quint16 address, bool value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->coils.size()) return false;
-    da->coils[address] = value;
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->setBit(BitTable::Coils, address, value);
 }
 
 bool ModbusRtuServer::getCoil(quint8 unitId, quint16 address, bool& value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->coils.size()) return false;
-    value = da->coils[address];
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->getBit(BitTable::Coils, address, value);
 }
 
 bool ModbusRtuServer::setDiscreteInput(quint8 unitId, quint16 address, bool value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->discreteInputs.size()) return false;
-    da->discreteInputs[address] = value;
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->setBit(BitTable::DiscreteInputs, address, value);
 }
 
 bool ModbusRtuServer::getDiscreteInput(quint8 unitId, quint16 address, bool& value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->discreteInputs.size()) return false;
-    value = da->discreteInputs[address];
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->getBit(BitTable::DiscreteInputs, address, value);
 }
 
 bool ModbusRtuServer::setHoldingRegister(quint8 unitId, quint16 address, quint16 value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->holdingRegisters.size()) return false;
-    da->holdingRegisters[address] = value;
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->setRegister(RegisterTable::Holding, address, value);
 }
 
 bool ModbusRtuServer::getHoldingRegister(quint8 unitId, quint16 address, quint16& value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->holdingRegisters.size()) return false;
-    value = da->holdingRegisters[address];
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->getRegister(RegisterTable::Holding, address, value);
 }
 
 bool ModbusRtuServer::setInputRegister(quint8 unitId, quint16 address, quint16 value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->inputRegisters.size()) return false;
-    da->inputRegisters[address] = value;
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->setRegister(RegisterTable::Input, address, value);
 }
 
 bool ModbusRtuServer::getInputRegister(quint8 unitId, quint16 address, quint16& value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& da = m_unitDataAreas[unitId];
-    if (address >= da->inputRegisters.size()) return false;
-    value = da->inputRegisters[address];
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->getRegister(RegisterTable::Input, address, value);
+}
+
+bool ModbusRtuServer::setHoldingRegisters(quint8 unitId, quint16 address,
+        const QVector<quint16>& values) {
+    const auto unit = m_units.find(unitId);
+    return unit && unit->writeRegisters(RegisterTable::Holding, address,
+                                        static_cast<int>(values.size()), values.constData());
+}
+
+bool ModbusRtuServer::getHoldingRegisters(quint8 unitId, quint16 address, int count,
+        QVector<quint16>& values) {
+    const auto unit = m_units.find(unitId);
+    if (!unit || count < 0) return false;
+    values.resize(count);
+    return unit->readRegisters(RegisterTable::Holding, address, count, values.data());
+}
+
+bool ModbusRtuServer::setInputRegisters(quint8 unitId, quint16 address,
+        const QVector<quint16>& values) {
+    const auto unit = m_units.find(unitId);
+    return unit && unit->writeRegisters(RegisterTable::Input, address,
+                                        static_cast<int>(values.size()), values.constData());
+}
+
+bool ModbusRtuServer::getInputRegisters(quint8 unitId, quint16 address, int count,
+        QVector<quint16>& values) {
+    const auto unit = m_units.find(unitId);
+    if (!unit || count < 0) return false;
+    values.resize(count);
+    return unit->readRegisters(RegisterTable::Input, address, count, values.data());
+}
+
+int ModbusRtuServer::dataAreaSize(quint8 unitId) const {
+    const auto unit = m_units.find(unitId);
+    return unit ? unit->size() : 0;
 }
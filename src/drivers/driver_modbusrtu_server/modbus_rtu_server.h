@@ -1,27 +1,12 @@
 #pragma once
 
 #include <QMap>
-#include <QMutex>
 #include <QPointer>
-#include <QSharedPointer>
 #include <QTcpServer>
 #include <QTcpSocket>
 #include <QTimer>
 #include <QVector>
-
-struct ModbusDataArea_Rtu {
-    QVector<bool> coils;
-    QVector<bool> discreteInputs;
-    QVector<quint16> holdingRegisters;
-    QVector<quint16> inputRegisters;
-
-    explicit ModbusDataArea_Rtu(int size = 10000) {
-        coils = QVector<bool>(size, false);
-        discreteInputs = QVector<bool>(size, false);
-        holdingRegisters = QVector<quint16>(size, 0);
-        inputRegisters = QVector<quint16>(size, 0);
-    }
-};
+#include "modbus_data_area.h"
 
 struct RtuClientInfo {
     QByteArray recvBuffer;
@@ -56,6 +41,15 @@ public:
     bool setInputRegister(quint8 unitId, quint16 address, quint16 value);
     bool getInputRegister(quint8 unitId, quint16 address, quint16& value);
 
+    // 连续寄存器批量读写：整段为一次写入、读取得到一致快照，越界时不做任何修改
+    bool setHoldingRegisters(quint8 unitId, quint16 address, const QVector<quint16>& values);
+    bool getHoldingRegisters(quint8 unitId, quint16 address, int count, QVector<quint16>& values);
+    bool setInputRegisters(quint8 unitId, quint16 address, const QVector<quint16>& values);
+    bool getInputRegisters(quint8 unitId, quint16 address, int count, QVector<quint16>& values);
+
+    /** 单元数据区大小，单元不存在返回 0 */
+    int dataAreaSize(quint8 unitId) const;
+
     static uint16_t calculateCRC16(const QByteArray& data);
     static QByteArray buildRtuResponse(quint8 unitId, const QByteArray& pdu);
 
@@ -83,8 +77,7 @@ private:
     QByteArray uint16ToBytes(quint16 value) const;
 
     QMap<QPointer<QTcpSocket>, RtuClientInfo> m_clients;
-    QMap<quint8, QSharedPointer<ModbusDataArea_Rtu>> m_unitDataAreas;
-    mutable QMutex m_mutex;
+    modbus::ModbusUnitTable m_units;
 
     static constexpr int FRAME_TIMEOUT_MS = 50;
     static constexpr int MAX_RECV_BUFFER = 4096;
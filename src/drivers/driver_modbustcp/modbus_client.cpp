@@ -2,6 +2,8 @@
 #include <QDataStream>
 #include <QElapsedTimer>
 
+#include <utility>
+
 namespace modbus {
 
 namespace {
@@ -33,6 +35,7 @@ bool ModbusClient::connectToServer(const QString& host, quint16 port)
         disconnect();
     }
 
+    m_rxBuffer.clear();
     m_socket.connectToHost(host, port);
     return m_socket.waitForConnected(m_timeout);
 }
@@ -45,6 +48,7 @@ void ModbusClient::disconnect()
             m_socket.waitForDisconnected(1000);
         }
     }
+    m_rxBuffer.clear();
 }
 
 bool ModbusClient::isConnected() const
@@ -52,6 +56,16 @@ bool ModbusClient::isConnected() const
     return m_socket.state() == QAbstractSocket::ConnectedState;
 }
 
+bool ModbusClient::probe()
+{
+    if (m_socket.state() == QAbstractSocket::ConnectedState) {
+        m_socket.waitForReadyRead(0);
+        m_socket.readAll();
+        m_rxBuffer.clear();
+    }
+    return isConnected();
+}
+
 QByteArray ModbusClient::buildRequest(FunctionCode fc, const QByteArray& pdu)
 {
     QByteArray request;
@@ -71,56 +85,62 @@ QByteArray ModbusClient::buildRequest(FunctionCode fc, const QByteArray& pdu)
     return request;
 }
 
+ModbusClient::FrameStatus ModbusClient::takeFrame(QByteArray& frame, QString& errorMessage)
+{
+    if (m_rxBuffer.size() < 7) {
+        return FrameStatus::Incomplete;
+    }
+
+    const quint16 protocolId = readUInt16BE(m_rxBuffer, 2);
+    const quint16 length = readUInt16BE(m_rxBuffer, 4);
+    if (protocolId != 0 || length < 2) {
+        // 帧边界已丢失，缓冲区中剩余字节无法再对齐
+        errorMessage = protocolId != 0 ? "Unexpected protocol id" : "Invalid MBAP length";
+        m_rxBuffer.clear();
+        return FrameStatus::Invalid;
+    }
+
+    const int frameLength = 6 + length;
+    if (m_rxBuffer.size() < frameLength) {
+        return FrameStatus::Incomplete;
+    }
+
+    frame = m_rxBuffer.left(frameLength);
+    m_rxBuffer.remove(0, frameLength);
+    return FrameStatus::Complete;
+}
+
 QByteArray ModbusClient::readResponse(quint16 expectedTransactionId, QString& errorMessage)
 {
-    QByteArray response;
     QElapsedTimer timer;
     timer.start();
-    int expectedLength = -1;
 
-    while (timer.elapsed() < m_timeout) {
-        if (expectedLength > 0 && response.size() >= expectedLength) {
-            return response.left(expectedLength);
+    while (true) {
+        QByteArray frame;
+        const FrameStatus status = takeFrame(frame, errorMessage);
+        if (status == FrameStatus::Invalid) {
+            return {};
+        }
+        if (status == FrameStatus::Complete) {
+            if (readUInt16BE(frame, 0) == expectedTransactionId) {
+                return frame;
+            }
+            // 此前已超时事务的迟到响应，丢弃后继续等待
+            continue;
         }
 
         const int remaining = m_timeout - static_cast<int>(timer.elapsed());
-        const int waitMs = remaining > 100 ? 100 : remaining;
-        if (waitMs <= 0) {
+        if (remaining <= 0) {
             break;
         }
-
-        if (!m_socket.waitForReadyRead(waitMs)) {
-            continue;
-        }
-
-        response.append(m_socket.readAll());
-
-        if (expectedLength < 0 && response.size() >= 7) {
-            const quint16 transactionId = readUInt16BE(response, 0);
-            if (transactionId != expectedTransactionId) {
-                errorMessage = "Unexpected transaction id";
-                return {};
-            }
-
-            const quint16 protocolId = readUInt16BE(response, 2);
-            if (protocolId != 0) {
-                errorMessage = "Unexpected protocol id";
-                return {};
-            }
-
-            const quint16 length = readUInt16BE(response, 4);
-            if (length < 2) {
-                errorMessage = "Invalid MBAP length";
-                return {};
-            }
-
-            expectedLength = 6 + length;
+        if (m_socket.waitForReadyRead(remaining > 100 ? 100 : remaining)) {
+            m_rxBuffer.append(m_socket.readAll());
         }
     }
 
-    if (expectedLength > 0 && response.size() < expectedLength) {
+    if (m_rxBuffer.size() >= 7) {
         errorMessage = "Response truncated";
-    } else if (response.isEmpty()) {
+    } else if (m_rxBuffer.isEmpty()) {
         errorMessage = "Read timeout";
     } else {
         errorMessage = "Response too short";
@@ -129,6 +149,34 @@ QByteArray ModbusClient::readResponse(quint16 expectedTransactionId, QString& er
     return {};
 }
 
+ModbusResult ModbusClient::checkResponse(const QByteArray& response, FunctionCode expectedFc)
+{
+    ModbusResult result;
+
+    if (response.size() < 8) {
+        result.errorMessage = "Response too short";
+        return result;
+    }
+
+    // 检查功能码
+    uint8_t fc = static_cast<uint8_t>(response[7]);
+    if (fc & 0x80) {
+        // 异常响应
+        result.exception = response.size() > 8 ? static_cast<ExceptionCode>(response[8])
+                                                : ExceptionCode::None;
+        result.errorMessage = exceptionMessage(result.exception);
+        return result;
+    }
+
+    if (fc != static_cast<uint8_t>(expectedFc)) {
+        result.errorMessage = "Unexpected function code";
+        return result;
+    }
+
+    result.success = true;
+    return result;
+}
+
 ModbusResult ModbusClient::sendRequest(const QByteArray& request, FunctionCode expectedFc,
                                        QByteArray* responseOut)
 {
@@ -152,30 +200,122 @@ ModbusResult ModbusClient::sendRequest(const QByteArray& request, FunctionCode e
         return result;
     }
 
-    if (response.size() < 8) {
-        result.errorMessage = "Response too short";
-        return result;
+    result = checkResponse(response, expectedFc);
+    if (result.success && responseOut) {
+        *responseOut = response;
     }
+    return result;
+}
 
-    // 检查功能码
-    uint8_t fc = static_cast<uint8_t>(response[7]);
-    if (fc & 0x80) {
-        // 异常响应
-        result.exception = static_cast<ExceptionCode>(response[8]);
-        result.errorMessage = exceptionMessage(result.exception);
-        return result;
-    }
+void ModbusClient::setPipelineWindow(int window)
+{
+    m_pipelineWindow = qBound(1, window, kMaxPipelineWindow);
+}
 
-    if (fc != static_cast<uint8_t>(expectedFc)) {
-        result.errorMessage = "Unexpected function code";
-        return result;
+QVector<ModbusResult> ModbusClient::readBatch(const QVector<ReadRequest>& requests)
+{
+    QVector<ModbusResult> results(requests.size());
+
+    struct InFlight {
+        int index;
+        qint64 deadline;
+    };
+    QHash<quint16, InFlight> inFlight;
+    QElapsedTimer clock;
+    clock.start();
+    QString fatalError = isConnected() ? QString() : QStringLiteral("Not connected");
+    int next = 0;
+
+    while (fatalError.isEmpty() && (next < requests.size() || !inFlight.isEmpty())) {
+        // 补满窗口：请求连续写出，不等待前一个应答
+        bool wrote = false;
+        while (next < requests.size() && inFlight.size() < m_pipelineWindow) {
+            const ReadRequest& req = requests[next];
+            QByteArray pdu;
+            QDataStream stream(&pdu, QIODevice::WriteOnly);
+            stream.setByteOrder(QDataStream::BigEndian);
+            stream << req.address << req.count;
+
+            const QByteArray request = buildRequest(req.function, pdu);
+            m_socket.write(request);
+            inFlight.insert(readUInt16BE(request, 0), InFlight{next, clock.elapsed() + m_timeout});
+            ++next;
+            wrote = true;
+        }
+        while (wrote && m_socket.bytesToWrite() > 0) {
+            if (!m_socket.waitForBytesWritten(m_timeout)) {
+                fatalError = "Write timeout";
+                break;
+            }
+        }
+        if (!fatalError.isEmpty()) {
+            break;
+        }
+
+        // 取出所有已完整到达的帧，按事务 ID 交付
+        QByteArray frame;
+        FrameStatus status;
+        while ((status = takeFrame(frame, fatalError)) == FrameStatus::Complete) {
+            const auto it = inFlight.constFind(readUInt16BE(frame, 0));
+            if (it == inFlight.constEnd()) {
+                continue; // 已超时事务的迟到响应
+            }
+            const int index = it->index;
+            inFlight.erase(it);
+
+            const ReadRequest& req = requests[index];
+            ModbusResult result = checkResponse(frame, req.function);
+            if (result.success) {
+                const bool bits = req.function == FunctionCode::ReadCoils
+                                  || req.function == FunctionCode::ReadDiscreteInputs;
+                result = bits ? parseReadBitsResponse(frame, req.count)
+                              : parseReadRegistersResponse(frame);
+            }
+            results[index] = result;
+        }
+        if (status == FrameStatus::Invalid) {
+            break;
+        }
+
+        // 到期事务单独判超时，不影响窗口内其他事务
+        const qint64 now = clock.elapsed();
+        qint64 nearest = -1;
+        for (auto it = inFlight.begin(); it != inFlight.end();) {
+            if (it->deadline <= now) {
+                results[it->index].errorMessage = "Read timeout";
+                it = inFlight.erase(it);
+            } else {
+                if (nearest < 0 || it->deadline < nearest) {
+                    nearest = it->deadline;
+                }
+                ++it;
+            }
+        }
+        if (inFlight.isEmpty()) {
+            continue;
+        }
+
+        const int waitMs = static_cast<int>(qMin<qint64>(100, nearest - now));
+        if (m_socket.bytesAvailable() > 0 || m_socket.waitForReadyRead(waitMs)) {
+            m_rxBuffer.append(m_socket.readAll());
+        } else if (!isConnected()) {
+            fatalError = "Connection closed";
+        }
     }
 
-    result.success = true;
-    if (responseOut) {
-        *responseOut = response;
+    if (!fatalError.isEmpty()) {
+        // 写失败或帧边界丢失后连接不可再用，在途与未发出的请求统一失败
+        for (const InFlight& pending : std::as_const(inFlight)) {
+            results[pending.index].errorMessage = fatalError;
+        }
+        for (int i = next; i < requests.size(); ++i) {
+            results[i].errorMessage = fatalError;
+        }
+        if (isConnected()) {
+            disconnect();
+        }
     }
-    return result;
+    return results;
 }
 
 ModbusResult ModbusClient::parseReadBitsResponse(const QByteArray& response, uint16_t count)
@@ -33,6 +33,15 @@ struct ConnectionKey {
     }
 };
 
+/**
+ * 批量读请求（功能码 0x01-0x04），用于流水线模式
+ */
+struct ReadRequest {
+    FunctionCode function = FunctionCode::ReadHoldingRegisters;
+    uint16_t address = 0;
+    uint16_t count = 0;
+};
+
 inline uint qHash(const ConnectionKey& key, uint seed = 0) {
     return qHash(key.host, seed) ^ (key.port + seed);
 }
@@ -49,11 +58,19 @@ public:
     bool connectToServer(const QString& host, quint16 port);
     void disconnect();
     bool isConnected() const;
+    // 空闲探活：刷新套接字状态以发现对端已关闭，并丢弃空闲期间收到的残留字节
+    bool probe();
 
     // 设置
     void setTimeout(int ms) { m_timeout = ms; }
     void setUnitId(uint8_t id) { m_unitId = id; }
 
+    // 流水线窗口：同一连接上同时在途的事务数，1 为逐个请求-应答
+    void setPipelineWindow(int window);
+    int pipelineWindow() const { return m_pipelineWindow; }
+
+    static constexpr int kMaxPipelineWindow = 16;
+
     // 功能码 0x01: 读线圈
     ModbusResult readCoils(uint16_t address, uint16_t count);
 
@@ -78,7 +95,15 @@ public:
     // 功能码 0x10: 写多个寄存器
     ModbusResult writeMultipleRegisters(uint16_t address, const QVector<uint16_t>& values);
 
+    // 批量读：窗口内的请求连续写出，响应按事务 ID 匹配，允许乱序到达；
+    // 每个事务从写出时起独立计时。结果与 requests 一一对应
+    QVector<ModbusResult> readBatch(const QVector<ReadRequest>& requests);
+
 private:
+    enum class FrameStatus { Incomplete, Complete, Invalid };
+
+    FrameStatus takeFrame(QByteArray& frame, QString& errorMessage);
+    ModbusResult checkResponse(const QByteArray& response, FunctionCode expectedFc);
     QByteArray buildRequest(FunctionCode fc, const QByteArray& pdu);
     QByteArray readResponse(quint16 expectedTransactionId, QString& errorMessage);
     ModbusResult sendRequest(const QByteArray& request, FunctionCode expectedFc,
@@ -88,9 +113,11 @@ private:
     ModbusResult parseWriteResponse(const QByteArray& response);
 
     QTcpSocket m_socket;
+    QByteArray m_rxBuffer;  // 尚未取走的接收字节，可能含下一帧的开头
     uint16_t m_transactionId = 0;
     uint8_t m_unitId = 1;
     int m_timeout = 3000;
+    int m_pipelineWindow = 1;
 };
 
 } // namespace modbus
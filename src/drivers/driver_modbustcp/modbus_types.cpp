@@ -1,4 +1,6 @@
 #include "modbus_types.h"
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 namespace modbus {
@@ -69,6 +71,80 @@ QString exceptionMessage(ExceptionCode code)
     return QString("Unknown exception: 0x%1").arg(static_cast<int>(code), 2, 16, QChar('0'));
 }
 
+bool parseTagArea(const QString& str, TagArea& area)
+{
+    if (str == "coil") area = TagArea::Coil;
+    else if (str == "discrete_input") area = TagArea::DiscreteInput;
+    else if (str == "holding_register") area = TagArea::HoldingRegister;
+    else if (str == "input_register") area = TagArea::InputRegister;
+    else return false;
+    return true;
+}
+
+QVector<ReadBlock> planReadBlocks(const QVector<TagSpec>& tags, int maxGap)
+{
+    QVector<int> order(tags.size());
+    for (int i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    // 按数据区、起始地址、结束地址排序，同一数据区内单次扫描即可贪心合并
+    std::sort(order.begin(), order.end(), [&tags](int a, int b) {
+        const TagSpec& ta = tags[a];
+        const TagSpec& tb = tags[b];
+        if (ta.area != tb.area) return ta.area < tb.area;
+        if (ta.address != tb.address) return ta.address < tb.address;
+        return ta.width() < tb.width();
+    });
+
+    QVector<ReadBlock> blocks;
+    int blockEnd = 0;   // 当前块的结束地址（不含）
+    for (int index : order) {
+        const TagSpec& tag = tags[index];
+        const int tagStart = tag.address;
+        const int tagEnd = tagStart + tag.width();
+        const int limit = tag.isBit() ? kMaxReadBits : kMaxReadRegisters;
+
+        if (!blocks.isEmpty()) {
+            ReadBlock& cur = blocks.last();
+            const int newEnd = std::max(blockEnd, tagEnd);
+            if (cur.area == tag.area
+                && tagStart <= blockEnd + std::max(0, maxGap)
+                && newEnd - cur.start <= limit) {
+                blockEnd = newEnd;
+                cur.count = static_cast<uint16_t>(blockEnd - cur.start);
+                cur.tagIndices.append(index);
+                continue;
+            }
+        }
+
+        ReadBlock block;
+        block.area = tag.area;
+        block.start = tag.address;
+        block.count = static_cast<uint16_t>(tag.width());
+        block.tagIndices.append(index);
+        blocks.append(block);
+        blockEnd = tagEnd;
+    }
+    return blocks;
+}
+
+bool tagValueChanged(const QJsonValue& last, const QJsonValue& current, double deadband)
+{
+    if (last.isUndefined() || last.type() != current.type()) {
+        return true;
+    }
+    if (!current.isDouble()) {
+        return last != current;
+    }
+
+    const double a = last.toDouble();
+    const double b = current.toDouble();
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::isnan(a) != std::isnan(b);
+    }
+    return std::abs(b - a) > deadband;
+}
+
 // ByteOrderConverter 实现
 
 ByteOrderConverter::ByteOrderConverter(ByteOrder order)
@@ -359,18 +359,14 @@ void ModbusTcpServerHandler::handle(const QString& cmd, const QJsonValue& data,
             regs.append(r);
         }
 
-        bool ok = true;
-        for (int i = 0; i < regs.size(); i++) {
-            if (area == "input") {
-                ok = m_server.setInputRegister(uid, addr + i, regs[i]);
-            } else {
-                ok = m_server.setHoldingRegister(uid, addr + i, regs[i]);
-            }
-            if (!ok) {
-                resp.error(3, QJsonObject{{"message",
-                    QString("Address %1 out of range").arg(addr + i)}});
-                return;
-            }
+        // 整段一次写入，越界时不做任何修改
+        bool ok = area == "input" ? m_server.setInputRegisters(uid, addr, regs)
+                                  : m_server.setHoldingRegisters(uid, addr, regs);
+        if (!ok) {
+            resp.error(3, QJsonObject{{"message",
+                QString("Address %1 out of range")
+                    .arg(qMax(address, m_server.dataAreaSize(uid)))}});
+            return;
         }
         resp.done(0, QJsonObject{{"written", regs.size()}});
         return;
@@ -393,20 +389,13 @@ void ModbusTcpServerHandler::handle(const QString& cmd, const QJsonValue& data,
         }
 
         QVector<quint16> raw;
-        for (int i = 0; i < count; i++) {
-            quint16 val = 0;
-            bool ok;
-            if (area == "input") {
-                ok = m_server.getInputRegister(uid, addr + i, val);
-            } else {
-                ok = m_server.getHoldingRegister(uid, addr + i, val);
-            }
-            if (!ok) {
-                resp.error(3, QJsonObject{{"message",
-                    QString("Address %1 out of range").arg(addr + i)}});
-                return;
-            }
-            raw.append(val);
+        bool ok = area == "input" ? m_server.getInputRegisters(uid, addr, count, raw)
+                                  : m_server.getHoldingRegisters(uid, addr, count, raw);
+        if (!ok) {
+            resp.error(3, QJsonObject{{"message",
+                QString("Address %1 out of range")
+                    .arg(qMax(address, m_server.dataAreaSize(uid)))}});
+            return;
         }
 
         ByteOrderConverter conv(parseByteOrder(byteOrder));
@@ -1,5 +1,9 @@
 #include "modbus_tcp_server.h"
 
+using modbus::ModbusDataArea;
+using BitTable = ModbusDataArea::BitTable;
+using RegisterTable = ModbusDataArea::RegisterTable;
+
 enum ModbusFunctionCode {
     READ_COILS = 0x01,
     READ_DISCRETE_INPUTS = 0x02,
@@ -49,27 +53,19 @@ void ModbusTcpServer::stopServer() {
 }
 
 bool ModbusTcpServer::addUnit(quint8 unitId, int dataAreaSize) {
-    QMutexLocker locker(&m_mutex);
-    if (m_unitDataAreas.contains(unitId)) return false;
-    m_unitDataAreas.insert(unitId, QSharedPointer<ModbusDataArea>::create(dataAreaSize));
-    return true;
+    return m_units.add(unitId, dataAreaSize);
 }
 
 bool ModbusTcpServer::removeUnit(quint8 unitId) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    m_unitDataAreas.remove(unitId);
-    return true;
+    return m_units.remove(unitId);
 }
 
 bool ModbusTcpServer::hasUnit(quint8 unitId) const {
-    QMutexLocker locker(&m_mutex);
-    return m_unitDataAreas.contains(unitId);
+    return m_units.contains(unitId);
 }
 
 QList<quint8> ModbusTcpServer::getUnits() const {
-    QMutexLocker locker(&m_mutex);
-    return m_unitDataAreas.keys();
+    return m_units.units();
 }
 
 void ModbusTcpServer::incomingConnection(qintptr socketDescriptor) {
@@ -168,14 +164,12 @@ QByteArray ModbusTcpServer::processRequest(const QByteArray& request) {
     if (!parseHeader(request, header)) return QByteArray();
     if (header.protocolId != 0) return QByteArray();
 
-    QSharedPointer<ModbusDataArea> dataArea;
-    {
-        QMutexLocker locker(&m_mutex);
-        if (!m_unitDataAreas.contains(header.unitId)) {
-            return createExceptionResponse(header, request[7], GATEWAY_TARGET_DEVICE_FAILED);
-        }
-        dataArea = m_unitDataAreas[header.unitId];
+    // 持有 shared_ptr 保证处理期间单元即使被移除数据区仍然有效
+    const std::shared_ptr<ModbusDataArea> unit = m_units.find(header.unitId);
+    if (!unit) {
+        return createExceptionResponse(header, request[7], GATEWAY_TARGET_DEVICE_FAILED);
     }
+    ModbusDataArea& dataArea = *unit;
 
     quint8 functionCode = static_cast<quint8>(request[7]);
     QByteArray pdu = request.mid(8);
@@ -255,90 +249,72 @@ QByteArray ModbusTcpServer::processRequest(const QByteArray& request) {
 }
 
 QByteArray ModbusTcpServer::handleReadCoils(const ModbusTCPHeader& header,
-        QSharedPointer<ModbusDataArea> dataArea, quint16 startAddress, quint16 quantity) {
-    QMutexLocker locker(&m_mutex);
-    if (quantity < 1 || quantity > 2000 || startAddress + quantity > dataArea->coils.size())
+        ModbusDataArea& dataArea, quint16 startAddress, quint16 quantity) {
+    QByteArray bits;
+    if (quantity < 1 || quantity > 2000
+        || !dataArea.readBits(BitTable::Coils, startAddress, quantity, bits))
         return createExceptionResponse(header, READ_COILS, ILLEGAL_DATA_ADDRESS);
 
     QByteArray response;
     response.append(static_cast<char>(READ_COILS));
-    int byteCount = (quantity + 7) / 8;
-    response.append(static_cast<char>(byteCount));
-    for (int i = 0; i < byteCount; i++) {
-        quint8 byte = 0;
-        for (int bit = 0; bit < 8 && (i * 8 + bit) < quantity; bit++) {
-            if (dataArea->coils[startAddress + i * 8 + bit]) byte |= (1 << bit);
-        }
-        response.append(static_cast<char>(byte));
-    }
-    locker.unlock();
+    response.append(static_cast<char>(bits.size()));
+    response.append(bits);
     emit dataRead(header.unitId, READ_COILS, startAddress, quantity);
     return response;
 }
 
 QByteArray ModbusTcpServer::handleReadDiscreteInputs(const ModbusTCPHeader& header,
-        QSharedPointer<ModbusDataArea> dataArea, quint16 startAddress, quint16 quantity) {
-    QMutexLocker locker(&m_mutex);
-    if (quantity < 1 || quantity > 2000 || startAddress + quantity > dataArea->discreteInputs.size())
+        ModbusDataArea& dataArea, quint16 startAddress, quint16 quantity) {
+    QByteArray bits;
+    if (quantity < 1 || quantity > 2000
+        || !dataArea.readBits(BitTable::DiscreteInputs, startAddress, quantity, bits))
         return createExceptionResponse(header, READ_DISCRETE_INPUTS, ILLEGAL_DATA_ADDRESS);
 
     QByteArray response;
     response.append(static_cast<char>(READ_DISCRETE_INPUTS));
-    int byteCount = (quantity + 7) / 8;
-    response.append(static_cast<char>(byteCount));
-    for (int i = 0; i < byteCount; i++) {
-        quint8 byte = 0;
-        for (int bit = 0; bit < 8 && (i * 8 + bit) < quantity; bit++) {
-            if (dataArea->discreteInputs[startAddress + i * 8 + bit]) byte |= (1 << bit);
-        }
-        response.append(static_cast<char>(byte));
-    }
-    locker.unlock();
+    response.append(static_cast<char>(bits.size()));
+    response.append(bits);
     emit dataRead(header.unitId, READ_DISCRETE_INPUTS, startAddress, quantity);
     return response;
 }
 
 QByteArray ModbusTcpServer::handleReadHoldingRegisters(const ModbusTCPHeader& header,
-        QSharedPointer<ModbusDataArea> dataArea, quint16 startAddress, quint16 quantity) {
-    QMutexLocker locker(&m_mutex);
-    if (quantity < 1 || quantity > 125 || startAddress + quantity > dataArea->holdingRegisters.size())
+        ModbusDataArea& dataArea, quint16 startAddress, quint16 quantity) {
+    QByteArray data;
+    if (quantity < 1 || quantity > 125
+        || !dataArea.readRegistersBigEndian(RegisterTable::Holding, startAddress, quantity, data))
         return createExceptionResponse(header, READ_HOLDING_REGISTERS, ILLEGAL_DATA_ADDRESS);
 
     QByteArray response;
     response.append(static_cast<char>(READ_HOLDING_REGISTERS));
     response.append(static_cast<char>(quantity * 2));
-    for (int i = 0; i < quantity; i++)
-        response.append(uint16ToBytes(dataArea->holdingRegisters[startAddress + i]));
-    locker.unlock();
+    response.append(data);
     emit dataRead(header.unitId, READ_HOLDING_REGISTERS, startAddress, quantity);
     return response;
 }
 
 QByteArray ModbusTcpServer::handleReadInputRegisters(const ModbusTCPHeader& header,
-        QSharedPointer<ModbusDataArea> dataArea, quint16 startAddress, quint16 quantity) {
-    QMutexLocker locker(&m_mutex);
-    if (quantity < 1 || quantity > 125 || startAddress + quantity > dataArea->inputRegisters.size())
+        ModbusDataArea& dataArea, quint16 startAddress, quint16 quantity) {
+    QByteArray data;
+    if (quantity < 1 || quantity > 125
+        || !dataArea.readRegistersBigEndian(RegisterTable::Input, startAddress, quantity, data))
         return createExceptionResponse(header, READ_INPUT_REGISTERS, ILLEGAL_DATA_ADDRESS);
 
     QByteArray response;
     response.append(static_cast<char>(READ_INPUT_REGISTERS));
     response.append(static_cast<char>(quantity * 2));
-    for (int i = 0; i < quantity; i++)
-        response.append(uint16ToBytes(dataArea->inputRegisters[startAddress + i]));
-    locker.unlock();
+    response.append(data);
     emit dataRead(header.unitId, READ_INPUT_REGISTERS, startAddress, quantity);
     return response;
 }
 
 QByteArray ModbusTcpServer::handleWriteSingleCoil(const ModbusTCPHeader& header,
-        QSharedPointer<ModbusDataArea> dataArea, quint16 address, quint16 value) {
-    QMutexLocker locker(&m_mutex);
-    if (address >= dataArea->coils.size())
+        ModbusDataArea& dataArea, quint16 address, quint16 value) {
+    if (address >= dataArea.size())
         return createExceptionResponse(header, WRITE_SINGLE_COIL, ILLEGAL_DATA_ADDRESS);
     if (value != 0x0000 && value != 0xFF00)
         return createExceptionResponse(header, WRITE_SINGLE_COIL, ILLEGAL_DATA_VALUE);
-    dataArea->coils[address] = (value == 0xFF00);
-    locker.unlock();
+    dataArea.setBit(BitTable::Coils, address, value == 0xFF00);
     emit dataWritten(header.unitId, WRITE_SINGLE_COIL, address, 1);
 
     QByteArray response;
@@ -349,12 +325,9 @@ QByteArray ModbusTcpServer::handleWriteSingleCoil(const ModbusTCPHeader& header,
 }
 
 QByteArray ModbusTcpServer::handleWriteSingleRegister(const ModbusTCPHeader& header,
-        QSharedPointer<ModbusDataArea> dataArea, quint16 address, quint16 value) {
-    QMutexLocker locker(&m_mutex);
-    if (address >= dataArea->holdingRegisters.size())
+        ModbusDataArea& dataArea, quint16 address, quint16 value) {
+    if (!dataArea.setRegister(RegisterTable::Holding, address, value))
         return createExceptionResponse(header, WRITE_SINGLE_REGISTER, ILLEGAL_DATA_ADDRESS);
-    dataArea->holdingRegisters[address] = value;
-    locker.unlock();
     emit dataWritten(header.unitId, WRITE_SINGLE_REGISTER, address, 1);
 
     QByteArray response;
@@ -365,20 +338,12 @@ QByteArray ModbusTcpServer::handleWriteSingleRegister(const ModbusTCPHeader& hea
 }
 
 QByteArray ModbusTcpServer::handleWriteMultipleCoils(const ModbusTCPHeader& header,
-        QSharedPointer<ModbusDataArea> dataArea, quint16 startAddress, quint16 quantity,
+        ModbusDataArea& dataArea, quint16 startAddress, quint16 quantity,
         const QByteArray& values) {
-    QMutexLocker locker(&m_mutex);
-    if (quantity < 1 || quantity > 1968 || startAddress + quantity > dataArea->coils.size())
+    if (quantity < 1 || quantity > 1968 || startAddress + quantity > dataArea.size())
         return createExceptionResponse(header, WRITE_MULTIPLE_COILS, ILLEGAL_DATA_ADDRESS);
-    int byteCount = (quantity + 7) / 8;
-    if (values.size() < byteCount)
+    if (!dataArea.writeBits(BitTable::Coils, startAddress, quantity, values))
         return createExceptionResponse(header, WRITE_MULTIPLE_COILS, ILLEGAL_DATA_VALUE);
-    for (int i = 0; i < quantity; i++) {
-        int byteIndex = i / 8;
-        int bitIndex = i % 8;
-        dataArea->coils[startAddress + i] = (values[byteIndex] & (1 << bitIndex)) != 0;
-    }
-    locker.unlock();
     emit dataWritten(header.unitId, WRITE_MULTIPLE_COILS, startAddress, quantity);
 
     QByteArray response;
@@ -389,16 +354,14 @@ QByteArray ModbusTcpServer::handleWriteMultipleCoils(const ModbusTCPHeader& head
 }
 
 QByteArray ModbusTcpServer::handleWriteMultipleRegisters(const ModbusTCPHeader& header,
-        QSharedPointer<ModbusDataArea> dataArea, quint16 startAddress, quint16 quantity,
+        ModbusDataArea& dataArea, quint16 startAddress, quint16 quantity,
         const QByteArray& values) {
-    QMutexLocker locker(&m_mutex);
-    if (quantity < 1 || quantity > 123 || startAddress + quantity > dataArea->holdingRegisters.size())
+    if (quantity < 1 || quantity > 123 || startAddress + quantity > dataArea.size())
         return createExceptionResponse(header, WRITE_MULTIPLE_REGISTERS, ILLEGAL_DATA_ADDRESS);
     if (values.size() < quantity * 2)
         return createExceptionResponse(header, WRITE_MULTIPLE_REGISTERS, ILLEGAL_DATA_VALUE);
-    for (int i = 0; i < quantity; i++)
-        dataArea->holdingRegisters[startAddress + i] = bytesToUInt16(values, i * 2);
-    locker.unlock();
+    dataArea.writeRegistersBigEndian(RegisterTable::Holding, startAddress, quantity,
+                                     values.constData());
     emit dataWritten(header.unitId, WRITE_MULTIPLE_REGISTERS, startAddress, quantity);
 
     QByteArray response;
@@ -440,73 +403,76 @@ QByteArray ModbusTcpServer::uint16ToBytes(quint16 value) const {
 }
 
 bool ModbusTcpServer::setCoil(quint8 unitId, quint16 address, bool value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& area = m_unitDataAreas[unitId];
-    if (address >= area->coils.size()) return false;
-    area->coils[address] = value;
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->setBit(BitTable::Coils, address, value);
 }
 
 bool ModbusTcpServer::getCoil(quint8 unitId, quint16 address, bool& value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& area = m_unitDataAreas[unitId];
-    if (address >= area->coils.size()) return false;
-    value = area->coils[address];
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->getBit(BitTable::Coils, address, value);
 }
 
 bool ModbusTcpServer::setDiscreteInput(quint8 unitId, quint16 address, bool value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& area = m_unitDataAreas[unitId];
-    if (address >= area->discreteInputs.size()) return false;
-    area->discreteInputs[address] = value;
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->setBit(BitTable::DiscreteInputs, address, value);
 }
 
 bool ModbusTcpServer::getDiscreteInput(quint8 unitId, quint16 address, bool& value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& area = m_unitDataAreas[unitId];
-    if (address >= area->discreteInputs.size()) return false;
-    value = area->discreteInputs[address];
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->getBit(BitTable::DiscreteInputs, address, value);
 }
 
 bool ModbusTcpServer::setHoldingRegister(quint8 unitId, quint16 address, quint16 value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& area = m_unitDataAreas[unitId];
-    if (address >= area->holdingRegisters.size()) return false;
-    area->holdingRegisters[address] = value;
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->setRegister(RegisterTable::Holding, address, value);
 }
 
 bool ModbusTcpServer::getHoldingRegister(quint8 unitId, quint16 address, quint16& value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& area = m_unitDataAreas[unitId];
-    if (address >= area->holdingRegisters.size()) return false;
-    value = area->holdingRegisters[address];
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->getRegister(RegisterTable::Holding, address, value);
 }
 
 bool ModbusTcpServer::setInputRegister(quint8 unitId, quint16 address, quint16 value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& area = m_unitDataAreas[unitId];
-    if (address >= area->inputRegisters.size()) return false;
-    area->inputRegisters[address] = value;
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->setRegister(RegisterTable::Input, address, value);
 }
 
 bool ModbusTcpServer::getInputRegister(quint8 unitId, quint16 address, quint16& value) {
-    QMutexLocker locker(&m_mutex);
-    if (!m_unitDataAreas.contains(unitId)) return false;
-    auto& area = m_unitDataAreas[unitId];
-    if (address >= area->inputRegisters.size()) return false;
-    value = area->inputRegisters[address];
-    return true;
+    const auto unit = m_units.find(unitId);
+    return unit && unit->getRegister(RegisterTable::Input, address, value);
+}
+
+bool ModbusTcpServer::setHoldingRegisters(quint8 unitId, quint16 address,
+        const QVector<quint16>& values) {
+    const auto unit = m_units.find(unitId);
+    return unit && unit->writeRegisters(RegisterTable::Holding, address,
+                                        static_cast<int>(values.size()), values.constData());
+}
+
+bool ModbusTcpServer::getHoldingRegisters(quint8 unitId, quint16 address, int count,
+        QVector<quint16>& values) {
+    const auto unit = m_units.find(unitId);
+    if (!unit || count < 0) return false;
+    values.resize(count);
+    return unit->readRegisters(RegisterTable::Holding, address, count, values.data());
+}
+
+bool ModbusTcpServer::setInputRegisters(quint8 unitId, quint16 address,
+        const QVector<quint16>& values) {
+    const auto unit = m_units.find(unitId);
+    return unit && unit->writeRegisters(RegisterTable::Input, address,
+                                        static_cast<int>(values.size()), values.constData());
+}
+
+bool ModbusTcpServer::getInputRegisters(quint8 unitId, quint16 address, int count,
+        QVector<quint16>& values) {
+    const auto unit = m_units.find(unitId);
+    if (!unit || count < 0) return false;
+    values.resize(count);
+    return unit->readRegisters(RegisterTable::Input, address, count, values.data());
+}
+
+int ModbusTcpServer::dataAreaSize(quint8 unitId) const {
+    const auto unit = m_units.find(unitId);
+    return unit ? unit->size() : 0;
 }
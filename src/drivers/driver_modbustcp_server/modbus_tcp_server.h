@@ -1,12 +1,11 @@
 #pragma once
 
 #include <QMap>
-#include <QMutex>
 #include <QPointer>
-#include <QSharedPointer>
 #include <QTcpServer>
 #include <QTcpSocket>
 #include <QVector>
+#include "modbus_data_area.h"
 
 struct ModbusTCPHeader {
     quint16 transactionId;
@@ -15,20 +14,6 @@ struct ModbusTCPHeader {
     quint8 unitId;
 };
 
-struct ModbusDataArea {
-    QVector<bool> coils;
-    QVector<bool> discreteInputs;
-    QVector<quint16> holdingRegisters;
-    QVector<quint16> inputRegisters;
-
-    explicit ModbusDataArea(int size = 10000) {
-        coils = QVector<bool>(size, false);
-        discreteInputs = QVector<bool>(size, false);
-        holdingRegisters = QVector<quint16>(size, 0);
-        inputRegisters = QVector<quint16>(size, 0);
-    }
-};
-
 struct ClientInfo {
     QByteArray recvBuffer;
     QString address;
@@ -61,6 +46,15 @@ public:
     bool setInputRegister(quint8 unitId, quint16 address, quint16 value);
     bool getInputRegister(quint8 unitId, quint16 address, quint16& value);
 
+    // 连续寄存器批量读写：整段为一次写入、读取得到一致快照，越界时不做任何修改
+    bool setHoldingRegisters(quint8 unitId, quint16 address, const QVector<quint16>& values);
+    bool getHoldingRegisters(quint8 unitId, quint16 address, int count, QVector<quint16>& values);
+    bool setInputRegisters(quint8 unitId, quint16 address, const QVector<quint16>& values);
+    bool getInputRegisters(quint8 unitId, quint16 address, int count, QVector<quint16>& values);
+
+    /** 单元数据区大小，单元不存在返回 0 */
+    int dataAreaSize(quint8 unitId) const;
+
 signals:
     void clientConnected(QString address, quint16 port);
     void clientDisconnected(QString address, quint16 port);
@@ -82,29 +76,29 @@ private:
     void processBuffer(QTcpSocket* socket);
 
     QByteArray handleReadCoils(const ModbusTCPHeader& header,
-                               QSharedPointer<ModbusDataArea> dataArea,
+                               modbus::ModbusDataArea& dataArea,
                                quint16 startAddress, quint16 quantity);
     QByteArray handleReadDiscreteInputs(const ModbusTCPHeader& header,
-                                        QSharedPointer<ModbusDataArea> dataArea,
+                                        modbus::ModbusDataArea& dataArea,
                                         quint16 startAddress, quint16 quantity);
     QByteArray handleReadHoldingRegisters(const ModbusTCPHeader& header,
-                                          QSharedPointer<ModbusDataArea> dataArea,
+                                          modbus::ModbusDataArea& dataArea,
                                           quint16 startAddress, quint16 quantity);
     QByteArray handleReadInputRegisters(const ModbusTCPHeader& header,
-                                        QSharedPointer<ModbusDataArea> dataArea,
+                                        modbus::ModbusDataArea& dataArea,
                                         quint16 startAddress, quint16 quantity);
     QByteArray handleWriteSingleCoil(const ModbusTCPHeader& header,
-                                     QSharedPointer<ModbusDataArea> dataArea,
+                                     modbus::ModbusDataArea& dataArea,
                                      quint16 address, quint16 value);
     QByteArray handleWriteSingleRegister(const ModbusTCPHeader& header,
-                                         QSharedPointer<ModbusDataArea> dataArea,
+                                         modbus::ModbusDataArea& dataArea,
                                          quint16 address, quint16 value);
     QByteArray handleWriteMultipleCoils(const ModbusTCPHeader& header,
-                                        QSharedPointer<ModbusDataArea> dataArea,
+                                        modbus::ModbusDataArea& dataArea,
                                         quint16 startAddress, quint16 quantity,
                                         const QByteArray& values);
     QByteArray handleWriteMultipleRegisters(const ModbusTCPHeader& header,
-                                            QSharedPointer<ModbusDataArea> dataArea,
+                                            modbus::ModbusDataArea& dataArea,
                                             quint16 startAddress, quint16 quantity,
                                             const QByteArray& values);
 
@@ -116,8 +110,7 @@ private:
     QByteArray uint16ToBytes(quint16 value) const;
 
     QMap<QPointer<QTcpSocket>, ClientInfo> m_clients;
-    QMap<quint8, QSharedPointer<ModbusDataArea>> m_unitDataAreas;
-    mutable QMutex m_mutex;
+    modbus::ModbusUnitTable m_units;
 
     static constexpr int MAX_MODBUS_LENGTH = 260;
 };
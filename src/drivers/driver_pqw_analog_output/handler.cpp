@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "driver_modbusrtu_serial/modbus_rtu_serial_client.h"
+#include "stdiolink/driver/fieldbus_transport.h"
 #include "stdiolink/driver/meta_builder.h"
 
 using namespace stdiolink;
@@ -35,55 +36,37 @@ struct ConfigReadResult {
     QJsonArray rawRegisters;
 };
 
-struct SerialConnectionInfo {
-    std::shared_ptr<ModbusRtuSerialClient> client;
-    int baudRate = 9600;
-    QString stopBits = "1";
-    QString parity = "none";
-};
-
+// 串口复用、空闲关闭与重连退避交给 stdiolink 的 FieldbusPool；本设备固定 8 数据位
 class SerialConnectionManager {
 public:
+    using Pool = FieldbusPool<ModbusRtuSerialClient>;
+
     static SerialConnectionManager& instance() {
         static SerialConnectionManager manager;
         return manager;
     }
 
-    ModbusRtuSerialClient* getClient(const PqwAnalogOutputConnectionOptions& options, QString& errorMessage) {
-        auto it = m_connections.find(options.portName);
-        if (it != m_connections.end()) {
-            const SerialConnectionInfo& info = it.value();
-            if (info.client->isOpen()) {
-                if (info.baudRate != options.baudRate
-                    || info.stopBits != options.stopBits
-                    || info.parity != options.parity) {
-                    errorMessage = QString(
-                        "Serial port %1 is already open with different parameters")
-                        .arg(options.portName);
+    Pool::Lease getClient(const PqwAnalogOutputConnectionOptions& options, QString& errorMessage) {
+        const QString signature = QString("%1,8,%2,%3")
+            .arg(options.baudRate).arg(options.stopBits, options.parity);
+        return m_pool.acquire(options.portName, signature,
+            [&](QString& err) -> std::shared_ptr<ModbusRtuSerialClient> {
+                auto client = std::make_shared<ModbusRtuSerialClient>();
+                if (!client->open(options.portName, options.baudRate, 8,
+                                  options.stopBits, options.parity)) {
+                    err = QString("Failed to open serial port %1").arg(options.portName);
                     return nullptr;
                 }
-                return info.client.get();
-            }
-            m_connections.erase(it);
-        }
-
-        auto client = std::make_shared<ModbusRtuSerialClient>();
-        if (!client->open(options.portName, options.baudRate, 8, options.stopBits, options.parity)) {
-            errorMessage = QString("Failed to open serial port %1").arg(options.portName);
-            return nullptr;
-        }
-
-        SerialConnectionInfo info;
-        info.client = client;
-        info.baudRate = options.baudRate;
-        info.stopBits = options.stopBits;
-        info.parity = options.parity;
-        m_connections.insert(options.portName, info);
-        return client.get();
+                return client;
+            },
+            errorMessage);
     }
 
 private:
-    QHash<QString, SerialConnectionInfo> m_connections;
+    SerialConnectionManager()
+        : m_pool([](ModbusRtuSerialClient& client) { return client.isOpen(); }) {}
+
+    Pool m_pool;
 };
 
 QJsonArray toIntArray(const QVector<quint16>& values) {
@@ -204,6 +187,7 @@ bool isAllowedBaudRate(int baudRate) {
 bool tryGetClient(const QString& cmd,
                   const QJsonObject& params,
                   PqwAnalogOutputConnectionOptions& options,
+                  SerialConnectionManager::Pool::Lease& lease,
                   ModbusRtuSerialClient*& client,
                   IResponder& responder) {
     QString errorMessage;
@@ -212,11 +196,12 @@ bool tryGetClient(const QString& cmd,
         return false;
     }
 
-    client = SerialConnectionManager::instance().getClient(options, errorMessage);
-    if (!client) {
+    lease = SerialConnectionManager::instance().getClient(options, errorMessage);
+    if (!lease) {
         respondIoError(responder, errorMessage);
         return false;
     }
+    client = lease.get();
     return true;
 }
 
@@ -591,10 +576,11 @@ void PqwAnalogOutputHandler::handle(const QString& cmd,
 
     const QJsonObject params = data.toObject();
     PqwAnalogOutputConnectionOptions options;
+    SerialConnectionManager::Pool::Lease lease;
     ModbusRtuSerialClient* client = nullptr;
 
     if (cmd == "get_config") {
-        if (!tryGetClient(cmd, params, options, client, responder)) {
+        if (!tryGetClient(cmd, params, options, lease, client, responder)) {
             return;
         }
         QVector<quint16> registers;
@@ -630,7 +616,7 @@ void PqwAnalogOutputHandler::handle(const QString& cmd,
             return;
         }
 
-        if (!tryGetClient(cmd, params, options, client, responder)) {
+        if (!tryGetClient(cmd, params, options, lease, client, responder)) {
             return;
         }
         for (const auto& item : writes) {
@@ -647,7 +633,7 @@ void PqwAnalogOutputHandler::handle(const QString& cmd,
     }
 
     if (cmd == "restore_defaults") {
-        if (!tryGetClient(cmd, params, options, client, responder)) {
+        if (!tryGetClient(cmd, params, options, lease, client, responder)) {
             return;
         }
         if (!writeSingleRegister(client, options, kRegRestoreDefaults, 1, responder)) {
@@ -673,7 +659,7 @@ void PqwAnalogOutputHandler::handle(const QString& cmd,
             return;
         }
 
-        if (!tryGetClient(cmd, params, options, client, responder)) {
+        if (!tryGetClient(cmd, params, options, lease, client, responder)) {
             return;
         }
         QVector<quint16> registers;
@@ -714,7 +700,7 @@ void PqwAnalogOutputHandler::handle(const QString& cmd,
             return;
         }
 
-        if (!tryGetClient(cmd, params, options, client, responder)) {
+        if (!tryGetClient(cmd, params, options, lease, client, responder)) {
             return;
         }
         if (!writeSingleRegister(client,
@@ -770,7 +756,7 @@ void PqwAnalogOutputHandler::handle(const QString& cmd,
             rawValues.append(rawValue);
         }
 
-        if (!tryGetClient(cmd, params, options, client, responder)) {
+        if (!tryGetClient(cmd, params, options, lease, client, responder)) {
             return;
         }
         if (!writeMultipleRegisters(client,
@@ -791,7 +777,7 @@ void PqwAnalogOutputHandler::handle(const QString& cmd,
     }
 
     if (cmd == "clear_outputs") {
-        if (!tryGetClient(cmd, params, options, client, responder)) {
+        if (!tryGetClient(cmd, params, options, lease, client, responder)) {
             return;
         }
         if (!writeSingleRegister(client, options, kRegClearOutputs, 1, responder)) {
@@ -15,8 +15,8 @@ EXE_SUFFIX = ".exe" if os.name == "nt" else ""
 
 DRIVERS: dict[str, int] = {
     "stdio.drv.plc_crane": 6,
-    "stdio.drv.modbustcp": 10,
-    "stdio.drv.modbusrtu": 10,
+    "stdio.drv.modbustcp": 13,
+    "stdio.drv.modbusrtu": 13,
     "stdio.drv.modbusrtu_serial": 10,
     "stdio.drv.modbustcp_server": 17,
     "stdio.drv.modbusrtu_server": 17,
@@ -25,7 +25,11 @@ DRIVERS: dict[str, int] = {
     "stdio.drv.pqw_analog_output": 8,
 }
 
-CONSOLE_EXCEPTION_ALLOWLIST: set[tuple[str, str]] = set()
+# subscribe 依赖请求 ID 回显事件帧，console 模式没有请求 ID
+CONSOLE_EXCEPTION_ALLOWLIST: set[tuple[str, str]] = {
+    ("stdio.drv.modbustcp", "subscribe"),
+    ("stdio.drv.modbusrtu", "subscribe"),
+}
 CONSOLE_COVERAGE_MIN = 0.8
 
 
@@ -475,6 +475,7 @@ QString DocGenerator::toTypeScript(const meta::DriverMeta& meta) {
     ts += "    status: string;\n";
     ts += "    code: number;\n";
     ts += "    data: any;\n";
+    ts += "    blob?: ArrayBuffer;\n";
     ts += "}\n\n";
 
     ts += "export interface Task {\n";
@@ -484,6 +485,7 @@ QString DocGenerator::toTypeScript(const meta::DriverMeta& meta) {
     ts += "    readonly exitCode: number;\n";
     ts += "    readonly errorText: string;\n";
     ts += "    readonly finalPayload: any;\n";
+    ts += "    readonly finalBlob: ArrayBuffer | null;\n";
     ts += "}\n\n";
 
     ts += "export interface Driver {\n";
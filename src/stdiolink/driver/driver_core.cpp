@@ -9,6 +9,7 @@
 #include <QThread>
 #include <QTimer>
 #include <cstdio>
+#include <cstring>
 #include <atomic>
 #include "help_generator.h"
 #include "log_redirector.h"
@@ -93,6 +94,9 @@ int DriverCore::runStdioMode() {
         return 1;
     }
 
+    // 在分发任何请求前读取并清除侧信道帧协商变量，handler 启动的子进程不会继承
+    (void)StdioResponder::blobFramesEnabled();
+
     // 重置本次运行的状态，避免重复调用 run 时残留旧状态。
     m_stdioStopRequested.store(false, std::memory_order_relaxed);
     m_stdioAcceptLines.store(true, std::memory_order_relaxed);
@@ -111,6 +115,8 @@ int DriverCore::runStdioMode() {
             return;
         }
 
+#ifdef Q_OS_WIN
+        // Windows 管道必须沿用 Qt 行读取链路；逐行封装成单行块投递。
         QTextStream in(&input);
         while (!m_stdioStopRequested.load(std::memory_order_relaxed) && !in.atEnd()) {
             const QString line = in.readLine();
@@ -118,12 +124,52 @@ int DriverCore::runStdioMode() {
                 break;
             }
 
-            const QByteArray data = line.toUtf8();
+            QByteArray block = line.toUtf8();
+            block.append('\n');
+            QMetaObject::invokeMethod(
+                app,
+                [this, block]() { handleStdioBlockOnMainThread(block); },
+                Qt::QueuedConnection);
+        }
+#else
+        // 按块读取原始字节：QFile 对顺序设备只返回当前可读的数据，不会等满整块。
+        // 每次读取后把所有完整行作为一个块投递到主线程，未完整的尾行留待下次拼接。
+        QByteArray pending;
+        while (!m_stdioStopRequested.load(std::memory_order_relaxed)) {
+            const qsizetype used = pending.size();
+            pending.resize(used + kStdinReadChunkBytes);
+            const qint64 n = input.read(pending.data() + used, kStdinReadChunkBytes);
+            if (n <= 0) {
+                pending.truncate(used);
+                break;
+            }
+            pending.truncate(used + static_cast<qsizetype>(n));
+
+            // 旧的 pending 不含换行，只需在本次新读入的字节中查找
+            const qsizetype hit = QByteArrayView(pending).sliced(used).lastIndexOf('\n');
+            if (hit < 0) {
+                continue;
+            }
+            const qsizetype lastNl = used + hit;
+
+            QByteArray block = std::move(pending);
+            pending = QByteArray(block.constData() + lastNl + 1, block.size() - lastNl - 1);
+            block.truncate(lastNl + 1);
+            QMetaObject::invokeMethod(
+                app,
+                [this, block = std::move(block)]() { handleStdioBlockOnMainThread(block); },
+                Qt::QueuedConnection);
+        }
+
+        // EOF 时与 QTextStream::readLine 一致：最后一行可以没有换行符
+        if (!pending.isEmpty()) {
+            pending.append('\n');
             QMetaObject::invokeMethod(
                 app,
-                [this, data]() { handleStdioLineOnMainThread(data); },
+                [this, block = std::move(pending)]() { handleStdioBlockOnMainThread(block); },
                 Qt::QueuedConnection);
         }
+#endif
 
         QMetaObject::invokeMethod(
             app,
@@ -147,6 +193,7 @@ int DriverCore::runStdioMode() {
     QCoreApplication::setQuitLockEnabled(false);
     const int exitCode = app->exec();
     QCoreApplication::setQuitLockEnabled(oldQuitLock);
+    StdioResponder::flush();
 
     m_stdioStopRequested.store(true, std::memory_order_relaxed);
 
@@ -167,6 +214,26 @@ int DriverCore::runStdioMode() {
     return exitCode;
 }
 
+void DriverCore::handleStdioBlockOnMainThread(const QByteArray& block) {
+    // 块内按行原地切分，行数据以 fromRawData 引用块内存，不再逐行分配。
+    const char* const begin = block.constData();
+    const char* const end = begin + block.size();
+    const char* cur = begin;
+    while (cur < end) {
+        const auto* nl = static_cast<const char*>(std::memchr(cur, '\n', static_cast<size_t>(end - cur)));
+        const char* lineEnd = nl ? nl : end;
+        qsizetype len = lineEnd - cur;
+        if (len > 0 && cur[len - 1] == '\r') {
+            --len;
+        }
+        handleStdioLineOnMainThread(QByteArray::fromRawData(cur, len));
+        if (!m_stdioAcceptLines.load(std::memory_order_relaxed)) {
+            return;
+        }
+        cur = nl ? nl + 1 : end;
+    }
+}
+
 void DriverCore::handleStdioLineOnMainThread(const QByteArray& line) {
     if (!m_stdioAcceptLines.load(std::memory_order_relaxed)) {
         return;
@@ -270,6 +337,15 @@ int DriverCore::run(int argc, char* argv[]) {
 void DriverCore::setMetaHandler(IMetaCommandHandler* h) {
     m_metaHandler = h;
     m_handler = h;  // 同时设置为普通处理器
+    m_validationPlan.reset();
+}
+
+const meta::CommandValidationPlan* DriverCore::validationPlanFor(const QString& cmd) {
+    if (!m_validationPlan) {
+        m_validationPlan =
+            std::make_shared<const meta::DriverValidationPlan>(m_metaHandler->driverMeta());
+    }
+    return m_validationPlan->find(cmd);
 }
 
 bool DriverCore::processOneLine(const QByteArray& line) {
@@ -287,8 +363,10 @@ bool DriverCore::processOneLine(const QByteArray& line) {
         return false;
     }
 
-    // 处理命令
-    StdioResponder responder;
+    // 处理命令：携带 id 的请求在所有响应帧中回显 id，Host 据此在同一进程上并发多条请求。
+    // DispatchScope 让 handler 内部为异步回包创建的 StdioResponder 也能继承该 id。
+    StdioResponder::DispatchScope dispatchScope(req.id);
+    StdioResponder responder(req.id);
 
     // 优先处理 meta 命令
     if (handleMetaCommand(req.cmd, req.data, responder)) {
@@ -297,14 +375,11 @@ bool DriverCore::processOneLine(const QByteArray& line) {
 
     // 自动参数验证
     if (m_metaHandler && m_metaHandler->autoValidateParams()) {
-        const auto* cmdMeta = m_metaHandler->driverMeta().findCommand(req.cmd);
-        if (cmdMeta) {
-            // 填充默认值
-            QJsonObject filledData = meta::DefaultFiller::fillDefaults(
-                req.data.toObject(), *cmdMeta);
-
-            // 验证参数
-            auto result = meta::MetaValidator::validateParams(filledData, *cmdMeta);
+        const auto* plan = validationPlanFor(req.cmd);
+        if (plan) {
+            // 填充默认值并验证参数（预编译计划，单次遍历）
+            QJsonObject filledData = req.data.toObject();
+            auto result = plan->fillAndValidate(filledData);
             if (!result.valid) {
                 responder.error(400, QJsonObject{
                     {"name", "ValidationFailed"},
@@ -413,10 +488,9 @@ int DriverCore::runConsoleMode(const ConsoleArgs& args) {
         // 自动参数验证
         QJsonValue data = consoleData;
         if (m_metaHandler && m_metaHandler->autoValidateParams()) {
-            if (cmdMeta) {
-                QJsonObject filledData = meta::DefaultFiller::fillDefaults(
-                    consoleData, *cmdMeta);
-                auto result = meta::MetaValidator::validateParams(filledData, *cmdMeta);
+            if (const auto* plan = validationPlanFor(args.cmd)) {
+                QJsonObject filledData = consoleData;
+                auto result = plan->fillAndValidate(filledData);
                 if (!result.valid) {
                     responder.error(400, QJsonObject{
                         {"name", "ValidationFailed"},
@@ -435,6 +509,7 @@ int DriverCore::runConsoleMode(const ConsoleArgs& args) {
     QCoreApplication::setQuitLockEnabled(false);
     const int loopExitCode = app->exec();
     QCoreApplication::setQuitLockEnabled(oldQuitLock);
+    StdioResponder::flush();
 
     if (responder.hasResult()) {
         return responder.exitCode();
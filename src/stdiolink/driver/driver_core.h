@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <QThread>
 #include "icommand_handler.h"
 #include "stdiolink/protocol/jsonl_parser.h"
@@ -11,6 +12,11 @@ namespace stdiolink {
 class IMetaCommandHandler;
 class ConsoleArgs;
 
+namespace meta {
+class CommandValidationPlan;
+class DriverValidationPlan;
+} // namespace meta
+
 /**
  * Driver 核心类
  * 处理 stdin/stdout 通信，支持 Stdio 和 Console 双模式
@@ -53,13 +59,19 @@ private:
     Profile m_profile = Profile::OneShot;
     ICommandHandler* m_handler = nullptr;
     IMetaCommandHandler* m_metaHandler = nullptr;
+    // 首次自动验证时由 driverMeta() 构建，setMetaHandler() 时失效
+    std::shared_ptr<const meta::DriverValidationPlan> m_validationPlan;
     JsonlParser m_parser;
     QThread* m_stdinReaderThread = nullptr;
     std::atomic_bool m_stdioStopRequested{false};
     std::atomic_bool m_stdioAcceptLines{true};
     bool m_stdioQuitScheduled = false;
 
+    // stdin 读取线程单次读取上限
+    static constexpr qint64 kStdinReadChunkBytes = 64 * 1024;
+
     int runStdioMode();
+    void handleStdioBlockOnMainThread(const QByteArray& block);
     void handleStdioLineOnMainThread(const QByteArray& line);
     void scheduleStdioQuit();
     int runConsoleMode(const ConsoleArgs& args);
@@ -70,6 +82,7 @@ private:
     int handleExportMeta(const ConsoleArgs& args);
     int handleExportDoc(const ConsoleArgs& args);
 
+    const meta::CommandValidationPlan* validationPlanFor(const QString& cmd);
     bool processOneLine(const QByteArray& line);
     bool handleMetaCommand(const QString& cmd, const QJsonValue& data,
                            IResponder& responder);
@@ -0,0 +1,376 @@
+#include "fieldbus_transport.h"
+
+#include <QJsonArray>
+#include <QThread>
+#include <QTimer>
+#include <algorithm>
+#include <utility>
+
+namespace stdiolink {
+
+namespace {
+
+constexpr int kMaintenanceIntervalMs = 1000;
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// FieldbusPacer
+
+FieldbusPacer::FieldbusPacer(qint64 gapUs)
+    : m_gapUs(std::max<qint64>(0, gapUs)) {}
+
+void FieldbusPacer::setGapUs(qint64 gapUs) {
+    m_gapUs = std::max<qint64>(0, gapUs);
+}
+
+qint64 FieldbusPacer::waitForGap() {
+    qint64 remaining = m_gapUs;
+    if (m_sinceFrameEnd.isValid()) {
+        remaining -= m_sinceFrameEnd.nsecsElapsed() / 1000;
+    }
+    if (remaining <= 0) {
+        return 0;
+    }
+    QThread::usleep(static_cast<unsigned long>(remaining));
+    return remaining;
+}
+
+void FieldbusPacer::markFrameEnd() {
+    m_sinceFrameEnd.start();
+}
+
+void FieldbusPacer::reset() {
+    m_sinceFrameEnd.invalidate();
+}
+
+// ---------------------------------------------------------------------------
+// FieldbusStats
+
+void FieldbusStats::recordRoundTrip(qint64 us) {
+    ++transactions;
+    rttTotalUs += us;
+    rttMaxUs = std::max(rttMaxUs, us);
+
+    int bucket = 0;
+    while (bucket < static_cast<int>(kRttBucketUpperMs.size())
+           && us > static_cast<qint64>(kRttBucketUpperMs[bucket]) * 1000) {
+        ++bucket;
+    }
+    ++rttBuckets[bucket];
+}
+
+QJsonObject FieldbusStats::toJson() const {
+    QJsonObject histogram;
+    for (int i = 0; i < kRttBucketCount; ++i) {
+        const QString key = i < static_cast<int>(kRttBucketUpperMs.size())
+            ? QString("le_%1").arg(kRttBucketUpperMs[i])
+            : QString("gt_%1").arg(kRttBucketUpperMs.back());
+        histogram[key] = rttBuckets[i];
+    }
+
+    return QJsonObject{
+        {"transactions", transactions},
+        {"link_errors", linkErrors},
+        {"opens", opens},
+        {"open_failures", openFailures},
+        {"idle_closes", idleCloses},
+        {"probe_failures", probeFailures},
+        {"queue_depth", queueDepth},
+        {"max_queue_depth", maxQueueDepth},
+        {"rtt_avg_us", transactions > 0 ? rttTotalUs / transactions : 0},
+        {"rtt_max_us", rttMaxUs},
+        {"rtt_histogram_ms", histogram},
+    };
+}
+
+// ---------------------------------------------------------------------------
+// FieldbusTransport::Lease
+
+FieldbusTransport::Lease::Lease(FieldbusTransport* owner, const QString& endpoint, Link link)
+    : m_owner(owner)
+    , m_endpoint(endpoint)
+    , m_link(std::move(link)) {
+    m_elapsed.start();
+}
+
+FieldbusTransport::Lease::~Lease() {
+    release();
+}
+
+FieldbusTransport::Lease::Lease(Lease&& other) noexcept
+    : m_owner(std::exchange(other.m_owner, nullptr))
+    , m_endpoint(std::move(other.m_endpoint))
+    , m_link(std::move(other.m_link))
+    , m_elapsed(other.m_elapsed) {}
+
+FieldbusTransport::Lease& FieldbusTransport::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_owner = std::exchange(other.m_owner, nullptr);
+        m_endpoint = std::move(other.m_endpoint);
+        m_link = std::move(other.m_link);
+        m_elapsed = other.m_elapsed;
+    }
+    return *this;
+}
+
+void FieldbusTransport::Lease::release() {
+    if (m_owner && m_link) {
+        m_owner->releaseLink(m_endpoint, m_link, m_elapsed.nsecsElapsed() / 1000);
+    }
+    m_owner = nullptr;
+    m_link.reset();
+}
+
+// ---------------------------------------------------------------------------
+// FieldbusTransport
+
+FieldbusTransport::FieldbusTransport(LinkCheck isAlive, const Options& options)
+    : m_isAlive(std::move(isAlive))
+    , m_options(options)
+    , m_dispatcher(std::make_unique<QTimer>())
+    , m_maintenance(std::make_unique<QTimer>()) {
+    m_dispatcher->setSingleShot(true);
+    m_dispatcher->setInterval(0);
+    QObject::connect(m_dispatcher.get(), &QTimer::timeout, m_dispatcher.get(),
+                     [this]() { dispatchOne(); });
+
+    m_maintenance->setInterval(kMaintenanceIntervalMs);
+    QObject::connect(m_maintenance.get(), &QTimer::timeout, m_maintenance.get(),
+                     [this]() { closeIdle(); });
+}
+
+FieldbusTransport::~FieldbusTransport() {
+    m_dispatcher->stop();
+    m_maintenance->stop();
+}
+
+void FieldbusTransport::setOptions(const Options& options) {
+    m_options = options;
+    updateMaintenanceTimer();
+}
+
+FieldbusTransport::Lease FieldbusTransport::acquireLink(const QString& endpoint,
+                                                        const QString& signature,
+                                                        const Opener& opener,
+                                                        QString& error) {
+    Endpoint& ep = m_endpoints[endpoint];
+
+    if (ep.link) {
+        bool alive = m_isAlive(ep.link.get());
+        // 租用中的链路刚被使用过，无需探活；空闲链路可能已被对端或线缆断开
+        if (alive && m_probe && ep.leases == 0
+            && ep.lastUsed.elapsed() >= m_options.probeAfterIdleMs) {
+            if (!m_probe(ep.link.get())) {
+                ++ep.stats.probeFailures;
+                alive = false;
+            }
+        }
+        if (alive) {
+            if (ep.signature != signature) {
+                error = QString("%1 is already open with different parameters").arg(endpoint);
+                return Lease();
+            }
+            ++ep.leases;
+            return Lease(this, endpoint, ep.link);
+        }
+        ++ep.stats.linkErrors;
+        ep.link.reset();
+    }
+
+    // 错误文本保持不变，调用方可按文本判断状态是否变化；剩余退避见 reconnectInMs()
+    if (remainingBackoffMs(ep) > 0) {
+        error = ep.lastError;
+        return Lease();
+    }
+
+    Link link = opener(error);
+    if (!link) {
+        ++ep.stats.openFailures;
+        ep.lastError = error;
+        ep.failedAt.start();
+        ep.backoffMs = ep.backoffMs > 0
+            ? std::min(ep.backoffMs * 2, m_options.maxReconnectBackoffMs)
+            : m_options.reconnectBackoffMs;
+        return Lease();
+    }
+
+    ++ep.stats.opens;
+    ep.backoffMs = 0;
+    ep.lastError.clear();
+    ep.failedAt.invalidate();
+    ep.link = std::move(link);
+    ep.signature = signature;
+    ep.lastUsed.start();
+    ++ep.leases;
+    updateMaintenanceTimer();
+    return Lease(this, endpoint, ep.link);
+}
+
+void FieldbusTransport::releaseLink(const QString& endpoint, const Link& link, qint64 elapsedUs) {
+    auto it = m_endpoints.find(endpoint);
+    if (it == m_endpoints.end()) {
+        return;
+    }
+    Endpoint& ep = it->second;
+    ep.stats.recordRoundTrip(elapsedUs);
+    if (ep.link != link) {
+        return;  // 租用期间已被关闭或替换
+    }
+
+    --ep.leases;
+    ep.lastUsed.start();
+    if (!m_isAlive(link.get())) {
+        ++ep.stats.linkErrors;
+        ep.link.reset();
+        updateMaintenanceTimer();
+    }
+}
+
+void FieldbusTransport::post(const QString& endpoint, Priority priority, Task task) {
+    Endpoint& ep = m_endpoints[endpoint];
+    ep.queues[static_cast<size_t>(priority)].push_back(std::move(task));
+    ++ep.stats.queueDepth;
+    ep.stats.maxQueueDepth = std::max(ep.stats.maxQueueDepth, ep.stats.queueDepth);
+
+    if (std::find(m_ready.begin(), m_ready.end(), endpoint) == m_ready.end()) {
+        m_ready.push_back(endpoint);
+    }
+    if (!m_dispatcher->isActive()) {
+        m_dispatcher->start();
+    }
+}
+
+int FieldbusTransport::queueDepth(const QString& endpoint) const {
+    auto it = m_endpoints.find(endpoint);
+    return it == m_endpoints.end() ? 0 : it->second.stats.queueDepth;
+}
+
+qint64 FieldbusTransport::reconnectInMs(const QString& endpoint) const {
+    auto it = m_endpoints.find(endpoint);
+    return it == m_endpoints.end() ? 0 : remainingBackoffMs(it->second);
+}
+
+qint64 FieldbusTransport::remainingBackoffMs(const Endpoint& ep) {
+    if (ep.backoffMs <= 0 || !ep.failedAt.isValid()) {
+        return 0;
+    }
+    return std::max<qint64>(0, ep.backoffMs - ep.failedAt.elapsed());
+}
+
+void FieldbusTransport::dispatchOne() {
+    while (!m_ready.empty()) {
+        const QString endpoint = m_ready.front();
+        m_ready.pop_front();
+        auto it = m_endpoints.find(endpoint);
+        if (it == m_endpoints.end()) {
+            continue;
+        }
+
+        Endpoint& ep = it->second;
+        Task task;
+        for (std::deque<Task>& queue : ep.queues) {
+            if (!queue.empty()) {
+                task = std::move(queue.front());
+                queue.pop_front();
+                break;
+            }
+        }
+        if (!task) {
+            continue;
+        }
+        // 先放回轮转队尾再执行：任务内部可能继续 post 或关闭链路
+        if (--ep.stats.queueDepth > 0) {
+            m_ready.push_back(endpoint);
+        }
+        task();
+        break;
+    }
+
+    if (!m_ready.empty() && !m_dispatcher->isActive()) {
+        m_dispatcher->start();
+    }
+}
+
+void FieldbusTransport::close(const QString& endpoint) {
+    auto it = m_endpoints.find(endpoint);
+    if (it == m_endpoints.end()) {
+        return;
+    }
+    it->second.link.reset();
+    it->second.leases = 0;
+    updateMaintenanceTimer();
+}
+
+void FieldbusTransport::closeAll() {
+    for (auto& [name, ep] : m_endpoints) {
+        ep.link.reset();
+        ep.leases = 0;
+    }
+    updateMaintenanceTimer();
+}
+
+int FieldbusTransport::closeIdle() {
+    int closed = 0;
+    if (m_options.idleCloseMs > 0) {
+        for (auto& [name, ep] : m_endpoints) {
+            if (ep.link && ep.leases == 0 && ep.lastUsed.elapsed() >= m_options.idleCloseMs) {
+                ep.link.reset();
+                ++ep.stats.idleCloses;
+                ++closed;
+            }
+        }
+    }
+    updateMaintenanceTimer();
+    return closed;
+}
+
+FieldbusStats FieldbusTransport::stats(const QString& endpoint) const {
+    auto it = m_endpoints.find(endpoint);
+    return it == m_endpoints.end() ? FieldbusStats{} : it->second.stats;
+}
+
+QStringList FieldbusTransport::endpoints() const {
+    QStringList names;
+    for (const auto& [name, ep] : m_endpoints) {
+        names.append(name);
+    }
+    return names;
+}
+
+QJsonObject FieldbusTransport::statsJson() const {
+    QJsonObject out;
+    for (const auto& [name, ep] : m_endpoints) {
+        QJsonObject entry = ep.stats.toJson();
+        entry["open"] = ep.link != nullptr;
+        entry["leases"] = ep.leases;
+        if (!ep.lastError.isEmpty()) {
+            entry["last_error"] = ep.lastError;
+        }
+        if (const qint64 waitMs = remainingBackoffMs(ep); waitMs > 0) {
+            entry["reconnect_in_ms"] = waitMs;
+        }
+        out[name] = entry;
+    }
+    return out;
+}
+
+void FieldbusTransport::updateMaintenanceTimer() {
+    bool needed = false;
+    if (m_options.idleCloseMs > 0) {
+        for (const auto& [name, ep] : m_endpoints) {
+            if (ep.link) {
+                needed = true;
+                break;
+            }
+        }
+    }
+    if (needed && !m_maintenance->isActive()) {
+        m_maintenance->start();
+    } else if (!needed && m_maintenance->isActive()) {
+        m_maintenance->stop();
+    }
+}
+
+} // namespace stdiolink
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <array>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include "stdiolink/stdiolink_export.h"
+
+class QTimer;
+
+namespace stdiolink {
+
+/**
+ * 帧间静默控制
+ *
+ * RTU 帧之间须保持至少 T3.5 的线路静默。只在距上一帧结束不足间隔时补足剩余
+ * 时长，请求之间已有的处理耗时不再重复等待。
+ */
+class STDIOLINK_API FieldbusPacer {
+public:
+    explicit FieldbusPacer(qint64 gapUs = 0);
+
+    void setGapUs(qint64 gapUs);
+    qint64 gapUs() const { return m_gapUs; }
+
+    /** 阻塞至距上一帧结束满 gapUs，返回实际等待的微秒数 */
+    qint64 waitForGap();
+
+    /** 一帧收发完成（含超时放弃）后调用，作为下一次静默计时的起点 */
+    void markFrameEnd();
+
+    /** 遗忘上一帧，下一次 waitForGap 按完整间隔等待（链路刚打开时使用） */
+    void reset();
+
+private:
+    qint64 m_gapUs = 0;
+    QElapsedTimer m_sinceFrameEnd;
+};
+
+/**
+ * 单个端点的链路与调度统计
+ */
+struct STDIOLINK_API FieldbusStats {
+    // 往返耗时直方图各桶上界（毫秒），最后一桶收纳超出 2000ms 的样本
+    static constexpr std::array<int, 11> kRttBucketUpperMs{
+        1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000};
+    static constexpr int kRttBucketCount = static_cast<int>(kRttBucketUpperMs.size()) + 1;
+
+    qint64 transactions = 0;   // 已归还的租用次数
+    qint64 linkErrors = 0;     // 使用中或探活后发现链路失效的次数
+    qint64 opens = 0;          // 成功打开链路次数
+    qint64 openFailures = 0;   // 打开失败次数（含退避期内被拒绝前的那次）
+    qint64 idleCloses = 0;     // 空闲超时关闭次数
+    qint64 probeFailures = 0;  // 空闲后探活失败次数
+    int queueDepth = 0;        // 当前排队任务数
+    int maxQueueDepth = 0;     // 排队任务数峰值
+    qint64 rttTotalUs = 0;
+    qint64 rttMaxUs = 0;
+    std::array<qint64, kRttBucketCount> rttBuckets{};
+
+    void recordRoundTrip(qint64 us);
+    QJsonObject toJson() const;
+};
+
+/**
+ * 现场总线传输层
+ *
+ * 按端点（"host:port" 或串口名）缓存链路供多条命令复用，并提供：
+ * - 打开失败后指数退避，退避期内原样返回上次的错误，不再反复阻塞重连；
+ * - 空闲超过 probeAfterIdleMs 的链路租出前先探活，失效则重新打开；
+ * - 空闲超过 idleCloseMs 的链路由后台定时器关闭，释放串口或套接字；
+ * - 端点内按优先级排队、同优先级先进先出，多个端点之间轮转，
+ *   每次事件循环只执行一个任务，使 stdin 上的新命令能插入到后台轮询之间；
+ * - 队列深度、打开/失效计数与往返耗时直方图。
+ *
+ * 链路以类型擦除的 shared_ptr<void> 保存，驱动一般通过 FieldbusPool<Client> 使用。
+ * 同一端点的链路参数（波特率、校验等）以 signature 区分，链路打开期间以不同参数
+ * 访问同一端点会被拒绝。
+ * 非线程安全，只能在创建它的线程（事件循环所在线程）使用。
+ */
+class STDIOLINK_API FieldbusTransport {
+public:
+    struct Options {
+        int idleCloseMs = 60000;           // 空闲超过该时长自动关闭，0 表示不关闭
+        int probeAfterIdleMs = 5000;       // 空闲超过该时长再租出前先探活，0 表示每次探活
+        int reconnectBackoffMs = 500;      // 首次打开失败后的退避时长，0 表示不退避
+        int maxReconnectBackoffMs = 10000; // 连续失败时退避翻倍的上限
+    };
+
+    enum class Priority { High = 0, Normal = 1, Low = 2 };
+
+    using Link = std::shared_ptr<void>;
+    using Opener = std::function<Link(QString& error)>;
+    using LinkCheck = std::function<bool(void* link)>;
+    using Task = std::function<void()>;
+
+    /**
+     * 链路租约：持有期间链路不会被空闲关闭，析构时归还并记录往返耗时
+     */
+    class STDIOLINK_API Lease {
+    public:
+        Lease() = default;
+        ~Lease();
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        void* link() const { return m_link.get(); }
+        explicit operator bool() const { return m_link != nullptr; }
+
+        /** 提前归还，之后 link() 返回 nullptr */
+        void release();
+
+    private:
+        friend class FieldbusTransport;
+        Lease(FieldbusTransport* owner, const QString& endpoint, Link link);
+
+        FieldbusTransport* m_owner = nullptr;
+        QString m_endpoint;
+        Link m_link;
+        QElapsedTimer m_elapsed;
+    };
+
+    explicit FieldbusTransport(LinkCheck isAlive, const Options& options = Options());
+    virtual ~FieldbusTransport();
+
+    FieldbusTransport(const FieldbusTransport&) = delete;
+    FieldbusTransport& operator=(const FieldbusTransport&) = delete;
+
+    void setOptions(const Options& options);
+    const Options& options() const { return m_options; }
+
+    /** 设置空闲探活函数；未设置时只检查 isAlive */
+    void setLinkProbe(LinkCheck probe) { m_probe = std::move(probe); }
+
+    /**
+     * 租用端点链路；没有可用链路时调用 opener 打开
+     * @return 失败时返回空租约，原因写入 error
+     */
+    Lease acquireLink(const QString& endpoint, const QString& signature,
+                      const Opener& opener, QString& error);
+
+    /** 将任务排入端点队列，由事件循环按优先级与端点轮转逐个执行 */
+    void post(const QString& endpoint, Priority priority, Task task);
+
+    int queueDepth(const QString& endpoint) const;
+
+    /** 端点剩余的重连退避时长（毫秒），不在退避期时为 0 */
+    qint64 reconnectInMs(const QString& endpoint) const;
+
+    /** 关闭端点链路；已租出的链路在租约归还后释放，排队任务不受影响 */
+    void close(const QString& endpoint);
+    void closeAll();
+
+    /** 关闭空闲超过 idleCloseMs 的链路，返回关闭数量；后台定时器每秒调用一次 */
+    int closeIdle();
+
+    FieldbusStats stats(const QString& endpoint) const;
+    QStringList endpoints() const;
+
+    /** {endpoint: {open, leases, ..., rtt_histogram_ms}}，供 status 命令上报 */
+    QJsonObject statsJson() const;
+
+private:
+    struct Endpoint {
+        Link link;
+        QString signature;
+        int leases = 0;
+        QElapsedTimer lastUsed;
+        QString lastError;
+        QElapsedTimer failedAt;
+        int backoffMs = 0;
+        std::array<std::deque<Task>, 3> queues;
+        FieldbusStats stats;
+    };
+
+    static qint64 remainingBackoffMs(const Endpoint& ep);
+    void releaseLink(const QString& endpoint, const Link& link, qint64 elapsedUs);
+    void dispatchOne();
+    void updateMaintenanceTimer();
+
+    LinkCheck m_isAlive;
+    LinkCheck m_probe;
+    Options m_options;
+    std::map<QString, Endpoint> m_endpoints;
+    std::deque<QString> m_ready;           // 有排队任务的端点，按轮转顺序
+    std::unique_ptr<QTimer> m_dispatcher;  // 0ms 单次定时器，每次执行一个任务
+    std::unique_ptr<QTimer> m_maintenance; // 空闲关闭
+};
+
+/**
+ * 按客户端类型包装的 FieldbusTransport
+ *
+ * @code
+ * FieldbusPool<ModbusClient> pool([](ModbusClient& c) { return c.isConnected(); });
+ * auto lease = pool.acquire("127.0.0.1:502", QString(), opener, error);
+ * if (lease) lease->readHoldingRegisters(0, 10);
+ * @endcode
+ */
+template <typename Client>
+class FieldbusPool : public FieldbusTransport {
+public:
+    using ClientOpener = std::function<std::shared_ptr<Client>(QString& error)>;
+    using ClientCheck = std::function<bool(Client& client)>;
+
+    class Lease {
+    public:
+        Lease() = default;
+        explicit Lease(FieldbusTransport::Lease lease) : m_lease(std::move(lease)) {}
+
+        Client* get() const { return static_cast<Client*>(m_lease.link()); }
+        Client* operator->() const { return get(); }
+        explicit operator bool() const { return static_cast<bool>(m_lease); }
+        void release() { m_lease.release(); }
+
+    private:
+        FieldbusTransport::Lease m_lease;
+    };
+
+    explicit FieldbusPool(ClientCheck isAlive, const Options& options = Options())
+        : FieldbusTransport(wrap(std::move(isAlive)), options) {}
+
+    void setProbe(ClientCheck probe) { setLinkProbe(wrap(std::move(probe))); }
+
+    Lease acquire(const QString& endpoint, const QString& signature,
+                  const ClientOpener& opener, QString& error) {
+        return Lease(acquireLink(endpoint, signature,
+                                 [&opener](QString& err) -> Link { return opener(err); },
+                                 error));
+    }
+
+private:
+    static LinkCheck wrap(ClientCheck check) {
+        return [check = std::move(check)](void* link) {
+            return check(*static_cast<Client*>(link));
+        };
+    }
+};
+
+} // namespace stdiolink
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QByteArray>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QString>
@@ -43,6 +44,34 @@ public:
      * 输出错误
      */
     virtual void error(int code, const QJsonValue& payload) = 0;
+
+    /**
+     * 是否能以二进制侧信道帧输出附件（仅当 Host 声明支持时为 true）
+     * 为 false 时 eventBlob/doneBlob 回退为 payload 内的 base64 字段
+     */
+    virtual bool supportsBlobFrames() const { return false; }
+
+    /**
+     * 输出带二进制附件的中间事件
+     * 默认实现：附件以 base64 写入 payload 对象的 "blob_base64" 字段
+     */
+    virtual void eventBlob(int code, const QJsonValue& payload, const QByteArray& blob) {
+        event(code, inlineBlob(payload, blob));
+    }
+
+    /**
+     * 输出带二进制附件的成功完成，默认实现同 eventBlob
+     */
+    virtual void doneBlob(int code, const QJsonValue& payload, const QByteArray& blob) {
+        done(code, inlineBlob(payload, blob));
+    }
+
+protected:
+    static QJsonObject inlineBlob(const QJsonValue& payload, const QByteArray& blob) {
+        QJsonObject obj = payload.toObject();
+        obj["blob_base64"] = QString::fromLatin1(blob.toBase64());
+        return obj;
+    }
 };
 
 } // namespace stdiolink
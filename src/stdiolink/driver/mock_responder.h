@@ -20,6 +20,9 @@ public:
     };
 
     std::vector<Response> responses;
+    bool blobFrames = false; // 模拟 Host 已声明支持二进制侧信道帧
+
+    bool supportsBlobFrames() const override { return blobFrames; }
 
     void event(int code, const QJsonValue& payload) override {
         responses.push_back({"event", code, payload, "default"});
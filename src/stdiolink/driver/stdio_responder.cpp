@@ -1,9 +1,153 @@
 #include "stdio_responder.h"
+#include <QCoreApplication>
 #include <QFile>
+#include <QMutex>
+#include <QTimer>
+#include <atomic>
 #include "stdiolink/protocol/jsonl_serializer.h"
 
 namespace stdiolink {
 
+namespace {
+
+thread_local QString t_currentRequestId;
+
+std::atomic<int> g_blobFrames{-1}; // -1 未初始化，0/1 为是否启用
+
+// 进程级 stdout 写出器：按 FlushPolicy 决定逐帧 flush 还是合并 event 帧。
+class StdoutWriter {
+public:
+    static StdoutWriter& instance() {
+        static StdoutWriter writer;
+        return writer;
+    }
+
+    ~StdoutWriter() { flushLocked(); }
+
+    void write(const QString& status, int code, const QJsonValue& payload, const QString& id) {
+        QMutexLocker lock(&m_mutex);
+        appendResponse(m_buffer, status, code, payload, id);
+
+        const bool terminal = status != QLatin1String("event");
+        if (!m_policy.coalesceEvents || terminal || m_buffer.size() >= m_policy.maxBufferBytes) {
+            flushLocked();
+            return;
+        }
+        armTimerLocked();
+    }
+
+    // 侧信道帧：先写出缓冲中的帧保证顺序，再直接写头部与附件，避免把大块数据拷进缓冲
+    void writeBlob(const QString& status, int code, const QJsonValue& payload, const QString& id,
+                   const QByteArray& blob) {
+        QMutexLocker lock(&m_mutex);
+        appendBlobHeader(m_buffer, status, code, payload, id, blob.size());
+        flushLocked(&blob);
+    }
+
+    void flush() {
+        QMutexLocker lock(&m_mutex);
+        flushLocked();
+    }
+
+    void setPolicy(const StdioResponder::FlushPolicy& policy) {
+        QMutexLocker lock(&m_mutex);
+        m_policy = policy;
+        if (!m_policy.coalesceEvents) {
+            flushLocked();
+        }
+    }
+
+    StdioResponder::FlushPolicy policy() {
+        QMutexLocker lock(&m_mutex);
+        return m_policy;
+    }
+
+private:
+    void flushLocked(const QByteArray* blob = nullptr) {
+        if (m_buffer.isEmpty()) {
+            return;
+        }
+        if (!m_output.isOpen()) {
+            (void)m_output.open(stdout, QIODevice::WriteOnly);
+        }
+        m_output.write(m_buffer);
+        if (blob != nullptr) {
+            m_output.write(*blob);
+        }
+        m_output.flush();
+        m_buffer.resize(0);
+    }
+
+    void armTimerLocked() {
+        if (m_timerArmed) {
+            return;
+        }
+        auto* app = QCoreApplication::instance();
+        if (app == nullptr) {
+            flushLocked();
+            return;
+        }
+        m_timerArmed = true;
+        QTimer::singleShot(m_policy.maxDelayMs, app, [this]() {
+            QMutexLocker lock(&m_mutex);
+            m_timerArmed = false;
+            flushLocked();
+        });
+    }
+
+    QMutex m_mutex;
+    QFile m_output;
+    QByteArray m_buffer;
+    StdioResponder::FlushPolicy m_policy;
+    bool m_timerArmed = false;
+};
+
+} // namespace
+
+StdioResponder::StdioResponder() : m_requestId(t_currentRequestId) {}
+
+StdioResponder::StdioResponder(const QString& requestId) : m_requestId(requestId) {}
+
+void StdioResponder::setFlushPolicy(const FlushPolicy& policy) {
+    StdoutWriter::instance().setPolicy(policy);
+}
+
+StdioResponder::FlushPolicy StdioResponder::flushPolicy() {
+    return StdoutWriter::instance().policy();
+}
+
+void StdioResponder::flush() {
+    StdoutWriter::instance().flush();
+}
+
+bool StdioResponder::blobFramesEnabled() {
+    int state = g_blobFrames.load(std::memory_order_relaxed);
+    if (state < 0) {
+        state = qEnvironmentVariableIntValue(kBlobFramesEnvVar) == 1 ? 1 : 0;
+        g_blobFrames.store(state, std::memory_order_relaxed);
+        // 协商只对直接父进程有效，读取后清除，避免本进程再启动的子进程继承
+        qunsetenv(kBlobFramesEnvVar);
+    }
+    return state == 1;
+}
+
+void StdioResponder::setBlobFramesEnabled(bool enabled) {
+    g_blobFrames.store(enabled ? 1 : 0, std::memory_order_relaxed);
+}
+
+QString StdioResponder::currentRequestId() {
+    return t_currentRequestId;
+}
+
+StdioResponder::DispatchScope::DispatchScope(const QString& requestId)
+    : m_previous(t_currentRequestId) {
+    t_currentRequestId = requestId;
+}
+
+StdioResponder::DispatchScope::~DispatchScope() {
+    t_currentRequestId = m_previous;
+}
+
 void StdioResponder::event(int code, const QJsonValue& payload) {
     writeResponse("event", code, payload);
 }
@@ -23,15 +167,29 @@ void StdioResponder::error(int code, const QJsonValue& payload) {
     writeResponse("error", code, payload);
 }
 
-void StdioResponder::writeResponse(const QString& status, int code, const QJsonValue& payload) {
-    static QFile output;
-    if (!output.isOpen()) {
-        (void)output.open(stdout, QIODevice::WriteOnly);
+void StdioResponder::eventBlob(int code, const QJsonValue& payload, const QByteArray& blob) {
+    if (!blobFramesEnabled()) {
+        IResponder::eventBlob(code, payload, blob);
+        return;
+    }
+    writeBlobResponse("event", code, payload, blob);
+}
+
+void StdioResponder::doneBlob(int code, const QJsonValue& payload, const QByteArray& blob) {
+    if (!blobFramesEnabled()) {
+        IResponder::doneBlob(code, payload, blob);
+        return;
     }
+    writeBlobResponse("done", code, payload, blob);
+}
 
-    QByteArray data = serializeResponse(status, code, payload);
-    output.write(data);
-    output.flush();
+void StdioResponder::writeBlobResponse(const QString& status, int code, const QJsonValue& payload,
+                                       const QByteArray& blob) {
+    StdoutWriter::instance().writeBlob(status, code, payload, m_requestId, blob);
+}
+
+void StdioResponder::writeResponse(const QString& status, int code, const QJsonValue& payload) {
+    StdoutWriter::instance().write(status, code, payload, m_requestId);
 }
 
 } // namespace stdiolink
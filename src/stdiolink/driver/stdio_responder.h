@@ -3,24 +3,85 @@
 #include "stdiolink/stdiolink_export.h"
 
 #include <QJsonValue>
+#include <QString>
 #include "iresponder.h"
 
 namespace stdiolink {
 
 /**
  * StdIO 响应器
+ *
+ * 默认构造时捕获 DriverCore 当前正在分发的请求 ID（见 currentRequestId()），
+ * 因此 handler 内部为异步回包 new 出来的响应器也能正确回显 ID。
  */
 class STDIOLINK_API StdioResponder : public IResponder {
 public:
-    StdioResponder() = default;
+    StdioResponder();
+    explicit StdioResponder(const QString& requestId);
 
     void event(int code, const QJsonValue& payload) override;
     void event(const QString& eventName, int code, const QJsonValue& data) override;
     void done(int code, const QJsonValue& payload) override;
     void error(int code, const QJsonValue& payload) override;
 
+    bool supportsBlobFrames() const override { return blobFramesEnabled(); }
+    void eventBlob(int code, const QJsonValue& payload, const QByteArray& blob) override;
+    void doneBlob(int code, const QJsonValue& payload, const QByteArray& blob) override;
+
+    /**
+     * Host 是否声明支持二进制侧信道帧（见 kBlobFramesEnvVar），进程内只读取一次环境变量，
+     * 读取后即从本进程环境中移除
+     */
+    static bool blobFramesEnabled();
+    static void setBlobFramesEnabled(bool enabled);
+
+    QString requestId() const { return m_requestId; }
+
+    /**
+     * stdout 刷新策略（进程级，所有 StdioResponder 共享同一输出缓冲）
+     * 默认每帧立即写出并 flush；开启 coalesceEvents 后 event 帧先进缓冲，
+     * 在 done/error、缓冲达到 maxBufferBytes 或 maxDelayMs 定时器到期时统一写出。
+     */
+    struct FlushPolicy {
+        bool coalesceEvents = false;
+        qsizetype maxBufferBytes = 64 * 1024;
+        int maxDelayMs = 5;
+    };
+
+    static void setFlushPolicy(const FlushPolicy& policy);
+    static FlushPolicy flushPolicy();
+
+    /**
+     * 立即写出所有缓冲中的帧
+     */
+    static void flush();
+
+    /**
+     * 当前线程正在分发的请求 ID（仅在 ICommandHandler::handle 调用期间有效）
+     */
+    static QString currentRequestId();
+
+    /**
+     * 请求分发作用域，由 DriverCore 在调用 handler 前后设置/恢复当前请求 ID
+     */
+    class STDIOLINK_API DispatchScope {
+    public:
+        explicit DispatchScope(const QString& requestId);
+        ~DispatchScope();
+
+        DispatchScope(const DispatchScope&) = delete;
+        DispatchScope& operator=(const DispatchScope&) = delete;
+
+    private:
+        QString m_previous;
+    };
+
 private:
-    static void writeResponse(const QString& status, int code, const QJsonValue& payload);
+    void writeResponse(const QString& status, int code, const QJsonValue& payload);
+    void writeBlobResponse(const QString& status, int code, const QJsonValue& payload,
+                           const QByteArray& blob);
+
+    QString m_requestId;
 };
 
 } // namespace stdiolink
@@ -1,7 +1,6 @@
 #include "driver.h"
 #include <QCoreApplication>
 #include <QDir>
-#include <QJsonDocument>
 #include <QProcessEnvironment>
 #include "meta_cache.h"
 #include "stdiolink/protocol/jsonl_serializer.h"
@@ -10,6 +9,7 @@ namespace stdiolink {
 
 Driver::~Driver() {
     terminate();
+    detachTasks(1001, QStringLiteral("driver instance destroyed"));
 }
 
 bool Driver::start(const QString& program, const QStringList& args) {
@@ -43,6 +43,8 @@ bool Driver::start(const QString& program, const QStringList& args) {
 #endif
     const QString existing = env.value(pathKey);
     env.insert(pathKey, existing.isEmpty() ? binDir : binDir + QDir::listSeparator() + existing);
+    // 声明本 Host 能解析二进制侧信道帧
+    env.insert(QString::fromLatin1(kBlobFramesEnvVar), QStringLiteral("1"));
     m_proc.setProcessEnvironment(env);
 
     m_treeGuard.prepareProcess(&m_proc);
@@ -84,39 +86,68 @@ QString Driver::exitContext() const {
 }
 
 Task Driver::request(const QString& cmd, const QJsonObject& data) {
-    m_cur = std::make_shared<TaskState>();
-
-    QJsonObject req;
-    req["cmd"] = cmd;
-    if (!data.isEmpty())
-        req["data"] = data;
+    auto state = std::make_shared<TaskState>();
+    if (m_pipelining) {
+        state->requestId = QString::number(++m_nextRequestId);
+    } else {
+        // 非流水线模式：新请求取代旧请求，并丢弃旧请求的残留输出
+        m_inFlight.clear();
+        m_inFlightById.clear();
+        resetStdout();
+    }
+    m_cur = state;
 
-    QByteArray line = QJsonDocument(req).toJson(QJsonDocument::Compact);
-    line.append('\n');
+    const QByteArray line = serializeRequest(cmd, data.isEmpty() ? QJsonValue() : QJsonValue(data),
+                                             state->requestId);
     const qint64 written = m_proc.write(line);
     if (written < 0) {
-        pushError(1001, QJsonObject{
-                            {"message", "failed to write request: " + exitContext()},
-                        });
+        pushError(state, 1001, QJsonObject{
+                                   {"message", "failed to write request: " + exitContext()},
+                               });
     } else {
         // Best-effort flush: avoid blocking up to 1s when process is already gone.
         if (m_proc.state() == QProcess::Running) {
             m_proc.waitForBytesWritten(10);
         }
-        if (m_proc.state() != QProcess::Running && !m_cur->terminal) {
-            pushError(1001, QJsonObject{
-                                {"message", "driver process exited while sending request: "
-                                                + exitContext()},
-                            });
+        if (m_proc.state() != QProcess::Running && !state->terminal) {
+            pushError(state, 1001, QJsonObject{
+                                       {"message", "driver process exited while sending request: "
+                                                       + exitContext()},
+                                   });
         }
     }
 
-    m_buf.clear();
+    if (!state->terminal) {
+        m_inFlight.push_back(state);
+        if (!state->requestId.isEmpty()) {
+            m_inFlightById.insert(state->requestId, state);
+        }
+    }
 
-    return {this, m_cur};
+    return {this, state};
+}
+
+void Driver::detachTasks(int code, const QString& message) {
+    const QJsonObject payload{{"message", message}};
+    for (const auto& state : m_inFlight) {
+        if (!state->terminal) {
+            pushError(state, code, payload);
+        }
+    }
+    m_inFlight.clear();
+    m_inFlightById.clear();
+    m_cur.reset();
+    resetStdout();
+    // 替换存活标记：旧句柄持有的 weak_ptr 随之失效
+    m_lifetime = std::make_shared<int>(0);
 }
 
 bool Driver::hasQueued() const {
+    for (const auto& state : m_inFlight) {
+        if (!state->queue.empty()) {
+            return true;
+        }
+    }
     return m_cur && !m_cur->queue.empty();
 }
 
@@ -124,72 +155,138 @@ bool Driver::isCurrentTerminal() const {
     return m_cur && m_cur->terminal;
 }
 
-bool Driver::tryReadLine(QByteArray& outLine) {
-    int idx = m_buf.indexOf('\n');
-    if (idx < 0)
-        return false;
-    outLine = m_buf.left(idx);
-    m_buf.remove(0, idx + 1);
-    return true;
+std::shared_ptr<TaskState> Driver::routeResponse(const Message& msg) const {
+    if (m_inFlight.empty()) {
+        return nullptr;
+    }
+    // 未回显 id（旧版 Driver 或非流水线模式）：按发送顺序归属最早的在途请求
+    if (msg.id.isEmpty()) {
+        return m_inFlight.front();
+    }
+    // 未知 id 通常是已被放弃请求的迟到响应，直接丢弃而不是错投给其他请求
+    return m_inFlightById.value(msg.id);
+}
+
+void Driver::retireInFlight(const std::shared_ptr<TaskState>& state) {
+    if (!state->requestId.isEmpty()) {
+        m_inFlightById.remove(state->requestId);
+    }
+    for (auto it = m_inFlight.begin(); it != m_inFlight.end(); ++it) {
+        if (*it == state) {
+            m_inFlight.erase(it);
+            break;
+        }
+    }
+    if (m_cur == state) {
+        m_cur.reset();
+    }
 }
 
-void Driver::pushError(int code, const QJsonObject& payload) {
-    Message msg{"error", code, payload};
-    m_cur->queue.push_back(msg);
-    m_cur->terminal = true;
-    m_cur->exitCode = code;
-    m_cur->finalPayload = payload;
+void Driver::pushError(const std::shared_ptr<TaskState>& state, int code,
+                       const QJsonObject& payload) {
+    Message msg{"error", code, payload, state->requestId};
+    state->queue.push_back(msg);
+    state->terminal = true;
+    state->exitCode = code;
+    state->finalPayload = payload;
 
     if (payload.contains("message")) {
-        m_cur->errorText = payload["message"].toString();
+        state->errorText = payload["message"].toString();
     }
 }
 
 void Driver::pumpStdout() {
-    if (!m_cur)
+    if (m_inFlight.empty())
         return;
 
-    m_buf.append(m_proc.readAllStandardOutput());
+    m_stdout.append(m_proc.readAllStandardOutput());
 
-    if (m_buf.size() > kMaxOutputBufferBytes) {
-        pushError(1002, QJsonObject{
-                            {"message", "output buffer overflow"},
-                            {"channel", "stdout"},
-                            {"limit", kMaxOutputBufferBytes},
-                        });
-        m_buf.clear();
-        return;
-    }
+    QByteArrayView view;
+    while (!m_inFlight.empty()) {
+        if (m_blobPending >= 0) {
+            if (!m_stdout.takeBytes(m_blobPending, view)) {
+                break;
+            }
+            Message msg = std::move(m_blobMsg);
+            msg.blob = view.toByteArray();
+            m_blobMsg = Message{};
+            m_blobPending = -1;
+            deliverResponse(msg);
+            continue;
+        }
 
-    QByteArray line;
-    while (tryReadLine(line)) {
+        if (!m_stdout.nextLine(view)) {
+            break;
+        }
+        const QByteArray line = QByteArray::fromRawData(view.data(), view.size());
         Message msg;
-        if (!parseResponse(line, msg)) {
-            pushError(1000, QJsonObject{{"message", "invalid response"},
-                                        {"raw", QString::fromUtf8(line)}});
+        qint64 blobSize = -1;
+        if (!parseResponse(line, msg, &blobSize) || blobSize > kMaxBlobBytes) {
+            const auto state = m_inFlight.front();
+            pushError(state, 1000, QJsonObject{{"message", "invalid response"},
+                                               {"raw", QString::fromUtf8(line)}});
+            retireInFlight(state);
             return;
         }
 
-        m_cur->queue.push_back(msg);
+        if (blobSize >= 0) {
+            // 头部之后紧跟 blobSize 字节原始数据，收齐后再随该帧一起投递
+            m_blobMsg = std::move(msg);
+            m_blobPending = blobSize;
+            continue;
+        }
+        deliverResponse(msg);
+    }
+
+    // 完整帧都已取走，剩余的是未完整的尾行或正在接收的附件；
+    // 附件不计入输出缓冲上限，其长度已由 kMaxBlobBytes 约束
+    const qint64 blobReserve = m_blobPending > 0 ? m_blobPending : 0;
+    if (m_stdout.pendingSize() - blobReserve > kMaxOutputBufferBytes) {
+        const QJsonObject payload{
+            {"message", "output buffer overflow"},
+            {"channel", "stdout"},
+            {"limit", kMaxOutputBufferBytes},
+        };
+        for (const auto& state : m_inFlight) {
+            pushError(state, 1002, payload);
+        }
+        m_inFlight.clear();
+        m_inFlightById.clear();
+        resetStdout();
+    }
+}
+
+void Driver::deliverResponse(const Message& msg) {
+    const auto state = routeResponse(msg);
+    if (!state) {
+        return;
+    }
 
-        if (msg.status == "done" || msg.status == "error") {
-            m_cur->terminal = true;
-            m_cur->exitCode = msg.code;
-            m_cur->finalPayload = msg.payload;
+    state->queue.push_back(msg);
 
-            if (msg.status == "error" && msg.payload.isObject()) {
-                auto obj = msg.payload.toObject();
-                if (obj.contains("message")) {
-                    m_cur->errorText = obj["message"].toString();
-                }
-            }
+    if (msg.status == "done" || msg.status == "error") {
+        state->terminal = true;
+        state->exitCode = msg.code;
+        state->finalPayload = msg.payload;
+        state->finalBlob = msg.blob;
 
-            m_cur.reset();
-            break;
+        if (msg.status == "error" && msg.payload.isObject()) {
+            auto obj = msg.payload.toObject();
+            if (obj.contains("message")) {
+                state->errorText = obj["message"].toString();
+            }
         }
+
+        retireInFlight(state);
     }
 }
 
+void Driver::resetStdout() {
+    m_stdout.clear();
+    m_blobMsg = Message{};
+    m_blobPending = -1;
+}
+
 const meta::DriverMeta* Driver::queryMeta(int timeoutMs) {
     if (m_meta) {
         return m_meta.get();
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <QHash>
 #include <QJsonObject>
 #include <QProcess>
+#include <deque>
 #include <memory>
 #include "stdiolink/guard/process_guard_server.h"
 #include "stdiolink/guard/process_tree_guard.h"
 #include "stdiolink/protocol/jsonl_types.h"
+#include "stdiolink/protocol/line_framer.h"
 #include "stdiolink/protocol/meta_types.h"
 #include "stdiolink/stdiolink_export.h"
 #include "task.h"
@@ -39,6 +42,26 @@ public:
     bool hasQueued() const;
     bool isCurrentTerminal() const;
 
+    /**
+     * 请求流水线（协议扩展，默认关闭）
+     * 开启后每个请求携带唯一 id，request() 不再取代在途请求；
+     * pumpStdout() 按响应帧回显的 id 路由到对应 Task。
+     * 未回显 id 的旧版 Driver 按 FIFO 归属到最早的在途请求。
+     */
+    void setPipeliningEnabled(bool enabled) { m_pipelining = enabled; }
+    bool isPipeliningEnabled() const { return m_pipelining; }
+    int inFlightCount() const { return static_cast<int>(m_inFlight.size()); }
+
+    /**
+     * 使已发出的 Task 句柄与本实例脱离
+     * 在途请求以 code/message 终止，之后这些句柄的 owner() 返回 nullptr，
+     * 不再读取本实例。归还进程池或析构前调用，防止句柄访问已复用或已释放的实例。
+     */
+    void detachTasks(int code, const QString& message);
+
+    /** Task 句柄据此判断实例是否仍可访问，detachTasks() 或析构后失效 */
+    std::weak_ptr<void> lifetimeToken() const { return m_lifetime; }
+
     // 元数据查询
     const meta::DriverMeta* queryMeta(int timeoutMs = 5000);
     bool hasMeta() const;
@@ -50,19 +73,31 @@ public:
 #endif
 
     static constexpr qint64 kMaxOutputBufferBytes = 8 * 1024 * 1024; // 8MB
+    static constexpr qint64 kMaxBlobBytes = 512LL * 1024 * 1024;     // 单帧侧信道附件上限
 
 private:
     QProcess m_proc;
-    QByteArray m_buf;
+    LineFramer m_stdout;
 
-    std::shared_ptr<TaskState> m_cur;
+    std::shared_ptr<TaskState> m_cur;                            // 最近一次 request() 的状态
+    std::deque<std::shared_ptr<TaskState>> m_inFlight;           // 按发送顺序排列的在途请求
+    QHash<QString, std::shared_ptr<TaskState>> m_inFlightById;   // 流水线模式 id 索引
+    bool m_pipelining = false;
+    quint64 m_nextRequestId = 0;
     std::shared_ptr<meta::DriverMeta> m_meta;
     std::unique_ptr<ProcessGuardServer> m_guard;
     ProcessTreeGuard m_treeGuard;
     QString m_guardNameOverride;
+    Message m_blobMsg;         // 已解析头部、等待附件字节的响应帧
+    qint64 m_blobPending = -1; // 待读取的附件字节数，-1 表示当前不在读附件
+    std::shared_ptr<int> m_lifetime = std::make_shared<int>(0);
 
-    bool tryReadLine(QByteArray& outLine);
-    void pushError(int code, const QJsonObject& payload);
+    std::shared_ptr<TaskState> routeResponse(const Message& msg) const;
+    void retireInFlight(const std::shared_ptr<TaskState>& state);
+    void deliverResponse(const Message& msg);
+    void resetStdout();
+    static void pushError(const std::shared_ptr<TaskState>& state, int code,
+                          const QJsonObject& payload);
 };
 
 } // namespace stdiolink
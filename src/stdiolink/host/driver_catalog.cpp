@@ -91,10 +91,25 @@ QString DriverScanner::findExecutableInDirectory(const QString& dirPath) {
 
 void DriverCatalog::replaceAll(const QHash<QString, DriverConfig>& drivers) {
     m_drivers = drivers;
+    ++m_revision;
+}
+
+void DriverCatalog::upsert(const DriverConfig& config) {
+    m_drivers.insert(config.id, config);
+    ++m_revision;
+}
+
+bool DriverCatalog::remove(const QString& id) {
+    if (m_drivers.remove(id) == 0) {
+        return false;
+    }
+    ++m_revision;
+    return true;
 }
 
 void DriverCatalog::clear() {
     m_drivers.clear();
+    ++m_revision;
 }
 
 QStringList DriverCatalog::listDrivers() const {
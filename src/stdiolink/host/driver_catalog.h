@@ -48,6 +48,8 @@ private:
 class STDIOLINK_API DriverCatalog {
 public:
     void replaceAll(const QHash<QString, DriverConfig>& drivers);
+    void upsert(const DriverConfig& config);
+    bool remove(const QString& id);
     void clear();
 
     QStringList listDrivers() const;
@@ -57,8 +59,12 @@ public:
     bool healthCheck(const QString& id) const;
     void healthCheckAll() const;
 
+    /// 内容修订号，每次修改目录后递增，供调用方判断缓存是否过期
+    quint64 revision() const { return m_revision; }
+
 private:
     QHash<QString, DriverConfig> m_drivers;
+    quint64 m_revision = 0;
 };
 
 } // namespace stdiolink
@@ -0,0 +1,218 @@
+#include "driver_pool.h"
+
+#include <QTimer>
+#include <algorithm>
+#include "driver.h"
+
+namespace stdiolink {
+
+namespace {
+
+constexpr int kMaintenanceIntervalMs = 1000;
+
+} // namespace
+
+DriverPool::DriverPool()
+    : m_maintenance(std::make_unique<QTimer>()) {
+    m_maintenance->setInterval(kMaintenanceIntervalMs);
+    QObject::connect(m_maintenance.get(), &QTimer::timeout, m_maintenance.get(),
+                     [this]() { maintain(); });
+}
+
+DriverPool::~DriverPool() {
+    m_maintenance->stop();
+    clear();
+}
+
+QString DriverPool::keyFor(const QString& program, const QStringList& args) {
+    QString key = program;
+    for (const QString& arg : args) {
+        key += QChar(u'\0');
+        key += arg;
+    }
+    return key;
+}
+
+bool DriverPool::isReusable(Driver& driver) {
+    driver.pumpStdout();
+    return driver.isRunning() && driver.inFlightCount() == 0;
+}
+
+bool DriverPool::probe(Driver& driver, int timeoutMs) {
+    // 直接发 meta.describe 而不走 queryMeta()：后者命中缓存时不会与进程交互。
+    // 只验证进程仍在应答，未实现元数据的 Driver 返回的 error 同样视为健康
+    Task task = driver.request("meta.describe", QJsonObject{});
+    Message msg;
+    return task.waitNext(msg, timeoutMs) && msg.status != "event" && driver.isRunning();
+}
+
+DriverPool::Slot& DriverPool::slotFor(const QString& program, const QStringList& args) {
+    const QString key = keyFor(program, args);
+    auto it = m_slots.find(key);
+    if (it == m_slots.end()) {
+        Slot slot;
+        slot.program = program;
+        slot.args = args;
+        slot.options = m_defaults;
+        it = m_slots.emplace(key, std::move(slot)).first;
+    }
+    return it->second;
+}
+
+std::unique_ptr<Driver> DriverPool::spawn(Slot& slot, QString* error) {
+    auto driver = std::make_unique<Driver>();
+    if (!driver->start(slot.program, slot.args)) {
+        if (error) {
+            *error = QStringLiteral("failed to start driver: %1").arg(slot.program);
+        }
+        return nullptr;
+    }
+    ++slot.stats.created;
+    return driver;
+}
+
+bool DriverPool::warm(Slot& slot) {
+    bool ok = true;
+    while (static_cast<int>(slot.idle.size()) < slot.options.minWarm) {
+        auto driver = spawn(slot, nullptr);
+        if (!driver) {
+            ok = false;
+            break;
+        }
+        IdleDriver entry;
+        entry.driver = std::move(driver);
+        entry.idleSince.start();
+        slot.idle.push_back(std::move(entry));
+    }
+    slot.stats.idle = static_cast<int>(slot.idle.size());
+    updateMaintenanceTimer();
+    return ok;
+}
+
+bool DriverPool::configure(const QString& program, const QStringList& args,
+                           const Options& options) {
+    Slot& slot = slotFor(program, args);
+    slot.options = options;
+    slot.options.minWarm = std::max(0, options.minWarm);
+    slot.options.maxWarm = std::max(slot.options.minWarm, options.maxWarm);
+    while (static_cast<int>(slot.idle.size()) > slot.options.maxWarm) {
+        slot.idle.pop_front();
+    }
+    return warm(slot);
+}
+
+std::unique_ptr<Driver> DriverPool::acquire(const QString& program, const QStringList& args,
+                                            QString* error) {
+    Slot& slot = slotFor(program, args);
+
+    std::unique_ptr<Driver> driver;
+    while (!slot.idle.empty() && !driver) {
+        // 取最近归还的实例：页缓存与 Driver 内部状态都最热
+        IdleDriver entry = std::move(slot.idle.back());
+        slot.idle.pop_back();
+
+        const bool stale = entry.idleSince.elapsed() >= slot.options.healthCheckAfterIdleMs;
+        if (!isReusable(*entry.driver)
+            || (stale && !probe(*entry.driver, slot.options.healthCheckTimeoutMs))) {
+            ++slot.stats.discarded;
+            continue;
+        }
+        driver = std::move(entry.driver);
+        ++slot.stats.reused;
+    }
+
+    if (!driver) {
+        driver = spawn(slot, error);
+        if (!driver) {
+            slot.stats.idle = static_cast<int>(slot.idle.size());
+            return nullptr;
+        }
+    }
+
+    m_leased.insert(driver.get(), keyFor(program, args));
+    ++slot.stats.leased;
+    slot.stats.idle = static_cast<int>(slot.idle.size());
+    updateMaintenanceTimer();
+    return driver;
+}
+
+void DriverPool::release(std::unique_ptr<Driver> driver) {
+    if (!driver) {
+        return;
+    }
+    const QString key = m_leased.take(driver.get());
+    auto it = m_slots.find(key);
+    if (key.isEmpty() || it == m_slots.end()) {
+        return;  // 非本池租出，随 unique_ptr 析构终止
+    }
+
+    Slot& slot = it->second;
+    --slot.stats.leased;
+    driver->setPipeliningEnabled(false);
+    // 先判断是否可复用（依据在途请求数），再让租用期间发出的 Task 句柄脱离：
+    // 句柄不能再读取即将被销毁或转租给他人的实例
+    const bool reusable = isReusable(*driver);
+    driver->detachTasks(1001, QStringLiteral("lease released"));
+    if (!reusable || static_cast<int>(slot.idle.size()) >= slot.options.maxWarm) {
+        ++slot.stats.discarded;
+        return;
+    }
+
+    IdleDriver entry;
+    entry.driver = std::move(driver);
+    entry.idleSince.start();
+    slot.idle.push_back(std::move(entry));
+    slot.stats.idle = static_cast<int>(slot.idle.size());
+    updateMaintenanceTimer();
+}
+
+DriverPool::Stats DriverPool::stats(const QString& program, const QStringList& args) const {
+    auto it = m_slots.find(keyFor(program, args));
+    return it == m_slots.end() ? Stats{} : it->second.stats;
+}
+
+void DriverPool::clear() {
+    for (auto& [key, slot] : m_slots) {
+        slot.idle.clear();
+        slot.stats.idle = 0;
+    }
+    updateMaintenanceTimer();
+}
+
+void DriverPool::maintain() {
+    for (auto& [key, slot] : m_slots) {
+        // 已退出的空闲实例直接剔除
+        for (auto it = slot.idle.begin(); it != slot.idle.end();) {
+            if (!isReusable(*it->driver)) {
+                ++slot.stats.discarded;
+                it = slot.idle.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        // 头部是最久未用的实例，超出 minWarm 且超时的从头部回收
+        while (static_cast<int>(slot.idle.size()) > slot.options.minWarm
+               && slot.idle.front().idleSince.elapsed() >= slot.options.idleTimeoutMs) {
+            slot.idle.pop_front();
+        }
+        warm(slot);
+    }
+    updateMaintenanceTimer();
+}
+
+void DriverPool::updateMaintenanceTimer() {
+    bool needed = false;
+    for (const auto& [key, slot] : m_slots) {
+        if (!slot.idle.empty() || slot.options.minWarm > 0) {
+            needed = true;
+            break;
+        }
+    }
+    if (needed && !m_maintenance->isActive()) {
+        m_maintenance->start();
+    } else if (!needed && m_maintenance->isActive()) {
+        m_maintenance->stop();
+    }
+}
+
+} // namespace stdiolink
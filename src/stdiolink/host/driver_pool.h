@@ -0,0 +1,110 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QStringList>
+#include <deque>
+#include <map>
+#include <memory>
+#include "stdiolink/stdiolink_export.h"
+
+class QTimer;
+
+namespace stdiolink {
+
+class Driver;
+
+/**
+ * Driver 热进程池
+ *
+ * 按 (program, args) 分组缓存已启动的 Driver 进程，租出/归还代替每次新建进程，
+ * 省去 ProcessGuardServer 创建、环境构造与 waitForStarted 的冷启动开销。
+ * 池中实例应以 keepalive profile 启动，否则一次请求后即退出，归还时会被丢弃。
+ *
+ * 空闲超过 healthCheckAfterIdleMs 的实例在租出前用 meta.describe 探活；
+ * 超出 minWarm 的空闲实例在 idleTimeoutMs 后回收，低于 minWarm 时由后台定时器补齐。
+ * 非线程安全，只能在创建它的线程（事件循环所在线程）使用。
+ */
+class STDIOLINK_API DriverPool {
+public:
+    struct Options {
+        int minWarm = 0;                    // 常驻热实例数
+        int maxWarm = 4;                    // 归还时最多保留的空闲实例数
+        int idleTimeoutMs = 60000;          // 超出 minWarm 的空闲实例存活时长
+        int healthCheckAfterIdleMs = 5000;  // 空闲超过该时长再租出前先探活，0 表示每次探活
+        int healthCheckTimeoutMs = 2000;    // meta.describe 探活超时
+    };
+
+    struct Stats {
+        int idle = 0;
+        int leased = 0;
+        int created = 0;    // 新建进程次数
+        int reused = 0;     // 复用热实例次数
+        int discarded = 0;  // 因退出、忙碌或探活失败被丢弃的实例数
+    };
+
+    DriverPool();
+    ~DriverPool();
+
+    DriverPool(const DriverPool&) = delete;
+    DriverPool& operator=(const DriverPool&) = delete;
+
+    void setDefaultOptions(const Options& options) { m_defaults = options; }
+    const Options& defaultOptions() const { return m_defaults; }
+
+    /**
+     * 设置某组 (program, args) 的池参数并立即预热到 minWarm
+     * @return 预热全部成功返回 true
+     */
+    bool configure(const QString& program, const QStringList& args, const Options& options);
+
+    /**
+     * 租出一个运行中的 Driver；没有可用热实例时新建进程
+     * @return 启动失败返回 nullptr，原因写入 error
+     */
+    std::unique_ptr<Driver> acquire(const QString& program, const QStringList& args,
+                                    QString* error = nullptr);
+
+    /**
+     * 归还租出的 Driver
+     * 进程已退出、仍有在途请求、超出 maxWarm 或并非本池租出时直接终止。
+     * 租用期间发出的 Task 句柄随之脱离，未完成的请求以 1001 "lease released" 终止。
+     */
+    void release(std::unique_ptr<Driver> driver);
+
+    Stats stats(const QString& program, const QStringList& args) const;
+
+    /** 终止所有空闲实例；已租出的实例不受影响 */
+    void clear();
+
+private:
+    struct IdleDriver {
+        std::unique_ptr<Driver> driver;
+        QElapsedTimer idleSince;
+    };
+
+    struct Slot {
+        QString program;
+        QStringList args;
+        Options options;
+        std::deque<IdleDriver> idle;  // 尾部为最近归还的实例
+        Stats stats;
+    };
+
+    static QString keyFor(const QString& program, const QStringList& args);
+    static bool isReusable(Driver& driver);
+    static bool probe(Driver& driver, int timeoutMs);
+
+    Slot& slotFor(const QString& program, const QStringList& args);
+    std::unique_ptr<Driver> spawn(Slot& slot, QString* error);
+    bool warm(Slot& slot);
+    void maintain();
+    void updateMaintenanceTimer();
+
+    Options m_defaults;
+    std::map<QString, Slot> m_slots;
+    QHash<const Driver*, QString> m_leased;  // 租出实例 -> 所属分组
+    std::unique_ptr<QTimer> m_maintenance;    // 空闲回收与补齐 minWarm
+};
+
+} // namespace stdiolink
@@ -6,7 +6,13 @@
 
 namespace stdiolink {
 
-Task::Task(Driver* owner, std::shared_ptr<TaskState> state) : m_drv(owner), m_st(std::move(state)) {}
+Task::Task(Driver* owner, std::shared_ptr<TaskState> state)
+    : m_drv(owner), m_alive(owner ? owner->lifetimeToken() : std::weak_ptr<void>()),
+      m_st(std::move(state)) {}
+
+Driver* Task::owner() const {
+    return m_alive.expired() ? nullptr : m_drv;
+}
 
 bool Task::isValid() const {
     return m_drv != nullptr && m_st != nullptr;
@@ -27,7 +33,11 @@ QString Task::errorText() const {
 }
 
 QJsonValue Task::finalPayload() const {
-    return m_st ? m_st->finalPayload : QJsonValue();
+    return m_st ? m_st->finalPayload.value() : QJsonValue();
+}
+
+QByteArray Task::finalBlob() const {
+    return m_st ? m_st->finalBlob : QByteArray();
 }
 
 bool Task::hasQueued() const {
@@ -47,13 +57,26 @@ void Task::forceTerminal(int code, const QString& error) {
     m_st->queue.push_back(Message{"error", code, payload});
 }
 
+namespace {
+
+QString releasedMessage() {
+    return QStringLiteral("driver instance released before sending a response");
+}
+
+} // namespace
+
 bool Task::tryNext(Message& out) {
     if (!m_st)
         return false;
 
-    if (m_st->queue.empty() && m_drv && !m_st->terminal && !m_drv->isRunning()) {
-        forceTerminal(1001, QStringLiteral("driver process exited without sending a response: %1")
-                                .arg(m_drv->exitContext()));
+    if (m_st->queue.empty() && m_drv && !m_st->terminal) {
+        Driver* drv = owner();
+        if (!drv) {
+            forceTerminal(1001, releasedMessage());
+        } else if (!drv->isRunning()) {
+            forceTerminal(1001, QStringLiteral("driver process exited without sending a response: %1")
+                                    .arg(drv->exitContext()));
+        }
     }
     if (m_st->queue.empty())
         return false;
@@ -66,11 +89,12 @@ bool Task::tryNext(Message& out) {
 bool Task::waitNext(Message& out, int timeoutMs) {
     if (tryNext(out))
         return true;
-    if (!m_st || !m_drv || isDone())
+    Driver* drv = owner();
+    if (!m_st || !drv || isDone())
         return false;
 
     // 先尝试读取已有数据
-    m_drv->pumpStdout();
+    drv->pumpStdout();
     if (tryNext(out))
         return true;
     if (isDone())
@@ -79,27 +103,34 @@ bool Task::waitNext(Message& out, int timeoutMs) {
     QEventLoop loop;
     QTimer timer;
     auto exitedMsg = [&] {
+        Driver* current = owner();
         return QStringLiteral("driver process exited without sending a response: %1")
-            .arg(m_drv ? m_drv->exitContext() : QStringLiteral("program=<unknown>, exitCode=-1, exitStatus=unknown"));
+            .arg(current ? current->exitContext() : QStringLiteral("program=<unknown>, exitCode=-1, exitStatus=unknown"));
     };
 
+    // 嵌套事件循环期间实例可能被归还或销毁，每次回调都重新取 owner()
     auto quitIfReady = [&] {
-        if (m_drv)
-            m_drv->pumpStdout();
-        if (!hasQueued() && !isDone() && m_drv && !m_drv->isRunning()) {
-            forceTerminal(1001, exitedMsg());
+        Driver* current = owner();
+        if (current)
+            current->pumpStdout();
+        if (!hasQueued() && !isDone()) {
+            if (!current) {
+                forceTerminal(1001, releasedMessage());
+            } else if (!current->isRunning()) {
+                forceTerminal(1001, exitedMsg());
+            }
         }
         if (hasQueued() || isDone())
             loop.quit();
     };
 
-    QObject::connect(m_drv->process(), &QProcess::readyReadStandardOutput, &loop, quitIfReady);
-    QObject::connect(m_drv->process(), QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+    QObject::connect(drv->process(), &QProcess::readyReadStandardOutput, &loop, quitIfReady);
+    QObject::connect(drv->process(), QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
                      &loop, quitIfReady);
 
     // Pre-check: 进程可能在建立连接前已退出，此时 finished 信号不会再触发
-    if (!m_drv->isRunning()) {
-        m_drv->pumpStdout();
+    if (!drv->isRunning()) {
+        drv->pumpStdout();
         if (tryNext(out))
             return true;
         forceTerminal(1001, exitedMsg());
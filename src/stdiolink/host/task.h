@@ -22,6 +22,7 @@ public:
     int exitCode() const;
     QString errorText() const;
     QJsonValue finalPayload() const;
+    QByteArray finalBlob() const;
 
     bool tryNext(Message& out);
     bool waitNext(Message& out, int timeoutMs = -1);
@@ -29,10 +30,12 @@ public:
     const TaskState* stateId() const { return m_st.get(); }
     void forceTerminal(int code, const QString& error);
 
-    Driver* owner() const { return m_drv; }
+    /** 所属 Driver；实例已销毁或已调用 detachTasks() 时返回 nullptr */
+    Driver* owner() const;
 
 private:
     Driver* m_drv = nullptr;
+    std::weak_ptr<void> m_alive;
     std::shared_ptr<TaskState> m_st;
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QByteArray>
 #include <QJsonValue>
 #include <QString>
 #include <deque>
@@ -16,8 +17,10 @@ struct TaskState {
     bool terminal = false;     // 是否已收到 done/error
     int exitCode = 0;          // 终态 code
     QString errorText;         // 错误文本
-    QJsonValue finalPayload;   // 终态 payload
+    JsonPayload finalPayload;  // 终态 payload
+    QByteArray finalBlob;      // 终态帧的二进制侧信道附件
     std::deque<Message> queue; // 待取消息队列
+    QString requestId;         // 流水线模式下的请求关联 ID
 };
 
 } // namespace stdiolink
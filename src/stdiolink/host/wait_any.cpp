@@ -59,13 +59,19 @@ bool waitAnyNext(QVector<Task>& tasks, AnyItem& out, int timeoutMs,
                 t.owner()->pumpStdout();
             }
         }
-        // 进程已退出但未收到 terminal 响应 → forceTerminal
+        // 进程已退出或实例已释放但未收到 terminal 响应 → forceTerminal
         for (auto& t : tasks) {
-            if (t.isValid() && !t.isDone() && !t.hasQueued()
-                && t.owner() && !t.owner()->isRunning()) {
+            if (!t.isValid() || t.isDone() || t.hasQueued()) {
+                continue;
+            }
+            Driver* drv = t.owner();
+            if (!drv) {
+                t.forceTerminal(1001, QStringLiteral(
+                                           "driver instance released before sending a response"));
+            } else if (!drv->isRunning()) {
                 t.forceTerminal(1001, QStringLiteral(
                                            "driver process exited without sending a response: %1")
-                                           .arg(t.owner()->exitContext()));
+                                           .arg(drv->exitContext()));
             }
         }
         // 检查是否有消息或全部完成
@@ -0,0 +1,86 @@
+#include "json_payload.h"
+
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+namespace stdiolink {
+
+JsonPayload::JsonPayload(const QJsonValue& value)
+    : m_value(value) {}
+
+JsonPayload::JsonPayload(const QJsonObject& obj)
+    : m_value(obj) {}
+
+JsonPayload::JsonPayload(const QJsonArray& arr)
+    : m_value(arr) {}
+
+JsonPayload JsonPayload::fromRaw(const QByteArray& rawJson) {
+    JsonPayload payload;
+    payload.m_value = QJsonValue(QJsonValue::Undefined);
+    payload.m_raw = rawJson;
+    payload.m_materialized = false;
+    return payload;
+}
+
+const QJsonValue& JsonPayload::value() const {
+    if (!m_materialized) {
+        m_value = parseJsonValue(m_raw);
+        m_raw.clear();
+        m_materialized = true;
+    }
+    return m_value;
+}
+
+bool JsonPayload::isObject() const {
+    // 原始字节由信封扫描器校验过，首字节即可判定类型，无需物化
+    if (!m_materialized) {
+        return m_raw.startsWith('{');
+    }
+    return m_value.isObject();
+}
+
+bool JsonPayload::isArray() const {
+    if (!m_materialized) {
+        return m_raw.startsWith('[');
+    }
+    return m_value.isArray();
+}
+
+bool JsonPayload::isUndefined() const {
+    if (!m_materialized) {
+        return false;
+    }
+    return m_value.isUndefined();
+}
+
+QJsonValue parseJsonValue(QByteArrayView json) {
+    json = json.trimmed();
+    if (json.isEmpty()) {
+        return QJsonValue(QJsonValue::Undefined);
+    }
+
+    QJsonParseError err{};
+    if (json.front() == '{' || json.front() == '[') {
+        const QJsonDocument doc =
+            QJsonDocument::fromJson(QByteArray::fromRawData(json.data(), json.size()), &err);
+        if (err.error != QJsonParseError::NoError) {
+            return QJsonValue(QJsonValue::Undefined);
+        }
+        if (doc.isObject()) {
+            return doc.object();
+        }
+        return doc.array();
+    }
+
+    // QJsonDocument 只接受对象/数组顶层，标量包一层数组再取出
+    QByteArray wrapped;
+    wrapped.reserve(json.size() + 2);
+    wrapped.append('[').append(json).append(']');
+    const QJsonDocument doc = QJsonDocument::fromJson(wrapped, &err);
+    if (err.error != QJsonParseError::NoError || doc.array().size() != 1) {
+        return QJsonValue(QJsonValue::Undefined);
+    }
+    return doc.array().at(0);
+}
+
+} // namespace stdiolink
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "stdiolink/stdiolink_export.h"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+namespace stdiolink {
+
+/**
+ * 延迟解析的 JSON 载荷
+ *
+ * 既可以直接持有 QJsonValue，也可以只持有 data 字段的原始 JSON 字节，
+ * 第一次通过 value()/toObject() 等访问时才物化为 QJsonValue 并缓存。
+ * 只转发载荷的调用方（如 JS 绑定直接 JS_ParseJSON）可以通过 raw() 跳过 QJson 树。
+ * 原始字节在构造时已深拷贝并以 '\0' 结尾；首次物化不是线程安全的，
+ * 与 Message 其他字段一样应由单一线程访问。
+ */
+class STDIOLINK_API JsonPayload {
+public:
+    JsonPayload() = default;
+    JsonPayload(const QJsonValue& value);
+    JsonPayload(const QJsonObject& obj);
+    JsonPayload(const QJsonArray& arr);
+
+    /**
+     * 以原始 JSON 文本构造；rawJson 必须是一个语法合法的 JSON 值
+     */
+    static JsonPayload fromRaw(const QByteArray& rawJson);
+
+    /**
+     * 是否仍处于未物化的原始字节状态
+     */
+    bool isRaw() const { return !m_materialized; }
+
+    /**
+     * 原始 JSON 字节；已物化或由 QJsonValue 构造时为空
+     */
+    const QByteArray& raw() const { return m_raw; }
+
+    /**
+     * 物化并返回 QJsonValue（结果被缓存）
+     */
+    const QJsonValue& value() const;
+
+    bool isObject() const;
+    bool isArray() const;
+    bool isUndefined() const;
+    QJsonObject toObject() const { return value().toObject(); }
+    QJsonArray toArray() const { return value().toArray(); }
+    QString toString() const { return value().toString(); }
+
+    friend bool operator==(const JsonPayload& a, const JsonPayload& b) { return a.value() == b.value(); }
+    friend bool operator!=(const JsonPayload& a, const JsonPayload& b) { return !(a == b); }
+
+private:
+    mutable QJsonValue m_value;
+    mutable QByteArray m_raw;
+    mutable bool m_materialized = true;
+};
+
+/**
+ * 把一个完整 JSON 值的文本解析为 QJsonValue，支持标量顶层值；
+ * 语法错误返回 Undefined
+ */
+STDIOLINK_API QJsonValue parseJsonValue(QByteArrayView json);
+
+} // namespace stdiolink
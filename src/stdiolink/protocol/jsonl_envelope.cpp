@@ -0,0 +1,341 @@
+#include "jsonl_envelope.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace stdiolink {
+
+namespace {
+
+// 与 QJsonDocument 的嵌套上限保持一致，同时限制递归深度
+constexpr int kMaxNestingDepth = 1024;
+
+class EnvelopeScanner {
+public:
+    EnvelopeScanner(const char* begin, const char* end)
+        : m_p(begin)
+        , m_end(end) {}
+
+    bool scan(JsonlEnvelope& out) {
+        skipWhitespace();
+        if (!consume('{')) {
+            return false;
+        }
+        skipWhitespace();
+        if (consume('}')) {
+            return atEnd();
+        }
+
+        while (true) {
+            skipWhitespace();
+            const char* keyBegin = m_p;
+            if (!skipString()) {
+                return false;
+            }
+            const QByteArrayView key(keyBegin, m_p - keyBegin);
+
+            skipWhitespace();
+            if (!consume(':')) {
+                return false;
+            }
+            skipWhitespace();
+
+            const char* valueBegin = m_p;
+            if (!skipValue(1)) {
+                return false;
+            }
+            assign(out, key, QByteArrayView(valueBegin, m_p - valueBegin));
+
+            skipWhitespace();
+            if (consume(',')) {
+                continue;
+            }
+            if (consume('}')) {
+                return atEnd();
+            }
+            return false;
+        }
+    }
+
+private:
+    static void assign(JsonlEnvelope& out, QByteArrayView key, QByteArrayView value) {
+        // 协议键都是纯 ASCII；带转义的键先解码再比较
+        const QByteArrayView inner = key.sliced(1, key.size() - 2);
+        QByteArray decoded;
+        QByteArrayView name = inner;
+        if (inner.contains('\\')) {
+            decoded = jsonTokenToString(key).toUtf8();
+            name = decoded;
+        }
+
+        if (name == "status") {
+            out.status = value;
+        } else if (name == "code") {
+            out.code = value;
+        } else if (name == "data") {
+            out.data = value;
+        } else if (name == "id") {
+            out.id = value;
+        } else if (name == "cmd") {
+            out.cmd = value;
+        } else if (name == "blob") {
+            out.blob = value;
+        }
+    }
+
+    bool atEnd() {
+        skipWhitespace();
+        return m_p == m_end;
+    }
+
+    bool consume(char c) {
+        if (m_p < m_end && *m_p == c) {
+            ++m_p;
+            return true;
+        }
+        return false;
+    }
+
+    void skipWhitespace() {
+        while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\r' || *m_p == '\n')) {
+            ++m_p;
+        }
+    }
+
+    static bool isHex(char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    bool skipString() {
+        if (!consume('"')) {
+            return false;
+        }
+        while (m_p < m_end) {
+            const unsigned char c = static_cast<unsigned char>(*m_p++);
+            if (c == '"') {
+                return true;
+            }
+            if (c < 0x20) {
+                return false;
+            }
+            if (c >= 0x80) {
+                if (!skipUtf8Tail(c)) {
+                    return false;
+                }
+                continue;
+            }
+            if (c != '\\') {
+                continue;
+            }
+            if (m_p >= m_end) {
+                return false;
+            }
+            const char esc = *m_p++;
+            if (esc == 'u') {
+                if (m_end - m_p < 4 || !isHex(m_p[0]) || !isHex(m_p[1]) || !isHex(m_p[2])
+                    || !isHex(m_p[3])) {
+                    return false;
+                }
+                m_p += 4;
+            } else if (!std::strchr("\"\\/bfnrt", esc) || esc == '\0') {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    // 校验以 lead 开头的多字节 UTF-8 序列的后续字节（RFC 3629）：拒绝过长编码、
+    // 代理区与超出 U+10FFFF 的码点，与 QJsonDocument 的 IllegalUTF8String 判定一致
+    bool skipUtf8Tail(unsigned char lead) {
+        int tail = 0;
+        unsigned char lo = 0x80;
+        unsigned char hi = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            tail = 1;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            tail = 2;
+            if (lead == 0xE0) {
+                lo = 0xA0;
+            } else if (lead == 0xED) {
+                hi = 0x9F;
+            }
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            tail = 3;
+            if (lead == 0xF0) {
+                lo = 0x90;
+            } else if (lead == 0xF4) {
+                hi = 0x8F;
+            }
+        } else {
+            return false;
+        }
+        if (m_end - m_p < tail) {
+            return false;
+        }
+        const unsigned char first = static_cast<unsigned char>(*m_p);
+        if (first < lo || first > hi) {
+            return false;
+        }
+        for (int i = 1; i < tail; ++i) {
+            const unsigned char next = static_cast<unsigned char>(m_p[i]);
+            if (next < 0x80 || next > 0xBF) {
+                return false;
+            }
+        }
+        m_p += tail;
+        return true;
+    }
+
+    bool skipDigits() {
+        const char* start = m_p;
+        while (m_p < m_end && isDigit(*m_p)) {
+            ++m_p;
+        }
+        return m_p != start;
+    }
+
+    bool skipNumber() {
+        consume('-');
+        if (consume('0')) {
+            // 前导 0 之后不允许继续出现数字
+        } else if (!skipDigits()) {
+            return false;
+        }
+        if (consume('.') && !skipDigits()) {
+            return false;
+        }
+        if (m_p < m_end && (*m_p == 'e' || *m_p == 'E')) {
+            ++m_p;
+            if (!consume('+')) {
+                consume('-');
+            }
+            if (!skipDigits()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool skipLiteral(const char* literal) {
+        const qsizetype len = static_cast<qsizetype>(std::strlen(literal));
+        if (m_end - m_p < len || std::memcmp(m_p, literal, static_cast<size_t>(len)) != 0) {
+            return false;
+        }
+        m_p += len;
+        return true;
+    }
+
+    bool skipContainer(char close, bool isObject, int depth) {
+        ++m_p;
+        skipWhitespace();
+        if (consume(close)) {
+            return true;
+        }
+        while (true) {
+            skipWhitespace();
+            if (isObject) {
+                if (!skipString()) {
+                    return false;
+                }
+                skipWhitespace();
+                if (!consume(':')) {
+                    return false;
+                }
+                skipWhitespace();
+            }
+            if (!skipValue(depth + 1)) {
+                return false;
+            }
+            skipWhitespace();
+            if (consume(',')) {
+                continue;
+            }
+            return consume(close);
+        }
+    }
+
+    bool skipValue(int depth) {
+        if (m_p >= m_end) {
+            return false;
+        }
+        switch (*m_p) {
+            case '"':
+                return skipString();
+            case '{':
+                return depth < kMaxNestingDepth && skipContainer('}', true, depth);
+            case '[':
+                return depth < kMaxNestingDepth && skipContainer(']', false, depth);
+            case 't':
+                return skipLiteral("true");
+            case 'f':
+                return skipLiteral("false");
+            case 'n':
+                return skipLiteral("null");
+            default:
+                return skipNumber();
+        }
+    }
+
+    const char* m_p;
+    const char* m_end;
+};
+
+} // namespace
+
+bool scanEnvelope(QByteArrayView line, JsonlEnvelope& out) {
+    out = JsonlEnvelope{};
+    EnvelopeScanner scanner(line.data(), line.data() + line.size());
+    return scanner.scan(out);
+}
+
+QString jsonTokenToString(QByteArrayView token) {
+    if (token.size() < 2 || token.front() != '"') {
+        return QString();
+    }
+    const QByteArrayView inner = token.sliced(1, token.size() - 2);
+    if (!inner.contains('\\')) {
+        return QString::fromUtf8(inner);
+    }
+
+    // 带转义的字符串很少见，交给 QJsonDocument 处理以保证语义一致
+    QByteArray wrapped;
+    wrapped.reserve(token.size() + 2);
+    wrapped.append('[').append(token).append(']');
+    return QJsonDocument::fromJson(wrapped).array().at(0).toString();
+}
+
+int jsonTokenToInt(QByteArrayView token) {
+    if (token.isEmpty()) {
+        return 0;
+    }
+    const char first = token.front();
+    if (first != '-' && (first < '0' || first > '9')) {
+        return 0;
+    }
+
+    const char* end = token.data() + token.size();
+    qint64 integer = 0;
+    const auto [ptr, ec] = std::from_chars(token.data(), end, integer);
+    if (ec == std::errc() && ptr == end) {
+        if (integer < std::numeric_limits<int>::min() || integer > std::numeric_limits<int>::max()) {
+            return 0;
+        }
+        return static_cast<int>(integer);
+    }
+
+    bool ok = false;
+    const double d = token.toDouble(&ok);
+    if (!ok || std::trunc(d) != d || d < std::numeric_limits<int>::min()
+        || d > std::numeric_limits<int>::max()) {
+        return 0;
+    }
+    return static_cast<int>(d);
+}
+
+} // namespace stdiolink
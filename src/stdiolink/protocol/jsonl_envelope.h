@@ -0,0 +1,46 @@
+#pragma once
+
+#include "stdiolink/stdiolink_export.h"
+
+#include <QByteArrayView>
+#include <QString>
+
+namespace stdiolink {
+
+/**
+ * 一帧 JSONL 信封中各顶层字段的原始字节区间
+ *
+ * 区间指向被扫描的行缓冲区，覆盖字段值的完整 JSON token（字符串含引号）；
+ * 字段不存在时对应视图 isNull()。重复键以最后一次出现为准，与 QJsonObject 一致。
+ */
+struct JsonlEnvelope {
+    QByteArrayView cmd;
+    QByteArrayView status;
+    QByteArrayView code;
+    QByteArrayView data;
+    QByteArrayView id;
+    QByteArrayView blob;
+};
+
+/**
+ * 单遍扫描一行 JSONL 信封，只定位顶层字段而不构造 QJsonDocument
+ *
+ * 扫描过程会完整校验 JSON 语法（含嵌套的 data 子树）以及字符串内的 UTF-8 编码，
+ * 因此返回 true 的行交给 QJsonDocument 解析也必然成功；
+ * 顶层不是对象、语法错误或嵌套过深时返回 false。
+ */
+STDIOLINK_API bool scanEnvelope(QByteArrayView line, JsonlEnvelope& out);
+
+/**
+ * 解码字符串 token（含引号）；token 为空或不是字符串时返回空串，
+ * 语义同 QJsonValue::toString()
+ */
+STDIOLINK_API QString jsonTokenToString(QByteArrayView token);
+
+/**
+ * 把数值 token 转为 int；非整数、越界或不是数值时返回 0，
+ * 语义同 QJsonValue::toInt()
+ */
+STDIOLINK_API int jsonTokenToInt(QByteArrayView token);
+
+} // namespace stdiolink
@@ -1,48 +1,44 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonParseError>
+#include "jsonl_envelope.h"
 #include "jsonl_serializer.h"
 
 namespace stdiolink {
 
 bool parseRequest(const QByteArray& line, Request& out) {
-    QJsonParseError err{};
-    QJsonDocument doc = QJsonDocument::fromJson(line, &err);
-
-    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+    JsonlEnvelope env;
+    if (!scanEnvelope(line, env)) {
         return false;
     }
 
-    QJsonObject obj = doc.object();
-
     // cmd 是必填字段
-    if (!obj.contains("cmd") || !obj["cmd"].isString()) {
+    if (env.cmd.isNull() || env.cmd.front() != '"') {
         return false;
     }
 
-    out.cmd = obj["cmd"].toString();
-    out.data = obj.value("data");
+    out.cmd = jsonTokenToString(env.cmd);
+    out.data = env.data.isNull() ? QJsonValue(QJsonValue::Undefined) : parseJsonValue(env.data);
+
+    // id 是可选字段，仅接受字符串；旧版 Host 不携带
+    out.id = jsonTokenToString(env.id);
 
     return true;
 }
 
 bool parseHeader(const QByteArray& line, FrameHeader& out) {
-    QJsonParseError err{};
-    QJsonDocument doc = QJsonDocument::fromJson(line, &err);
-
-    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+    JsonlEnvelope env;
+    if (!scanEnvelope(line, env)) {
         return false;
     }
 
-    QJsonObject obj = doc.object();
-
-    // status 和 code 都是必填字段
-    if (!obj.contains("status") || !obj.contains("code")) {
+    // status 和 code 都是必填字段；data 只校验语法，不解析
+    if (env.status.isNull() || env.code.isNull()) {
         return false;
     }
 
-    out.status = obj["status"].toString();
-    out.code = obj["code"].toInt();
+    out.status = jsonTokenToString(env.status);
+    out.code = jsonTokenToInt(env.code);
 
     // 验证 status 值
     return out.status == "event" || out.status == "done" || out.status == "error";
@@ -83,23 +79,36 @@ QJsonValue parsePayload(const QByteArray& line) {
     return str;
 }
 
-bool parseResponse(const QByteArray& line, Message& out) {
-    QJsonParseError err{};
-    QJsonDocument doc = QJsonDocument::fromJson(line, &err);
-
-    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+bool parseResponse(const QByteArray& line, Message& out, qint64* blobSize) {
+    JsonlEnvelope env;
+    if (!scanEnvelope(line, env)) {
         return false;
     }
 
-    QJsonObject obj = doc.object();
-
-    if (!obj.contains("status") || !obj.contains("code")) {
+    if (env.status.isNull() || env.code.isNull()) {
         return false;
     }
 
-    out.status = obj["status"].toString();
-    out.code = obj["code"].toInt();
-    out.payload = obj.value("data");
+    out.status = jsonTokenToString(env.status);
+    out.code = jsonTokenToInt(env.code);
+    // data 只深拷贝原始字节，调用方访问时才物化为 QJsonValue
+    out.payload = env.data.isNull() ? JsonPayload(QJsonValue(QJsonValue::Undefined))
+                                    : JsonPayload::fromRaw(env.data.toByteArray());
+    out.id = jsonTokenToString(env.id);
+    out.blob.clear();
+
+    if (blobSize != nullptr) {
+        *blobSize = -1;
+        if (!env.blob.isNull()) {
+            // 附件长度必须是非负整数，否则无法确定下一帧的起点
+            bool ok = false;
+            const qint64 size = env.blob.toLongLong(&ok);
+            if (!ok || size < 0) {
+                return false;
+            }
+            *blobSize = size;
+        }
+    }
 
     return out.status == "event" || out.status == "done" || out.status == "error";
 }
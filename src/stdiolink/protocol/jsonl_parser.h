@@ -3,6 +3,7 @@
 #include "stdiolink/stdiolink_export.h"
 
 #include <QByteArray>
+#include "line_framer.h"
 
 namespace stdiolink {
 
@@ -25,6 +26,11 @@ public:
      */
     bool tryReadLine(QByteArray& outLine);
 
+    /**
+     * 尝试读取一行的零拷贝视图，在下一次 append()/clear() 前有效
+     */
+    bool nextLine(QByteArrayView& outLine);
+
     /**
      * 清空缓冲区
      */
@@ -36,7 +42,7 @@ public:
     int bufferSize() const;
 
 private:
-    QByteArray m_buffer;
+    LineFramer m_framer;
 };
 
 } // namespace stdiolink
@@ -5,9 +5,12 @@
 
 namespace stdiolink {
 
-QByteArray serializeRequest(const QString& cmd, const QJsonValue& data) {
+QByteArray serializeRequest(const QString& cmd, const QJsonValue& data, const QString& id) {
     QJsonObject req;
     req["cmd"] = cmd;
+    if (!id.isEmpty()) {
+        req["id"] = id;
+    }
 
     if (!data.isNull() && !data.isUndefined()) {
         req["data"] = data;
@@ -18,15 +21,71 @@ QByteArray serializeRequest(const QString& cmd, const QJsonValue& data) {
     return line;
 }
 
-QByteArray serializeResponse(const QString& status, int code, const QJsonValue& payload) {
-    QJsonObject resp;
-    resp["status"] = status;
-    resp["code"] = code;
-    resp["data"] = payload;
+namespace {
+
+void appendJsonValue(QByteArray& out, const QJsonValue& value) {
+    switch (value.type()) {
+    case QJsonValue::Object:
+        out += QJsonDocument(value.toObject()).toJson(QJsonDocument::Compact);
+        break;
+    case QJsonValue::Array:
+        out += QJsonDocument(value.toArray()).toJson(QJsonDocument::Compact);
+        break;
+    case QJsonValue::Bool:
+        out += value.toBool() ? "true" : "false";
+        break;
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        out += "null";
+        break;
+    default: {
+        // 数字与字符串：借单元素数组复用 Qt 的数字格式化与字符串转义
+        const QByteArray wrapped = QJsonDocument(QJsonArray{value}).toJson(QJsonDocument::Compact);
+        out.append(wrapped.constData() + 1, wrapped.size() - 2);
+        break;
+    }
+    }
+}
+
+// 输出信封的公共前缀（不含结尾的 "}\n"）
+void appendEnvelopeFields(QByteArray& out, const QString& status, int code,
+                          const QJsonValue& payload, const QString& id) {
+    out += "{\"status\":";
+    appendJsonValue(out, status);
+    out += ",\"code\":";
+    out += QByteArray::number(code);
+    // 与 QJsonObject 行为一致：undefined 的 data 不输出
+    if (!payload.isUndefined()) {
+        out += ",\"data\":";
+        appendJsonValue(out, payload);
+    }
+    if (!id.isEmpty()) {
+        out += ",\"id\":";
+        appendJsonValue(out, id);
+    }
+}
+
+} // namespace
 
-    QByteArray result = QJsonDocument(resp).toJson(QJsonDocument::Compact);
-    result.append('\n');
+QByteArray serializeResponse(const QString& status, int code, const QJsonValue& payload,
+                             const QString& id) {
+    QByteArray result;
+    appendResponse(result, status, code, payload, id);
     return result;
 }
 
+void appendResponse(QByteArray& out, const QString& status, int code, const QJsonValue& payload,
+                    const QString& id) {
+    appendEnvelopeFields(out, status, code, payload, id);
+    out += "}\n";
+}
+
+void appendBlobHeader(QByteArray& out, const QString& status, int code, const QJsonValue& payload,
+                      const QString& id, qsizetype blobSize) {
+    appendEnvelopeFields(out, status, code, payload, id);
+    out += ",\"blob\":";
+    out += QByteArray::number(blobSize);
+    out += "}\n";
+}
+
 } // namespace stdiolink
@@ -8,9 +8,26 @@
 
 namespace stdiolink {
 
-STDIOLINK_API QByteArray serializeRequest(const QString& cmd, const QJsonValue& data = QJsonValue());
-
-STDIOLINK_API QByteArray serializeResponse(const QString& status, int code, const QJsonValue& payload);
+STDIOLINK_API QByteArray serializeRequest(const QString& cmd, const QJsonValue& data = QJsonValue(),
+                                          const QString& id = QString());
+
+STDIOLINK_API QByteArray serializeResponse(const QString& status, int code, const QJsonValue& payload,
+                                           const QString& id = QString());
+
+/**
+ * 把一条响应帧（含结尾 \n）直接追加到 out
+ * 信封 {"status","code","data"[,"id"]} 按固定顺序拼接，不构造中间 QJsonObject，
+ * 只有 data 子树交给 QJsonDocument 序列化。
+ */
+STDIOLINK_API void appendResponse(QByteArray& out, const QString& status, int code,
+                                  const QJsonValue& payload, const QString& id = QString());
+
+/**
+ * 追加二进制侧信道帧的头部行：信封末尾多一个 "blob":blobSize 字段，
+ * 调用方须紧接着写出 blobSize 字节原始数据（不追加换行）
+ */
+STDIOLINK_API void appendBlobHeader(QByteArray& out, const QString& status, int code,
+                                    const QJsonValue& payload, const QString& id, qsizetype blobSize);
 
 STDIOLINK_API bool parseRequest(const QByteArray& line, Request& out);
 
@@ -18,6 +35,12 @@ STDIOLINK_API bool parseHeader(const QByteArray& line, FrameHeader& out);
 
 STDIOLINK_API QJsonValue parsePayload(const QByteArray& line);
 
-STDIOLINK_API bool parseResponse(const QByteArray& line, Message& out);
+/**
+ * 解析响应帧
+ * @param blobSize 非空时输出头部声明的侧信道附件长度（无附件为 -1），
+ *                 调用方负责从流中再读取这么多字节填入 out.blob；
+ *                 为空时忽略 blob 字段
+ */
+STDIOLINK_API bool parseResponse(const QByteArray& line, Message& out, qint64* blobSize = nullptr);
 
 } // namespace stdiolink
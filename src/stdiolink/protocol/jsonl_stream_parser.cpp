@@ -3,26 +3,23 @@
 namespace stdiolink {
 
 void JsonlParser::append(const QByteArray& data) {
-    m_buffer.append(data);
+    m_framer.append(data);
 }
 
 bool JsonlParser::tryReadLine(QByteArray& outLine) {
-    int idx = m_buffer.indexOf('\n');
-    if (idx < 0) {
-        return false;
-    }
+    return m_framer.tryReadLine(outLine);
+}
 
-    outLine = m_buffer.left(idx);
-    m_buffer.remove(0, idx + 1);
-    return true;
+bool JsonlParser::nextLine(QByteArrayView& outLine) {
+    return m_framer.nextLine(outLine);
 }
 
 void JsonlParser::clear() {
-    m_buffer.clear();
+    m_framer.clear();
 }
 
 int JsonlParser::bufferSize() const {
-    return m_buffer.size();
+    return static_cast<int>(m_framer.pendingSize());
 }
 
 } // namespace stdiolink
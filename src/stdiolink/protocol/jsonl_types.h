@@ -2,15 +2,25 @@
 
 #include "stdiolink/stdiolink_export.h"
 
+#include <QByteArray>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QString>
+#include "json_payload.h"
 
 namespace stdiolink {
 
+/**
+ * 二进制侧信道帧协商环境变量
+ * Host 启动 Driver 时置为 "1"，表示能解析 {"blob":N} 头部之后紧跟的 N 字节原始数据；
+ * 未设置时 Driver 不得输出侧信道帧（附件回退为 data 内的 base64 字段）。
+ */
+inline constexpr char kBlobFramesEnvVar[] = "STDIOLINK_BLOB_FRAMES";
+
 struct STDIOLINK_API Request {
     QString cmd;
     QJsonValue data;
+    QString id; // 可选关联 ID，非空时 Driver 在所有响应帧中原样回显
 };
 
 struct STDIOLINK_API FrameHeader {
@@ -21,7 +31,9 @@ struct STDIOLINK_API FrameHeader {
 struct STDIOLINK_API Message {
     QString status;
     int code = 0;
-    QJsonValue payload;
+    JsonPayload payload; // 解析自 JSONL 时保留 data 原始字节，首次访问才物化
+    QString id; // 响应帧回显的请求 ID，旧版 Driver 为空
+    QByteArray blob; // 二进制侧信道附件，无附件时为空
 };
 
 } // namespace stdiolink
@@ -0,0 +1,87 @@
+#include "line_framer.h"
+
+#include <cstring>
+
+namespace stdiolink {
+
+void LineFramer::append(const QByteArray& data) {
+    append(data.constData(), data.size());
+}
+
+void LineFramer::append(const char* data, qsizetype size) {
+    if (size <= 0) {
+        return;
+    }
+    compact();
+    m_buffer.append(data, size);
+}
+
+bool LineFramer::nextLine(QByteArrayView& outLine) {
+    const qsizetype size = m_buffer.size();
+    if (m_scanPos >= size) {
+        return false;
+    }
+
+    const char* base = m_buffer.constData();
+    const void* hit = std::memchr(base + m_scanPos, '\n', static_cast<size_t>(size - m_scanPos));
+    if (hit == nullptr) {
+        m_scanPos = size;
+        return false;
+    }
+
+    const qsizetype nl = static_cast<const char*>(hit) - base;
+    outLine = QByteArrayView(base + m_readPos, nl - m_readPos);
+    m_readPos = nl + 1;
+    m_scanPos = m_readPos;
+    return true;
+}
+
+bool LineFramer::tryReadLine(QByteArray& outLine) {
+    QByteArrayView view;
+    if (!nextLine(view)) {
+        return false;
+    }
+    outLine = view.toByteArray();
+    return true;
+}
+
+bool LineFramer::takeBytes(qsizetype size, QByteArrayView& outBytes) {
+    if (size < 0 || m_buffer.size() - m_readPos < size) {
+        return false;
+    }
+    outBytes = QByteArrayView(m_buffer.constData() + m_readPos, size);
+    m_readPos += size;
+    // 之前的 memchr 可能已越过这段二进制数据，换行查找不能落在它之前
+    m_scanPos = qMax(m_scanPos, m_readPos);
+    return true;
+}
+
+QByteArrayView LineFramer::pending() const {
+    return QByteArrayView(m_buffer.constData() + m_readPos, m_buffer.size() - m_readPos);
+}
+
+void LineFramer::clear() {
+    m_buffer.resize(0);
+    m_readPos = 0;
+    m_scanPos = 0;
+}
+
+void LineFramer::compact() {
+    if (m_readPos == 0) {
+        return;
+    }
+    if (m_readPos == m_buffer.size()) {
+        clear();
+        return;
+    }
+    if (m_readPos < m_buffer.size() - m_readPos) {
+        return;
+    }
+
+    // 一次 memmove 丢弃所有已消费行；搬移量不超过已消费量
+    m_buffer.remove(0, m_readPos);
+    m_scanPos -= m_readPos;
+    m_readPos = 0;
+}
+
+} // namespace stdiolink
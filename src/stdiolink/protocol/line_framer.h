@@ -0,0 +1,64 @@
+#pragma once
+
+#include "stdiolink/stdiolink_export.h"
+
+#include <QByteArray>
+#include <QByteArrayView>
+
+namespace stdiolink {
+
+/**
+ * 按 '\n' 切分字节流的行分帧器
+ *
+ * 维护读游标而不是每读一行就 remove(0, n)：已消费的前缀只在 append() 时
+ * 一次性压缩（仅当已消费字节不少于剩余字节，搬移成本摊还为线性），
+ * 换行查找使用 memchr 且不会重复扫描未完整的尾部。
+ * nextLine() 返回的视图指向内部缓冲区，在下一次 append()/clear() 前有效。
+ */
+class STDIOLINK_API LineFramer {
+public:
+    LineFramer() = default;
+
+    /**
+     * 追加数据到缓冲区
+     */
+    void append(const QByteArray& data);
+    void append(const char* data, qsizetype size);
+
+    /**
+     * 取出下一行（不含 \n）的零拷贝视图
+     * @return 成功返回 true，无完整行返回 false
+     */
+    bool nextLine(QByteArrayView& outLine);
+
+    /**
+     * 取出下一行的拷贝，语义同 JsonlParser::tryReadLine
+     */
+    bool tryReadLine(QByteArray& outLine);
+
+    /**
+     * 取出紧随其后的 size 字节原始数据（二进制侧信道帧），不做换行切分
+     * @return 缓冲区不足 size 字节时返回 false 且不消费任何数据
+     */
+    bool takeBytes(qsizetype size, QByteArrayView& outBytes);
+
+    /**
+     * 尚未消费的字节（含未完整的尾行）
+     */
+    QByteArrayView pending() const;
+    qsizetype pendingSize() const { return m_buffer.size() - m_readPos; }
+
+    /**
+     * 清空缓冲区（保留已分配容量）
+     */
+    void clear();
+
+private:
+    void compact();
+
+    QByteArray m_buffer;
+    qsizetype m_readPos = 0; // 下一行起点
+    qsizetype m_scanPos = 0; // 下一次 memchr 起点，跳过已确认不含 '\n' 的尾部
+};
+
+} // namespace stdiolink
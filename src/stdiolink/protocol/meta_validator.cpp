@@ -2,6 +2,22 @@
 
 namespace stdiolink::meta {
 
+namespace {
+
+// 旧接口按 FieldMeta 逐次验证，没有地方保存编译结果；按线程缓存避免每次重新编译
+const QRegularExpression& cachedRegex(const QString& pattern) {
+    thread_local QHash<QString, QRegularExpression> cache;
+    auto it = cache.constFind(pattern);
+    if (it == cache.constEnd()) {
+        QRegularExpression re(pattern);
+        re.optimize();
+        it = cache.insert(pattern, re);
+    }
+    return *it;
+}
+
+} // namespace
+
 // MetaValidator 实现
 
 ValidationResult MetaValidator::checkType(const QJsonValue& value, FieldType type) {
@@ -57,46 +73,52 @@ ValidationResult MetaValidator::checkType(const QJsonValue& value, FieldType typ
 
 ValidationResult MetaValidator::checkConstraints(const QJsonValue& value, const FieldMeta& field) {
     const auto& c = field.constraints;
+    const QRegularExpression* re = c.pattern.isEmpty() ? nullptr : &cachedRegex(c.pattern);
+    return checkConstraints(value, field.name, field.type, c, re);
+}
 
+ValidationResult MetaValidator::checkConstraints(const QJsonValue& value,
+                                                 const QString& name,
+                                                 FieldType type,
+                                                 const Constraints& c,
+                                                 const QRegularExpression* re) {
     // 数值范围检查
     if (c.min.has_value() && value.isDouble()) {
         if (value.toDouble() < c.min.value())
             return ValidationResult::fail(
-                field.name, QString("value %1 < min %2").arg(value.toDouble()).arg(*c.min));
+                name, QString("value %1 < min %2").arg(value.toDouble()).arg(*c.min));
     }
     if (c.max.has_value() && value.isDouble()) {
         if (value.toDouble() > c.max.value())
             return ValidationResult::fail(
-                field.name, QString("value %1 > max %2").arg(value.toDouble()).arg(*c.max));
+                name, QString("value %1 > max %2").arg(value.toDouble()).arg(*c.max));
     }
 
     // 字符串长度检查
     if (value.isString()) {
-        int len = value.toString().length();
+        const QString str = value.toString();
+        const int len = str.length();
         if (c.minLength.has_value() && len < *c.minLength)
-            return ValidationResult::fail(field.name, "string too short");
+            return ValidationResult::fail(name, "string too short");
         if (c.maxLength.has_value() && len > *c.maxLength)
-            return ValidationResult::fail(field.name, "string too long");
-        if (!c.pattern.isEmpty()) {
-            QRegularExpression re(c.pattern);
-            if (!re.match(value.toString()).hasMatch())
-                return ValidationResult::fail(field.name, "pattern mismatch");
-        }
+            return ValidationResult::fail(name, "string too long");
+        if (re && !re->match(str).hasMatch())
+            return ValidationResult::fail(name, "pattern mismatch");
     }
 
     // 枚举值检查
-    if (field.type == FieldType::Enum && !c.enumValues.isEmpty()) {
+    if (type == FieldType::Enum && !c.enumValues.isEmpty()) {
         if (!c.enumValues.contains(value))
-            return ValidationResult::fail(field.name, "invalid enum value");
+            return ValidationResult::fail(name, "invalid enum value");
     }
 
     // 数组长度检查
     if (value.isArray()) {
         int size = value.toArray().size();
         if (c.minItems.has_value() && size < *c.minItems)
-            return ValidationResult::fail(field.name, "array too short");
+            return ValidationResult::fail(name, "array too short");
         if (c.maxItems.has_value() && size > *c.maxItems)
-            return ValidationResult::fail(field.name, "array too long");
+            return ValidationResult::fail(name, "array too long");
     }
 
     return ValidationResult::ok();
@@ -241,4 +263,180 @@ QJsonObject DefaultFiller::fillDefaults(const QJsonObject& data, const CommandMe
     return fillDefaults(data, cmd.params);
 }
 
+// CommandValidationPlan 实现
+
+CommandValidationPlan::CommandValidationPlan(const CommandMeta& cmd) {
+    m_paramCount = static_cast<int>(cmd.params.size());
+    m_firstParam = compileChildren(cmd.params);
+}
+
+int CommandValidationPlan::compileChildren(const QVector<FieldMeta>& fields) {
+    // 同级字段先占连续槽位，再依次展开各自的子树
+    const int first = static_cast<int>(m_nodes.size());
+    m_nodes.resize(m_nodes.size() + static_cast<size_t>(fields.size()));
+    for (int i = 0; i < fields.size(); ++i) {
+        compileNode(first + i, fields[i]);
+    }
+    return first;
+}
+
+void CommandValidationPlan::compileNode(int index, const FieldMeta& field) {
+    {
+        Node& node = m_nodes[static_cast<size_t>(index)];
+        node.name = field.name;
+        node.type = field.type;
+        node.required = field.required;
+        node.nestedObject = field.type == FieldType::Object && !field.fields.isEmpty();
+        node.defaultValue = field.defaultValue;
+        node.constraints = field.constraints;
+        node.requiredKeys = field.requiredKeys;
+        if (!field.constraints.pattern.isEmpty()) {
+            node.pattern.setPattern(field.constraints.pattern);
+            node.pattern.optimize();
+        }
+    }
+
+    // 展开子树会使 m_nodes 扩容，之后只能通过下标回写
+    if (field.type == FieldType::Object && !field.fields.isEmpty()) {
+        const int first = compileChildren(field.fields);
+        m_nodes[static_cast<size_t>(index)].firstChild = first;
+        m_nodes[static_cast<size_t>(index)].childCount = static_cast<int>(field.fields.size());
+    }
+    if (field.type == FieldType::Array && field.items) {
+        const int items = static_cast<int>(m_nodes.size());
+        m_nodes.emplace_back();
+        compileNode(items, *field.items);
+        m_nodes[static_cast<size_t>(index)].items = items;
+    }
+}
+
+ValidationResult CommandValidationPlan::fillAndValidate(QJsonObject& params,
+                                                        bool allowUnknown) const {
+    return processObject(params, m_firstParam, m_paramCount, {}, allowUnknown, true);
+}
+
+ValidationResult CommandValidationPlan::processObject(QJsonObject& obj, int firstChild,
+                                                      int childCount,
+                                                      const QStringList& requiredKeys,
+                                                      bool allowUnknown, bool fill) const {
+    const Node* children = m_nodes.data() + firstChild;
+
+    // 与 DefaultFiller 一致：先补默认值，声明了嵌套字段的对象总是物化为对象
+    if (fill) {
+        for (int i = 0; i < childCount; ++i) {
+            const Node& node = children[i];
+            if (!obj.contains(node.name) && !node.defaultValue.isNull()
+                && !node.defaultValue.isUndefined()) {
+                obj.insert(node.name, node.defaultValue);
+            }
+            if (node.nestedObject) {
+                obj.insert(node.name, obj.value(node.name).toObject());
+            }
+        }
+    }
+
+    for (int i = 0; i < childCount; ++i) {
+        if (children[i].required && !obj.contains(children[i].name)) {
+            return ValidationResult::fail(children[i].name, "required field missing");
+        }
+    }
+    for (const auto& key : requiredKeys) {
+        if (!obj.contains(key)) {
+            return ValidationResult::fail(key, "required key missing");
+        }
+    }
+
+    for (int i = 0; i < childCount; ++i) {
+        const Node& node = children[i];
+        auto it = obj.find(node.name);
+        if (it == obj.end()) {
+            continue;
+        }
+        QJsonValue value = it.value();
+        auto result = processValue(node, value, fill);
+        if (!result.valid) {
+            return result;
+        }
+        if (fill && node.nestedObject) {
+            obj.insert(node.name, value);
+        }
+    }
+
+    if (!allowUnknown) {
+        for (auto it = obj.begin(); it != obj.end(); ++it) {
+            bool known = false;
+            for (int i = 0; i < childCount && !known; ++i) {
+                known = children[i].name == it.key();
+            }
+            if (!known) {
+                return ValidationResult::fail(it.key(), "unknown field");
+            }
+        }
+    }
+
+    return ValidationResult::ok();
+}
+
+ValidationResult CommandValidationPlan::processValue(const Node& node, QJsonValue& value,
+                                                     bool fill) const {
+    auto typeResult = MetaValidator::checkType(value, node.type);
+    if (!typeResult.valid) {
+        typeResult.errorField = node.name;
+        return typeResult;
+    }
+
+    const QRegularExpression* re = node.constraints.pattern.isEmpty() ? nullptr : &node.pattern;
+    auto constraintResult =
+        MetaValidator::checkConstraints(value, node.name, node.type, node.constraints, re);
+    if (!constraintResult.valid) {
+        return constraintResult;
+    }
+
+    if (node.nestedObject) {
+        QJsonObject nested = value.toObject();
+        auto objResult = processObject(nested, node.firstChild, node.childCount,
+                                       node.requiredKeys, true, fill);
+        if (!objResult.valid) {
+            objResult.errorField = node.name + "." + objResult.errorField;
+            return objResult;
+        }
+        if (fill) {
+            value = nested;
+        }
+    }
+
+    // 旧实现不向数组元素填充默认值，这里同样只做验证
+    if (node.type == FieldType::Array && node.items >= 0) {
+        const Node& items = m_nodes[static_cast<size_t>(node.items)];
+        const QJsonArray arr = value.toArray();
+        for (int i = 0; i < arr.size(); ++i) {
+            QJsonValue element = arr.at(i);
+            auto result = processValue(items, element, false);
+            if (!result.valid) {
+                result.errorField = QString("%1[%2]").arg(node.name).arg(i);
+                return result;
+            }
+        }
+    }
+
+    return ValidationResult::ok();
+}
+
+// DriverValidationPlan 实现
+
+DriverValidationPlan::DriverValidationPlan(const DriverMeta& meta) {
+    m_commands.reserve(meta.commands.size());
+    for (const auto& cmd : meta.commands) {
+        // 同名命令以第一条为准，与 DriverMeta::findCommand() 一致
+        if (!m_commands.contains(cmd.name)) {
+            m_commands.insert(cmd.name, std::make_shared<const CommandValidationPlan>(cmd));
+        }
+    }
+}
+
+const CommandValidationPlan* DriverValidationPlan::find(const QString& cmd) const {
+    auto it = m_commands.constFind(cmd);
+    return it == m_commands.constEnd() ? nullptr : it->get();
+}
+
 } // namespace stdiolink::meta
@@ -3,7 +3,10 @@
 #include "stdiolink/stdiolink_export.h"
 #include "meta_types.h"
 
+#include <QHash>
 #include <QRegularExpression>
+#include <memory>
+#include <vector>
 
 namespace stdiolink::meta {
 
@@ -54,10 +57,18 @@ public:
     static ValidationResult validateConfig(const QJsonObject& config, const ConfigSchema& schema);
 
 private:
+    friend class CommandValidationPlan;
+
     static ValidationResult checkType(const QJsonValue& value, FieldType type);
 
     static ValidationResult checkConstraints(const QJsonValue& value, const FieldMeta& field);
 
+    static ValidationResult checkConstraints(const QJsonValue& value,
+                                             const QString& name,
+                                             FieldType type,
+                                             const Constraints& c,
+                                             const QRegularExpression* re);
+
     static ValidationResult validateObject(const QJsonObject& obj,
                                            const QVector<FieldMeta>& fields,
                                            const QStringList& requiredKeys,
@@ -76,4 +87,66 @@ public:
     static QJsonObject fillDefaults(const QJsonObject& data, const CommandMeta& cmd);
 };
 
+/**
+ * 单条命令的预编译验证计划
+ *
+ * 由 CommandMeta 一次性构建：字段树展平为数组，pattern 预编译并 optimize()，
+ * 默认值填充与参数验证合并为一次遍历。结果与
+ * DefaultFiller::fillDefaults() + MetaValidator::validateParams() 逐字段一致，
+ * 包括错误字段路径与首个错误的判定顺序。
+ * 构建后只读，可在多线程间共享。
+ */
+class STDIOLINK_API CommandValidationPlan {
+public:
+    explicit CommandValidationPlan(const CommandMeta& cmd);
+
+    /**
+     * 原地填充默认值并验证参数
+     * 验证失败时 params 可能已被部分填充，调用方应丢弃
+     */
+    ValidationResult fillAndValidate(QJsonObject& params, bool allowUnknown = true) const;
+
+private:
+    struct Node {
+        QString name;
+        FieldType type = FieldType::Any;
+        bool required = false;
+        bool nestedObject = false;   // Object 且声明了嵌套字段
+        QJsonValue defaultValue;     // 为 null/undefined 时不填充
+        Constraints constraints;
+        QRegularExpression pattern;  // constraints.pattern 的预编译形式
+        QStringList requiredKeys;
+        int firstChild = 0;          // 嵌套字段在 m_nodes 中的连续区间
+        int childCount = 0;
+        int items = -1;              // Array 元素 schema 的下标
+    };
+
+    void compileNode(int index, const FieldMeta& field);
+    int compileChildren(const QVector<FieldMeta>& fields);
+
+    ValidationResult processObject(QJsonObject& obj, int firstChild, int childCount,
+                                   const QStringList& requiredKeys, bool allowUnknown,
+                                   bool fill) const;
+    ValidationResult processValue(const Node& node, QJsonValue& value, bool fill) const;
+
+    std::vector<Node> m_nodes;
+    int m_firstParam = 0;
+    int m_paramCount = 0;
+};
+
+/**
+ * Driver 全部命令的验证计划，按命令名哈希查找
+ */
+class STDIOLINK_API DriverValidationPlan {
+public:
+    DriverValidationPlan() = default;
+    explicit DriverValidationPlan(const DriverMeta& meta);
+
+    /** 未声明的命令返回 nullptr */
+    const CommandValidationPlan* find(const QString& cmd) const;
+
+private:
+    QHash<QString, std::shared_ptr<const CommandValidationPlan>> m_commands;
+};
+
 } // namespace stdiolink::meta
@@ -44,7 +44,10 @@ ServerConfig ServerConfig::loadFromFile(const QString& filePath, QString& error)
 
     const QJsonObject obj = doc.object();
     static const QSet<QString> known = {"port", "host", "logLevel", "serviceProgram", "corsOrigin", "webuiDir",
-                                        "logMaxBytes", "logMaxFiles"};
+                                        "logMaxBytes", "logMaxFiles", "metricsIntervalMs",
+                                        "metricsHistorySize", "sseMaxConnections",
+                                        "scheduleMaxConcurrent", "watchDataRoot",
+                                        "watchDebounceMs"};
     for (auto it = obj.begin(); it != obj.end(); ++it) {
         if (!known.contains(it.key())) {
             error = "unknown field in config.json: " + it.key();
@@ -140,6 +143,75 @@ ServerConfig ServerConfig::loadFromFile(const QString& filePath, QString& error)
         }
     }
 
+    if (obj.contains("metricsIntervalMs")) {
+        if (!obj.value("metricsIntervalMs").isDouble()) {
+            error = "config field 'metricsIntervalMs' must be a number";
+            return cfg;
+        }
+        cfg.metricsIntervalMs = obj.value("metricsIntervalMs").toInt();
+        if (cfg.metricsIntervalMs != 0
+            && (cfg.metricsIntervalMs < 200 || cfg.metricsIntervalMs > 60000)) {
+            error = "config field 'metricsIntervalMs' must be 0 or between 200 and 60000";
+            return cfg;
+        }
+    }
+
+    if (obj.contains("metricsHistorySize")) {
+        if (!obj.value("metricsHistorySize").isDouble()) {
+            error = "config field 'metricsHistorySize' must be a number";
+            return cfg;
+        }
+        cfg.metricsHistorySize = obj.value("metricsHistorySize").toInt();
+        if (cfg.metricsHistorySize < 1 || cfg.metricsHistorySize > 86400) {
+            error = "config field 'metricsHistorySize' must be between 1 and 86400";
+            return cfg;
+        }
+    }
+
+    if (obj.contains("sseMaxConnections")) {
+        if (!obj.value("sseMaxConnections").isDouble()) {
+            error = "config field 'sseMaxConnections' must be a number";
+            return cfg;
+        }
+        cfg.sseMaxConnections = obj.value("sseMaxConnections").toInt();
+        if (cfg.sseMaxConnections < 1 || cfg.sseMaxConnections > 4096) {
+            error = "config field 'sseMaxConnections' must be between 1 and 4096";
+            return cfg;
+        }
+    }
+
+    if (obj.contains("scheduleMaxConcurrent")) {
+        if (!obj.value("scheduleMaxConcurrent").isDouble()) {
+            error = "config field 'scheduleMaxConcurrent' must be a number";
+            return cfg;
+        }
+        cfg.scheduleMaxConcurrent = obj.value("scheduleMaxConcurrent").toInt();
+        if (cfg.scheduleMaxConcurrent < 0 || cfg.scheduleMaxConcurrent > 10000) {
+            error = "config field 'scheduleMaxConcurrent' must be between 0 and 10000";
+            return cfg;
+        }
+    }
+
+    if (obj.contains("watchDataRoot")) {
+        if (!obj.value("watchDataRoot").isBool()) {
+            error = "config field 'watchDataRoot' must be a boolean";
+            return cfg;
+        }
+        cfg.watchDataRoot = obj.value("watchDataRoot").toBool();
+    }
+
+    if (obj.contains("watchDebounceMs")) {
+        if (!obj.value("watchDebounceMs").isDouble()) {
+            error = "config field 'watchDebounceMs' must be a number";
+            return cfg;
+        }
+        cfg.watchDebounceMs = obj.value("watchDebounceMs").toInt();
+        if (cfg.watchDebounceMs < 50 || cfg.watchDebounceMs > 60000) {
+            error = "config field 'watchDebounceMs' must be between 50 and 60000";
+            return cfg;
+        }
+    }
+
     error.clear();
     return cfg;
 }
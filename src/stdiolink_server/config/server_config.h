@@ -15,6 +15,12 @@ struct ServerConfig {
     QString webuiDir;
     qint64 logMaxBytes = 10 * 1024 * 1024;  // 10MB
     int logMaxFiles = 3;
+    int metricsIntervalMs = 2000;   // 0 = 关闭后台资源采样
+    int metricsHistorySize = 900;   // 每实例保留的样本数
+    int sseMaxConnections = 512;    // /api/events/stream 同时在线连接上限
+    int scheduleMaxConcurrent = 0;  // 定时触发实例的全局并发上限，0 = 不限
+    bool watchDataRoot = true;      // 监视 services/projects/drivers 并增量更新
+    int watchDebounceMs = 500;      // 文件变更合并窗口
 
     static ServerConfig loadFromFile(const QString& filePath, QString& error);
     void applyArgs(const ServerArgs& args);
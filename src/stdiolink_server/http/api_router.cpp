@@ -17,8 +17,10 @@
 #include "cors_middleware.h"
 #include "event_log.h"
 #include "event_stream_handler.h"
+#include "log_stream_handler.h"
 #include "service_file_handler.h"
 #include "static_file_server.h"
+#include "manager/instance_log_reader.h"
 #include "manager/process_monitor.h"
 #include "manager/project_manager.h"
 #include "server_manager.h"
@@ -168,46 +170,39 @@ QString scheduleTypeToString(ScheduleType type) {
         return "fixed_rate";
     case ScheduleType::Daemon:
         return "daemon";
+    case ScheduleType::Cron:
+        return "cron";
     }
     return "manual";
 }
 
-constexpr qint64 kMaxTailReadBytes = 4 * 1024 * 1024; // 4MB window
-
-QJsonArray readTailLines(const QString& path, int maxLines) {
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly)) {
-        return {};
-    }
-
-    const qint64 fileSize = file.size();
-    const qint64 start = std::max(static_cast<qint64>(0), fileSize - kMaxTailReadBytes);
-    if (start > 0) {
-        file.seek(start);
-    }
-
-    const QByteArray raw = file.readAll();
-    const QList<QByteArray> all = raw.split('\n');
-
-    // If we seeked into the middle, discard the first (potentially incomplete) line
-    const int firstLine = (start > 0) ? 1 : 0;
-
-    // Collect non-empty lines from the tail
-    QVector<QString> lines;
-    for (int i = firstLine; i < all.size(); ++i) {
-        const QByteArray line = all[i].trimmed();
-        if (!line.isEmpty()) {
-            lines.append(QString::fromUtf8(line));
+/// 按查询参数读取日志：带 offset 时从游标增量读取，否则返回尾部 maxLines 行。
+/// 结果写入 out 的 lines / fileId / nextOffset（/ reset）字段
+bool readLogLines(const QString& logPath, const QUrlQuery& query, int maxLines,
+                  QJsonObject& out, QString* error) {
+    InstanceLogReader::Chunk chunk;
+    const QString offsetParam = query.queryItemValue("offset");
+    if (offsetParam.isEmpty()) {
+        chunk = InstanceLogReader::readTail(logPath, maxLines);
+    } else {
+        bool ok = false;
+        InstanceLogReader::Cursor cursor;
+        cursor.offset = offsetParam.toLongLong(&ok);
+        if (!ok || cursor.offset < 0) {
+            *error = "offset must be a non-negative integer";
+            return false;
         }
+        cursor.fileId = query.queryItemValue("fileId");
+        chunk = InstanceLogReader::readSince(logPath, cursor, maxLines);
     }
 
-    // Keep only the last maxLines
-    const int offset = std::max(0, static_cast<int>(lines.size()) - maxLines);
-    QJsonArray out;
-    for (int i = offset; i < lines.size(); ++i) {
-        out.append(lines[i]);
+    out["lines"] = QJsonArray::fromStringList(chunk.lines);
+    out["fileId"] = chunk.next.fileId;
+    out["nextOffset"] = chunk.next.offset;
+    if (chunk.reset) {
+        out["reset"] = true;
     }
-    return out;
+    return true;
 }
 
 QHttpServerResponse projectBusyResponse(const QString& id) {
@@ -248,17 +243,44 @@ ApiRouter::ApiRouter(ServerManager* manager, QObject* parent)
     : QObject(parent)
     , m_manager(manager)
     , m_staticFileServer(manager ? manager->staticFileServer() : nullptr) {
+    if (m_manager) {
+        m_manager->setProjectBusyCheck([this](const QString& id) {
+            return m_projectMutationsInFlight.contains(id);
+        });
+    }
 }
 
 ApiRouter::~ApiRouter() {
     if (!m_manager) {
         return;
     }
-    auto* handler = m_manager->eventStreamHandler();
-    if (!handler) {
-        return;
+    m_manager->setProjectBusyCheck({});
+    if (auto* handler = m_manager->eventStreamHandler()) {
+        handler->closeAllConnections();
+    }
+    if (auto* handler = m_manager->logStreamHandler()) {
+        handler->closeAllConnections();
     }
-    handler->closeAllConnections();
+}
+
+QHttpServerResponse ApiRouter::cachedResponse(const QHttpServerRequest& req,
+                                              int dependencies,
+                                              const ResponseCache::Builder& builder) {
+    // 版本标签由所依赖数据源的修订号拼成，任一数据源变化即重新生成
+    QString tag;
+    if (dependencies & DependsOnServices) {
+        tag += QStringLiteral("s%1.").arg(m_manager->servicesRevision());
+    }
+    if (dependencies & DependsOnProjects) {
+        tag += QStringLiteral("p%1.").arg(m_manager->projectsRevision());
+    }
+    if (dependencies & DependsOnInstances) {
+        tag += QStringLiteral("i%1.").arg(m_manager->instanceManager()->revision());
+    }
+    if (dependencies & DependsOnDrivers) {
+        tag += QStringLiteral("d%1.").arg(m_manager->driverCatalog()->revision());
+    }
+    return m_responseCache.respond(req, tag, builder);
 }
 
 void ApiRouter::registerRoutes(QHttpServer& server) {
@@ -267,7 +289,8 @@ void ApiRouter::registerRoutes(QHttpServer& server) {
     });
 
     server.route("/api/services", Method::Get, [this](const QHttpServerRequest& req) {
-        return handleServiceList(req);
+        return cachedResponse(req, DependsOnServices | DependsOnProjects,
+                              [&] { return handleServiceList(req); });
     });
     server.route("/api/services", Method::Post, [this](const QHttpServerRequest& req) {
         return handleServiceCreate(req);
@@ -276,7 +299,8 @@ void ApiRouter::registerRoutes(QHttpServer& server) {
         return handleServiceScan(req);
     });
     server.route("/api/services/<arg>", Method::Get, [this](const QString& id, const QHttpServerRequest& req) {
-        return handleServiceDetail(id, req);
+        return cachedResponse(req, DependsOnServices | DependsOnProjects,
+                              [&] { return handleServiceDetail(id, req); });
     });
     server.route("/api/services/<arg>", Method::Delete, [this](const QString& id, const QHttpServerRequest& req) {
         return handleServiceDelete(id, req);
@@ -307,7 +331,8 @@ void ApiRouter::registerRoutes(QHttpServer& server) {
     });
 
     server.route("/api/projects", Method::Get, [this](const QHttpServerRequest& req) {
-        return handleProjectList(req);
+        return cachedResponse(req, DependsOnProjects | DependsOnInstances,
+                              [&] { return handleProjectList(req); });
     });
     server.route("/api/projects", Method::Post, [this](const QHttpServerRequest& req) {
         return handleProjectCreate(req);
@@ -316,7 +341,8 @@ void ApiRouter::registerRoutes(QHttpServer& server) {
         return handleProjectRuntimeBatch(req);
     });
     server.route("/api/projects/<arg>", Method::Get, [this](const QString& id, const QHttpServerRequest& req) {
-        return handleProjectDetail(id, req);
+        return cachedResponse(req, DependsOnServices | DependsOnProjects | DependsOnInstances,
+                              [&] { return handleProjectDetail(id, req); });
     });
     server.route("/api/projects/<arg>", Method::Put, [this](const QString& id, const QHttpServerRequest& req) {
         return handleProjectUpdate(id, req);
@@ -352,6 +378,10 @@ void ApiRouter::registerRoutes(QHttpServer& server) {
     server.route("/api/projects/<arg>/logs", Method::Get, [this](const QString& id, const QHttpServerRequest& req) {
         return handleProjectLogs(id, req);
     });
+    server.route("/api/projects/<arg>/logs/stream", Method::Get, this,
+                 [this](const QString& id, const QHttpServerRequest& req, QHttpServerResponder& responder) {
+                     handleLogStream(id, false, req, responder);
+                 });
 
     server.route("/api/instances", Method::Get, [this](const QHttpServerRequest& req) {
         return handleInstanceList(req);
@@ -365,32 +395,39 @@ void ApiRouter::registerRoutes(QHttpServer& server) {
     server.route("/api/instances/<arg>/logs", Method::Get, [this](const QString& id, const QHttpServerRequest& req) {
         return handleInstanceLogs(id, req);
     });
+    server.route("/api/instances/<arg>/logs/stream", Method::Get, this,
+                 [this](const QString& id, const QHttpServerRequest& req, QHttpServerResponder& responder) {
+                     handleLogStream(id, true, req, responder);
+                 });
     server.route("/api/instances/<arg>/process-tree", Method::Get, [this](const QString& id, const QHttpServerRequest& req) {
         return handleInstanceProcessTree(id, req);
     });
     server.route("/api/instances/<arg>/resources", Method::Get, [this](const QString& id, const QHttpServerRequest& req) {
         return handleInstanceResources(id, req);
     });
+    server.route("/api/instances/<arg>/metrics", Method::Get, [this](const QString& id, const QHttpServerRequest& req) {
+        return handleInstanceMetrics(id, req);
+    });
     server.route("/api/instances/<arg>", Method::Get, [this](const QString& id, const QHttpServerRequest& req) {
         return handleInstanceDetail(id, req);
     });
 
     server.route("/api/drivers", Method::Get, [this](const QHttpServerRequest& req) {
-        return handleDriverList(req);
+        return cachedResponse(req, DependsOnDrivers, [&] { return handleDriverList(req); });
     });
     server.route("/api/drivers/scan", Method::Post, [this](const QHttpServerRequest& req) {
         return handleDriverScan(req);
     });
     server.route("/api/drivers/<arg>/docs", Method::Get, [this](const QString& id, const QHttpServerRequest& req) {
-        return handleDriverDocs(id, req);
+        return cachedResponse(req, DependsOnDrivers, [&] { return handleDriverDocs(id, req); });
     });
     server.route("/api/drivers/<arg>", Method::Get, [this](const QString& id, const QHttpServerRequest& req) {
-        return handleDriverDetail(id, req);
+        return cachedResponse(req, DependsOnDrivers, [&] { return handleDriverDetail(id, req); });
     });
 
     server.route("/api/events/stream", Method::Get, this,
-                 [this](const QHttpServerRequest& req, QHttpServerResponder& responder) {
-                     handleEventStream(req, responder);
+                 [this, &server](const QHttpServerRequest& req, QHttpServerResponder& responder) {
+                     handleEventStream(req, responder, server.servers());
                  });
 
     server.route("/api/events", Method::Get, [this](const QHttpServerRequest& req) {
@@ -1147,6 +1184,7 @@ QHttpServerResponse ApiRouter::handleProjectCreate(const QHttpServerRequest& req
     }
 
     projects.insert(id, project);
+    m_manager->markProjectsChanged();
     m_manager->startScheduling();
 
     return jsonResponse(projectToJson(project, m_manager->instanceManager()),
@@ -1203,6 +1241,7 @@ QHttpServerResponse ApiRouter::handleProjectUpdate(const QString& id,
     }
 
     projects[id] = project;
+    m_manager->markProjectsChanged();
     m_manager->startScheduling();
 
     return jsonResponse(projectToJson(project, m_manager->instanceManager()));
@@ -1236,6 +1275,7 @@ QHttpServerResponse ApiRouter::handleProjectDelete(const QString& id,
     }
 
     projects.remove(id);
+    m_manager->markProjectsChanged();
 
     return noContentResponse();
 }
@@ -1304,7 +1344,8 @@ QHttpServerResponse ApiRouter::handleProjectStart(const QString& id,
         if (running > 0) {
             return errorResponse(QHttpServerResponse::StatusCode::Conflict, "already running");
         }
-    } else if (project.schedule.type == ScheduleType::FixedRate) {
+    } else if (project.schedule.type == ScheduleType::FixedRate
+               || project.schedule.type == ScheduleType::Cron) {
         if (running >= project.schedule.maxConcurrent) {
             return errorResponse(QHttpServerResponse::StatusCode::Conflict, "max concurrent reached");
         }
@@ -1380,6 +1421,7 @@ QHttpServerResponse ApiRouter::handleProjectReload(const QString& id,
         return projectBusyResponse(id);
     }
     m_manager->projects()[id] = project;
+    m_manager->markProjectsChanged();
     m_manager->startScheduling();
 
     return jsonResponse(projectToJson(project, m_manager->instanceManager()));
@@ -1409,6 +1451,12 @@ QHttpServerResponse ApiRouter::handleProjectRuntime(const QString& id,
     QJsonObject schedule;
     schedule["type"] = scheduleTypeToString(project.schedule.type);
     schedule["timerActive"] = runtime.timerActive;
+    schedule["startPending"] = runtime.startPending;
+    if (runtime.nextFireMs > 0) {
+        schedule["nextFireAt"] = QDateTime::fromMSecsSinceEpoch(runtime.nextFireMs)
+                                     .toUTC()
+                                     .toString(Qt::ISODateWithMs);
+    }
     schedule["restartSuppressed"] = runtime.restartSuppressed;
     schedule["consecutiveFailures"] = runtime.consecutiveFailures;
     schedule["shuttingDown"] = runtime.shuttingDown;
@@ -1482,6 +1530,7 @@ QHttpServerResponse ApiRouter::handleProjectEnabled(const QString& id,
     }
 
     *it = updated;
+    m_manager->markProjectsChanged();
 
     if (!newEnabled) {
     } else {
@@ -1509,14 +1558,15 @@ QHttpServerResponse ApiRouter::handleProjectLogs(const QString& id,
 
     const QString logPath = m_manager->dataRoot() + "/logs/" + id + ".log";
 
-    QJsonArray linesArray;
-    if (QFile::exists(logPath)) {
-        linesArray = readTailLines(logPath, lines);
-    }
-
     QJsonObject result;
     result["projectId"] = id;
-    result["lines"] = linesArray;
+    result["lines"] = QJsonArray();
+    if (QFile::exists(logPath)) {
+        QString error;
+        if (!readLogLines(logPath, query, lines, result, &error)) {
+            return errorResponse(QHttpServerResponse::StatusCode::BadRequest, error);
+        }
+    }
     result["logPath"] = logPath;
     return jsonResponse(result);
 }
@@ -1553,6 +1603,12 @@ QHttpServerResponse ApiRouter::handleProjectRuntimeBatch(const QHttpServerReques
         QJsonObject schedule;
         schedule["type"] = scheduleTypeToString(project.schedule.type);
         schedule["timerActive"] = runtime.timerActive;
+        schedule["startPending"] = runtime.startPending;
+        if (runtime.nextFireMs > 0) {
+            schedule["nextFireAt"] = QDateTime::fromMSecsSinceEpoch(runtime.nextFireMs)
+                                         .toUTC()
+                                         .toString(Qt::ISODateWithMs);
+        }
         schedule["restartSuppressed"] = runtime.restartSuppressed;
         schedule["consecutiveFailures"] = runtime.consecutiveFailures;
         schedule["shuttingDown"] = runtime.shuttingDown;
@@ -1635,8 +1691,12 @@ QHttpServerResponse ApiRouter::handleInstanceLogs(const QString& id,
         return errorResponse(QHttpServerResponse::StatusCode::NotFound, "log file not found");
     }
 
-    return jsonResponse(QJsonObject{{"projectId", projectId},
-                                    {"lines", readTailLines(logPath, lines)}});
+    QJsonObject result{{"projectId", projectId}};
+    QString error;
+    if (!readLogLines(logPath, query, lines, result, &error)) {
+        return errorResponse(QHttpServerResponse::StatusCode::BadRequest, error);
+    }
+    return jsonResponse(result);
 }
 
 QHttpServerResponse ApiRouter::handleDriverList(const QHttpServerRequest& req) {
@@ -1685,10 +1745,20 @@ QFuture<QHttpServerResponse> ApiRouter::handleDriverScan(const QHttpServerReques
 
     return m_manager->rescanDriversAsync(refreshMeta)
         .then([](DriverManagerScanner::ScanStats stats) {
+            QJsonArray drivers;
+            for (const auto& timing : stats.drivers) {
+                drivers.append(QJsonObject{{"name", timing.name},
+                                           {"action", timing.action},
+                                           {"elapsedMs", timing.elapsedMs}});
+            }
             return jsonResponse(QJsonObject{{"scanned", stats.scanned},
                                             {"updated", stats.updated},
                                             {"newlyFailed", stats.newlyFailed},
-                                            {"skippedFailed", stats.skippedFailed}});
+                                            {"skippedFailed", stats.skippedFailed},
+                                            {"exported", stats.exported},
+                                            {"cacheHits", stats.cacheHits},
+                                            {"elapsedMs", stats.elapsedMs},
+                                            {"drivers", drivers}});
         });
 }
 
@@ -1885,8 +1955,70 @@ QHttpServerResponse ApiRouter::handleInstanceResources(const QString& id,
     return jsonResponse(result);
 }
 
+QHttpServerResponse ApiRouter::handleInstanceMetrics(const QString& id,
+                                                      const QHttpServerRequest& req) {
+    if (!ProcessMonitor::isSupported()) {
+        return jsonResponse(QJsonObject{
+            {"error", "process monitoring not supported on this platform"},
+            {"code", "PROCESS_MONITOR_UNSUPPORTED"},
+            {"supported", false},
+            {"platform", QSysInfo::productType()}
+        }, QHttpServerResponse::StatusCode::NotImplemented);
+    }
+
+    const Instance* inst = m_manager->instanceManager()->getInstance(id);
+    if (!inst) {
+        return errorResponse(QHttpServerResponse::StatusCode::NotFound, "instance not found");
+    }
+
+    const QUrlQuery query(req.url());
+    // since 接受 epoch 毫秒或 ISO 8601，返回严格晚于该时刻的样本
+    qint64 sinceMs = 0;
+    const QString sinceParam = query.queryItemValue("since");
+    if (!sinceParam.isEmpty()) {
+        bool ok = false;
+        sinceMs = sinceParam.toLongLong(&ok);
+        if (!ok) {
+            const QDateTime dt = QDateTime::fromString(sinceParam, Qt::ISODateWithMs);
+            if (!dt.isValid()) {
+                return errorResponse(QHttpServerResponse::StatusCode::BadRequest,
+                                     "since must be epoch milliseconds or ISO 8601");
+            }
+            sinceMs = dt.toMSecsSinceEpoch();
+        }
+    }
+
+    auto* sampler = m_manager->resourceSampler();
+    int limit = sampler->historySize();
+    const QString limitParam = query.queryItemValue("limit");
+    if (!limitParam.isEmpty()) {
+        bool ok = false;
+        limit = limitParam.toInt(&ok);
+        if (!ok || limit < 1) {
+            return errorResponse(QHttpServerResponse::StatusCode::BadRequest,
+                                 "limit must be a positive integer");
+        }
+    }
+
+    const QVector<ResourceSample> samples = sampler->query(id, sinceMs, limit);
+    QJsonArray sampleArray;
+    for (const auto& s : samples) {
+        sampleArray.append(s.toJson());
+    }
+
+    QJsonObject result;
+    result["instanceId"] = id;
+    result["pid"] = inst->pid;
+    result["intervalMs"] = sampler->isRunning() ? sampler->intervalMs() : 0;
+    result["historySize"] = sampler->historySize();
+    result["samples"] = sampleArray;
+    result["nextSince"] = samples.isEmpty() ? sinceMs : samples.last().timestampMs;
+    return jsonResponse(result);
+}
+
 void ApiRouter::handleEventStream(const QHttpServerRequest& req,
-                                   QHttpServerResponder& responder) {
+                                   QHttpServerResponder& responder,
+                                   const QList<QTcpServer*>& listeners) {
     auto* handler = m_manager->eventStreamHandler();
 
     QSet<QString> filters;
@@ -1899,15 +2031,116 @@ void ApiRouter::handleEventStream(const QHttpServerRequest& req,
         }
     }
 
-    handler->addConnection(std::move(responder), filters);
+    // EventSource 重连时自动携带上次收到的 id，据此从重放缓冲补发
+    const QString lastEventId =
+        QString::fromUtf8(req.headers().value("Last-Event-ID").toByteArray()).trimmed();
+    // 定位承载本响应的套接字，用于按写缓冲积压暂停推送
+    QAbstractSocket* socket =
+        EventStreamHandler::findPeerSocket(listeners, req.remoteAddress(), req.remotePort());
+    handler->addConnection(std::move(responder), filters, lastEventId, socket);
+}
+
+void ApiRouter::handleLogStream(const QString& id,
+                                bool byInstance,
+                                const QHttpServerRequest& req,
+                                QHttpServerResponder& responder) {
+    const QString corsOrigin = m_manager->config().corsOrigin;
+    const auto reject = [&responder, &corsOrigin](QHttpServerResponder::StatusCode status,
+                                                  const QString& message) {
+        QHttpHeaders headers = CorsMiddleware::buildCorsHeaders(corsOrigin);
+        headers.append(QHttpHeaders::WellKnownHeader::ContentType, "application/json");
+        responder.write(QJsonDocument(QJsonObject{{"error", message}}).toJson(QJsonDocument::Compact),
+                        headers, status);
+    };
+
+    // 与 /logs 相同：实例路由也接受 projectId，以便实例结束后继续跟随同一日志
+    QString projectId;
+    if (byInstance) {
+        if (const Instance* inst = m_manager->instanceManager()->getInstance(id)) {
+            projectId = inst->projectId;
+        }
+    }
+    if (projectId.isEmpty() && m_manager->projects().contains(id)) {
+        projectId = id;
+    }
+    if (projectId.isEmpty()) {
+        reject(QHttpServerResponder::StatusCode::NotFound,
+               byInstance ? "instance not found" : "project not found");
+        return;
+    }
+
+    const QUrlQuery query(req.url());
+    LogStreamStart start;
+    const QString linesParam = query.queryItemValue("lines");
+    if (!linesParam.isEmpty()) {
+        bool ok = false;
+        start.tailLines = linesParam.toInt(&ok);
+        if (!ok || start.tailLines < 0 || start.tailLines > 5000) {
+            reject(QHttpServerResponder::StatusCode::BadRequest, "lines out of range");
+            return;
+        }
+    }
+
+    // 续传：EventSource 自动重连携带的 Last-Event-ID 比 URL 中的初始 offset 更新，优先使用
+    const QString lastEventId =
+        QString::fromUtf8(req.headers().value("Last-Event-ID").toByteArray());
+    const QString offsetParam = query.queryItemValue("offset");
+    if (!lastEventId.isEmpty() && LogStreamConnection::parseCursor(lastEventId, start.cursor)) {
+        start.resume = true;
+    } else if (!offsetParam.isEmpty()) {
+        bool ok = false;
+        start.cursor.offset = offsetParam.toLongLong(&ok);
+        if (!ok || start.cursor.offset < 0) {
+            reject(QHttpServerResponder::StatusCode::BadRequest,
+                   "offset must be a non-negative integer");
+            return;
+        }
+        start.cursor.fileId = query.queryItemValue("fileId");
+        start.resume = true;
+    }
+
+    const QString logPath = m_manager->dataRoot() + "/logs/" + projectId + ".log";
+    m_manager->logStreamHandler()->addConnection(std::move(responder), projectId, logPath, start);
 }
 
 QHttpServerResponse ApiRouter::handleEventList(const QHttpServerRequest& req) {
     const QUrlQuery query(req.url());
     const int rawLimit = query.queryItemValue("limit").toInt();
-    const int limit = rawLimit > 0 ? qBound(1, rawLimit, 1000) : 100;
-    const QString typePrefix = query.queryItemValue("type");
-    const QString projectId = query.queryItemValue("projectId");
+    EventQuery q;
+    q.limit = rawLimit > 0 ? qBound(1, rawLimit, 1000) : 100;
+    q.typePrefix = query.queryItemValue("type");
+    q.projectId = query.queryItemValue("projectId");
+
+    // 游标为事件 seq：since 取更新的事件，before 向更早翻页
+    const auto readSeq = [&query](const QString& key, qint64& out) {
+        const QString raw = query.queryItemValue(key);
+        if (raw.isEmpty()) {
+            return true;
+        }
+        bool ok = false;
+        out = raw.toLongLong(&ok);
+        return ok && out >= 0;
+    };
+    const auto readTime = [&query](const QString& key, qint64& out) {
+        const QString raw = query.queryItemValue(key);
+        if (raw.isEmpty()) {
+            return true;
+        }
+        const QDateTime dt = QDateTime::fromString(raw, Qt::ISODateWithMs);
+        if (!dt.isValid()) {
+            return false;
+        }
+        out = dt.toMSecsSinceEpoch();
+        return true;
+    };
+    if (!readSeq("since", q.since) || !readSeq("before", q.before)) {
+        return errorResponse(QHttpServerResponse::StatusCode::BadRequest,
+                             "since/before must be non-negative integers");
+    }
+    if (!readTime("from", q.fromMs) || !readTime("to", q.toMs)) {
+        return errorResponse(QHttpServerResponse::StatusCode::BadRequest,
+                             "from/to must be ISO 8601 timestamps");
+    }
 
     auto* eventLog = m_manager->eventLog();
     if (!eventLog) {
@@ -1916,11 +2149,16 @@ QHttpServerResponse ApiRouter::handleEventList(const QHttpServerRequest& req) {
             "event log not initialized");
     }
 
-    const QJsonArray events = eventLog->query(limit, typePrefix, projectId);
+    const QJsonArray events = eventLog->query(q);
 
     QJsonObject result;
     result["events"] = events;
     result["count"] = events.size();
+    result["latestSeq"] = eventLog->latestSeq();
+    if (events.size() >= q.limit) {
+        // 结果按 seq 倒序，最后一条即下一页的 before 游标
+        result["nextBefore"] = events.last().toObject().value("seq");
+    }
     return jsonResponse(result);
 }
 
@@ -6,6 +6,8 @@
 #include <QObject>
 #include <QSet>
 
+#include "response_cache.h"
+
 namespace stdiolink_server {
 
 class ServerManager;
@@ -21,6 +23,18 @@ public:
     void registerRoutes(QHttpServer& server);
 
 private:
+    /// GET 响应缓存所依赖的数据源
+    enum CacheDependency {
+        DependsOnServices = 0x1,
+        DependsOnProjects = 0x2,
+        DependsOnInstances = 0x4,
+        DependsOnDrivers = 0x8,
+    };
+
+    QHttpServerResponse cachedResponse(const QHttpServerRequest& req,
+                                       int dependencies,
+                                       const ResponseCache::Builder& builder);
+
     QHttpServerResponse handleServiceList(const QHttpServerRequest& req);
     QHttpServerResponse handleServiceCreate(const QHttpServerRequest& req);
     QHttpServerResponse handleServiceDetail(const QString& id,
@@ -78,6 +92,8 @@ private:
                                                    const QHttpServerRequest& req);
     QHttpServerResponse handleInstanceResources(const QString& id,
                                                  const QHttpServerRequest& req);
+    QHttpServerResponse handleInstanceMetrics(const QString& id,
+                                               const QHttpServerRequest& req);
 
     QHttpServerResponse handleServerStatus(const QHttpServerRequest& req);
     QHttpServerResponse handleInstanceDetail(const QString& id,
@@ -91,12 +107,18 @@ private:
     QFuture<QHttpServerResponse> handleDriverScan(const QHttpServerRequest& req);
 
     void handleEventStream(const QHttpServerRequest& req,
-                           QHttpServerResponder& responder);
+                           QHttpServerResponder& responder,
+                           const QList<QTcpServer*>& listeners);
     QHttpServerResponse handleEventList(const QHttpServerRequest& req);
+    void handleLogStream(const QString& id,
+                         bool byInstance,
+                         const QHttpServerRequest& req,
+                         QHttpServerResponder& responder);
 
     ServerManager* m_manager = nullptr;
     StaticFileServer* m_staticFileServer = nullptr;
     QSet<QString> m_projectMutationsInFlight;
+    ResponseCache m_responseCache;
 };
 
 } // namespace stdiolink_server
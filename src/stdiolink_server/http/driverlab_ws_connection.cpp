@@ -58,7 +58,7 @@ void DriverLabWsConnection::startDriver(bool queryMeta) {
 
     m_lastDriverStart = QDateTime::currentDateTimeUtc();
     m_metaSent = !queryMeta;  // Skip meta parsing on restart (already have it)
-    m_stdoutBuffer.clear();
+    m_stdoutFramer.clear();
 
     QStringList args = m_extraArgs;
     args.prepend(QStringLiteral("--profile=") + m_runMode);
@@ -215,28 +215,23 @@ void DriverLabWsConnection::onDriverStdoutReady() {
         return;
     }
 
-    m_stdoutBuffer.append(m_process->readAllStandardOutput());
+    m_stdoutFramer.append(m_process->readAllStandardOutput());
 
-    if (m_stdoutBuffer.size() > kMaxOutputBufferBytes) {
+    if (m_stdoutFramer.pendingSize() > kMaxOutputBufferBytes) {
         sendJson(QJsonObject{
             {"type", "error"},
             {"message", "output buffer overflow"},
             {"channel", "stdout"},
             {"limit", kMaxOutputBufferBytes}
         });
-        m_stdoutBuffer.clear();
+        m_stdoutFramer.clear();
         stopDriver();
         return;
     }
 
-    while (true) {
-        const int nlIndex = m_stdoutBuffer.indexOf('\n');
-        if (nlIndex < 0) {
-            break;
-        }
-
-        const QByteArray line = m_stdoutBuffer.left(nlIndex).trimmed();
-        m_stdoutBuffer.remove(0, nlIndex + 1);
+    QByteArrayView view;
+    while (m_stdoutFramer.nextLine(view)) {
+        const QByteArray line = QByteArray::fromRawData(view.data(), view.size()).trimmed();
 
         if (line.isEmpty()) {
             continue;
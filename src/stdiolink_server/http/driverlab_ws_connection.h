@@ -6,6 +6,7 @@
 #include <QProcess>
 #include <QWebSocket>
 #include <memory>
+#include "stdiolink/protocol/line_framer.h"
 
 namespace stdiolink_server {
 
@@ -54,7 +55,7 @@ private:
     QString m_program;
     QString m_runMode;  // "oneshot" | "keepalive"
     QStringList m_extraArgs;
-    QByteArray m_stdoutBuffer;
+    stdiolink::LineFramer m_stdoutFramer;
     bool m_metaSent = false;
     bool m_closing = false;
     QDateTime m_lastPongAt;
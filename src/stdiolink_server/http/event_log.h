@@ -4,9 +4,9 @@
 #include <QObject>
 #include <QString>
 #include <memory>
-#include <spdlog/spdlog.h>
 
 #include "event_bus.h"
+#include "event_store.h"
 
 namespace stdiolink_server {
 
@@ -22,13 +22,15 @@ public:
     QJsonArray query(int limit = 100,
                      const QString& typePrefix = QString(),
                      const QString& projectId = QString()) const;
+    QJsonArray query(const EventQuery& q) const;
+    qint64 latestSeq() const;
     QString logPath() const { return m_logPath; }
 
 private slots:
     void onEventPublished(const ServerEvent& event);
 
 private:
-    std::shared_ptr<spdlog::logger> m_logger;
+    std::unique_ptr<EventStore> m_store;
     QString m_logPath;
 };
 
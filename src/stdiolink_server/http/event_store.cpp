@@ -0,0 +1,483 @@
+#include "event_store.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <algorithm>
+#include <limits>
+
+namespace stdiolink_server {
+
+namespace {
+
+struct ParsedEvent {
+    QJsonObject record;
+    QString type;
+    QString projectId;
+    qint64 tsMs = 0;
+};
+
+bool parseEventLine(const QByteArray& line, ParsedEvent& out) {
+    const QJsonDocument doc = QJsonDocument::fromJson(line);
+    if (!doc.isObject()) {
+        return false;
+    }
+    out.record = doc.object();
+    out.type = out.record.value("type").toString();
+    out.projectId = out.record.value("data").toObject().value("projectId").toString();
+    const QDateTime ts = QDateTime::fromString(out.record.value("ts").toString(), Qt::ISODateWithMs);
+    out.tsMs = ts.isValid() ? ts.toMSecsSinceEpoch() : 0;
+    return true;
+}
+
+QJsonArray toJsonArray(const QStringList& list) {
+    QJsonArray arr;
+    for (const QString& s : list) {
+        arr.append(s);
+    }
+    return arr;
+}
+
+QStringList toStringList(const QJsonArray& arr) {
+    QStringList list;
+    for (const QJsonValue& v : arr) {
+        list.append(v.toString());
+    }
+    return list;
+}
+
+} // namespace
+
+QJsonObject EventStore::Block::toJson() const {
+    QJsonObject obj;
+    obj["seq"] = firstSeq;
+    obj["n"] = count;
+    obj["off"] = offset;
+    obj["len"] = length;
+    obj["t0"] = firstTsMs;
+    obj["t1"] = lastTsMs;
+    obj["types"] = toJsonArray(types);
+    obj["projects"] = toJsonArray(projects);
+    return obj;
+}
+
+bool EventStore::Block::fromJson(const QJsonObject& obj, Block& out) {
+    out.firstSeq = obj.value("seq").toInteger();
+    out.count = obj.value("n").toInt();
+    out.offset = obj.value("off").toInteger(-1);
+    out.length = obj.value("len").toInteger();
+    out.firstTsMs = obj.value("t0").toInteger();
+    out.lastTsMs = obj.value("t1").toInteger();
+    out.types = toStringList(obj.value("types").toArray());
+    out.projects = toStringList(obj.value("projects").toArray());
+    return out.firstSeq > 0 && out.count > 0 && out.offset >= 0 && out.length > 0;
+}
+
+EventStore::EventStore(const QString& logPath, qint64 maxBytes, int maxFiles, int ringCapacity)
+    : m_logPath(logPath),
+      m_maxBytes(maxBytes),
+      m_maxFiles(qMax(0, maxFiles)),
+      m_ringCapacity(qMax(0, ringCapacity)) {
+    load();
+    openActive();
+}
+
+EventStore::~EventStore() {
+    sealOpenBlock();
+}
+
+QString EventStore::segmentPath(int index) const {
+    if (index == 0) {
+        return m_logPath;
+    }
+    // 与 spdlog rotating_file_sink 的命名一致：events.jsonl -> events.1.jsonl
+    const QFileInfo info(m_logPath);
+    const QString base = info.path() + "/" + info.completeBaseName() + "." + QString::number(index);
+    return info.suffix().isEmpty() ? base : base + "." + info.suffix();
+}
+
+QString EventStore::indexPath(const QString& segmentPath) {
+    return segmentPath + ".idx";
+}
+
+qint64 EventStore::oldestSeq() const {
+    for (auto it = m_segments.rbegin(); it != m_segments.rend(); ++it) {
+        if (!it->blocks.empty()) {
+            return it->blocks.front().firstSeq;
+        }
+    }
+    return 0;
+}
+
+void EventStore::load() {
+    m_segments.assign(static_cast<size_t>(m_maxFiles) + 1, Segment{});
+    qint64 nextSeq = 1;
+    // 从最旧的段开始，保证无索引的段能接续前一段的 seq
+    for (int i = m_maxFiles; i >= 0; --i) {
+        loadSegment(i, nextSeq, i == 0);
+    }
+    m_nextSeq = nextSeq;
+}
+
+void EventStore::loadSegment(int index, qint64& nextSeq, bool active) {
+    const QString path = segmentPath(index);
+    QFile file(path);
+    if (!file.exists()) {
+        QFile::remove(indexPath(path));  // 段文件已被外部删除，残留索引作废
+        return;
+    }
+    Segment& seg = m_segments[static_cast<size_t>(index)];
+    seg.size = file.size();
+
+    // 读取已有索引，遇到越界、seq 不连续或与前段重叠即截断，其余部分重新扫描
+    std::vector<Block> blocks;
+    bool indexClean = true;
+    QFile idx(indexPath(path));
+    if (idx.open(QIODevice::ReadOnly)) {
+        qint64 expectSeq = -1;
+        qint64 prevEnd = 0;
+        while (!idx.atEnd()) {
+            const QByteArray line = idx.readLine().trimmed();
+            if (line.isEmpty()) {
+                continue;
+            }
+            Block block;
+            if (!Block::fromJson(QJsonDocument::fromJson(line).object(), block)
+                || block.offset < prevEnd || block.offset + block.length > seg.size
+                || (expectSeq < 0 ? block.firstSeq < nextSeq : block.firstSeq != expectSeq)) {
+                indexClean = false;
+                break;
+            }
+            expectSeq = block.lastSeq() + 1;
+            prevEnd = block.offset + block.length;
+            blocks.push_back(std::move(block));
+        }
+        idx.close();
+    }
+    if (!blocks.empty()) {
+        nextSeq = blocks.back().lastSeq() + 1;
+    }
+
+    // 扫描索引未覆盖的尾部（旧版无索引文件、崩溃前未落盘的块）
+    const qint64 indexedEnd = blocks.empty() ? 0 : blocks.back().offset + blocks.back().length;
+    const size_t indexedBlocks = blocks.size();
+    if (indexedEnd < seg.size && file.open(QIODevice::ReadOnly)) {
+        file.seek(indexedEnd);
+        const QByteArray tail = file.readAll();
+        file.close();
+
+        qint64 pos = 0;
+        qint64 completeEnd = 0;
+        while (pos < tail.size()) {
+            const qsizetype nl = tail.indexOf('\n', pos);
+            if (nl < 0) {
+                break;  // 未写完的半行
+            }
+            const QByteArray line = tail.mid(pos, nl - pos).trimmed();
+            const qint64 lineStart = indexedEnd + pos;
+            pos = nl + 1;
+            completeEnd = pos;
+            if (line.isEmpty()) {
+                continue;
+            }
+            ParsedEvent ev;
+            parseEventLine(line, ev);
+            if (blocks.size() == indexedBlocks || blocks.back().count >= kBlockEvents) {
+                Block block;
+                block.firstSeq = nextSeq;
+                block.offset = lineStart;
+                blocks.push_back(std::move(block));
+            }
+            extendBlock(blocks.back(), ev.tsMs, ev.type, ev.projectId, indexedEnd + pos);
+            ++nextSeq;
+        }
+        // 活动段截掉半行，否则后续追加会与之拼成一条损坏记录
+        if (active && indexedEnd + completeEnd < seg.size
+            && file.open(QIODevice::ReadWrite)) {
+            file.resize(indexedEnd + completeEnd);
+            file.close();
+            seg.size = indexedEnd + completeEnd;
+        }
+    }
+
+    // 补写新扫描出的块；活动段最后一个未满的块保持打开，随后续追加继续增长
+    if (!indexClean) {
+        QFile::remove(indexPath(path));
+        for (size_t i = 0; i < indexedBlocks; ++i) {
+            appendIndexLine(path, blocks[i]);
+        }
+    }
+    size_t persistEnd = blocks.size();
+    if (active && persistEnd > indexedBlocks && blocks.back().count < kBlockEvents) {
+        --persistEnd;
+        m_openBlock = true;
+    }
+    for (size_t i = indexedBlocks; i < persistEnd; ++i) {
+        appendIndexLine(path, blocks[i]);
+    }
+    seg.blocks = std::move(blocks);
+}
+
+void EventStore::openActive() {
+    QDir().mkpath(QFileInfo(m_logPath).absolutePath());
+    m_active.setFileName(m_logPath);
+    if (!m_active.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning("EventStore: cannot open %s: %s", qUtf8Printable(m_logPath),
+                 qUtf8Printable(m_active.errorString()));
+    }
+}
+
+void EventStore::appendIndexLine(const QString& segmentPath, const Block& block) {
+    QFile idx(indexPath(segmentPath));
+    if (!idx.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning("EventStore: cannot write index %s", qUtf8Printable(idx.fileName()));
+        return;
+    }
+    idx.write(QJsonDocument(block.toJson()).toJson(QJsonDocument::Compact));
+    idx.write("\n");
+}
+
+void EventStore::extendBlock(Block& block, qint64 tsMs, const QString& type,
+                             const QString& projectId, qint64 lineEnd) {
+    if (block.count == 0) {
+        block.firstTsMs = tsMs;
+    }
+    block.lastTsMs = tsMs;
+    block.firstTsMs = qMin(block.firstTsMs, tsMs);
+    ++block.count;
+    block.length = lineEnd - block.offset;
+    if (!type.isEmpty() && !block.types.contains(type)) {
+        block.types.append(type);
+    }
+    if (!projectId.isEmpty() && !block.projects.contains(projectId)) {
+        block.projects.append(projectId);
+    }
+}
+
+void EventStore::sealOpenBlock() {
+    if (!m_openBlock) {
+        return;
+    }
+    m_openBlock = false;
+    if (!m_segments.empty() && !m_segments.front().blocks.empty()) {
+        appendIndexLine(m_logPath, m_segments.front().blocks.back());
+    }
+}
+
+void EventStore::rotate() {
+    sealOpenBlock();
+    m_active.close();
+
+    if (m_maxFiles == 0) {
+        QFile::remove(m_logPath);
+        QFile::remove(indexPath(m_logPath));
+        m_segments.front() = Segment{};
+    } else {
+        // 与 spdlog 相同：依次后移 i-1 -> i，最旧的段被覆盖
+        for (int i = m_maxFiles; i > 0; --i) {
+            const QString src = segmentPath(i - 1);
+            if (!QFile::exists(src)) {
+                continue;
+            }
+            const QString target = segmentPath(i);
+            QFile::remove(target);
+            QFile::remove(indexPath(target));
+            QFile::rename(src, target);
+            QFile::rename(indexPath(src), indexPath(target));
+        }
+        m_segments.insert(m_segments.begin(), Segment{});
+        m_segments.pop_back();
+    }
+
+    // 环形缓冲不再返回已从磁盘淘汰的事件
+    const qint64 oldest = oldestSeq();
+    while (!m_ring.empty() && (oldest == 0 || m_ring.front().seq < oldest)) {
+        m_ring.pop_front();
+    }
+
+    openActive();
+}
+
+qint64 EventStore::append(const QString& type, const QJsonObject& data,
+                          const QDateTime& timestamp) {
+    if (!m_active.isOpen()) {
+        return 0;
+    }
+
+    QJsonObject record;
+    record["type"] = type;
+    record["data"] = data;
+    record["ts"] = timestamp.toString(Qt::ISODateWithMs);
+    QByteArray line = QJsonDocument(record).toJson(QJsonDocument::Compact);
+    line.append('\n');
+
+    if (m_segments.front().size > 0 && m_segments.front().size + line.size() > m_maxBytes) {
+        rotate();
+        if (!m_active.isOpen()) {
+            return 0;
+        }
+    }
+
+    if (m_active.write(line) != line.size() || !m_active.flush()) {
+        qWarning("EventStore: write failed: %s", qUtf8Printable(m_active.errorString()));
+        return 0;
+    }
+
+    Segment& seg = m_segments.front();
+    const qint64 seq = m_nextSeq++;
+    const qint64 tsMs = timestamp.toMSecsSinceEpoch();
+    const QString projectId = data.value("projectId").toString();
+
+    if (!m_openBlock) {
+        Block block;
+        block.firstSeq = seq;
+        block.offset = seg.size;
+        seg.blocks.push_back(std::move(block));
+        m_openBlock = true;
+    }
+    seg.size += line.size();
+    extendBlock(seg.blocks.back(), tsMs, type, projectId, seg.size);
+    if (seg.blocks.back().count >= kBlockEvents) {
+        sealOpenBlock();
+    }
+
+    if (m_ringCapacity > 0) {
+        RingEntry entry;
+        entry.seq = seq;
+        entry.tsMs = tsMs;
+        entry.type = type;
+        entry.projectId = projectId;
+        entry.record = std::move(record);
+        m_ring.push_back(std::move(entry));
+        while (static_cast<int>(m_ring.size()) > m_ringCapacity) {
+            m_ring.pop_front();
+        }
+    }
+    return seq;
+}
+
+bool EventStore::matches(const EventQuery& q, qint64 seq, qint64 tsMs, const QString& type,
+                         const QString& projectId) {
+    if (q.before > 0 && seq >= q.before) {
+        return false;
+    }
+    if (seq <= q.since) {
+        return false;
+    }
+    if (q.fromMs >= 0 && tsMs < q.fromMs) {
+        return false;
+    }
+    if (q.toMs >= 0 && tsMs > q.toMs) {
+        return false;
+    }
+    if (!q.typePrefix.isEmpty() && !type.startsWith(q.typePrefix)) {
+        return false;
+    }
+    return q.projectId.isEmpty() || projectId == q.projectId;
+}
+
+bool EventStore::blockMayMatch(const EventQuery& q, const Block& block) {
+    if (q.fromMs >= 0 && block.lastTsMs < q.fromMs) {
+        return false;
+    }
+    if (q.toMs >= 0 && block.firstTsMs > q.toMs) {
+        return false;
+    }
+    if (!q.projectId.isEmpty() && !block.projects.contains(q.projectId)) {
+        return false;
+    }
+    if (!q.typePrefix.isEmpty()) {
+        return std::any_of(block.types.cbegin(), block.types.cend(),
+                           [&](const QString& t) { return t.startsWith(q.typePrefix); });
+    }
+    return true;
+}
+
+QJsonArray EventStore::query(const EventQuery& q) const {
+    QJsonArray out;
+    if (q.limit <= 0) {
+        return out;
+    }
+
+    for (auto it = m_ring.rbegin(); it != m_ring.rend(); ++it) {
+        if (it->seq <= q.since) {
+            return out;
+        }
+        if (!matches(q, it->seq, it->tsMs, it->type, it->projectId)) {
+            continue;
+        }
+        QJsonObject record = it->record;
+        record["seq"] = it->seq;
+        out.append(record);
+        if (out.size() >= q.limit) {
+            return out;
+        }
+    }
+
+    // 环形缓冲之前的事件走磁盘索引
+    qint64 upper = q.before > 0 ? q.before : std::numeric_limits<qint64>::max();
+    if (!m_ring.empty()) {
+        upper = qMin(upper, m_ring.front().seq);
+    }
+    if (upper - 1 > q.since) {
+        queryDisk(q, upper, out);
+    }
+    return out;
+}
+
+void EventStore::queryDisk(const EventQuery& q, qint64 upperSeq, QJsonArray& out) const {
+    for (size_t s = 0; s < m_segments.size(); ++s) {
+        const Segment& seg = m_segments[s];
+        if (seg.blocks.empty()) {
+            continue;
+        }
+        QFile file(segmentPath(static_cast<int>(s)));
+
+        for (auto it = seg.blocks.rbegin(); it != seg.blocks.rend(); ++it) {
+            const Block& block = *it;
+            if (block.lastSeq() <= q.since) {
+                return;
+            }
+            if (block.firstSeq >= upperSeq || !blockMayMatch(q, block)) {
+                continue;
+            }
+            if (!file.isOpen() && !file.open(QIODevice::ReadOnly)) {
+                break;
+            }
+            if (!file.seek(block.offset)) {
+                break;
+            }
+            const QByteArray bytes = file.read(block.length);
+
+            QList<QByteArray> lines;
+            lines.reserve(block.count);
+            for (const QByteArray& raw : bytes.split('\n')) {
+                const QByteArray line = raw.trimmed();
+                if (!line.isEmpty()) {
+                    lines.append(line);
+                }
+            }
+            for (qsizetype i = lines.size() - 1; i >= 0; --i) {
+                const qint64 seq = block.firstSeq + i;
+                if (seq >= upperSeq) {
+                    continue;
+                }
+                if (seq <= q.since) {
+                    return;
+                }
+                ParsedEvent ev;
+                if (!parseEventLine(lines[i], ev)
+                    || !matches(q, seq, ev.tsMs, ev.type, ev.projectId)) {
+                    continue;
+                }
+                ev.record["seq"] = seq;
+                out.append(ev.record);
+                if (out.size() >= q.limit) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+} // namespace stdiolink_server
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <deque>
+#include <vector>
+
+namespace stdiolink_server {
+
+/// 事件查询条件，游标均为 seq（事件序号，单调递增，从 1 开始）
+struct EventQuery {
+    int limit = 100;
+    QString typePrefix;
+    QString projectId;
+    qint64 since = 0;     ///< 仅返回 seq > since，0 表示不限
+    qint64 before = 0;    ///< 仅返回 seq < before，0 表示不限
+    qint64 fromMs = -1;   ///< 仅返回 ts >= fromMs（epoch 毫秒），-1 表示不限
+    qint64 toMs = -1;     ///< 仅返回 ts <= toMs（epoch 毫秒），-1 表示不限
+};
+
+/// 分段追加式事件存储
+///
+/// 磁盘布局与旧版 spdlog rotating sink 相同：活动段为 logPath，
+/// 轮转段为 events.1.jsonl ... events.N.jsonl，每行一条 {"data","ts","type"}。
+/// 每个段旁有一个 `<段文件>.idx` 稀疏索引，每 kBlockEvents 条事件一行，
+/// 记录块的首 seq、条数、字节区间、时间范围以及块内出现的 type / projectId 集合。
+/// seq 不写入事件行，由索引块的首 seq 加行序推出，因此旧版无索引的日志文件
+/// 可在启动时补建索引后继续使用。
+///
+/// 查询从最新事件向旧事件遍历：先查内存环形缓冲，未满足 limit 时按索引块
+/// 倒序跳过不可能命中的块，只读取候选块的字节区间，代价与结果规模相关，
+/// 与历史总量无关。非线程安全，仅在主线程使用。
+class EventStore {
+public:
+    static constexpr int kBlockEvents = 64;
+    static constexpr int kDefaultRingCapacity = 1024;
+
+    EventStore(const QString& logPath, qint64 maxBytes, int maxFiles,
+               int ringCapacity = kDefaultRingCapacity);
+    ~EventStore();
+
+    EventStore(const EventStore&) = delete;
+    EventStore& operator=(const EventStore&) = delete;
+
+    /// 追加一条事件，返回分配的 seq；写入失败返回 0
+    qint64 append(const QString& type, const QJsonObject& data, const QDateTime& timestamp);
+
+    /// 按 seq 倒序返回命中的事件，每条附带 "seq" 字段
+    QJsonArray query(const EventQuery& q) const;
+
+    /// 最近一条事件的 seq，尚无事件时为 0
+    qint64 latestSeq() const { return m_nextSeq - 1; }
+
+    /// 仍保留在磁盘上的最早事件 seq，尚无事件时为 0
+    qint64 oldestSeq() const;
+
+    QString logPath() const { return m_logPath; }
+
+private:
+    struct Block {
+        qint64 firstSeq = 0;
+        int count = 0;
+        qint64 offset = 0;
+        qint64 length = 0;
+        qint64 firstTsMs = 0;
+        qint64 lastTsMs = 0;
+        QStringList types;
+        QStringList projects;
+
+        qint64 lastSeq() const { return firstSeq + count - 1; }
+        QJsonObject toJson() const;
+        static bool fromJson(const QJsonObject& obj, Block& out);
+    };
+
+    struct Segment {
+        std::vector<Block> blocks;   ///< 按 seq 升序
+        qint64 size = 0;
+    };
+
+    struct RingEntry {
+        qint64 seq = 0;
+        qint64 tsMs = 0;
+        QString type;
+        QString projectId;
+        QJsonObject record;
+    };
+
+    QString segmentPath(int index) const;
+    static QString indexPath(const QString& segmentPath);
+
+    void load();
+    void loadSegment(int index, qint64& nextSeq, bool active);
+    void openActive();
+    void rotate();
+    void sealOpenBlock();
+    static void appendIndexLine(const QString& segmentPath, const Block& block);
+    static void extendBlock(Block& block, qint64 tsMs, const QString& type,
+                            const QString& projectId, qint64 lineEnd);
+
+    static bool matches(const EventQuery& q, qint64 seq, qint64 tsMs, const QString& type,
+                        const QString& projectId);
+    static bool blockMayMatch(const EventQuery& q, const Block& block);
+    void queryDisk(const EventQuery& q, qint64 upperSeq, QJsonArray& out) const;
+
+    QString m_logPath;
+    qint64 m_maxBytes;
+    int m_maxFiles;
+    int m_ringCapacity;
+
+    QFile m_active;
+    std::vector<Segment> m_segments;  ///< [0] 为活动段，其余按轮转编号递增（越往后越旧）
+    bool m_openBlock = false;         ///< 活动段最后一个块尚未写入索引
+    qint64 m_nextSeq = 1;
+    std::deque<RingEntry> m_ring;     ///< 最近事件，尾部最新
+};
+
+} // namespace stdiolink_server
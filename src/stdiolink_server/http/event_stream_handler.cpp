@@ -1,22 +1,73 @@
 #include "event_stream_handler.h"
 
+#include <QHostAddress>
 #include <QHttpHeaders>
 #include <QJsonDocument>
+#include <QTcpServer>
+#include <QTcpSocket>
 
 #include "cors_middleware.h"
 
 namespace stdiolink_server {
 
+// ---- EventFrameQueue ----
+
+EventFrameQueue::EventFrameQueue(int capacity)
+    : m_capacity(qMax(1, capacity)) {
+}
+
+void EventFrameQueue::push(const QByteArray& frame) {
+    if (static_cast<int>(m_frames.size()) >= m_capacity) {
+        m_queuedBytes -= m_frames.front().size();
+        m_frames.pop_front();
+        ++m_pendingDropped;
+        ++m_totalDropped;
+    }
+    m_frames.push_back(frame);
+    m_queuedBytes += frame.size();
+}
+
+QByteArray EventFrameQueue::takeUpTo(qsizetype maxBytes) {
+    if (m_frames.empty()) {
+        return {};
+    }
+    // 单帧时直接交出共享缓冲，避免拷贝
+    if (m_frames.size() == 1 || m_frames.front().size() + m_frames[1].size() > maxBytes) {
+        QByteArray chunk = std::move(m_frames.front());
+        m_frames.pop_front();
+        m_queuedBytes -= chunk.size();
+        return chunk;
+    }
+
+    QByteArray chunk;
+    chunk.reserve(qMin(m_queuedBytes, maxBytes));
+    while (!m_frames.empty()
+           && (chunk.isEmpty() || chunk.size() + m_frames.front().size() <= maxBytes)) {
+        chunk.append(m_frames.front());
+        m_queuedBytes -= m_frames.front().size();
+        m_frames.pop_front();
+    }
+    return chunk;
+}
+
+qint64 EventFrameQueue::takeDropped() {
+    const qint64 dropped = m_pendingDropped;
+    m_pendingDropped = 0;
+    return dropped;
+}
+
 // ---- EventStreamConnection ----
 
 EventStreamConnection::EventStreamConnection(QHttpServerResponder&& responder,
                                              const QSet<QString>& filters,
                                              const QString& allowedOrigin,
+                                             int queueCapacity,
                                              QObject* parent)
     : QObject(parent)
     , m_responder(std::move(responder))
     , m_filters(filters)
     , m_allowedOrigin(allowedOrigin)
+    , m_queue(queueCapacity)
     , m_createdAt(QDateTime::currentDateTimeUtc())
     , m_lastSendAt(m_createdAt) {
 }
@@ -30,21 +81,60 @@ void EventStreamConnection::beginStream() {
     m_streamOpen = true;
 }
 
-void EventStreamConnection::sendEvent(const ServerEvent& event) {
-    QByteArray chunk;
-    chunk.append("event: ");
-    chunk.append(event.type.toUtf8());
-    chunk.append('\n');
-    chunk.append("data: ");
-    chunk.append(QJsonDocument(event.data).toJson(QJsonDocument::Compact));
-    chunk.append("\n\n");
+void EventStreamConnection::setSocket(QAbstractSocket* socket, qsizetype maxBacklogBytes) {
+    if (m_socket) {
+        disconnect(m_socket, &QAbstractSocket::bytesWritten, this, nullptr);
+    }
+    m_socket = socket;
+    m_maxBacklogBytes = maxBacklogBytes;
+    if (m_socket) {
+        connect(m_socket, &QAbstractSocket::bytesWritten, this, [this]() {
+            if (hasPending() && !isBacklogged()) {
+                emit writable();
+            }
+        });
+    }
+}
+
+qint64 EventStreamConnection::outboundBacklog() const {
+    return m_socket ? m_socket->bytesToWrite() : 0;
+}
+
+bool EventStreamConnection::isBacklogged() const {
+    return m_maxBacklogBytes > 0 && outboundBacklog() > m_maxBacklogBytes;
+}
+
+void EventStreamConnection::flush(qsizetype maxBytes, const QString& lastEventId) {
+    if (!m_streamOpen) {
+        return;
+    }
+    // 客户端读得慢时不再往套接字写缓冲里追加，让帧留在有界队列里由丢弃策略兜底
+    if (isBacklogged()) {
+        return;
+    }
+    const qint64 dropped = m_queue.takeDropped();
+    if (dropped > 0) {
+        // 丢弃的帧无法再按 id 续传，告知客户端最新 id 以便经 /api/events 补查
+        m_responder.writeChunk(formatFrame(QStringLiteral("dropped"), QJsonObject{
+            {"dropped", dropped},
+            {"totalDropped", m_queue.totalDropped()},
+            {"lastEventId", lastEventId}
+        }));
+    }
+    const QByteArray chunk = m_queue.takeUpTo(maxBytes);
+    if (chunk.isEmpty()) {
+        return;
+    }
     m_responder.writeChunk(chunk);
     m_lastSendAt = QDateTime::currentDateTimeUtc();
 }
 
 void EventStreamConnection::sendHeartbeat() {
+    if (!m_streamOpen) {
+        return;
+    }
     m_responder.writeChunk(": heartbeat\n\n");
-    // Do NOT update m_lastSendAt here. Only sendEvent() updates it,
+    // Do NOT update m_lastSendAt here. Only flush() updates it,
     // so that sweepStaleConnections() can detect connections where no
     // real data has been delivered for longer than the timeout window.
     // If writeChunk() silently fails on a dead socket, the stale
@@ -71,6 +161,25 @@ QDateTime EventStreamConnection::lastSendAt() const {
     return m_lastSendAt;
 }
 
+QByteArray EventStreamConnection::formatFrame(const QString& type, const QJsonObject& data,
+                                              const QString& id) {
+    const QByteArray json = QJsonDocument(data).toJson(QJsonDocument::Compact);
+    QByteArray frame;
+    frame.reserve(json.size() + type.size() + id.size() + 24);
+    if (!id.isEmpty()) {
+        frame.append("id: ");
+        frame.append(id.toUtf8());
+        frame.append('\n');
+    }
+    frame.append("event: ");
+    frame.append(type.toUtf8());
+    frame.append('\n');
+    frame.append("data: ");
+    frame.append(json);
+    frame.append("\n\n");
+    return frame;
+}
+
 bool EventStreamConnection::matchesFilter(const QString& eventType) const {
     return matchesFilter(m_filters, eventType);
 }
@@ -92,13 +201,22 @@ bool EventStreamConnection::matchesFilter(const QSet<QString>& filters,
 
 EventStreamHandler::EventStreamHandler(EventBus* bus,
                                        const QString& allowedOrigin,
+                                       int maxConnections,
                                        QObject* parent)
     : QObject(parent)
     , m_bus(bus)
-    , m_allowedOrigin(allowedOrigin) {
+    , m_allowedOrigin(allowedOrigin)
+    , m_maxConnections(qMax(1, maxConnections))
+    // 每次启动一个新纪元，旧进程签发的 Last-Event-ID 不会被误认为本进程的 seq
+    , m_epoch(QString::number(QDateTime::currentMSecsSinceEpoch(), 36)) {
     connect(m_bus, &EventBus::eventPublished,
             this, &EventStreamHandler::onEventPublished);
 
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushIntervalMs);
+    connect(&m_flushTimer, &QTimer::timeout,
+            this, &EventStreamHandler::onFlush);
+
     m_heartbeatTimer.setInterval(kHeartbeatIntervalMs);
     connect(&m_heartbeatTimer, &QTimer::timeout,
             this, &EventStreamHandler::onHeartbeat);
@@ -110,22 +228,48 @@ EventStreamHandler::~EventStreamHandler() {
 }
 
 void EventStreamHandler::addConnection(QHttpServerResponder&& responder,
-                                        const QSet<QString>& filters) {
-    if (m_connections.size() >= kMaxSseConnections) {
+                                        const QSet<QString>& filters,
+                                        const QString& lastEventId,
+                                        QAbstractSocket* socket) {
+    if (m_connections.size() >= m_maxConnections) {
         evictOldestConnection();
     }
 
     auto* conn = new EventStreamConnection(std::move(responder),
                                            filters,
                                            m_allowedOrigin,
+                                           kQueueCapacity,
                                            this);
     connect(conn, &EventStreamConnection::disconnected,
             this, &EventStreamHandler::onConnectionDisconnected);
+    connect(conn, &EventStreamConnection::writable,
+            this, &EventStreamHandler::onConnectionWritable);
+    if (socket) {
+        conn->setSocket(socket, kMaxSocketBacklogBytes);
+    }
     m_connections.append(conn);
     conn->beginStream();
+
+    if (lastEventId.isEmpty()) {
+        return;
+    }
+    QVector<QByteArray> frames;
+    if (replayFramesSince(lastEventId, filters, frames)) {
+        for (const QByteArray& frame : frames) {
+            conn->enqueue(frame);
+        }
+    } else {
+        conn->enqueue(EventStreamConnection::formatFrame(QStringLiteral("reset"), QJsonObject{
+            {"lastEventId", this->lastEventId()}
+        }));
+    }
+    if (conn->hasPending() && !m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
 }
 
 void EventStreamHandler::closeAllConnections() {
+    m_flushTimer.stop();
     m_heartbeatTimer.stop();
     const QVector<EventStreamConnection*> connections = m_connections;
     m_connections.clear();
@@ -141,16 +285,103 @@ void EventStreamHandler::closeAllConnections() {
     }
 }
 
+QAbstractSocket* EventStreamHandler::findPeerSocket(const QList<QTcpServer*>& listeners,
+                                                    const QHostAddress& address,
+                                                    quint16 port) {
+    // QTcpServer 接受的连接是它的子对象
+    for (QTcpServer* listener : listeners) {
+        if (!listener) {
+            continue;
+        }
+        const auto sockets = listener->findChildren<QTcpSocket*>(Qt::FindDirectChildrenOnly);
+        for (QTcpSocket* socket : sockets) {
+            if (socket->peerPort() == port
+                && socket->peerAddress().isEqual(address, QHostAddress::TolerantConversion)) {
+                return socket;
+            }
+        }
+    }
+    qWarning("EventStreamHandler: no accepted socket for peer %s:%u, "
+             "SSE write backpressure disabled for this connection",
+             qUtf8Printable(address.toString()), static_cast<unsigned>(port));
+    return nullptr;
+}
+
 int EventStreamHandler::activeConnectionCount() const {
     return m_connections.size();
 }
 
+QString EventStreamHandler::lastEventId() const {
+    return m_lastSeq == 0 ? QString() : formatEventId(m_lastSeq);
+}
+
+QString EventStreamHandler::formatEventId(quint64 seq) const {
+    return m_epoch + '-' + QString::number(seq);
+}
+
+bool EventStreamHandler::replayFramesSince(const QString& lastEventId,
+                                           const QSet<QString>& filters,
+                                           QVector<QByteArray>& out) const {
+    out.clear();
+    const qsizetype sep = lastEventId.lastIndexOf('-');
+    if (sep <= 0 || lastEventId.left(sep) != m_epoch) {
+        return false;
+    }
+    bool ok = false;
+    const quint64 seq = lastEventId.mid(sep + 1).toULongLong(&ok);
+    if (!ok || seq > m_lastSeq) {
+        return false;
+    }
+    // 缓冲中最早的帧必须紧接在客户端已收到的 seq 之后，否则中间有缺口
+    const quint64 oldest = m_replay.empty() ? m_lastSeq + 1 : m_replay.front().seq;
+    if (seq + 1 < oldest) {
+        return false;
+    }
+    for (const ReplayEntry& entry : m_replay) {
+        if (entry.seq > seq && EventStreamConnection::matchesFilter(filters, entry.type)) {
+            out.append(entry.frame);
+        }
+    }
+    return true;
+}
+
 void EventStreamHandler::onEventPublished(const ServerEvent& event) {
+    // 只序列化一次；各连接队列与重放缓冲共享同一 QByteArray
+    const quint64 seq = ++m_lastSeq;
+    const QByteArray frame =
+        EventStreamConnection::formatFrame(event.type, event.data, formatEventId(seq));
+    m_replay.push_back(ReplayEntry{seq, event.type, frame});
+    if (static_cast<int>(m_replay.size()) > kReplayBufferSize) {
+        m_replay.pop_front();
+    }
+
+    bool queued = false;
     for (auto* conn : m_connections) {
         if (conn->matchesFilter(event.type)) {
-            conn->sendEvent(event);
+            conn->enqueue(frame);
+            queued = true;
         }
     }
+    if (queued && !m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+void EventStreamHandler::onFlush() {
+    const QString latestId = lastEventId();
+    bool pending = false;
+    for (auto* conn : m_connections) {
+        if (!conn->hasPending()) {
+            continue;
+        }
+        conn->flush(kMaxFlushBytes, latestId);
+        pending = pending || (conn->hasPending() && !conn->isBacklogged());
+    }
+    // 超出单轮写出上限的连接留到下一轮；套接字积压的连接不占用定时器，
+    // 由其 writable() 恢复，期间新事件继续在其队列内排队或丢弃
+    if (pending) {
+        m_flushTimer.start();
+    }
 }
 
 void EventStreamHandler::onHeartbeat() {
@@ -170,6 +401,12 @@ void EventStreamHandler::onConnectionDisconnected() {
     }
 }
 
+void EventStreamHandler::onConnectionWritable() {
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
 void EventStreamHandler::sweepStaleConnections() {
     const QDateTime now = QDateTime::currentDateTimeUtc();
     QVector<EventStreamConnection*> stale;
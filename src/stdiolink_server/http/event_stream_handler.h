@@ -3,76 +3,181 @@
 #include <QDateTime>
 #include <QHttpServerResponder>
 #include <QObject>
+#include <QPointer>
 #include <QSet>
 #include <QTimer>
 #include <QVector>
+#include <deque>
 
 #include "event_bus.h"
 
+class QAbstractSocket;
+class QHostAddress;
+class QTcpServer;
+
 namespace stdiolink_server {
 
+/// 单个连接的有界出站帧队列：满时丢弃最旧帧并累计丢弃数
+///
+/// 帧为 EventStreamHandler 序列化一次后共享的 QByteArray，入队不复制数据。
+class EventFrameQueue {
+public:
+    explicit EventFrameQueue(int capacity);
+
+    void push(const QByteArray& frame);
+    /// 取出队首若干帧拼接为一个 chunk，总长不超过 maxBytes（至少取一帧）
+    QByteArray takeUpTo(qsizetype maxBytes);
+
+    bool isEmpty() const { return m_frames.empty(); }
+    int size() const { return static_cast<int>(m_frames.size()); }
+    qsizetype queuedBytes() const { return m_queuedBytes; }
+
+    /// 取出上次调用以来新增的丢弃帧数
+    qint64 takeDropped();
+    qint64 totalDropped() const { return m_totalDropped; }
+
+private:
+    std::deque<QByteArray> m_frames;
+    int m_capacity;
+    qsizetype m_queuedBytes = 0;
+    qint64 m_pendingDropped = 0;
+    qint64 m_totalDropped = 0;
+};
+
 class EventStreamConnection : public QObject {
     Q_OBJECT
 public:
     EventStreamConnection(QHttpServerResponder&& responder,
                           const QSet<QString>& filters,
                           const QString& allowedOrigin,
+                          int queueCapacity,
                           QObject* parent = nullptr);
 
     void beginStream();
-    void sendEvent(const ServerEvent& event);
+    void enqueue(const QByteArray& frame) { m_queue.push(frame); }
+    bool hasPending() const { return !m_queue.isEmpty(); }
+
+    /// 关联底层套接字：其待发送字节超过 maxBacklogBytes 时 flush() 暂停写出，
+    /// 积压回落后由套接字的 bytesWritten 触发 writable()
+    void setSocket(QAbstractSocket* socket, qsizetype maxBacklogBytes);
+    /// 底层套接字尚未写出的字节数；未关联套接字时为 0
+    qint64 outboundBacklog() const;
+    bool isBacklogged() const;
+
+    /// 写出至多 maxBytes 的排队帧；期间有丢弃时先发送一个 dropped 事件。
+    /// 套接字积压超限时不写出，帧留在队列中，队列满后按丢弃策略处理
+    void flush(qsizetype maxBytes, const QString& lastEventId);
     void sendHeartbeat();
     void close();
     bool matchesFilter(const QString& eventType) const;
 
     QDateTime createdAt() const;
     QDateTime lastSendAt() const;
+    qint64 totalDropped() const { return m_queue.totalDropped(); }
 
+    static QByteArray formatFrame(const QString& type, const QJsonObject& data,
+                                  const QString& id = QString());
     static bool matchesFilter(const QSet<QString>& filters, const QString& eventType);
 
 signals:
     void disconnected();
+    /// 套接字积压回落到上限以内且队列中仍有帧
+    void writable();
 
 private:
     QHttpServerResponder m_responder;
     QSet<QString> m_filters;
     QString m_allowedOrigin;
+    EventFrameQueue m_queue;
+    QPointer<QAbstractSocket> m_socket;
+    qsizetype m_maxBacklogBytes = 0;
     bool m_streamOpen = false;
     QDateTime m_createdAt;
     QDateTime m_lastSendAt;
 };
 
+/// 全局事件实时推送
+///
+/// 每个事件只序列化一次为带 `id` 的 SSE 帧，存入重放环形缓冲并以共享 QByteArray
+/// 放入各匹配连接的有界队列，由 kFlushIntervalMs 合并定时器批量写出，每个连接每轮
+/// 至多写 kMaxFlushBytes；套接字待发送字节超过 kMaxSocketBacklogBytes 的连接本轮跳过，
+/// 且不再为其重启定时器，直到其套接字写出数据使积压回落。
+/// 慢连接只会在自己的队列里丢帧（随后收到 `dropped`），不会拖慢其他连接，也不会
+/// 让服务端的套接字写缓冲无限增长。EventSource 重连携带 Last-Event-ID 时从环形缓冲补发；
+/// 缺口无法补齐（服务器重启或已滚出缓冲）时发送 `reset`，由客户端重新拉取状态。
 class EventStreamHandler : public QObject {
     Q_OBJECT
 public:
     explicit EventStreamHandler(EventBus* bus,
                                 const QString& allowedOrigin = QStringLiteral("*"),
+                                int maxConnections = kMaxSseConnections,
                                 QObject* parent = nullptr);
     ~EventStreamHandler() override;
 
+    /// socket 为承载该响应的连接（见 findPeerSocket），为空时不做写出背压
     void addConnection(QHttpServerResponder&& responder,
-                       const QSet<QString>& filters);
+                       const QSet<QString>& filters,
+                       const QString& lastEventId = QString(),
+                       QAbstractSocket* socket = nullptr);
     void closeAllConnections();
 
     int activeConnectionCount() const;
-
-    static constexpr int kMaxSseConnections = 32;
+    int maxConnections() const { return m_maxConnections; }
+
+    /// 最近一个事件的 SSE id，形如 "<epoch>-<seq>"；尚无事件时为空
+    QString lastEventId() const;
+
+    /// 重放 lastEventId 之后、匹配 filters 的已序列化帧；缺口无法补齐时返回 false
+    bool replayFramesSince(const QString& lastEventId,
+                           const QSet<QString>& filters,
+                           QVector<QByteArray>& out) const;
+
+    /// 合并写出定时器是否在运行；只剩积压连接有待发帧时停止
+    bool isFlushScheduled() const { return m_flushTimer.isActive(); }
+
+    /// 在监听器已接受的连接中按对端地址与端口查找请求所在的套接字
+    ///
+    /// 依赖 QTcpServer 把接受的连接作为直接子对象（Qt 未文档化的实现细节）；
+    /// 找不到时输出警告并返回 nullptr，调用方退化为无写出背压
+    static QAbstractSocket* findPeerSocket(const QList<QTcpServer*>& listeners,
+                                           const QHostAddress& address, quint16 port);
+
+    static constexpr int kMaxSseConnections = 512;
+    static constexpr int kQueueCapacity = 1024;
+    static constexpr int kReplayBufferSize = 1024;
+    static constexpr qsizetype kMaxFlushBytes = 256 * 1024;
+    static constexpr qsizetype kMaxSocketBacklogBytes = 4 * kMaxFlushBytes;
+    static constexpr int kFlushIntervalMs = 20;
     static constexpr int kHeartbeatIntervalMs = 30000;
     static constexpr int kConnectionTimeoutMs = kHeartbeatIntervalMs * 2;
 
 private slots:
     void onEventPublished(const ServerEvent& event);
+    void onFlush();
     void onHeartbeat();
     void onConnectionDisconnected();
+    void onConnectionWritable();
 
 private:
     void removeConnection(EventStreamConnection* conn);
     void evictOldestConnection();
     void sweepStaleConnections();
+    QString formatEventId(quint64 seq) const;
+
+    struct ReplayEntry {
+        quint64 seq = 0;
+        QString type;
+        QByteArray frame;
+    };
 
     EventBus* m_bus;
     QString m_allowedOrigin;
+    int m_maxConnections;
+    QString m_epoch;
+    quint64 m_lastSeq = 0;
+    std::deque<ReplayEntry> m_replay;
     QVector<EventStreamConnection*> m_connections;
+    QTimer m_flushTimer;
     QTimer m_heartbeatTimer;
 };
 
@@ -0,0 +1,286 @@
+#include "log_stream_handler.h"
+
+#include <QHash>
+#include <QHttpHeaders>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include "cors_middleware.h"
+
+namespace stdiolink_server {
+
+// ---- LogLineQueue ----
+
+LogLineQueue::LogLineQueue(int capacity)
+    : m_capacity(qMax(1, capacity)) {
+}
+
+void LogLineQueue::push(const QString& line) {
+    if (static_cast<int>(m_lines.size()) >= m_capacity) {
+        m_lines.pop_front();
+        ++m_pendingDropped;
+        ++m_totalDropped;
+    }
+    m_lines.push_back(line);
+}
+
+QStringList LogLineQueue::takeAll() {
+    QStringList out;
+    out.reserve(static_cast<qsizetype>(m_lines.size()));
+    for (auto& line : m_lines) {
+        out.append(std::move(line));
+    }
+    m_lines.clear();
+    return out;
+}
+
+qint64 LogLineQueue::takeDropped() {
+    const qint64 dropped = m_pendingDropped;
+    m_pendingDropped = 0;
+    return dropped;
+}
+
+// ---- LogStreamConnection ----
+
+LogStreamConnection::LogStreamConnection(QHttpServerResponder&& responder,
+                                         const QString& projectId,
+                                         const QString& logPath,
+                                         const QString& allowedOrigin,
+                                         int queueCapacity,
+                                         QObject* parent)
+    : QObject(parent)
+    , m_responder(std::move(responder))
+    , m_projectId(projectId)
+    , m_logPath(logPath)
+    , m_allowedOrigin(allowedOrigin)
+    , m_queue(queueCapacity)
+    , m_createdAt(QDateTime::currentDateTimeUtc())
+    , m_lastSendAt(m_createdAt) {
+}
+
+void LogStreamConnection::beginStream() {
+    QHttpHeaders headers = CorsMiddleware::buildCorsHeaders(m_allowedOrigin);
+    headers.append(QHttpHeaders::WellKnownHeader::ContentType, "text/event-stream");
+    headers.append(QHttpHeaders::WellKnownHeader::CacheControl, "no-cache");
+    headers.append("X-Accel-Buffering", "no");
+    m_responder.writeBeginChunked(headers);
+    m_streamOpen = true;
+}
+
+void LogStreamConnection::flush(const InstanceLogReader::Cursor& cursor) {
+    const qint64 dropped = m_queue.takeDropped();
+    if (dropped > 0) {
+        writeEvent("dropped", QJsonObject{
+            {"dropped", dropped},
+            {"totalDropped", m_queue.totalDropped()}
+        });
+    }
+    sendLines(m_queue.takeAll(), cursor, false);
+}
+
+void LogStreamConnection::sendLines(const QStringList& lines,
+                                    const InstanceLogReader::Cursor& cursor,
+                                    bool reset) {
+    QJsonObject data{{"lines", QJsonArray::fromStringList(lines)}};
+    if (reset) {
+        data["reset"] = true;
+    }
+    writeEvent("log", data, formatCursor(cursor));
+}
+
+void LogStreamConnection::sendHeartbeat() {
+    if (!m_streamOpen) {
+        return;
+    }
+    // 与 EventStreamConnection 一致：心跳不刷新 lastSendAt
+    m_responder.writeChunk(": heartbeat\n\n");
+}
+
+void LogStreamConnection::close() {
+    // 与 EventStreamConnection::close() 相同，依赖 TCP 断开结束流
+    m_streamOpen = false;
+}
+
+void LogStreamConnection::writeEvent(const char* type, const QJsonObject& data,
+                                     const QString& id) {
+    if (!m_streamOpen) {
+        return;
+    }
+    QByteArray chunk;
+    if (!id.isEmpty()) {
+        chunk.append("id: ");
+        chunk.append(id.toUtf8());
+        chunk.append('\n');
+    }
+    chunk.append("event: ");
+    chunk.append(type);
+    chunk.append('\n');
+    chunk.append("data: ");
+    chunk.append(QJsonDocument(data).toJson(QJsonDocument::Compact));
+    chunk.append("\n\n");
+    m_responder.writeChunk(chunk);
+    m_lastSendAt = QDateTime::currentDateTimeUtc();
+}
+
+QString LogStreamConnection::formatCursor(const InstanceLogReader::Cursor& cursor) {
+    return cursor.fileId + ":" + QString::number(cursor.offset);
+}
+
+bool LogStreamConnection::parseCursor(const QString& text, InstanceLogReader::Cursor& out) {
+    const qsizetype sep = text.lastIndexOf(':');
+    if (sep < 0) {
+        return false;
+    }
+    bool ok = false;
+    const qint64 offset = text.mid(sep + 1).toLongLong(&ok);
+    if (!ok || offset < 0) {
+        return false;
+    }
+    out.fileId = text.left(sep);
+    out.offset = offset;
+    return true;
+}
+
+// ---- LogStreamHandler ----
+
+LogStreamHandler::LogStreamHandler(const QString& allowedOrigin, QObject* parent)
+    : QObject(parent)
+    , m_allowedOrigin(allowedOrigin) {
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushIntervalMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &LogStreamHandler::onFlush);
+
+    m_heartbeatTimer.setInterval(kHeartbeatIntervalMs);
+    connect(&m_heartbeatTimer, &QTimer::timeout, this, &LogStreamHandler::onHeartbeat);
+    m_heartbeatTimer.start();
+}
+
+LogStreamHandler::~LogStreamHandler() {
+    closeAllConnections();
+}
+
+void LogStreamHandler::addConnection(QHttpServerResponder&& responder,
+                                     const QString& projectId,
+                                     const QString& logPath,
+                                     const LogStreamStart& start) {
+    if (m_connections.size() >= kMaxConnections) {
+        evictOldestConnection();
+    }
+
+    auto* conn = new LogStreamConnection(std::move(responder), projectId, logPath,
+                                         m_allowedOrigin, kQueueCapacity, this);
+    connect(conn, &LogStreamConnection::disconnected,
+            this, &LogStreamHandler::onConnectionDisconnected);
+    m_connections.append(conn);
+    conn->beginStream();
+
+    // 日志写入与本函数都在主线程：此刻文件内容即为补发终点，之后的行进入队列
+    InstanceLogReader::Chunk backlog;
+    if (start.resume) {
+        backlog = InstanceLogReader::readSince(logPath, start.cursor, kMaxBacklogLines + 1);
+        if (!backlog.reset && backlog.lines.size() > kMaxBacklogLines) {
+            // 断线期间积压过多，放弃补齐，改发尾部并要求客户端清空视图
+            backlog = InstanceLogReader::readTail(logPath, kMaxBacklogLines);
+            backlog.reset = true;
+        }
+    } else if (start.tailLines > 0) {
+        backlog = InstanceLogReader::readTail(logPath, start.tailLines);
+    } else {
+        backlog.next = InstanceLogReader::endCursor(logPath);
+    }
+    conn->sendLines(backlog.lines, backlog.next, backlog.reset);
+}
+
+void LogStreamHandler::publishLine(const QString& projectId, const QString& line) {
+    bool queued = false;
+    for (auto* conn : m_connections) {
+        if (conn->projectId() == projectId) {
+            conn->enqueue(line);
+            queued = true;
+        }
+    }
+    if (queued && !m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+void LogStreamHandler::closeAllConnections() {
+    m_flushTimer.stop();
+    m_heartbeatTimer.stop();
+    const QVector<LogStreamConnection*> connections = m_connections;
+    m_connections.clear();
+    for (auto* conn : connections) {
+        if (!conn) {
+            continue;
+        }
+        conn->close();
+        // 析构期间事件循环可能已不再处理 deleteLater，直接删除
+        delete conn;
+    }
+}
+
+int LogStreamHandler::activeConnectionCount() const {
+    return m_connections.size();
+}
+
+void LogStreamHandler::onFlush() {
+    // 同一日志文件的游标每轮只计算一次
+    QHash<QString, InstanceLogReader::Cursor> cursors;
+    for (auto* conn : m_connections) {
+        if (!conn->hasPending()) {
+            continue;
+        }
+        auto it = cursors.find(conn->logPath());
+        if (it == cursors.end()) {
+            it = cursors.insert(conn->logPath(), InstanceLogReader::endCursor(conn->logPath()));
+        }
+        conn->flush(it.value());
+    }
+}
+
+void LogStreamHandler::onHeartbeat() {
+    sweepStaleConnections();
+    for (auto* conn : m_connections) {
+        conn->sendHeartbeat();
+    }
+}
+
+void LogStreamHandler::onConnectionDisconnected() {
+    auto* conn = qobject_cast<LogStreamConnection*>(sender());
+    if (conn) {
+        removeConnection(conn);
+    }
+}
+
+void LogStreamHandler::sweepStaleConnections() {
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    QVector<LogStreamConnection*> stale;
+    for (auto* conn : m_connections) {
+        if (conn->lastSendAt().msecsTo(now) > kConnectionTimeoutMs) {
+            stale.append(conn);
+        }
+    }
+    for (auto* conn : stale) {
+        conn->close();
+        emit conn->disconnected();
+    }
+}
+
+void LogStreamHandler::removeConnection(LogStreamConnection* conn) {
+    if (!conn) {
+        return;
+    }
+    m_connections.removeOne(conn);
+    conn->deleteLater();
+}
+
+void LogStreamHandler::evictOldestConnection() {
+    if (m_connections.isEmpty()) {
+        return;
+    }
+    LogStreamConnection* oldest = m_connections.front();
+    oldest->close();
+    removeConnection(oldest);
+}
+
+} // namespace stdiolink_server
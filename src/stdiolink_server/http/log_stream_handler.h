@@ -0,0 +1,137 @@
+#pragma once
+
+#include <QDateTime>
+#include <QHttpServerResponder>
+#include <QJsonObject>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+#include <deque>
+
+#include "manager/instance_log_reader.h"
+
+namespace stdiolink_server {
+
+/// 单个订阅者的有界行队列：满时丢弃最旧的行并累计丢弃数
+class LogLineQueue {
+public:
+    explicit LogLineQueue(int capacity);
+
+    void push(const QString& line);
+    QStringList takeAll();
+
+    bool isEmpty() const { return m_lines.empty(); }
+    int size() const { return static_cast<int>(m_lines.size()); }
+
+    /// 取出上次调用以来新增的丢弃行数
+    qint64 takeDropped();
+    qint64 totalDropped() const { return m_totalDropped; }
+
+private:
+    std::deque<QString> m_lines;
+    int m_capacity;
+    qint64 m_pendingDropped = 0;
+    qint64 m_totalDropped = 0;
+};
+
+/// 日志流的起点：续传游标或尾部行数
+struct LogStreamStart {
+    bool resume = false;               ///< true 时从 cursor 续传，否则发送最后 tailLines 行
+    InstanceLogReader::Cursor cursor;
+    int tailLines = 100;
+};
+
+class LogStreamConnection : public QObject {
+    Q_OBJECT
+public:
+    LogStreamConnection(QHttpServerResponder&& responder,
+                        const QString& projectId,
+                        const QString& logPath,
+                        const QString& allowedOrigin,
+                        int queueCapacity,
+                        QObject* parent = nullptr);
+
+    void beginStream();
+    void enqueue(const QString& line) { m_queue.push(line); }
+    bool hasPending() const { return !m_queue.isEmpty(); }
+
+    /// 发送队列中的行；期间有丢弃时先发送一个 dropped 事件
+    void flush(const InstanceLogReader::Cursor& cursor);
+    void sendLines(const QStringList& lines, const InstanceLogReader::Cursor& cursor,
+                   bool reset);
+    void sendHeartbeat();
+    void close();
+
+    QString projectId() const { return m_projectId; }
+    QString logPath() const { return m_logPath; }
+    qint64 totalDropped() const { return m_queue.totalDropped(); }
+    QDateTime createdAt() const { return m_createdAt; }
+    QDateTime lastSendAt() const { return m_lastSendAt; }
+
+    /// SSE id 字段，形如 "<fileId>:<offset>"，可原样作为 Last-Event-ID 续传
+    static QString formatCursor(const InstanceLogReader::Cursor& cursor);
+    static bool parseCursor(const QString& text, InstanceLogReader::Cursor& out);
+
+signals:
+    void disconnected();
+
+private:
+    void writeEvent(const char* type, const QJsonObject& data, const QString& id = QString());
+
+    QHttpServerResponder m_responder;
+    QString m_projectId;
+    QString m_logPath;
+    QString m_allowedOrigin;
+    LogLineQueue m_queue;
+    bool m_streamOpen = false;
+    QDateTime m_createdAt;
+    QDateTime m_lastSendAt;
+};
+
+/// 实例日志实时推送
+///
+/// InstanceLogWriter 每写一行即调用 publishLine()，行被放入同项目下每个订阅者
+/// 自己的有界队列，由 kFlushIntervalMs 合并定时器批量写出为 SSE `log` 事件。
+/// 连接建立时先按 LogStreamStart 从日志文件补发历史行再加入订阅，二者均在
+/// 主线程完成，补发结尾与实时行之间不会遗漏或重复。
+class LogStreamHandler : public QObject {
+    Q_OBJECT
+public:
+    explicit LogStreamHandler(const QString& allowedOrigin = QStringLiteral("*"),
+                              QObject* parent = nullptr);
+    ~LogStreamHandler() override;
+
+    void addConnection(QHttpServerResponder&& responder,
+                       const QString& projectId,
+                       const QString& logPath,
+                       const LogStreamStart& start);
+    void publishLine(const QString& projectId, const QString& line);
+    void closeAllConnections();
+
+    int activeConnectionCount() const;
+
+    static constexpr int kMaxConnections = 32;
+    static constexpr int kQueueCapacity = 2000;
+    static constexpr int kMaxBacklogLines = 5000;
+    static constexpr int kFlushIntervalMs = 100;
+    static constexpr int kHeartbeatIntervalMs = 30000;
+    static constexpr int kConnectionTimeoutMs = kHeartbeatIntervalMs * 2;
+
+private slots:
+    void onFlush();
+    void onHeartbeat();
+    void onConnectionDisconnected();
+
+private:
+    void removeConnection(LogStreamConnection* conn);
+    void evictOldestConnection();
+    void sweepStaleConnections();
+
+    QString m_allowedOrigin;
+    QVector<LogStreamConnection*> m_connections;
+    QTimer m_flushTimer;
+    QTimer m_heartbeatTimer;
+};
+
+} // namespace stdiolink_server
@@ -0,0 +1,164 @@
+#include "response_cache.h"
+
+#include <QCryptographicHash>
+#include <QHttpHeaders>
+
+namespace stdiolink_server {
+
+namespace {
+
+constexpr char kDeflateSuffix[] = "-deflate";
+
+/// 同一资源不同编码须有不同的强 ETag："hash" → "hash-deflate"
+QByteArray deflateETag(const QByteArray& etag) {
+    QByteArray out = etag;
+    out.insert(out.size() - 1, kDeflateSuffix);
+    return out;
+}
+
+/// zlib 格式（RFC 1950）即 HTTP 的 deflate 编码；qCompress 在其前附加 4 字节原始长度
+QByteArray deflate(const QByteArray& body) {
+    return qCompress(body).mid(4);
+}
+
+void applyCacheHeaders(QHttpServerResponse& resp, const QByteArray& etag, bool deflated) {
+    QHttpHeaders headers = resp.headers();
+    headers.replaceOrAppend(QHttpHeaders::WellKnownHeader::ETag, etag);
+    headers.replaceOrAppend(QHttpHeaders::WellKnownHeader::CacheControl, "no-cache");
+    headers.replaceOrAppend(QHttpHeaders::WellKnownHeader::Vary, "Accept-Encoding");
+    if (deflated) {
+        headers.replaceOrAppend(QHttpHeaders::WellKnownHeader::ContentEncoding, "deflate");
+    }
+    resp.setHeaders(std::move(headers));
+}
+
+} // namespace
+
+ResponseCache::ResponseCache(int capacity)
+    : m_capacity(qMax(1, capacity)) {}
+
+QHttpServerResponse ResponseCache::respond(const QHttpServerRequest& req,
+                                           const QString& versionTag,
+                                           const Builder& builder) {
+    const QString key = req.url().path(QUrl::FullyEncoded) + '?'
+                        + req.url().query(QUrl::FullyEncoded);
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end() && it->versionTag == versionTag) {
+        ++m_hits;
+    } else {
+        ++m_misses;
+        QHttpServerResponse built = builder();
+        if (built.statusCode() != QHttpServerResponse::StatusCode::Ok) {
+            return built;
+        }
+
+        Entry entry;
+        entry.versionTag = versionTag;
+        entry.mimeType = built.mimeType();
+        entry.body = built.data();
+        entry.etag = computeETag(entry.body);
+        if (entry.body.size() > kCompressThreshold) {
+            QByteArray compressed = deflate(entry.body);
+            if (compressed.size() < entry.body.size()) {
+                entry.deflateBody = std::move(compressed);
+            }
+        }
+
+        if (it == m_entries.end()) {
+            evictIfFull();
+            it = m_entries.insert(key, std::move(entry));
+        } else {
+            *it = std::move(entry);
+        }
+    }
+    it->lastUsed = ++m_clock;
+
+    const QHttpHeaders& reqHeaders = req.headers();
+    const bool deflated = !it->deflateBody.isEmpty()
+        && acceptsDeflate(reqHeaders.combinedValue(QHttpHeaders::WellKnownHeader::AcceptEncoding));
+    const QByteArray etag = deflated ? deflateETag(it->etag) : it->etag;
+
+    if (matchesIfNoneMatch(reqHeaders.combinedValue(QHttpHeaders::WellKnownHeader::IfNoneMatch),
+                           it->etag)) {
+        QHttpServerResponse resp(QHttpServerResponse::StatusCode::NotModified);
+        applyCacheHeaders(resp, etag, false);
+        return resp;
+    }
+
+    QHttpServerResponse resp(it->mimeType, deflated ? it->deflateBody : it->body);
+    applyCacheHeaders(resp, etag, deflated);
+    return resp;
+}
+
+void ResponseCache::clear() {
+    m_entries.clear();
+}
+
+QByteArray ResponseCache::computeETag(const QByteArray& body) {
+    return '"' + QCryptographicHash::hash(body, QCryptographicHash::Sha1).toHex() + '"';
+}
+
+bool ResponseCache::matchesIfNoneMatch(const QByteArray& ifNoneMatch, const QByteArray& etag) {
+    const QByteArray trimmed = ifNoneMatch.trimmed();
+    if (trimmed.isEmpty() || etag.isEmpty()) {
+        return false;
+    }
+    if (trimmed == "*") {
+        return true;
+    }
+
+    // If-None-Match 使用弱比较：忽略 W/ 前缀；两种编码的 ETag 指向同一份内容
+    const QByteArray deflated = deflateETag(etag);
+    for (QByteArray candidate : trimmed.split(',')) {
+        candidate = candidate.trimmed();
+        if (candidate.startsWith("W/")) {
+            candidate = candidate.mid(2);
+        }
+        if (candidate == etag || candidate == deflated) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ResponseCache::acceptsDeflate(const QByteArray& acceptEncoding) {
+    for (const QByteArray& item : acceptEncoding.split(',')) {
+        const QList<QByteArray> parts = item.split(';');
+        const QByteArray coding = parts.first().trimmed().toLower();
+        if (coding != "deflate" && coding != "*") {
+            continue;
+        }
+
+        double quality = 1.0;
+        for (qsizetype i = 1; i < parts.size(); ++i) {
+            const QByteArray param = parts.at(i).trimmed();
+            if (param.startsWith("q=")) {
+                bool ok = false;
+                quality = param.mid(2).toDouble(&ok);
+                if (!ok) {
+                    quality = 0.0;
+                }
+            }
+        }
+        if (quality > 0.0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ResponseCache::evictIfFull() {
+    if (m_entries.size() < m_capacity) {
+        return;
+    }
+    auto oldest = m_entries.begin();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->lastUsed < oldest->lastUsed) {
+            oldest = it;
+        }
+    }
+    m_entries.erase(oldest);
+}
+
+} // namespace stdiolink_server
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QHttpServerRequest>
+#include <QHttpServerResponse>
+#include <QString>
+
+#include <functional>
+
+namespace stdiolink_server {
+
+/// 只读 GET 接口的响应缓存
+///
+/// 以请求路径 + 查询串为键保存生成好的正文及其版本标签。版本标签由调用方
+/// 拼接所依赖数据源的修订号，任一修订号变化即视为过期、重新生成。响应带强
+/// ETag 与 `Cache-Control: no-cache`，客户端 If-None-Match 命中时回 304；
+/// 超过 kCompressThreshold 的正文同时保存一份 deflate 版本，按 Accept-Encoding
+/// 选用。容量满时淘汰最久未使用的条目。
+class ResponseCache {
+public:
+    using Builder = std::function<QHttpServerResponse()>;
+
+    explicit ResponseCache(int capacity = kDefaultCapacity);
+
+    /// 版本标签未变时复用缓存，否则调用 builder 生成；只缓存 200 响应
+    QHttpServerResponse respond(const QHttpServerRequest& req,
+                                const QString& versionTag,
+                                const Builder& builder);
+
+    int size() const { return static_cast<int>(m_entries.size()); }
+    quint64 hits() const { return m_hits; }
+    quint64 misses() const { return m_misses; }
+    void clear();
+
+    static QByteArray computeETag(const QByteArray& body);
+    static bool matchesIfNoneMatch(const QByteArray& ifNoneMatch, const QByteArray& etag);
+    static bool acceptsDeflate(const QByteArray& acceptEncoding);
+
+    static constexpr int kDefaultCapacity = 256;
+    static constexpr qsizetype kCompressThreshold = 1024;
+
+private:
+    struct Entry {
+        QString versionTag;
+        QByteArray etag;
+        QByteArray mimeType;
+        QByteArray body;
+        QByteArray deflateBody;  // 空表示不压缩
+        quint64 lastUsed = 0;
+    };
+
+    void evictIfFull();
+
+    int m_capacity = kDefaultCapacity;
+    QHash<QString, Entry> m_entries;
+    quint64 m_clock = 0;
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+};
+
+} // namespace stdiolink_server
@@ -0,0 +1,204 @@
+#include "instance_log_reader.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <algorithm>
+
+namespace stdiolink_server {
+
+namespace {
+
+constexpr qint64 kFileIdProbeBytes = 4096;
+
+QString fileIdOf(QFile& file) {
+    if (!file.seek(0)) {
+        return {};
+    }
+    const QByteArray head = file.read(kFileIdProbeBytes);
+    const qsizetype nl = head.indexOf('\n');
+    if (nl < 0) {
+        return {};
+    }
+    // 首行带写入时间戳，轮转后的新文件首行必然不同
+    return QString::fromLatin1(
+        QCryptographicHash::hash(head.left(nl + 1), QCryptographicHash::Sha1).toHex().left(16));
+}
+
+/// 从文件末尾按块倒序扫描，收集最多 need 个非空完整行（新到旧）
+/// @param endOut 输出最后一个换行之后的位置，即完整内容的末尾
+void scanTail(QFile& file, qint64 blockBytes, int need, QList<QByteArray>& newestFirst,
+              qint64* endOut) {
+    QByteArray buf;
+    qint64 bufStart = file.size();
+    bool haveEnd = false;
+    qint64 endAbs = 0;
+    const qsizetype target = newestFirst.size() + need;
+
+    while (bufStart > 0 && newestFirst.size() < target) {
+        const qint64 len = std::min(blockBytes, bufStart);
+        bufStart -= len;
+        if (!file.seek(bufStart)) {
+            break;
+        }
+        buf.prepend(file.read(len));
+
+        // buf 中旧的剩余部分不含换行，只需扫描新读入的块
+        qsizetype end = buf.size();
+        for (qsizetype i = len - 1; i >= 0; --i) {
+            if (buf.at(i) != '\n') {
+                continue;
+            }
+            if (!haveEnd) {
+                // 最后一个换行之后是正在写入的半行，不返回
+                haveEnd = true;
+                endAbs = bufStart + i + 1;
+            } else {
+                const QByteArray line = buf.mid(i + 1, end - i - 1).trimmed();
+                if (!line.isEmpty()) {
+                    newestFirst.append(line);
+                    if (newestFirst.size() >= target) {
+                        break;
+                    }
+                }
+            }
+            end = i;
+        }
+        buf.truncate(end);
+    }
+
+    if (bufStart == 0 && haveEnd && newestFirst.size() < target) {
+        const QByteArray line = buf.trimmed();
+        if (!line.isEmpty()) {
+            newestFirst.append(line);
+        }
+    }
+    if (endOut) {
+        *endOut = haveEnd ? endAbs : 0;
+    }
+}
+
+/// 从 start 开始向后读取最多 need 个非空完整行，返回已消费内容之后的位置
+qint64 readForward(QFile& file, qint64 start, qint64 blockBytes, int need, QStringList& out) {
+    qint64 consumed = start;
+    if (need <= 0 || !file.seek(start)) {
+        return consumed;
+    }
+    QByteArray buf;
+    qint64 bufStart = start;
+    int taken = 0;
+
+    while (true) {
+        const QByteArray block = file.read(blockBytes);
+        if (block.isEmpty()) {
+            break;
+        }
+        buf.append(block);
+
+        qsizetype lineStart = 0;
+        qsizetype nl;
+        while ((nl = buf.indexOf('\n', lineStart)) >= 0) {
+            const QByteArray line = buf.mid(lineStart, nl - lineStart).trimmed();
+            lineStart = nl + 1;
+            consumed = bufStart + lineStart;
+            if (!line.isEmpty()) {
+                out.append(QString::fromUtf8(line));
+                if (++taken >= need) {
+                    return consumed;
+                }
+            }
+        }
+        buf.remove(0, lineStart);
+        bufStart += lineStart;
+    }
+    return consumed;
+}
+
+} // namespace
+
+QString InstanceLogReader::rotatedPath(const QString& logPath, int index) {
+    if (index == 0) {
+        return logPath;
+    }
+    const QFileInfo info(logPath);
+    const QString base = info.path() + "/" + info.completeBaseName() + "." + QString::number(index);
+    return info.suffix().isEmpty() ? base : base + "." + info.suffix();
+}
+
+InstanceLogReader::Chunk InstanceLogReader::readTail(const QString& logPath, int maxLines) {
+    Chunk chunk;
+    QList<QByteArray> newestFirst;
+
+    for (int idx = 0; idx <= kMaxRotatedFiles && newestFirst.size() < maxLines; ++idx) {
+        QFile file(rotatedPath(logPath, idx));
+        if (!file.open(QIODevice::ReadOnly)) {
+            if (idx == 0) {
+                continue;
+            }
+            break;
+        }
+        qint64 end = 0;
+        scanTail(file, kBlockBytes, maxLines - static_cast<int>(newestFirst.size()), newestFirst,
+                 &end);
+        if (idx == 0) {
+            chunk.next = Cursor{fileIdOf(file), end};
+        }
+    }
+
+    chunk.lines.reserve(newestFirst.size());
+    for (auto it = newestFirst.crbegin(); it != newestFirst.crend(); ++it) {
+        chunk.lines.append(QString::fromUtf8(*it));
+    }
+    return chunk;
+}
+
+InstanceLogReader::Chunk InstanceLogReader::readSince(const QString& logPath,
+                                                      const Cursor& cursor, int maxLines) {
+    // 定位游标所在文件：它可能已被轮转为 .1、.2 ...
+    int found = cursor.fileId.isEmpty() ? 0 : -1;
+    for (int idx = 0; found < 0 && idx <= kMaxRotatedFiles; ++idx) {
+        QFile file(rotatedPath(logPath, idx));
+        if (!file.open(QIODevice::ReadOnly)) {
+            if (idx == 0) {
+                continue;
+            }
+            break;
+        }
+        if (fileIdOf(file) == cursor.fileId) {
+            found = idx;
+        }
+    }
+    if (found < 0 || cursor.offset < 0
+        || cursor.offset > QFileInfo(rotatedPath(logPath, found)).size()) {
+        Chunk chunk = readTail(logPath, maxLines);
+        chunk.reset = true;
+        return chunk;
+    }
+
+    Chunk chunk;
+    chunk.next = cursor;
+    for (int idx = found; idx >= 0; --idx) {
+        QFile file(rotatedPath(logPath, idx));
+        if (!file.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+        const qint64 start = (idx == found) ? cursor.offset : 0;
+        const int need = maxLines - static_cast<int>(chunk.lines.size());
+        const qint64 consumed = readForward(file, start, kBlockBytes, need, chunk.lines);
+        chunk.next = Cursor{fileIdOf(file), consumed};
+        if (chunk.lines.size() >= maxLines) {
+            break;
+        }
+    }
+    return chunk;
+}
+
+InstanceLogReader::Cursor InstanceLogReader::endCursor(const QString& logPath) {
+    QFile file(logPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return Cursor{fileIdOf(file), file.size()};
+}
+
+} // namespace stdiolink_server
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+namespace stdiolink_server {
+
+/// 读取 InstanceLogWriter 写出的日志（含轮转文件 <name>.1.log ...）
+///
+/// 尾部读取从文件末尾按块倒序扫描换行，只读取所需的最后 N 行，
+/// 不足时继续读更早的轮转文件。增量读取使用 (fileId, offset) 游标：
+/// fileId 为文件首行的摘要，轮转只改文件名不改内容，因此游标在轮转后
+/// 仍能定位到原文件，并顺延读完更新的文件。
+class InstanceLogReader {
+public:
+    struct Cursor {
+        QString fileId;    ///< 游标所在文件的标识，尚无完整行时为空
+        qint64 offset = 0; ///< 该文件中下一次读取的起始字节
+    };
+
+    struct Chunk {
+        QStringList lines;
+        Cursor next;        ///< 下一次增量读取的游标
+        bool reset = false; ///< 游标失效（文件已轮转淘汰或被截断），lines 为尾部内容
+    };
+
+    /// 第 index 个轮转文件路径，与 spdlog rotating_file_sink 的命名一致；index 为 0 时返回 logPath
+    static QString rotatedPath(const QString& logPath, int index);
+
+    /// 返回最后 maxLines 个非空行（旧到新），必要时跨越轮转文件；
+    /// next 指向当前日志文件的末尾
+    static Chunk readTail(const QString& logPath, int maxLines);
+
+    /// 返回游标之后最多 maxLines 个完整行（旧到新），未写完的半行留待下次读取
+    static Chunk readSince(const QString& logPath, const Cursor& cursor, int maxLines);
+
+    /// 当前日志文件末尾的游标；文件不存在时返回空游标
+    static Cursor endCursor(const QString& logPath);
+
+private:
+    static constexpr int kMaxRotatedFiles = 16;
+    static constexpr qint64 kBlockBytes = 64 * 1024;
+};
+
+} // namespace stdiolink_server
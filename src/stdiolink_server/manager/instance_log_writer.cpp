@@ -1,21 +1,57 @@
 #include "instance_log_writer.h"
 
+#include <spdlog/sinks/base_sink.h>
 #include <spdlog/sinks/rotating_file_sink.h>
+#include <mutex>
+#include <string_view>
 
 namespace stdiolink_server {
 
+namespace {
+
+/// 与文件 sink 共用 logger 的格式化器，把格式化后的整行交给回调
+class LineCallbackSink : public spdlog::sinks::base_sink<std::mutex> {
+public:
+    explicit LineCallbackSink(InstanceLogWriter::LineSink callback)
+        : m_callback(std::move(callback)) {}
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        spdlog::memory_buf_t formatted;
+        formatter_->format(msg, formatted);
+        qsizetype len = static_cast<qsizetype>(formatted.size());
+        while (len > 0 && (formatted[len - 1] == '\n' || formatted[len - 1] == '\r')) {
+            --len;
+        }
+        m_callback(QString::fromUtf8(formatted.data(), len));
+    }
+
+    void flush_() override {}
+
+private:
+    InstanceLogWriter::LineSink m_callback;
+};
+
+} // namespace
+
 InstanceLogWriter::InstanceLogWriter(const QString& logPath,
-                                     qint64 maxBytes, int maxFiles)
+                                     qint64 maxBytes, int maxFiles,
+                                     LineSink lineSink)
     : m_logPath(logPath)
 {
     try {
-        auto sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
+        std::vector<spdlog::sink_ptr> sinks;
+        sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
             logPath.toStdString(),
             static_cast<size_t>(maxBytes),
-            static_cast<size_t>(maxFiles));
+            static_cast<size_t>(maxFiles)));
+        // 实时订阅：回调 sink 与文件 sink 共用同一 pattern，推送的行与文件内容逐字一致
+        if (lineSink) {
+            sinks.push_back(std::make_shared<LineCallbackSink>(std::move(lineSink)));
+        }
 
         const std::string loggerName = "inst_" + logPath.toStdString();
-        m_logger = std::make_shared<spdlog::logger>(loggerName, sink);
+        m_logger = std::make_shared<spdlog::logger>(loggerName, sinks.begin(), sinks.end());
         m_logger->set_pattern("%Y-%m-%dT%H:%M:%S.%eZ | %v",
                               spdlog::pattern_time_type::utc);
         m_logger->set_level(spdlog::level::trace);
@@ -28,46 +64,48 @@ InstanceLogWriter::InstanceLogWriter(const QString& logPath,
 
 InstanceLogWriter::~InstanceLogWriter() {
     if (!m_logger) return;
-    if (!m_stdoutBuf.isEmpty()) {
-        m_logger->info("{}", m_stdoutBuf.constData());
+    if (m_stdoutFramer.pendingSize() > 0) {
+        writeLine(m_stdoutFramer.pending(), nullptr);
     }
-    if (!m_stderrBuf.isEmpty()) {
-        m_logger->info("[stderr] {}", m_stderrBuf.constData());
+    if (m_stderrFramer.pendingSize() > 0) {
+        writeLine(m_stderrFramer.pending(), "[stderr]");
     }
     spdlog::drop(m_logger->name());
 }
 
-void InstanceLogWriter::processBuffer(QByteArray& buf, const char* prefix) {
-    if (!m_logger) { buf.clear(); return; }
-    while (true) {
-        const int nl = buf.indexOf('\n');
-        if (nl < 0) break;
-        const QByteArray line = buf.left(nl);
-        buf.remove(0, nl + 1);
-        if (prefix) {
-            m_logger->info("{} {}", prefix, line.constData());
-        } else {
-            m_logger->info("{}", line.constData());
-        }
+void InstanceLogWriter::writeLine(QByteArrayView line, const char* prefix) {
+    const std::string_view text(line.data(), static_cast<size_t>(line.size()));
+    if (prefix) {
+        m_logger->info("{} {}", prefix, text);
+    } else {
+        m_logger->info("{}", text);
     }
 }
 
-void InstanceLogWriter::appendStdout(const QByteArray& data) {
-    m_stdoutBuf.append(data);
-    processBuffer(m_stdoutBuf, nullptr);
-    if (m_stdoutBuf.size() > kMaxBufferBytes) {
-        if (m_logger) m_logger->info("{}", m_stdoutBuf.constData());
-        m_stdoutBuf.clear();
+void InstanceLogWriter::processBuffer(stdiolink::LineFramer& framer, const char* prefix) {
+    if (!m_logger) { framer.clear(); return; }
+    QByteArrayView line;
+    while (framer.nextLine(line)) {
+        writeLine(line, prefix);
     }
 }
 
-void InstanceLogWriter::appendStderr(const QByteArray& data) {
-    m_stderrBuf.append(data);
-    processBuffer(m_stderrBuf, "[stderr]");
-    if (m_stderrBuf.size() > kMaxBufferBytes) {
-        if (m_logger) m_logger->info("[stderr] {}", m_stderrBuf.constData());
-        m_stderrBuf.clear();
+void InstanceLogWriter::append(stdiolink::LineFramer& framer, const QByteArray& data,
+                               const char* prefix) {
+    framer.append(data);
+    processBuffer(framer, prefix);
+    if (framer.pendingSize() > kMaxBufferBytes) {
+        if (m_logger) writeLine(framer.pending(), prefix);
+        framer.clear();
     }
 }
 
+void InstanceLogWriter::appendStdout(const QByteArray& data) {
+    append(m_stdoutFramer, data, nullptr);
+}
+
+void InstanceLogWriter::appendStderr(const QByteArray& data) {
+    append(m_stderrFramer, data, "[stderr]");
+}
+
 } // namespace stdiolink_server
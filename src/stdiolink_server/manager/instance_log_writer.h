@@ -2,16 +2,22 @@
 
 #include <QByteArray>
 #include <QString>
+#include <functional>
 #include <memory>
 #include <spdlog/spdlog.h>
+#include "stdiolink/protocol/line_framer.h"
 
 namespace stdiolink_server {
 
 class InstanceLogWriter {
 public:
+    /// 每写入一行日志回调一次，参数为与日志文件中完全相同的整行文本（含时间戳，不含换行）
+    using LineSink = std::function<void(const QString& line)>;
+
     InstanceLogWriter(const QString& logPath,
                       qint64 maxBytes = 10 * 1024 * 1024,
-                      int maxFiles = 3);
+                      int maxFiles = 3,
+                      LineSink lineSink = {});
     ~InstanceLogWriter();
 
     void appendStdout(const QByteArray& data);
@@ -19,11 +25,13 @@ public:
     QString logPath() const { return m_logPath; }
 
 private:
-    void processBuffer(QByteArray& buf, const char* prefix);
+    void append(stdiolink::LineFramer& framer, const QByteArray& data, const char* prefix);
+    void processBuffer(stdiolink::LineFramer& framer, const char* prefix);
+    void writeLine(QByteArrayView line, const char* prefix);
 
     std::shared_ptr<spdlog::logger> m_logger;
-    QByteArray m_stdoutBuf;
-    QByteArray m_stderrBuf;
+    stdiolink::LineFramer m_stdoutFramer;
+    stdiolink::LineFramer m_stderrFramer;
     QString m_logPath;
 
     static constexpr qint64 kMaxBufferBytes = 1 * 1024 * 1024;  // 1MB
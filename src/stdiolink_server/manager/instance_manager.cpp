@@ -152,8 +152,14 @@ QString InstanceManager::startInstance(const Project& project,
 
     const QString logPath = logsDir + "/" + project.id + ".log";
 
+    InstanceLogWriter::LineSink lineSink;
+    if (m_logLineSink) {
+        lineSink = [sink = m_logLineSink, projectId = project.id](const QString& line) {
+            sink(projectId, line);
+        };
+    }
     auto logWriter = std::make_unique<InstanceLogWriter>(
-        logPath, m_config.logMaxBytes, m_config.logMaxFiles);
+        logPath, m_config.logMaxBytes, m_config.logMaxFiles, std::move(lineSink));
 
     inst->workingDirectory = workspaceDir;
     inst->logPath = logPath;
@@ -182,6 +188,7 @@ QString InstanceManager::startInstance(const Project& project,
     // errorOccurred(FailedToStart) 可能从 start() 内部同步触发，
     // 若 emplace 在 start() 之后，lambda 中 find(instanceId) 会找不到实例。
     m_instances.emplace(instanceId, std::move(inst));
+    ++m_revision;
 
     // 信号驱动状态迁移
     connect(proc, &QProcess::started, this, [this, instanceId]() {
@@ -190,6 +197,7 @@ QString InstanceManager::startInstance(const Project& project,
         Instance* inst = it->second.get();
         inst->pid = inst->process->processId();
         inst->status = "running";
+        ++m_revision;
         if (inst->runTimeoutMs > 0) {
             auto timer = std::make_unique<QTimer>();
             timer->setSingleShot(true);
@@ -233,6 +241,7 @@ QString InstanceManager::startInstance(const Project& project,
         inst->process->deleteLater();
         inst->process = nullptr;
         m_instances.erase(it);
+        ++m_revision;
     });
 
     proc->start();
@@ -440,6 +449,7 @@ void InstanceManager::onProcessFinished(const QString& instanceId,
         inst->process = nullptr;
     }
     m_instances.erase(it);
+    ++m_revision;
 }
 
 } // namespace stdiolink_server
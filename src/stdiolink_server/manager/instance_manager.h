@@ -3,6 +3,7 @@
 #include <QObject>
 #include <QString>
 
+#include <functional>
 #include <map>
 #include <memory>
 
@@ -34,8 +35,15 @@ public:
     const Instance* getInstance(const QString& instanceId) const;
     int instanceCount(const QString& projectId = QString()) const;
 
+    /// 实例集合或实例状态每次变化时递增
+    quint64 revision() const { return m_revision; }
+
     QString findServiceProgram() const;
 
+    /// 实例日志逐行回调（projectId, 整行文本），对之后启动的实例生效
+    using LogLineSink = std::function<void(const QString& projectId, const QString& line)>;
+    void setLogLineSink(LogLineSink sink) { m_logLineSink = std::move(sink); }
+
 signals:
     void instanceStarted(const QString& instanceId,
                          const QString& projectId);
@@ -60,6 +68,8 @@ private:
     ServerConfig m_config;
     std::map<QString, std::unique_ptr<Instance>> m_instances;
     QString m_guardNameOverride;
+    LogLineSink m_logLineSink;
+    quint64 m_revision = 0;
 };
 
 } // namespace stdiolink_server
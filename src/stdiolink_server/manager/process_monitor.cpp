@@ -20,6 +20,10 @@ namespace stdiolink_server {
 // ---- Common logic ----
 
 ProcessTreeNode ProcessMonitor::getProcessTree(qint64 rootPid) {
+    if (preferSnapshot(rootPid)) {
+        return getProcessTree(rootPid, ProcessSnapshot::capture());
+    }
+
     QSet<qint64> visited;
     ProcessTreeNode tree = buildTree(rootPid, visited);
 
@@ -37,6 +41,10 @@ ProcessInfo ProcessMonitor::getProcessInfo(qint64 pid) {
 
 QVector<ProcessInfo> ProcessMonitor::getProcessFamily(qint64 rootPid,
                                                        bool includeChildren) {
+    if (includeChildren && preferSnapshot(rootPid)) {
+        return getProcessFamily(rootPid, includeChildren, ProcessSnapshot::capture());
+    }
+
     QVector<ProcessInfo> result;
     QSet<qint64> visited;
 
@@ -53,6 +61,64 @@ QVector<ProcessInfo> ProcessMonitor::getProcessFamily(qint64 rootPid,
     return result;
 }
 
+ProcessTreeNode ProcessMonitor::getProcessTree(qint64 rootPid,
+                                               const ProcessSnapshot& snapshot) {
+    QSet<qint64> visited;
+    ProcessTreeNode tree = buildTree(rootPid, snapshot, visited);
+    cleanupSamples(visited);
+    return tree;
+}
+
+QVector<ProcessInfo> ProcessMonitor::getProcessFamily(qint64 rootPid,
+                                                       bool includeChildren,
+                                                       const ProcessSnapshot& snapshot) {
+    QVector<ProcessInfo> result;
+    QSet<qint64> visited;
+
+    ProcessInfo root = readProcessInfo(rootPid, snapshot);
+    root.cpuPercent = calculateCpuPercent(rootPid, static_cast<qint64>(root.cpuPercent));
+    result.append(root);
+    visited.insert(rootPid);
+
+    if (includeChildren) {
+        collectFamily(rootPid, snapshot, result, visited);
+    }
+
+    cleanupSamples(visited);
+    return result;
+}
+
+ProcessInfo ProcessMonitor::readProcessInfo(qint64 pid, const ProcessSnapshot& snapshot) {
+    ProcessInfo info;
+    info.pid = pid;
+    info.status = "unknown";
+
+    const ProcessSnapshot::Entry* entry = snapshot.find(pid);
+    if (!entry) {
+        return info;
+    }
+
+    info.parentPid = entry->parentPid;
+    info.name = entry->name;
+    if (entry->state == 'R') info.status = "running";
+    else if (entry->state == 'S' || entry->state == 'D') info.status = "sleeping";
+    else if (entry->state == 'Z') info.status = "zombie";
+    else if (entry->state == 'T') info.status = "stopped";
+
+    // Store CPU time in ms via cpuPercent (temporary), same as readProcessInfo(pid)
+    info.cpuPercent = static_cast<double>(entry->cpuTimeMs);
+    info.threadCount = entry->threadCount;
+    info.memoryVmsBytes = entry->memoryVmsBytes;
+    info.memoryRssBytes = entry->memoryRssBytes;
+    if (entry->uptimeSeconds >= 0) {
+        info.uptimeSeconds = entry->uptimeSeconds;
+        info.startedAt = snapshot.takenAt().addSecs(-entry->uptimeSeconds);
+    }
+
+    readProcessDetails(pid, info);
+    return info;
+}
+
 ProcessTreeSummary ProcessMonitor::summarize(const ProcessTreeNode& tree) {
     ProcessTreeSummary summary;
 
@@ -137,6 +203,38 @@ ProcessTreeNode ProcessMonitor::buildTree(qint64 pid, QSet<qint64>& visited) {
     return node;
 }
 
+ProcessTreeNode ProcessMonitor::buildTree(qint64 pid, const ProcessSnapshot& snapshot,
+                                          QSet<qint64>& visited) {
+    ProcessTreeNode node;
+    node.info = readProcessInfo(pid, snapshot);
+    node.info.cpuPercent = calculateCpuPercent(pid, static_cast<qint64>(node.info.cpuPercent));
+    visited.insert(pid);
+
+    for (qint64 childPid : snapshot.children(pid)) {
+        if (!visited.contains(childPid)) {
+            node.children.append(buildTree(childPid, snapshot, visited));
+        }
+    }
+
+    return node;
+}
+
+void ProcessMonitor::collectFamily(qint64 pid, const ProcessSnapshot& snapshot,
+                                   QVector<ProcessInfo>& out, QSet<qint64>& visited) {
+    for (qint64 childPid : snapshot.children(pid)) {
+        if (visited.contains(childPid)) {
+            continue;
+        }
+        visited.insert(childPid);
+
+        ProcessInfo info = readProcessInfo(childPid, snapshot);
+        info.cpuPercent = calculateCpuPercent(childPid, static_cast<qint64>(info.cpuPercent));
+        out.append(info);
+
+        collectFamily(childPid, snapshot, out, visited);
+    }
+}
+
 void ProcessMonitor::collectFamily(qint64 pid, QVector<ProcessInfo>& out,
                                     QSet<qint64>& visited) {
     const QVector<qint64> children = getChildPids(pid);
@@ -246,6 +344,17 @@ ProcessInfo ProcessMonitor::readProcessInfo(qint64 pid) {
     return info;
 }
 
+void ProcessMonitor::readProcessDetails(qint64 pid, ProcessInfo& info) {
+    // readProcessInfo(pid) already fills command line; snapshots are Linux-only
+    Q_UNUSED(pid);
+    Q_UNUSED(info);
+}
+
+bool ProcessMonitor::preferSnapshot(qint64 pid) {
+    Q_UNUSED(pid);
+    return false;
+}
+
 QVector<qint64> ProcessMonitor::getChildPids(qint64 pid) {
     QVector<qint64> children;
 
@@ -286,13 +395,6 @@ ProcessInfo ProcessMonitor::readProcessInfo(qint64 pid) {
         info.name = QString::fromUtf8(commFile.readAll()).trimmed();
     }
 
-    // Read /proc/{pid}/cmdline
-    QFile cmdFile(QString("/proc/%1/cmdline").arg(pid));
-    if (cmdFile.open(QIODevice::ReadOnly)) {
-        QByteArray cmdData = cmdFile.readAll();
-        info.commandLine = QString::fromUtf8(cmdData.replace('\0', ' ')).trimmed();
-    }
-
     // Read /proc/{pid}/stat
     QFile statFile(QString("/proc/%1/stat").arg(pid));
     if (statFile.open(QIODevice::ReadOnly)) {
@@ -361,6 +463,18 @@ ProcessInfo ProcessMonitor::readProcessInfo(qint64 pid) {
         }
     }
 
+    readProcessDetails(pid, info);
+    return info;
+}
+
+void ProcessMonitor::readProcessDetails(qint64 pid, ProcessInfo& info) {
+    // Read /proc/{pid}/cmdline
+    QFile cmdFile(QString("/proc/%1/cmdline").arg(pid));
+    if (cmdFile.open(QIODevice::ReadOnly)) {
+        QByteArray cmdData = cmdFile.readAll();
+        info.commandLine = QString::fromUtf8(cmdData.replace('\0', ' ')).trimmed();
+    }
+
     // Read /proc/{pid}/io (may require same-user permission)
     QFile ioFile(QString("/proc/%1/io").arg(pid));
     if (ioFile.open(QIODevice::ReadOnly)) {
@@ -373,8 +487,12 @@ ProcessInfo ProcessMonitor::readProcessInfo(qint64 pid) {
             }
         }
     }
+}
 
-    return info;
+bool ProcessMonitor::preferSnapshot(qint64 pid) {
+    // Without the children file every node would rescan all of /proc
+    const QByteArray path = QString("/proc/%1/task/%1/children").arg(pid).toLocal8Bit();
+    return ::access(path.constData(), R_OK) != 0;
 }
 
 QVector<qint64> ProcessMonitor::getChildPids(qint64 pid) {
@@ -442,6 +560,16 @@ ProcessInfo ProcessMonitor::readProcessInfo(qint64 pid) {
     return info;
 }
 
+void ProcessMonitor::readProcessDetails(qint64 pid, ProcessInfo& info) {
+    Q_UNUSED(pid);
+    Q_UNUSED(info);
+}
+
+bool ProcessMonitor::preferSnapshot(qint64 pid) {
+    Q_UNUSED(pid);
+    return false;
+}
+
 QVector<qint64> ProcessMonitor::getChildPids(qint64 pid) {
     Q_UNUSED(pid);
     qWarning("ProcessMonitor: getChildPids not implemented for this platform");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "model/process_info.h"
+#include "process_snapshot.h"
 
 #include <QDateTime>
 #include <QMap>
@@ -19,6 +20,9 @@ public:
     /// Get the full process tree rooted at rootPid (with resource info)
     ProcessTreeNode getProcessTree(qint64 rootPid);
 
+    /// Same as above, resolving parent/child links and stat fields from a snapshot
+    ProcessTreeNode getProcessTree(qint64 rootPid, const ProcessSnapshot& snapshot);
+
     /// Get info for a single process
     ProcessInfo getProcessInfo(qint64 pid);
 
@@ -26,6 +30,11 @@ public:
     QVector<ProcessInfo> getProcessFamily(qint64 rootPid,
                                            bool includeChildren = true);
 
+    /// Same as above, resolving parent/child links and stat fields from a snapshot
+    QVector<ProcessInfo> getProcessFamily(qint64 rootPid,
+                                           bool includeChildren,
+                                           const ProcessSnapshot& snapshot);
+
     /// Compute summary statistics from a tree
     static ProcessTreeSummary summarize(const ProcessTreeNode& tree);
 
@@ -39,6 +48,15 @@ private:
     /// Read raw process info (platform-specific)
     ProcessInfo readProcessInfo(qint64 pid);
 
+    /// Read raw process info from a snapshot; only command line and IO are read per pid
+    ProcessInfo readProcessInfo(qint64 pid, const ProcessSnapshot& snapshot);
+
+    /// Read command line and IO counters (platform-specific)
+    void readProcessDetails(qint64 pid, ProcessInfo& info);
+
+    /// True when per-node child lookup would need a full /proc scan
+    static bool preferSnapshot(qint64 pid);
+
     /// CPU sample cache
     struct CpuSample {
         qint64 cpuTimeMs = 0;
@@ -55,8 +73,13 @@ private:
     /// Build tree recursively
     ProcessTreeNode buildTree(qint64 pid, QSet<qint64>& visited);
 
+    ProcessTreeNode buildTree(qint64 pid, const ProcessSnapshot& snapshot,
+                              QSet<qint64>& visited);
+
     /// Collect all descendants into a flat list
     void collectFamily(qint64 pid, QVector<ProcessInfo>& out, QSet<qint64>& visited);
+    void collectFamily(qint64 pid, const ProcessSnapshot& snapshot,
+                       QVector<ProcessInfo>& out, QSet<qint64>& visited);
 };
 
 } // namespace stdiolink_server
@@ -0,0 +1,180 @@
+#include "process_snapshot.h"
+
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+#endif
+
+namespace stdiolink_server {
+
+#ifdef Q_OS_LINUX
+
+namespace {
+
+/// 经 /proc 的目录 fd 读取相对路径，复用调用方缓冲区并以 '\0' 结尾
+/// @return 读取的字节数，失败（通常是进程已退出）返回 -1
+qint64 readAt(int dirFd, const char* relPath, std::vector<char>& buf) {
+    const int fd = ::openat(dirFd, relPath, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    size_t total = 0;
+    while (true) {
+        if (total + 1 >= buf.size()) {
+            buf.resize(buf.size() * 2);
+        }
+        const ssize_t n = ::read(fd, buf.data() + total, buf.size() - total - 1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ::close(fd);
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        total += static_cast<size_t>(n);
+    }
+    ::close(fd);
+    buf[total] = '\0';
+    return static_cast<qint64>(total);
+}
+
+/// 解析 /proc/<pid>/stat；comm 字段可能含空格和括号，以最后一个 ')' 为界
+bool parseStat(const char* data, qint64 len, double uptimeSecs, long ticksPerSec, long pageSize,
+               ProcessSnapshot::Entry& entry) {
+    const char* end = data + len;
+    const char* open = static_cast<const char*>(std::memchr(data, '(', static_cast<size_t>(len)));
+    const char* close = nullptr;
+    for (const char* p = end; p > data; --p) {
+        if (p[-1] == ')') {
+            close = p - 1;
+            break;
+        }
+    }
+    if (!open || !close || close < open) {
+        return false;
+    }
+    entry.name = QString::fromUtf8(open + 1, static_cast<qsizetype>(close - open - 1));
+
+    // 字段序号从 state 开始计 0：1=ppid 11=utime 12=stime 17=num_threads
+    // 19=starttime 20=vsize 21=rss
+    constexpr int kLastField = 21;
+    long long values[kLastField + 1] = {};
+    int field = 0;
+    const char* p = close + 1;
+    while (p < end && field <= kLastField) {
+        while (p < end && *p == ' ') {
+            ++p;
+        }
+        if (p >= end || *p == '\n') {
+            break;
+        }
+        if (field == 0) {
+            entry.state = *p;
+        } else {
+            values[field] = std::strtoll(p, nullptr, 10);
+        }
+        while (p < end && *p != ' ' && *p != '\n') {
+            ++p;
+        }
+        ++field;
+    }
+    if (field <= kLastField) {
+        return false;
+    }
+
+    entry.parentPid = values[1];
+    entry.cpuTimeMs = (values[11] + values[12]) * 1000 / ticksPerSec;
+    entry.threadCount = static_cast<int>(values[17]);
+    entry.memoryVmsBytes = values[20];
+    entry.memoryRssBytes = values[21] * pageSize;
+    if (uptimeSecs >= 0) {
+        const double startSecs = static_cast<double>(values[19]) / ticksPerSec;
+        entry.uptimeSeconds = static_cast<qint64>(uptimeSecs - startSecs);
+    }
+    return true;
+}
+
+} // namespace
+
+bool ProcessSnapshot::isSupported() { return true; }
+
+ProcessSnapshot ProcessSnapshot::capture() {
+    ProcessSnapshot snap;
+    snap.m_takenAt = QDateTime::currentDateTimeUtc();
+
+    DIR* dir = ::opendir("/proc");
+    if (!dir) {
+        return snap;
+    }
+    const int procFd = ::dirfd(dir);
+    static const long ticksPerSec = ::sysconf(_SC_CLK_TCK);
+    static const long pageSize = ::sysconf(_SC_PAGESIZE);
+
+    std::vector<char> buf(1024);
+    double uptimeSecs = -1;
+    if (readAt(procFd, "uptime", buf) > 0) {
+        uptimeSecs = std::strtod(buf.data(), nullptr);
+    }
+
+    char relPath[48];
+    while (const dirent* de = ::readdir(dir)) {
+        const char* name = de->d_name;
+        if (name[0] < '0' || name[0] > '9') {
+            continue;
+        }
+        char* numEnd = nullptr;
+        const qint64 pid = std::strtoll(name, &numEnd, 10);
+        if (*numEnd != '\0') {
+            continue;
+        }
+        std::snprintf(relPath, sizeof(relPath), "%lld/stat", static_cast<long long>(pid));
+        const qint64 len = readAt(procFd, relPath, buf);
+        if (len <= 0) {
+            continue;
+        }
+        Entry entry;
+        entry.pid = pid;
+        if (parseStat(buf.data(), len, uptimeSecs, ticksPerSec, pageSize, entry)) {
+            snap.m_entries.insert(pid, std::move(entry));
+        }
+    }
+    ::closedir(dir);
+
+    for (auto it = snap.m_entries.cbegin(); it != snap.m_entries.cend(); ++it) {
+        snap.m_children[it->parentPid].append(it.key());
+    }
+    for (auto& kids : snap.m_children) {
+        std::sort(kids.begin(), kids.end());
+    }
+    return snap;
+}
+
+#else
+
+bool ProcessSnapshot::isSupported() { return false; }
+
+ProcessSnapshot ProcessSnapshot::capture() {
+    ProcessSnapshot snap;
+    snap.m_takenAt = QDateTime::currentDateTimeUtc();
+    return snap;
+}
+
+#endif
+
+const ProcessSnapshot::Entry* ProcessSnapshot::find(qint64 pid) const {
+    const auto it = m_entries.constFind(pid);
+    return it == m_entries.constEnd() ? nullptr : &it.value();
+}
+
+} // namespace stdiolink_server
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+namespace stdiolink_server {
+
+/// 系统进程表快照
+///
+/// 一次遍历 /proc 读取所有进程的 stat，建立 pid → 条目和 ppid → 子进程索引，
+/// 之后任意多个进程树 / 进程族查询都直接查表，不再逐节点扫描 /proc。
+/// 目前仅 Linux 支持；其他平台 isSupported() 为 false，capture() 返回空快照。
+class ProcessSnapshot {
+public:
+    struct Entry {
+        qint64 pid = 0;
+        qint64 parentPid = 0;
+        QString name;
+        char state = '?';
+        qint64 cpuTimeMs = 0;       ///< utime + stime
+        int threadCount = 0;
+        qint64 memoryVmsBytes = 0;
+        qint64 memoryRssBytes = 0;
+        qint64 uptimeSeconds = -1;  ///< 无法计算时为 -1
+    };
+
+    static bool isSupported();
+
+    /// 读取当前进程表
+    static ProcessSnapshot capture();
+
+    const Entry* find(qint64 pid) const;
+    QVector<qint64> children(qint64 pid) const { return m_children.value(pid); }
+
+    int size() const { return m_entries.size(); }
+    QDateTime takenAt() const { return m_takenAt; }
+
+private:
+    QHash<qint64, Entry> m_entries;
+    QHash<qint64, QVector<qint64>> m_children;  ///< 子 pid 升序
+    QDateTime m_takenAt;
+};
+
+} // namespace stdiolink_server
@@ -0,0 +1,174 @@
+#include "resource_sampler.h"
+
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QTimer>
+
+namespace stdiolink_server {
+
+QJsonObject ResourceSample::toJson() const {
+    QJsonObject obj;
+    obj["ts"] = timestampMs;
+    obj["cpuPercent"] = cpuPercent;
+    obj["memoryRssBytes"] = memoryRssBytes;
+    obj["ioReadBytes"] = ioReadBytes;
+    obj["ioWriteBytes"] = ioWriteBytes;
+    obj["threadCount"] = threadCount;
+    obj["processCount"] = processCount;
+    return obj;
+}
+
+ResourceSampler::ResourceSampler(int intervalMs, int historySize, QObject* parent)
+    : QObject(parent)
+    , m_intervalMs(qMax(0, intervalMs))
+    , m_historySize(qMax(1, historySize)) {
+    m_thread.setObjectName(QStringLiteral("ResourceSampler"));
+
+    // worker 与定时器一起迁入采样线程，timeout 在采样线程中执行
+    m_worker = new QObject;
+    m_timer = new QTimer(m_worker);
+    m_timer->setInterval(m_intervalMs);
+    connect(m_timer, &QTimer::timeout, m_worker, [this]() { sampleOnce(); });
+    m_worker->moveToThread(&m_thread);
+}
+
+ResourceSampler::~ResourceSampler() {
+    stop();
+    // 线程已结束，可在当前线程直接删除
+    delete m_worker;
+}
+
+void ResourceSampler::start() {
+    if (m_intervalMs <= 0 || m_thread.isRunning()) {
+        return;
+    }
+    m_thread.start(QThread::LowPriority);
+    QMetaObject::invokeMethod(m_timer, [this]() {
+        // 立即采一次建立 CPU 基线，下一次起 CPU% 有效
+        sampleOnce();
+        m_timer->start();
+    });
+}
+
+void ResourceSampler::stop() {
+    if (!m_thread.isRunning()) {
+        return;
+    }
+    QMetaObject::invokeMethod(m_timer, [this]() { m_timer->stop(); },
+                              Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void ResourceSampler::track(const QString& instanceId, qint64 pid) {
+    if (pid <= 0) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    Series& series = m_series[instanceId];
+    if (series.pid == pid && series.monitor) {
+        return;
+    }
+    series = Series{};
+    series.pid = pid;
+    series.monitor = std::make_shared<ProcessMonitor>();
+    series.ring.resize(static_cast<size_t>(m_historySize));
+}
+
+void ResourceSampler::untrack(const QString& instanceId) {
+    QMutexLocker locker(&m_mutex);
+    m_series.remove(instanceId);
+}
+
+bool ResourceSampler::isTracked(const QString& instanceId) const {
+    QMutexLocker locker(&m_mutex);
+    return m_series.contains(instanceId);
+}
+
+QVector<ResourceSample> ResourceSampler::query(const QString& instanceId,
+                                               qint64 sinceMs, int limit) const {
+    QVector<ResourceSample> out;
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_series.constFind(instanceId);
+    if (it == m_series.constEnd() || limit <= 0) {
+        return out;
+    }
+
+    const Series& series = it.value();
+    const qsizetype cap = static_cast<qsizetype>(series.ring.size());
+    const qsizetype count = series.full ? cap : series.next;
+    const qsizetype first = series.full ? series.next : 0;
+
+    // 从最新样本向前找到第一个不满足条件的位置，再正序输出
+    qsizetype taken = 0;
+    while (taken < count && taken < limit) {
+        const ResourceSample& s = series.ring[static_cast<size_t>((first + count - 1 - taken) % cap)];
+        if (s.timestampMs <= sinceMs) {
+            break;
+        }
+        ++taken;
+    }
+    out.reserve(taken);
+    for (qsizetype i = count - taken; i < count; ++i) {
+        out.append(series.ring[static_cast<size_t>((first + i) % cap)]);
+    }
+    return out;
+}
+
+void ResourceSampler::sampleOnce() {
+    struct Target {
+        QString instanceId;
+        qint64 pid;
+        std::shared_ptr<ProcessMonitor> monitor;
+    };
+    QVector<Target> targets;
+    {
+        QMutexLocker locker(&m_mutex);
+        targets.reserve(m_series.size());
+        for (auto it = m_series.cbegin(); it != m_series.cend(); ++it) {
+            targets.append(Target{it.key(), it->pid, it->monitor});
+        }
+    }
+
+    if (targets.isEmpty()) {
+        return;
+    }
+
+    // 读取 /proc 不持锁，避免阻塞主线程的查询；整轮共用一份进程表快照
+    const bool useSnapshot = ProcessSnapshot::isSupported();
+    const ProcessSnapshot snapshot = useSnapshot ? ProcessSnapshot::capture() : ProcessSnapshot();
+    for (const Target& target : targets) {
+        const QVector<ProcessInfo> family =
+            useSnapshot ? target.monitor->getProcessFamily(target.pid, true, snapshot)
+                        : target.monitor->getProcessFamily(target.pid, true);
+        const ProcessTreeSummary summary = ProcessMonitor::summarize(family);
+
+        ResourceSample sample;
+        sample.timestampMs = QDateTime::currentMSecsSinceEpoch();
+        sample.cpuPercent = summary.totalCpuPercent;
+        sample.memoryRssBytes = summary.totalMemoryRssBytes;
+        sample.threadCount = summary.totalThreads;
+        sample.processCount = summary.totalProcesses;
+        for (const ProcessInfo& p : family) {
+            sample.ioReadBytes += p.ioReadBytes;
+            sample.ioWriteBytes += p.ioWriteBytes;
+        }
+
+        QMutexLocker locker(&m_mutex);
+        auto it = m_series.find(target.instanceId);
+        // 采样期间实例可能已注销或以新 pid 重新登记
+        if (it != m_series.end() && it->monitor == target.monitor) {
+            push(it.value(), sample);
+        }
+    }
+}
+
+void ResourceSampler::push(Series& series, const ResourceSample& sample) {
+    series.ring[static_cast<size_t>(series.next)] = sample;
+    series.next = (series.next + 1) % static_cast<qsizetype>(series.ring.size());
+    if (series.next == 0) {
+        series.full = true;
+    }
+}
+
+} // namespace stdiolink_server
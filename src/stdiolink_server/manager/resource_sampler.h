@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <memory>
+#include <vector>
+
+#include "process_monitor.h"
+
+class QTimer;
+
+namespace stdiolink_server {
+
+/// 一次采样：实例主进程及其全部子进程的合计值
+struct ResourceSample {
+    qint64 timestampMs = 0;   ///< 采样时刻（epoch 毫秒）
+    double cpuPercent = 0.0;
+    qint64 memoryRssBytes = 0;
+    qint64 ioReadBytes = 0;
+    qint64 ioWriteBytes = 0;
+    int threadCount = 0;
+    int processCount = 0;
+
+    QJsonObject toJson() const;
+};
+
+/// 后台资源采样器
+///
+/// 在独立线程上按固定间隔采样所有已登记实例的进程族，写入每实例定长环形缓冲。
+/// CPU% 由相邻两次采样的 CPU 时间差除以采样间隔得出，不再依赖前端轮询频率；
+/// 每个实例使用独立的 ProcessMonitor，互不清理对方的 CPU 基线；
+/// 每轮只抓取一次 ProcessSnapshot，所有实例的进程族都从同一快照解析。
+/// track/untrack/query 可在任意线程调用。
+class ResourceSampler : public QObject {
+    Q_OBJECT
+public:
+    ResourceSampler(int intervalMs, int historySize, QObject* parent = nullptr);
+    ~ResourceSampler() override;
+
+    /// 启动采样线程；intervalMs 为 0 时不启动
+    void start();
+    void stop();
+    bool isRunning() const { return m_thread.isRunning(); }
+
+    void track(const QString& instanceId, qint64 pid);
+    void untrack(const QString& instanceId);
+    bool isTracked(const QString& instanceId) const;
+
+    /// 返回 timestampMs > sinceMs 的样本（旧到新），超过 limit 时只保留最新的 limit 条
+    QVector<ResourceSample> query(const QString& instanceId, qint64 sinceMs, int limit) const;
+
+    /// 立即采样一次所有实例；仅供未 start() 时（如测试）同步调用
+    void sampleOnce();
+
+    int intervalMs() const { return m_intervalMs; }
+    int historySize() const { return m_historySize; }
+
+private:
+    struct Series {
+        qint64 pid = 0;
+        std::shared_ptr<ProcessMonitor> monitor;  ///< 只在采样线程使用
+        std::vector<ResourceSample> ring;
+        qsizetype next = 0;                       ///< 下一次写入位置
+        bool full = false;
+    };
+
+    void push(Series& series, const ResourceSample& sample);
+
+    int m_intervalMs;
+    int m_historySize;
+
+    mutable QMutex m_mutex;
+    QHash<QString, Series> m_series;
+
+    QThread m_thread;
+    QObject* m_worker = nullptr;
+    QTimer* m_timer = nullptr;
+};
+
+} // namespace stdiolink_server
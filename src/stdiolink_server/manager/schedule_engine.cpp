@@ -1,17 +1,36 @@
 #include "schedule_engine.h"
 
+#include <QDateTime>
+#include <QRandomGenerator>
 #include <QTimer>
 
 namespace stdiolink_server {
 
+namespace {
+
+bool isTimedSchedule(ScheduleType type) {
+    return type == ScheduleType::FixedRate || type == ScheduleType::Cron;
+}
+
+QString timedScheduleName(ScheduleType type) {
+    return type == ScheduleType::Cron ? QStringLiteral("cron") : QStringLiteral("fixed_rate");
+}
+
+} // namespace
+
 ScheduleEngine::ScheduleEngine(InstanceManager* instanceMgr,
                                QObject* parent)
     : QObject(parent)
-    , m_instanceMgr(instanceMgr) {
+    , m_instanceMgr(instanceMgr)
+    , m_timer(new QTimer(this)) {
     connect(m_instanceMgr,
             &InstanceManager::instanceFinished,
             this,
             &ScheduleEngine::onInstanceFinished);
+
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &ScheduleEngine::onTimerQueueTimeout);
 }
 
 void ScheduleEngine::startAll(const QMap<QString, Project>& projects,
@@ -36,13 +55,15 @@ void ScheduleEngine::startAll(const QMap<QString, Project>& projects,
         case ScheduleType::Manual:
             break;
         case ScheduleType::FixedRate:
-            startFixedRate(project, serviceDir);
+        case ScheduleType::Cron:
+            startTimed(project, serviceDir);
             break;
         case ScheduleType::Daemon:
             startDaemon(project, serviceDir);
             break;
         }
     }
+    armTimer();
 }
 
 void ScheduleEngine::startProject(const Project& project,
@@ -50,12 +71,8 @@ void ScheduleEngine::startProject(const Project& project,
     m_projects.insert(project.id, project);
     m_services = services;
 
-    auto timerIt = m_timers.find(project.id);
-    if (timerIt != m_timers.end()) {
-        timerIt.value()->stop();
-        timerIt.value()->deleteLater();
-        m_timers.erase(timerIt);
-    }
+    removeEntry(project.id);
+    armTimer();
 
     m_restartSuppressed.remove(project.id);
     m_consecutiveFailures.remove(project.id);
@@ -74,7 +91,9 @@ void ScheduleEngine::startProject(const Project& project,
     case ScheduleType::Manual:
         break;
     case ScheduleType::FixedRate:
-        startFixedRate(project, serviceDir);
+    case ScheduleType::Cron:
+        startTimed(project, serviceDir);
+        armTimer();
         break;
     case ScheduleType::Daemon:
         startDaemon(project, serviceDir);
@@ -103,62 +122,188 @@ void ScheduleEngine::startDaemon(const Project& project,
     }
 }
 
-void ScheduleEngine::startFixedRate(const Project& project,
-                                    const QString& serviceDir) {
-    auto* timer = new QTimer(this);
-    timer->setInterval(project.schedule.intervalMs);
+void ScheduleEngine::startTimed(const Project& project,
+                                const QString& serviceDir) {
+    const qint64 nominalMs =
+        nextNominalFireMs(project.schedule, QDateTime::currentMSecsSinceEpoch());
+    if (nominalMs <= 0) {
+        qWarning("ScheduleEngine: no upcoming trigger for %s",
+                 qUtf8Printable(project.id));
+        return;
+    }
+    scheduleEntry(project.id, TimerEntry{0, 0, serviceDir}, nominalMs);
+}
 
-    connect(timer, &QTimer::timeout, this, [this, projectId = project.id, serviceDir]() {
-        if (m_shuttingDown) {
-            return;
+qint64 ScheduleEngine::nextNominalFireMs(const Schedule& schedule, qint64 nowMs,
+                                         qint64 previousNominalMs) {
+    if (schedule.type == ScheduleType::FixedRate) {
+        const qint64 interval = qMax(1, schedule.intervalMs);
+        if (previousNominalMs > 0) {
+            // 以上次名义时刻为基准累加，避免漂移；落后时跳过错过的周期而不补触发
+            qint64 next = previousNominalMs + interval;
+            if (next <= nowMs) {
+                next += ((nowMs - next) / interval + 1) * interval;
+            }
+            return next;
         }
-
-        auto projectIt = m_projects.find(projectId);
-        if (projectIt == m_projects.end()) {
-            return;
+        if (schedule.alignToInterval) {
+            return (nowMs / interval + 1) * interval;
         }
+        return nowMs + interval;
+    }
+    if (schedule.type == ScheduleType::Cron) {
+        const QDateTime next = schedule.cron.nextAfter(
+            QDateTime::fromMSecsSinceEpoch(qMax(nowMs, previousNominalMs)));
+        return next.isValid() ? next.toMSecsSinceEpoch() : 0;
+    }
+    return 0;
+}
 
-        const Project& project = projectIt.value();
-        if (!project.enabled || !project.valid || project.schedule.type != ScheduleType::FixedRate) {
-            return;
-        }
+void ScheduleEngine::scheduleEntry(const QString& projectId, TimerEntry entry,
+                                   qint64 nominalMs) {
+    removeEntry(projectId);
+    const auto projectIt = m_projects.constFind(projectId);
+    const int jitterMs = projectIt == m_projects.constEnd() ? 0 : projectIt->schedule.jitterMs;
+    entry.nominalMs = nominalMs;
+    entry.dueMs = nominalMs
+        + (jitterMs > 0 ? QRandomGenerator::global()->bounded(jitterMs + 1) : 0);
+    m_timerQueue.emplace(entry.dueMs, projectId);
+    m_timerEntries.insert(projectId, entry);
+}
+
+void ScheduleEngine::removeEntry(const QString& projectId) {
+    const auto it = m_timerEntries.constFind(projectId);
+    if (it == m_timerEntries.constEnd()) {
+        return;
+    }
+    m_timerQueue.erase(std::make_pair(it->dueMs, projectId));
+    m_timerEntries.erase(it);
+}
+
+void ScheduleEngine::armTimer() {
+    if (m_timerQueue.empty()) {
+        m_timer->stop();
+        return;
+    }
+    // 分片等待：系统时钟跳变时最多延迟一个分片即可按新时间重新计算
+    const qint64 delay = m_timerQueue.begin()->first - QDateTime::currentMSecsSinceEpoch();
+    m_timer->start(static_cast<int>(qBound<qint64>(0, delay, kMaxTimerSliceMs)));
+}
 
-        if (m_instanceMgr->instanceCount(projectId) >= project.schedule.maxConcurrent) {
-            return;
+void ScheduleEngine::onTimerQueueTimeout() {
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    while (!m_timerQueue.empty() && m_timerQueue.begin()->first <= nowMs) {
+        const QString projectId = m_timerQueue.begin()->second;
+        const TimerEntry entry = m_timerEntries.value(projectId);
+        removeEntry(projectId);
+
+        // 先排好下一次再触发：触发中的信号处理可能重新启停本项目
+        const auto projectIt = m_projects.constFind(projectId);
+        if (projectIt != m_projects.constEnd() && isTimedSchedule(projectIt->schedule.type)) {
+            const qint64 next = nextNominalFireMs(projectIt->schedule, nowMs, entry.nominalMs);
+            if (next > 0) {
+                scheduleEntry(projectId, entry, next);
+            }
         }
+        triggerTimed(projectId, entry.serviceDir);
+    }
+    armTimer();
+}
+
+void ScheduleEngine::triggerTimed(const QString& projectId, const QString& serviceDir) {
+    if (m_shuttingDown) {
+        return;
+    }
+
+    auto projectIt = m_projects.find(projectId);
+    if (projectIt == m_projects.end()) {
+        return;
+    }
+
+    const Project& project = projectIt.value();
+    if (!project.enabled || !project.valid || !isTimedSchedule(project.schedule.type)) {
+        return;
+    }
 
-        emit scheduleTriggered(projectId, QStringLiteral("fixed_rate"));
+    if (m_instanceMgr->instanceCount(projectId) >= project.schedule.maxConcurrent) {
+        return;
+    }
 
-        QString error;
-        (void)m_instanceMgr->startInstance(project, serviceDir, error);
-        if (!error.isEmpty()) {
-            qWarning("ScheduleEngine: fixed_rate trigger failed for %s: %s",
-                     qUtf8Printable(projectId),
-                     qUtf8Printable(error));
+    if (globalLimitReached()) {
+        for (const auto& pending : m_pendingStarts) {
+            if (pending.first == projectId) {
+                return;
+            }
         }
-    });
+        m_pendingStarts.append({projectId, serviceDir});
+        return;
+    }
 
-    m_timers.insert(project.id, timer);
-    timer->start();
+    (void)launchTimed(project, serviceDir);
 }
 
-void ScheduleEngine::stopAll() {
-    for (auto it = m_timers.begin(); it != m_timers.end(); ++it) {
-        it.value()->stop();
-        it.value()->deleteLater();
+bool ScheduleEngine::launchTimed(const Project& project, const QString& serviceDir) {
+    const QString scheduleType = timedScheduleName(project.schedule.type);
+    emit scheduleTriggered(project.id, scheduleType);
+
+    QString error;
+    const QString instanceId = m_instanceMgr->startInstance(project, serviceDir, error);
+    if (!error.isEmpty()) {
+        qWarning("ScheduleEngine: %s trigger failed for %s: %s",
+                 qUtf8Printable(scheduleType),
+                 qUtf8Printable(project.id),
+                 qUtf8Printable(error));
     }
-    m_timers.clear();
+    // FailedToStart 可能在 startInstance() 内同步结束实例，此时不再占用全局名额
+    if (instanceId.isEmpty() || !m_instanceMgr->getInstance(instanceId)) {
+        return false;
+    }
+    m_scheduledInstances.insert(instanceId);
+    return true;
+}
+
+bool ScheduleEngine::globalLimitReached() const {
+    return m_globalMaxConcurrent > 0
+        && m_scheduledInstances.size() >= m_globalMaxConcurrent;
+}
+
+void ScheduleEngine::setGlobalMaxConcurrent(int value) {
+    m_globalMaxConcurrent = qMax(0, value);
+    drainPendingStarts();
+}
+
+void ScheduleEngine::drainPendingStarts() {
+    while (!m_pendingStarts.isEmpty() && !globalLimitReached() && !m_shuttingDown) {
+        const auto [projectId, serviceDir] = m_pendingStarts.takeFirst();
+        auto projectIt = m_projects.find(projectId);
+        if (projectIt == m_projects.end()) {
+            continue;
+        }
+        const Project& project = projectIt.value();
+        if (!project.enabled || !project.valid || !isTimedSchedule(project.schedule.type)
+            || m_restartSuppressed.contains(projectId)
+            || m_instanceMgr->instanceCount(projectId) >= project.schedule.maxConcurrent) {
+            continue;
+        }
+        (void)launchTimed(project, serviceDir);
+    }
+}
+
+void ScheduleEngine::stopAll() {
+    m_timer->stop();
+    m_timerQueue.clear();
+    m_timerEntries.clear();
+    m_pendingStarts.clear();
     m_consecutiveFailures.clear();
     m_restartSuppressed.clear();
 }
 
 void ScheduleEngine::stopProject(const QString& projectId) {
-    auto timerIt = m_timers.find(projectId);
-    if (timerIt != m_timers.end()) {
-        timerIt.value()->stop();
-        timerIt.value()->deleteLater();
-        m_timers.erase(timerIt);
-    }
+    removeEntry(projectId);
+    armTimer();
+    m_pendingStarts.removeIf([&projectId](const std::pair<QString, QString>& pending) {
+        return pending.first == projectId;
+    });
 
     m_restartSuppressed.insert(projectId);
     m_consecutiveFailures.remove(projectId);
@@ -173,7 +318,15 @@ ScheduleEngine::ProjectRuntimeState ScheduleEngine::projectRuntimeState(const QS
     ProjectRuntimeState state;
     state.shuttingDown = m_shuttingDown;
     state.restartSuppressed = m_restartSuppressed.contains(projectId);
-    state.timerActive = m_timers.contains(projectId);
+    const auto entryIt = m_timerEntries.constFind(projectId);
+    state.timerActive = entryIt != m_timerEntries.constEnd();
+    state.nextFireMs = state.timerActive ? entryIt->dueMs : 0;
+    for (const auto& pending : m_pendingStarts) {
+        if (pending.first == projectId) {
+            state.startPending = true;
+            break;
+        }
+    }
     state.consecutiveFailures = m_consecutiveFailures.value(projectId, 0);
     return state;
 }
@@ -182,7 +335,10 @@ void ScheduleEngine::onInstanceFinished(const QString& instanceId,
                                         const QString& projectId,
                                         int exitCode,
                                         QProcess::ExitStatus exitStatus) {
-    Q_UNUSED(instanceId);
+    if (m_scheduledInstances.remove(instanceId) && !m_pendingStarts.isEmpty()) {
+        // 结束中的实例仍在 InstanceManager 中计数，待本轮信号处理完再补启动
+        QTimer::singleShot(0, this, &ScheduleEngine::drainPendingStarts);
+    }
 
     if (m_shuttingDown || m_restartSuppressed.contains(projectId)) {
         return;
@@ -1,11 +1,15 @@
 #pragma once
 
 #include <QHash>
+#include <QList>
 #include <QMap>
 #include <QObject>
 #include <QSet>
 #include <QString>
 
+#include <set>
+#include <utility>
+
 #include "manager/instance_manager.h"
 #include "model/project.h"
 #include "scanner/service_scanner.h"
@@ -14,6 +18,13 @@ class QTimer;
 
 namespace stdiolink_server {
 
+/// 项目调度
+///
+/// fixed_rate 与 cron 项目共用一个按到期时间排序的队列和单个 QTimer，
+/// 不再为每个项目创建定时器。每次触发按 jitterMs 随机延后以打散同一时刻的
+/// 启动风暴；名义触发时刻单独记录，抖动不会累积。setGlobalMaxConcurrent()
+/// 限制所有项目中由定时触发启动、仍在运行的实例总数，超出的触发进入等待队列，
+/// 有实例结束时按先后顺序补启动。
 class ScheduleEngine : public QObject {
     Q_OBJECT
 public:
@@ -21,7 +32,9 @@ public:
         bool shuttingDown = false;
         bool restartSuppressed = false;
         bool timerActive = false;
+        bool startPending = false;
         int consecutiveFailures = 0;
+        qint64 nextFireMs = 0;  // 下次触发的 epoch 毫秒（含抖动），0 表示无
     };
 
     explicit ScheduleEngine(InstanceManager* instanceMgr,
@@ -40,6 +53,18 @@ public:
     void setShuttingDown(bool value) { m_shuttingDown = value; }
     bool isShuttingDown() const { return m_shuttingDown; }
 
+    /// 定时触发实例的全局并发上限，0 表示不限
+    void setGlobalMaxConcurrent(int value);
+    int globalMaxConcurrent() const { return m_globalMaxConcurrent; }
+    int scheduledRunningCount() const { return m_scheduledInstances.size(); }
+    int pendingStartCount() const { return m_pendingStarts.size(); }
+
+    /// 计算 fixed_rate / cron 项目严格晚于 nowMs 的下一个名义触发时刻（epoch 毫秒，不含抖动）
+    static qint64 nextNominalFireMs(const Schedule& schedule, qint64 nowMs,
+                                    qint64 previousNominalMs = 0);
+
+    static constexpr int kMaxTimerSliceMs = 60000;
+
 signals:
     void scheduleTriggered(const QString& projectId, const QString& scheduleType);
     void scheduleSuppressed(const QString& projectId, const QString& reason,
@@ -51,18 +76,38 @@ private slots:
                             int exitCode,
                             QProcess::ExitStatus exitStatus);
 
+    void onTimerQueueTimeout();
+
 private:
+    struct TimerEntry {
+        qint64 nominalMs = 0;
+        qint64 dueMs = 0;
+        QString serviceDir;
+    };
+
     void startDaemon(const Project& project,
                      const QString& serviceDir);
-    void startFixedRate(const Project& project,
-                        const QString& serviceDir);
+    void startTimed(const Project& project,
+                    const QString& serviceDir);
+    void scheduleEntry(const QString& projectId, TimerEntry entry, qint64 nominalMs);
+    void removeEntry(const QString& projectId);
+    void armTimer();
+    void triggerTimed(const QString& projectId, const QString& serviceDir);
+    bool launchTimed(const Project& project, const QString& serviceDir);
+    void drainPendingStarts();
+    bool globalLimitReached() const;
 
     InstanceManager* m_instanceMgr = nullptr;
     QMap<QString, ServiceInfo> m_services;
     QMap<QString, Project> m_projects;
-    QHash<QString, QTimer*> m_timers;
+    QTimer* m_timer = nullptr;
+    std::set<std::pair<qint64, QString>> m_timerQueue;  // (dueMs, projectId)
+    QHash<QString, TimerEntry> m_timerEntries;
+    QList<std::pair<QString, QString>> m_pendingStarts;  // (projectId, serviceDir)
+    QSet<QString> m_scheduledInstances;
     QHash<QString, int> m_consecutiveFailures;
     QSet<QString> m_restartSuppressed;
+    int m_globalMaxConcurrent = 0;
     bool m_shuttingDown = false;
 };
 
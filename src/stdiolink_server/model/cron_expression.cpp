@@ -0,0 +1,188 @@
+#include "cron_expression.h"
+
+#include <QStringList>
+
+namespace stdiolink_server {
+
+namespace {
+
+const QStringList& monthNames() {
+    static const QStringList names = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+                                      "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+    return names;
+}
+
+const QStringList& weekdayNames() {
+    static const QStringList names = {"SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT"};
+    return names;
+}
+
+bool parseValue(const QString& text, const QStringList* names, int nameBase, int& out) {
+    bool ok = false;
+    out = text.toInt(&ok);
+    if (ok) {
+        return true;
+    }
+    if (names) {
+        const int idx = names->indexOf(text.toUpper());
+        if (idx >= 0) {
+            out = idx + nameBase;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseField(const QString& field, const QString& fieldName, int min, int max,
+                const QStringList* names, int nameBase, quint64& bits, QString& error) {
+    bits = 0;
+    const QStringList parts = field.split(',');
+    for (const QString& part : parts) {
+        QString range = part;
+        int step = 1;
+        const qsizetype slash = part.indexOf('/');
+        if (slash >= 0) {
+            bool ok = false;
+            step = part.mid(slash + 1).toInt(&ok);
+            if (!ok || step < 1) {
+                error = QString("invalid step in cron %1 field: %2").arg(fieldName, part);
+                return false;
+            }
+            range = part.left(slash);
+        }
+
+        int lo = min;
+        int hi = max;
+        if (range != "*") {
+            const qsizetype dash = range.indexOf('-');
+            if (dash >= 0) {
+                if (!parseValue(range.left(dash), names, nameBase, lo)
+                    || !parseValue(range.mid(dash + 1), names, nameBase, hi)) {
+                    error = QString("invalid range in cron %1 field: %2").arg(fieldName, part);
+                    return false;
+                }
+            } else {
+                if (!parseValue(range, names, nameBase, lo)) {
+                    error = QString("invalid value in cron %1 field: %2").arg(fieldName, part);
+                    return false;
+                }
+                // "a/n" 表示从 a 开始到上限每 n 个取一个
+                hi = slash >= 0 ? max : lo;
+            }
+        }
+        if (lo < min || hi > max || lo > hi) {
+            error = QString("cron %1 field out of range %2-%3: %4")
+                        .arg(fieldName).arg(min).arg(max).arg(part);
+            return false;
+        }
+        for (int v = lo; v <= hi; v += step) {
+            bits |= quint64(1) << v;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+CronExpression CronExpression::parse(const QString& text, QString& error) {
+    CronExpression expr;
+    expr.m_text = text.trimmed();
+
+    QString normalized = expr.m_text;
+    if (normalized == "@yearly" || normalized == "@annually") {
+        normalized = "0 0 1 1 *";
+    } else if (normalized == "@monthly") {
+        normalized = "0 0 1 * *";
+    } else if (normalized == "@weekly") {
+        normalized = "0 0 * * 0";
+    } else if (normalized == "@daily" || normalized == "@midnight") {
+        normalized = "0 0 * * *";
+    } else if (normalized == "@hourly") {
+        normalized = "0 * * * *";
+    }
+
+    const QStringList fields = normalized.split(' ', Qt::SkipEmptyParts);
+    if (fields.size() != 5) {
+        error = "cron expression must have 5 fields (minute hour day month weekday)";
+        return expr;
+    }
+
+    quint64 bits = 0;
+    if (!parseField(fields[0], "minute", 0, 59, nullptr, 0, bits, error)) {
+        return expr;
+    }
+    expr.m_minutes = bits;
+    if (!parseField(fields[1], "hour", 0, 23, nullptr, 0, bits, error)) {
+        return expr;
+    }
+    expr.m_hours = static_cast<quint32>(bits);
+    if (!parseField(fields[2], "day", 1, 31, nullptr, 0, bits, error)) {
+        return expr;
+    }
+    expr.m_daysOfMonth = static_cast<quint32>(bits);
+    if (!parseField(fields[3], "month", 1, 12, &monthNames(), 1, bits, error)) {
+        return expr;
+    }
+    expr.m_months = static_cast<quint32>(bits);
+    if (!parseField(fields[4], "weekday", 0, 7, &weekdayNames(), 0, bits, error)) {
+        return expr;
+    }
+    // 7 与 0 都表示周日
+    if (bits & (quint64(1) << 7)) {
+        bits = (bits & ~(quint64(1) << 7)) | 1;
+    }
+    expr.m_daysOfWeek = static_cast<quint32>(bits);
+
+    // 与 Vixie cron 一致：以 * 开头的日/周字段视为不受限
+    expr.m_domRestricted = !fields[2].startsWith('*');
+    expr.m_dowRestricted = !fields[4].startsWith('*');
+    expr.m_valid = true;
+    error.clear();
+    return expr;
+}
+
+bool CronExpression::matchesDay(const QDate& date) const {
+    const bool domMatch = m_daysOfMonth & (quint32(1) << date.day());
+    const bool dowMatch = m_daysOfWeek & (quint32(1) << (date.dayOfWeek() % 7));
+    if (m_domRestricted && m_dowRestricted) {
+        return domMatch || dowMatch;
+    }
+    return domMatch && dowMatch;
+}
+
+QDateTime CronExpression::nextAfter(const QDateTime& after) const {
+    if (!m_valid) {
+        return {};
+    }
+
+    const QDateTime local = after.toLocalTime();
+    QDateTime t(local.date(), QTime(local.time().hour(), local.time().minute()));
+    t = t.addSecs(60);
+    const QDateTime limit = local.addYears(4);
+
+    // 逐级跳过不匹配的月、日、时，最多逐分钟推进 59 次即可命中
+    while (t.isValid() && t <= limit) {
+        const QDate date = t.date();
+        const QTime time = t.time();
+        if (!(m_months & (quint32(1) << date.month()))) {
+            t = QDateTime(QDate(date.year(), date.month(), 1).addMonths(1), QTime(0, 0));
+            continue;
+        }
+        if (!matchesDay(date)) {
+            t = QDateTime(date.addDays(1), QTime(0, 0));
+            continue;
+        }
+        if (!(m_hours & (quint32(1) << time.hour()))) {
+            t = QDateTime(date, QTime(time.hour(), 0)).addSecs(3600);
+            continue;
+        }
+        if (!(m_minutes & (quint64(1) << time.minute()))) {
+            t = t.addSecs(60);
+            continue;
+        }
+        return t;
+    }
+    return {};
+}
+
+} // namespace stdiolink_server
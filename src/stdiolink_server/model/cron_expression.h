@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QDateTime>
+#include <QString>
+
+namespace stdiolink_server {
+
+/// 标准 5 字段 cron 表达式：分 时 日 月 周（本地时间）
+///
+/// 支持 `*`、列表 `a,b`、范围 `a-b`、步长 `*/n` 与 `a-b/n`，月份与星期可用英文缩写
+/// （JAN..DEC、SUN..SAT），星期 0 与 7 均表示周日；另支持 @hourly / @daily /
+/// @weekly / @monthly / @yearly。日与周同时受限时按 cron 惯例取并集。
+class CronExpression {
+public:
+    static CronExpression parse(const QString& text, QString& error);
+
+    bool isValid() const { return m_valid; }
+    QString text() const { return m_text; }
+
+    /// 严格晚于 after 的下一个触发时刻（秒与毫秒为 0）；四年内无匹配时返回无效 QDateTime
+    QDateTime nextAfter(const QDateTime& after) const;
+
+private:
+    bool matchesDay(const QDate& date) const;
+
+    QString m_text;
+    bool m_valid = false;
+    quint64 m_minutes = 0;      // bit 0..59
+    quint32 m_hours = 0;        // bit 0..23
+    quint32 m_daysOfMonth = 0;  // bit 1..31
+    quint32 m_months = 0;       // bit 1..12
+    quint32 m_daysOfWeek = 0;   // bit 0..6，0 = 周日
+    bool m_domRestricted = false;
+    bool m_dowRestricted = false;
+};
+
+} // namespace stdiolink_server
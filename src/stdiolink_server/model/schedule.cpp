@@ -58,6 +58,30 @@ Schedule Schedule::fromJson(const QJsonObject& obj, QString& error) {
             error = "schedule.maxConcurrent must be >= 1";
             return schedule;
         }
+        schedule.alignToInterval = obj.value("alignToInterval").toBool(false);
+        if (!parseNonNegativeIntField(obj, QStringLiteral("jitterMs"), 0, schedule.jitterMs, error)) {
+            return schedule;
+        }
+        if (schedule.jitterMs >= schedule.intervalMs) {
+            error = "schedule.jitterMs must be less than schedule.intervalMs";
+            return schedule;
+        }
+    } else if (type == "cron") {
+        schedule.type = ScheduleType::Cron;
+        schedule.maxConcurrent = obj.value("maxConcurrent").toInt(1);
+        if (schedule.maxConcurrent < 1) {
+            error = "schedule.maxConcurrent must be >= 1";
+            return schedule;
+        }
+        if (!parseNonNegativeIntField(obj, QStringLiteral("jitterMs"), 0, schedule.jitterMs, error)) {
+            return schedule;
+        }
+        QString cronError;
+        schedule.cron = CronExpression::parse(obj.value("cron").toString(), cronError);
+        if (!schedule.cron.isValid()) {
+            error = "schedule.cron: " + cronError;
+            return schedule;
+        }
     } else if (type == "daemon") {
         schedule.type = ScheduleType::Daemon;
         schedule.restartDelayMs = obj.value("restartDelayMs").toInt(3000);
@@ -91,6 +115,14 @@ QJsonObject Schedule::toJson() const {
         obj["type"] = "fixed_rate";
         obj["intervalMs"] = intervalMs;
         obj["maxConcurrent"] = maxConcurrent;
+        obj["alignToInterval"] = alignToInterval;
+        obj["jitterMs"] = jitterMs;
+        break;
+    case ScheduleType::Cron:
+        obj["type"] = "cron";
+        obj["cron"] = cron.text();
+        obj["maxConcurrent"] = maxConcurrent;
+        obj["jitterMs"] = jitterMs;
         break;
     case ScheduleType::Daemon:
         obj["type"] = "daemon";
@@ -3,12 +3,15 @@
 #include <QJsonObject>
 #include <QString>
 
+#include "cron_expression.h"
+
 namespace stdiolink_server {
 
 enum class ScheduleType {
     Manual,
     FixedRate,
-    Daemon
+    Daemon,
+    Cron
 };
 
 struct Schedule {
@@ -16,6 +19,10 @@ struct Schedule {
 
     int intervalMs = 5000;
     int maxConcurrent = 1;
+    bool alignToInterval = false;  // fixed_rate：触发时刻对齐到 intervalMs 的整数倍
+    int jitterMs = 0;              // fixed_rate / cron：每次触发随机延后 0..jitterMs
+
+    CronExpression cron;
 
     int restartDelayMs = 3000;
     int maxConsecutiveFailures = 5;
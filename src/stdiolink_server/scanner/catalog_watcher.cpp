@@ -0,0 +1,268 @@
+#include "catalog_watcher.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QTimer>
+
+#include <algorithm>
+#include <utility>
+
+#include "stdiolink/platform/platform_utils.h"
+
+namespace stdiolink_server {
+
+namespace {
+
+constexpr CatalogWatcher::Category kCategories[] = {
+    CatalogWatcher::Category::Services,
+    CatalogWatcher::Category::Projects,
+    CatalogWatcher::Category::Drivers,
+};
+
+QStringList keyFileNames(CatalogWatcher::Category category, const QString& entryDir) {
+    switch (category) {
+    case CatalogWatcher::Category::Services:
+        return {"manifest.json", "config.schema.json"};
+    case CatalogWatcher::Category::Projects:
+        return {"config.json", "param.json"};
+    case CatalogWatcher::Category::Drivers: {
+        // 可执行文件被原地覆盖时目录本身不会收到通知，需单独监视
+        QStringList names{"driver.meta.json"};
+        names += QDir(entryDir).entryList({stdiolink::PlatformUtils::executableFilter()},
+                                          QDir::Files | QDir::Executable);
+        return names;
+    }
+    }
+    return {};
+}
+
+} // namespace
+
+CatalogWatcher::CatalogWatcher(const QString& dataRoot, int debounceMs, QObject* parent)
+    : QObject(parent)
+    , m_dataRoot(QDir::cleanPath(QFileInfo(dataRoot).absoluteFilePath()))
+    , m_debounceMs(qMax(0, debounceMs)) {
+    state(Category::Services).rootDir = m_dataRoot + "/services";
+    state(Category::Projects).rootDir = m_dataRoot + "/projects";
+    state(Category::Drivers).rootDir = m_dataRoot + "/drivers";
+
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    connect(m_flushTimer, &QTimer::timeout, this, &CatalogWatcher::flush);
+}
+
+CatalogWatcher::~CatalogWatcher() {
+    stop();
+}
+
+bool CatalogWatcher::start() {
+    if (m_active) {
+        return true;
+    }
+    if (!QFileInfo(m_dataRoot).isDir()) {
+        return false;
+    }
+
+    m_watcher = new QFileSystemWatcher(this);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &CatalogWatcher::onDirectoryChanged);
+    connect(m_watcher, &QFileSystemWatcher::fileChanged,
+            this, &CatalogWatcher::onFileChanged);
+
+    // 监视 data_root 本身，以便分类目录事后被创建/删除时重新挂接
+    m_watcher->addPath(m_dataRoot);
+    m_active = true;
+    for (Category category : kCategories) {
+        syncRoot(category, false);
+    }
+    return true;
+}
+
+void CatalogWatcher::stop() {
+    m_flushTimer->stop();
+    for (CategoryState& s : m_states) {
+        s.rootWatched = false;
+        s.entries.clear();
+        s.dirty.clear();
+    }
+    delete m_watcher;
+    m_watcher = nullptr;
+    m_active = false;
+}
+
+int CatalogWatcher::watchedPathCount() const {
+    if (!m_watcher) {
+        return 0;
+    }
+    return static_cast<int>(m_watcher->files().size() + m_watcher->directories().size());
+}
+
+void CatalogWatcher::markDirty(Category category, const QString& entry) {
+    if (!m_active || entry.isEmpty()) {
+        return;
+    }
+    state(category).dirty.insert(entry);
+    scheduleFlush();
+}
+
+void CatalogWatcher::onDirectoryChanged(const QString& path) {
+    if (path == m_dataRoot) {
+        for (Category category : kCategories) {
+            syncRoot(category, true);
+        }
+        return;
+    }
+
+    for (Category category : kCategories) {
+        if (path == state(category).rootDir) {
+            syncRoot(category, true);
+            return;
+        }
+    }
+
+    Category category;
+    QString entry;
+    if (resolveEntry(path, category, entry)) {
+        markDirty(category, entry);
+    }
+}
+
+void CatalogWatcher::onFileChanged(const QString& path) {
+    Category category;
+    QString entry;
+    if (resolveEntry(path, category, entry)) {
+        markDirty(category, entry);
+    }
+}
+
+void CatalogWatcher::flush() {
+    if (!m_active) {
+        return;
+    }
+    m_pendingSince.invalidate();
+
+    for (Category category : kCategories) {
+        CategoryState& s = state(category);
+        if (s.dirty.isEmpty()) {
+            continue;
+        }
+
+        QStringList changed(s.dirty.cbegin(), s.dirty.cend());
+        s.dirty.clear();
+        std::sort(changed.begin(), changed.end());
+
+        // 原子替换（写临时文件再 rename）会使旧文件上的监视失效，逐条目重新挂接
+        for (const QString& entry : changed) {
+            unwatchEntry(category, entry);
+            if (s.rootWatched && QFileInfo(s.rootDir + "/" + entry).isDir()) {
+                watchEntry(category, entry);
+            }
+        }
+
+        switch (category) {
+        case Category::Services:
+            emit servicesChanged(changed);
+            break;
+        case Category::Projects:
+            emit projectsChanged(changed);
+            break;
+        case Category::Drivers:
+            emit driversChanged(changed);
+            break;
+        }
+    }
+}
+
+CatalogWatcher::CategoryState& CatalogWatcher::state(Category category) {
+    return m_states[static_cast<size_t>(category)];
+}
+
+void CatalogWatcher::syncRoot(Category category, bool markChanges) {
+    if (!m_watcher) {
+        return;
+    }
+    CategoryState& s = state(category);
+
+    QSet<QString> present;
+    if (QFileInfo(s.rootDir).isDir()) {
+        if (!s.rootWatched) {
+            m_watcher->addPath(s.rootDir);
+            s.rootWatched = true;
+        }
+        const QStringList names = QDir(s.rootDir).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        present = QSet<QString>(names.cbegin(), names.cend());
+    } else if (s.rootWatched) {
+        m_watcher->removePath(s.rootDir);
+        s.rootWatched = false;
+    }
+
+    const QStringList known = s.entries.keys();
+    for (const QString& entry : known) {
+        if (!present.contains(entry)) {
+            unwatchEntry(category, entry);
+            if (markChanges) {
+                markDirty(category, entry);
+            }
+        }
+    }
+    for (const QString& entry : std::as_const(present)) {
+        if (!s.entries.contains(entry)) {
+            watchEntry(category, entry);
+            if (markChanges) {
+                markDirty(category, entry);
+            }
+        }
+    }
+}
+
+void CatalogWatcher::watchEntry(Category category, const QString& entry) {
+    CategoryState& s = state(category);
+    const QString entryDir = s.rootDir + "/" + entry;
+
+    QStringList paths{entryDir};
+    for (const QString& name : keyFileNames(category, entryDir)) {
+        const QString filePath = entryDir + "/" + name;
+        if (QFileInfo::exists(filePath)) {
+            paths.append(filePath);
+        }
+    }
+    const QStringList failed = m_watcher->addPaths(paths);
+    for (const QString& path : failed) {
+        paths.removeAll(path);
+    }
+    s.entries.insert(entry, paths);
+}
+
+void CatalogWatcher::unwatchEntry(Category category, const QString& entry) {
+    CategoryState& s = state(category);
+    const QStringList paths = s.entries.take(entry);
+    if (!paths.isEmpty() && m_watcher) {
+        (void)m_watcher->removePaths(paths);
+    }
+}
+
+bool CatalogWatcher::resolveEntry(const QString& path, Category& category, QString& entry) const {
+    for (Category c : kCategories) {
+        const QString prefix = m_states[static_cast<size_t>(c)].rootDir + "/";
+        if (!path.startsWith(prefix)) {
+            continue;
+        }
+        entry = path.mid(prefix.size()).section('/', 0, 0);
+        category = c;
+        return !entry.isEmpty();
+    }
+    return false;
+}
+
+void CatalogWatcher::scheduleFlush() {
+    if (!m_pendingSince.isValid()) {
+        m_pendingSince.start();
+    }
+    // 尾沿去抖，但连续写入不能无限推迟：距首个变更超过上限后立即发出
+    const qint64 maxDelay = static_cast<qint64>(m_debounceMs) * kMaxDelayFactor;
+    const qint64 remaining = qMax<qint64>(0, maxDelay - m_pendingSince.elapsed());
+    m_flushTimer->start(static_cast<int>(qMin<qint64>(m_debounceMs, remaining)));
+}
+
+} // namespace stdiolink_server
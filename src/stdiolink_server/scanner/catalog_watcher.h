@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <array>
+
+class QFileSystemWatcher;
+class QTimer;
+
+namespace stdiolink_server {
+
+/// data_root 下 services / projects / drivers 的增量变更监视
+///
+/// 每个分类监视根目录、各条目子目录及其中的关键文件（manifest / schema、
+/// config / param、driver.meta.json 与驱动可执行文件），不递归。变更按条目
+/// （子目录名）去重，静默 debounceMs 后批量发出；持续写入时最迟
+/// kMaxDelayFactor 倍 debounceMs 也会发出一次。同一批次内按
+/// services → projects → drivers 顺序发信号，保证项目校验看到最新的服务。
+class CatalogWatcher : public QObject {
+    Q_OBJECT
+public:
+    enum class Category { Services = 0, Projects = 1, Drivers = 2 };
+
+    explicit CatalogWatcher(const QString& dataRoot,
+                            int debounceMs = kDefaultDebounceMs,
+                            QObject* parent = nullptr);
+    ~CatalogWatcher() override;
+
+    bool start();
+    void stop();
+    bool isActive() const { return m_active; }
+    int debounceMs() const { return m_debounceMs; }
+    int watchedPathCount() const;
+
+    /// 将条目标记为待更新，参与下一次批量发出（也用于暂缓处理后重新排队）
+    void markDirty(Category category, const QString& entry);
+
+    static constexpr int kDefaultDebounceMs = 500;
+    static constexpr int kMaxDelayFactor = 10;
+
+signals:
+    void servicesChanged(const QStringList& entries);
+    void projectsChanged(const QStringList& entries);
+    void driversChanged(const QStringList& entries);
+
+private slots:
+    void onDirectoryChanged(const QString& path);
+    void onFileChanged(const QString& path);
+    void flush();
+
+private:
+    struct CategoryState {
+        QString rootDir;
+        bool rootWatched = false;
+        QHash<QString, QStringList> entries;  // 条目名 -> 已监视路径
+        QSet<QString> dirty;
+    };
+
+    CategoryState& state(Category category);
+    void syncRoot(Category category, bool markChanges);
+    void watchEntry(Category category, const QString& entry);
+    void unwatchEntry(Category category, const QString& entry);
+    bool resolveEntry(const QString& path, Category& category, QString& entry) const;
+    void scheduleFlush();
+
+    QString m_dataRoot;
+    int m_debounceMs = kDefaultDebounceMs;
+    bool m_active = false;
+    std::array<CategoryState, 3> m_states;
+    QFileSystemWatcher* m_watcher = nullptr;
+    QTimer* m_flushTimer = nullptr;
+    QElapsedTimer m_pendingSince;
+};
+
+} // namespace stdiolink_server
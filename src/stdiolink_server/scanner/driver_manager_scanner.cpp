@@ -4,10 +4,16 @@
 #include <QCryptographicHash>
 #include <QDebug>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
 #include <QJsonDocument>
+#include <QJsonObject>
 #include <QProcess>
+#include <QSaveFile>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
 
 #include "stdiolink/platform/platform_utils.h"
 #include "stdiolink/protocol/meta_types.h"
@@ -15,6 +21,25 @@
 
 namespace stdiolink_server {
 
+struct DriverManagerScanner::DriverTask {
+    QString name;
+    QString subDir;
+    QString metaPath;
+    QString executable;
+    bool hasMeta = false;
+    bool needExport = false;
+    bool cacheHit = false;
+    bool exportOk = false;
+    qint64 exportMs = 0;
+};
+
+int DriverManagerScanner::maxParallelExports() const {
+    if (m_maxParallelExports > 0) {
+        return m_maxParallelExports;
+    }
+    return qBound(1, QThread::idealThreadCount(), kDefaultMaxParallelExports);
+}
+
 bool DriverManagerScanner::isFailedDir(const QString& dirName) {
     return dirName.endsWith(".failed");
 }
@@ -60,6 +85,76 @@ QString DriverManagerScanner::computeMetaHash(const QByteArray& data) {
     return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex());
 }
 
+QString DriverManagerScanner::computeFileSha256(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&file)) {
+        return {};
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+bool DriverManagerScanner::loadStamp(const QString& dirPath, ExecutableStamp& stamp) {
+    QFile file(dirPath + "/" + kStampFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isObject()) {
+        return false;
+    }
+    const QJsonObject obj = doc.object();
+    stamp.size = static_cast<qint64>(obj.value("size").toDouble(-1));
+    stamp.mtimeMs = static_cast<qint64>(obj.value("mtimeMs").toDouble(-1));
+    stamp.executable = obj.value("executable").toString();
+    stamp.sha256 = obj.value("sha256").toString();
+    return stamp.size >= 0 && !stamp.sha256.isEmpty();
+}
+
+bool DriverManagerScanner::writeStamp(const QString& dirPath, const QString& executable) {
+    const QFileInfo info(executable);
+    const QString sha256 = computeFileSha256(executable);
+    if (sha256.isEmpty()) {
+        return false;
+    }
+    const QJsonObject obj{
+        {"executable", info.fileName()},
+        {"size", info.size()},
+        {"mtimeMs", info.lastModified().toMSecsSinceEpoch()},
+        {"sha256", sha256},
+    };
+    QSaveFile file(dirPath + "/" + kStampFileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+    return file.commit();
+}
+
+bool DriverManagerScanner::isExecutableUnchanged(const QString& dirPath,
+                                                 const QString& executable) {
+    ExecutableStamp stamp;
+    if (!loadStamp(dirPath, stamp)) {
+        return false;
+    }
+    const QFileInfo info(executable);
+    if (info.fileName() != stamp.executable || info.size() != stamp.size) {
+        return false;
+    }
+    if (info.lastModified().toMSecsSinceEpoch() == stamp.mtimeMs) {
+        return true;
+    }
+    // 大小相同但时间戳变了（重新拷贝/解包）：按内容判定，相同则刷新记录的时间戳
+    if (computeFileSha256(executable) != stamp.sha256) {
+        return false;
+    }
+    (void)writeStamp(dirPath, executable);
+    return true;
+}
+
 bool DriverManagerScanner::loadMetaFile(const QString& metaPath,
                                         stdiolink::DriverConfig& config) {
     QFile file(metaPath);
@@ -119,16 +214,125 @@ bool DriverManagerScanner::tryExportMeta(const QString& executable,
     return parseErr.error == QJsonParseError::NoError && doc.isObject();
 }
 
+DriverManagerScanner::DriverTask DriverManagerScanner::prepareTask(const QString& dirPath,
+                                                                  bool refreshMeta) {
+    DriverTask task;
+    task.subDir = QFileInfo(dirPath).absoluteFilePath();
+    task.name = QFileInfo(task.subDir).fileName();
+    task.metaPath = task.subDir + "/driver.meta.json";
+    task.hasMeta = QFileInfo::exists(task.metaPath);
+    task.executable = findDriverExecutable(task.subDir);
+    if (!task.hasMeta) {
+        task.needExport = !task.executable.isEmpty();
+    } else if (refreshMeta && !task.executable.isEmpty()) {
+        task.cacheHit = isExecutableUnchanged(task.subDir, task.executable);
+        task.needExport = !task.cacheHit;
+    }
+    return task;
+}
+
+void DriverManagerScanner::runExport(DriverTask& task) const {
+    QElapsedTimer timer;
+    timer.start();
+    task.exportOk = tryExportMeta(task.executable, task.metaPath);
+    task.exportMs = timer.elapsed();
+}
+
+bool DriverManagerScanner::finishTask(const DriverTask& task,
+                                      bool markFailedOnError,
+                                      ScanStats* stats,
+                                      stdiolink::DriverConfig& config) {
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    DriverTiming timing;
+    timing.name = task.name;
+    if (stats) {
+        stats->exported += task.needExport ? 1 : 0;
+        stats->cacheHits += task.cacheHit ? 1 : 0;
+    }
+    const auto record = [&]() {
+        timing.elapsedMs = task.exportMs + loadTimer.elapsed();
+        if (stats) {
+            stats->drivers.append(timing);
+        }
+    };
+
+    if (!task.hasMeta) {
+        if (!task.exportOk && !markFailedOnError) {
+            qWarning("Driver not ready (%s), will retry: %s",
+                     task.executable.isEmpty() ? "no executable" : "export failed",
+                     qUtf8Printable(task.name));
+            if (stats) {
+                stats->pending++;
+            }
+            timing.action = QStringLiteral("pending");
+            record();
+            return false;
+        }
+        if (!task.exportOk) {
+            qWarning("Driver export failed, marking failed: %s", qUtf8Printable(task.name));
+            if (markFailed(task.subDir)) {
+                if (stats) {
+                    stats->newlyFailed++;
+                }
+            } else {
+                qWarning("Failed to rename directory to .failed: %s", qUtf8Printable(task.subDir));
+            }
+            timing.action = QStringLiteral("failed");
+            record();
+            return false;
+        }
+        (void)writeStamp(task.subDir, task.executable);
+        timing.action = QStringLiteral("exported");
+    } else if (task.needExport) {
+        if (task.exportOk) {
+            (void)writeStamp(task.subDir, task.executable);
+            timing.action = QStringLiteral("refreshed");
+        } else {
+            qWarning("Driver re-export failed, keeping old meta: %s", qUtf8Printable(task.name));
+            timing.action = QStringLiteral("refreshFailed");
+        }
+    } else {
+        timing.action = task.cacheHit ? QStringLiteral("cached") : QStringLiteral("loaded");
+    }
+
+    if (!loadMetaFile(task.metaPath, config)) {
+        qWarning("Invalid driver meta, skip: %s", qUtf8Printable(task.metaPath));
+        timing.action = QStringLiteral("invalid");
+        record();
+        return false;
+    }
+
+    if (config.program.isEmpty()) {
+        qWarning("Driver '%s' has meta but no %s executable, skip",
+                 qUtf8Printable(task.name),
+                 qUtf8Printable(stdiolink::PlatformUtils::driverExecutablePrefix()));
+        timing.action = QStringLiteral("invalid");
+        record();
+        return false;
+    }
+
+    if (stats) {
+        stats->updated++;
+    }
+    record();
+    return true;
+}
+
 QHash<QString, stdiolink::DriverConfig> DriverManagerScanner::scan(const QString& driversDir,
                                                                     bool refreshMeta,
                                                                     ScanStats* stats) const {
     QHash<QString, stdiolink::DriverConfig> result;
+    QElapsedTimer scanTimer;
+    scanTimer.start();
 
     QDir root(driversDir);
     if (!root.exists()) {
         return result;
     }
 
+    // 1. 逐目录决定是否需要导出（只读文件系统，开销小）
+    QVector<DriverTask> tasks;
     const auto entries = root.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
     for (const QString& entry : entries) {
         if (isFailedDir(entry)) {
@@ -141,50 +345,72 @@ QHash<QString, stdiolink::DriverConfig> DriverManagerScanner::scan(const QString
         if (stats) {
             stats->scanned++;
         }
+        tasks.append(prepareTask(root.absoluteFilePath(entry), refreshMeta));
+    }
 
-        const QString subDir = root.absoluteFilePath(entry);
-        const QString metaPath = subDir + "/driver.meta.json";
-        const bool hasMeta = QFileInfo::exists(metaPath);
-        const QString executable = findDriverExecutable(subDir);
-
-        if (!hasMeta) {
-            if (executable.isEmpty() || !tryExportMeta(executable, metaPath)) {
-                qWarning("Driver export failed, marking failed: %s", qUtf8Printable(entry));
-                if (markFailed(subDir)) {
-                    if (stats) {
-                        stats->newlyFailed++;
-                    }
-                } else {
-                    qWarning("Failed to rename directory to .failed: %s", qUtf8Printable(subDir));
-                }
-                continue;
-            }
-        } else if (refreshMeta && !executable.isEmpty()) {
-            if (!tryExportMeta(executable, metaPath)) {
-                qWarning("Driver re-export failed, keeping old meta: %s", qUtf8Printable(entry));
-            }
+    // 2. 并发导出：独立线程池，避免占满调用方可能所在的全局线程池
+    QList<DriverTask*> exports;
+    for (DriverTask& task : tasks) {
+        if (task.needExport) {
+            exports.append(&task);
         }
+    }
+    if (!exports.isEmpty()) {
+        QThreadPool pool;
+        pool.setMaxThreadCount(qMin(maxParallelExports(), static_cast<int>(exports.size())));
+        QtConcurrent::blockingMap(&pool, exports, [this](DriverTask* task) {
+            runExport(*task);
+        });
+    }
 
+    // 3. 按目录顺序汇总结果，保持与串行扫描相同的失败标记与加载语义
+    for (const DriverTask& task : tasks) {
         stdiolink::DriverConfig config;
-        if (!loadMetaFile(metaPath, config)) {
-            qWarning("Invalid driver meta, skip: %s", qUtf8Printable(metaPath));
-            continue;
+        if (finishTask(task, true, stats, config)) {
+            result.insert(config.id, config);
         }
+    }
 
-        if (config.program.isEmpty()) {
-            qWarning("Driver '%s' has meta but no %s executable, skip",
-                     qUtf8Printable(entry),
-                     qUtf8Printable(stdiolink::PlatformUtils::driverExecutablePrefix()));
-            continue;
-        }
+    if (stats) {
+        stats->elapsedMs = scanTimer.elapsed();
+    }
+    return result;
+}
+
+std::optional<stdiolink::DriverConfig> DriverManagerScanner::scanOne(const QString& driverDir,
+                                                                     bool refreshMeta,
+                                                                     ScanStats* stats) const {
+    QElapsedTimer scanTimer;
+    scanTimer.start();
 
-        result.insert(config.id, config);
+    const QFileInfo info(driverDir);
+    if (!info.isDir()) {
+        return std::nullopt;
+    }
+    if (isFailedDir(info.fileName())) {
         if (stats) {
-            stats->updated++;
+            stats->skippedFailed++;
         }
+        return std::nullopt;
+    }
+    if (stats) {
+        stats->scanned++;
     }
 
-    return result;
+    DriverTask task = prepareTask(driverDir, refreshMeta);
+    if (task.needExport) {
+        runExport(task);
+    }
+
+    stdiolink::DriverConfig config;
+    const bool ok = finishTask(task, false, stats, config);
+    if (stats) {
+        stats->elapsedMs = scanTimer.elapsed();
+    }
+    if (!ok) {
+        return std::nullopt;
+    }
+    return config;
 }
 
 } // namespace stdiolink_server
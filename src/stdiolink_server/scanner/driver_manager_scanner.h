@@ -2,6 +2,9 @@
 
 #include <QHash>
 #include <QString>
+#include <QVector>
+
+#include <optional>
 
 #include "stdiolink/host/driver_catalog.h"
 
@@ -9,28 +12,81 @@ namespace stdiolink_server {
 
 class DriverManagerScanner {
 public:
+    /// 单个驱动目录的处理结果与耗时
+    struct DriverTiming {
+        QString name;       ///< 驱动目录名
+        QString action;     ///< exported / refreshed / cached / loaded / refreshFailed / failed / pending / invalid
+        qint64 elapsedMs = 0;
+    };
+
     struct ScanStats {
         int scanned = 0;
         int updated = 0;
         int newlyFailed = 0;
         int skippedFailed = 0;
+        int pending = 0;     ///< scanOne() 中尚无可执行文件或导出失败、暂不标记 .failed 的新驱动数
+        int exported = 0;    ///< 执行了 --export-meta 的驱动数（含失败）
+        int cacheHits = 0;   ///< 可执行文件未变、沿用已有 meta 的驱动数
+        qint64 elapsedMs = 0;
+        QVector<DriverTiming> drivers;
     };
 
+    /// 扫描 driversDir 下的驱动目录
+    ///
+    /// 需要导出的驱动在独立线程池中并发执行 --export-meta（最多 maxParallelExports 个）。
+    /// refreshMeta 时仅对可执行文件的大小/修改时间/SHA-256 与 driver.meta.stamp.json
+    /// 记录不一致的驱动重新导出。
     QHash<QString, stdiolink::DriverConfig> scan(const QString& driversDir,
                                                   bool refreshMeta = true,
                                                   ScanStats* stats = nullptr) const;
 
+    /// 只处理 driversDir 下的单个驱动目录，语义与 scan() 中的一项相同
+    ///
+    /// 目录不存在、是 .failed 目录或加载失败时返回 std::nullopt。供文件监视触发的增量更新使用：
+    /// 目录可能仍在安装中，尚无可执行文件或导出失败的新驱动只计入 pending，不重命名为 .failed，
+    /// 隔离留给全量 scan()。
+    std::optional<stdiolink::DriverConfig> scanOne(const QString& driverDir,
+                                                   bool refreshMeta = true,
+                                                   ScanStats* stats = nullptr) const;
+
+    void setMaxParallelExports(int value) { m_maxParallelExports = value; }
+    int maxParallelExports() const;
+
+    static constexpr const char* kStampFileName = "driver.meta.stamp.json";
+
 private:
     static constexpr int kExportTimeoutMs = 10000;
+    static constexpr int kDefaultMaxParallelExports = 8;
+
+    struct DriverTask;
 
+    struct ExecutableStamp {
+        QString executable;
+        qint64 size = -1;
+        qint64 mtimeMs = -1;
+        QString sha256;
+    };
+
+    static DriverTask prepareTask(const QString& dirPath, bool refreshMeta);
+    void runExport(DriverTask& task) const;
+    static bool finishTask(const DriverTask& task,
+                           bool markFailedOnError,
+                           ScanStats* stats,
+                           stdiolink::DriverConfig& config);
     bool tryExportMeta(const QString& executable,
                        const QString& metaPath) const;
+    static bool loadStamp(const QString& dirPath, ExecutableStamp& stamp);
+    static bool writeStamp(const QString& dirPath, const QString& executable);
+    static bool isExecutableUnchanged(const QString& dirPath, const QString& executable);
+    static QString computeFileSha256(const QString& path);
     static QString findDriverExecutable(const QString& dirPath);
     static bool loadMetaFile(const QString& metaPath,
                              stdiolink::DriverConfig& config);
     static QString computeMetaHash(const QByteArray& data);
     static bool isFailedDir(const QString& dirName);
     static bool markFailed(const QString& dirPath);
+
+    int m_maxParallelExports = 0;  // 0 = min(CPU 数, kDefaultMaxParallelExports)
 };
 
 } // namespace stdiolink_server
@@ -2,7 +2,9 @@
 
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonDocument>
+#include <QPointer>
 #include <QRegularExpression>
 #include <QSaveFile>
 #include <QSysInfo>
@@ -91,6 +93,24 @@ QJsonObject templateConfigSchema(const QString& templateType) {
     return QJsonObject{};
 }
 
+QString normalizedPath(const QString& path) {
+    return QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+}
+
+bool serviceChanged(const ServiceInfo& prev, const ServiceInfo& cur) {
+    return prev.name != cur.name
+           || prev.version != cur.version
+           || prev.serviceDir != cur.serviceDir
+           || prev.rawConfigSchema != cur.rawConfigSchema;
+}
+
+bool projectChanged(const Project& prev, const Project& cur) {
+    return prev.toJson() != cur.toJson()
+           || prev.config != cur.config
+           || prev.valid != cur.valid
+           || prev.error != cur.error;
+}
+
 } // namespace
 
 ServerManager::ServerManager(const QString& dataRoot,
@@ -101,8 +121,22 @@ ServerManager::ServerManager(const QString& dataRoot,
     , m_config(config) {
     m_instanceManager = new InstanceManager(dataRoot, config, this);
     m_scheduleEngine = new ScheduleEngine(m_instanceManager, this);
+    m_scheduleEngine->setGlobalMaxConcurrent(m_config.scheduleMaxConcurrent);
     m_eventBus = new EventBus(this);
-    m_eventStreamHandler = new EventStreamHandler(m_eventBus, m_config.corsOrigin, this);
+    m_eventStreamHandler = new EventStreamHandler(m_eventBus, m_config.corsOrigin,
+                                                  m_config.sseMaxConnections, this);
+    m_logStreamHandler = new LogStreamHandler(m_config.corsOrigin, this);
+    m_resourceSampler = new ResourceSampler(m_config.metricsIntervalMs,
+                                            m_config.metricsHistorySize, this);
+
+    // 实例日志逐行推送给日志流订阅者；写入器可能晚于 handler 析构，故经 QPointer 判空
+    m_instanceManager->setLogLineSink(
+        [handler = QPointer<LogStreamHandler>(m_logStreamHandler)](const QString& projectId,
+                                                                   const QString& line) {
+            if (handler) {
+                handler->publishLine(projectId, line);
+            }
+        });
 
     // Wire InstanceManager signals → EventBus
     connect(m_instanceManager, &InstanceManager::instanceStarted,
@@ -111,6 +145,7 @@ ServerManager::ServerManager(const QString& dataRoot,
                 if (auto* inst = m_instanceManager->getInstance(instanceId)) {
                     pid = inst->pid;
                 }
+                m_resourceSampler->track(instanceId, pid);
                 m_eventBus->publish(QStringLiteral("instance.started"), QJsonObject{
                     {"instanceId", instanceId},
                     {"projectId", projectId},
@@ -121,6 +156,7 @@ ServerManager::ServerManager(const QString& dataRoot,
     connect(m_instanceManager, &InstanceManager::instanceFinished,
             this, [this](const QString& instanceId, const QString& projectId,
                          int exitCode, QProcess::ExitStatus exitStatus) {
+                m_resourceSampler->untrack(instanceId);
                 m_eventBus->publish(QStringLiteral("instance.finished"), QJsonObject{
                     {"instanceId", instanceId},
                     {"projectId", projectId},
@@ -168,6 +204,7 @@ bool ServerManager::initialize(QString& error) {
 
     ServiceScanner::ScanStats svcStats;
     m_services = m_serviceScanner.scan(m_dataRoot + "/services", &svcStats);
+    ++m_servicesRevision;
     qInfo("Services: %d loaded, %d failed", svcStats.loadedServices, svcStats.failedServices);
 
     DriverManagerScanner::ScanStats driverStats;
@@ -178,17 +215,41 @@ bool ServerManager::initialize(QString& error) {
     } else {
         m_driverCatalog.clear();
     }
-    qInfo("Drivers: %d updated, %d failed, %d skipped",
+    qInfo("Drivers: %d updated, %d failed, %d skipped, %d exported, %d cached (%lld ms)",
           driverStats.updated,
           driverStats.newlyFailed,
-          driverStats.skippedFailed);
+          driverStats.skippedFailed,
+          driverStats.exported,
+          driverStats.cacheHits,
+          static_cast<long long>(driverStats.elapsedMs));
 
     ProjectManager::LoadStats projectStats;
     m_projects = m_projectManager.loadAll(m_dataRoot + "/projects", m_services, &projectStats);
+    ++m_projectsRevision;
     qInfo("Projects: %d loaded, %d invalid", projectStats.loaded, projectStats.invalid);
 
+    if (m_config.watchDataRoot) {
+        m_catalogWatcher = new CatalogWatcher(m_dataRoot, m_config.watchDebounceMs, this);
+        connect(m_catalogWatcher, &CatalogWatcher::servicesChanged,
+                this, &ServerManager::applyServiceChanges);
+        connect(m_catalogWatcher, &CatalogWatcher::projectsChanged,
+                this, &ServerManager::applyProjectChanges);
+        connect(m_catalogWatcher, &CatalogWatcher::driversChanged,
+                this, &ServerManager::applyDriverChanges);
+        if (m_catalogWatcher->start()) {
+            qInfo("Catalog watch: %d paths, debounce %d ms",
+                  m_catalogWatcher->watchedPathCount(), m_catalogWatcher->debounceMs());
+        } else {
+            qWarning("Catalog watch: failed to watch %s", qUtf8Printable(m_dataRoot));
+        }
+    }
+
     m_startedAt = QDateTime::currentDateTimeUtc();
 
+    if (ProcessMonitor::isSupported()) {
+        m_resourceSampler->start();
+    }
+
     // Initialize event log (after data root validated)
     const QString eventsPath = m_dataRoot + "/logs/events.jsonl";
     m_eventLog = new EventLog(eventsPath, m_eventBus, 5 * 1024 * 1024, 2, this);
@@ -258,6 +319,9 @@ void ServerManager::startScheduling() {
 }
 
 void ServerManager::shutdown() {
+    if (m_catalogWatcher) {
+        m_catalogWatcher->stop();
+    }
     m_scheduleEngine->setShuttingDown(true);
     m_scheduleEngine->stopAll();
     if (m_driverLabWsHandler) {
@@ -265,6 +329,7 @@ void ServerManager::shutdown() {
     }
     m_instanceManager->terminateAll();
     m_instanceManager->waitAllFinished(5000);
+    m_resourceSampler->stop();
 }
 
 void ServerManager::registerWebSocket(QHttpServer& server) {
@@ -280,6 +345,8 @@ DriverManagerScanner::ScanStats ServerManager::rescanDrivers(bool refreshMeta) {
         return stats;
     }
 
+    // 同步全量扫描同样作废尚未返回的增量扫描结果
+    ++m_latestDriverScanSeq;
     const auto drivers = m_driverScanner.scan(driversDir, refreshMeta, &stats);
     m_driverCatalog.replaceAll(drivers);
     return stats;
@@ -298,16 +365,24 @@ QFuture<DriverManagerScanner::ScanStats> ServerManager::rescanDriversAsync(bool
 
     DriverManagerScanner scanner = m_driverScanner;
 
+    ++m_driverFullScansInFlight;
     return QtConcurrent::run([scanner, driversDir, refreshMeta]() mutable {
         DriverManagerScanner::ScanStats stats;
         auto drivers = scanner.scan(driversDir, refreshMeta, &stats);
         return std::make_pair(drivers, stats);
     }).then(this, [this, scanSeq](std::pair<QHash<QString, stdiolink::DriverConfig>,
                                                  DriverManagerScanner::ScanStats> result) {
+        --m_driverFullScansInFlight;
         // 仅应用最新一次 scan 的结果，防止后发先至。
         if (scanSeq == m_latestDriverScanSeq) {
             m_driverCatalog.replaceAll(result.first);
         }
+        // 全量扫描期间推迟的目录可能在扫描读取之后才变化，补扫一次
+        if (m_driverFullScansInFlight == 0 && !m_driverDirsDeferred.isEmpty()) {
+            const QStringList deferred = m_driverDirsDeferred.values();
+            m_driverDirsDeferred.clear();
+            applyDriverChanges(deferred);
+        }
         return result.second;
     });
 }
@@ -319,6 +394,7 @@ ServerManager::ServiceRescanStats ServerManager::rescanServices(bool revalidateP
     const QMap<QString, ServiceInfo> oldServices = m_services;
 
     m_services = m_serviceScanner.scan(m_dataRoot + "/services", &stats.scanStats);
+    ++m_servicesRevision;
 
     for (auto it = m_services.begin(); it != m_services.end(); ++it) {
         const QString& id = it.key();
@@ -329,12 +405,7 @@ ServerManager::ServiceRescanStats ServerManager::rescanServices(bool revalidateP
             continue;
         }
 
-        const ServiceInfo& prev = oldIt.value();
-        const bool changed = prev.name != cur.name
-                             || prev.version != cur.version
-                             || prev.serviceDir != cur.serviceDir
-                             || prev.rawConfigSchema != cur.rawConfigSchema;
-        if (changed) {
+        if (serviceChanged(oldIt.value(), cur)) {
             stats.updated++;
         } else {
             stats.unchanged++;
@@ -348,6 +419,7 @@ ServerManager::ServiceRescanStats ServerManager::rescanServices(bool revalidateP
     }
 
     if (revalidateProjects) {
+        ++m_projectsRevision;
         for (auto it = m_projects.begin(); it != m_projects.end(); ++it) {
             Project& project = it.value();
             const bool wasValid = project.valid;
@@ -472,6 +544,7 @@ ServerManager::ServiceCreateResult ServerManager::createService(const ServiceCre
     }
 
     m_services.insert(loaded->id, *loaded);
+    ++m_servicesRevision;
     result.success = true;
     result.serviceInfo = *loaded;
     return result;
@@ -498,6 +571,7 @@ bool ServerManager::deleteService(const QString& id, bool force, QString& error)
 
     // Force: mark associated projects as invalid
     if (force) {
+        ++m_projectsRevision;
         for (const QString& projectId : associatedProjectIds) {
             auto pIt = m_projects.find(projectId);
             if (pIt != m_projects.end()) {
@@ -516,6 +590,7 @@ bool ServerManager::deleteService(const QString& id, bool force, QString& error)
     }
 
     m_services.remove(id);
+    ++m_servicesRevision;
     error.clear();
     return true;
 }
@@ -536,8 +611,248 @@ bool ServerManager::reloadService(const QString& id, QString& error) {
     }
 
     m_services[id] = *loaded;
+    ++m_servicesRevision;
     error.clear();
     return true;
 }
 
+void ServerManager::applyServiceChanges(const QStringList& dirNames) {
+    const QDir servicesDir(m_dataRoot + "/services");
+    QSet<QString> touched;
+    QHash<QString, QString> previousDirs;
+
+    for (const QString& dirName : dirNames) {
+        const QString dirPath = normalizedPath(servicesDir.absoluteFilePath(dirName));
+
+        // 服务 id 取自 manifest，与目录名不一定相同，按目录反查原有条目
+        QString oldId;
+        for (auto it = m_services.cbegin(); it != m_services.cend(); ++it) {
+            if (normalizedPath(it->serviceDir) == dirPath) {
+                oldId = it.key();
+                break;
+            }
+        }
+
+        std::optional<ServiceInfo> loaded;
+        if (QFileInfo(dirPath).isDir()) {
+            QString loadError;
+            loaded = m_serviceScanner.loadSingle(servicesDir.absoluteFilePath(dirName), loadError);
+            if (!loaded.has_value()) {
+                qWarning("ServiceScanner: skip %s: %s",
+                         qUtf8Printable(dirName),
+                         qUtf8Printable(loadError));
+            } else if (loaded->id != oldId && m_services.contains(loaded->id)) {
+                qWarning("ServiceScanner: duplicate service id '%s' at %s",
+                         qUtf8Printable(loaded->id),
+                         qUtf8Printable(loaded->serviceDir));
+                loaded.reset();
+            }
+        }
+
+        if (!oldId.isEmpty() && (!loaded.has_value() || loaded->id != oldId)) {
+            previousDirs.insert(oldId, m_services.value(oldId).serviceDir);
+            m_services.remove(oldId);
+            touched.insert(oldId);
+            m_eventBus->publish(QStringLiteral("service.removed"),
+                                QJsonObject{{"serviceId", oldId}});
+        }
+        if (!loaded.has_value()) {
+            continue;
+        }
+
+        const QString id = loaded->id;
+        auto it = m_services.find(id);
+        if (it == m_services.end()) {
+            m_services.insert(id, *loaded);
+            touched.insert(id);
+            m_eventBus->publish(QStringLiteral("service.added"),
+                                QJsonObject{{"serviceId", id}});
+        } else if (serviceChanged(it.value(), *loaded)) {
+            previousDirs.insert(id, it->serviceDir);
+            it.value() = *loaded;
+            touched.insert(id);
+            m_eventBus->publish(QStringLiteral("service.updated"),
+                                QJsonObject{{"serviceId", id}});
+        }
+    }
+
+    if (!touched.isEmpty()) {
+        ++m_servicesRevision;
+        revalidateProjectsForServices(touched, previousDirs);
+    }
+}
+
+void ServerManager::revalidateProjectsForServices(const QSet<QString>& serviceIds,
+                                                  const QHash<QString, QString>& previousDirs) {
+    const QString projectsDir = m_dataRoot + "/projects";
+    for (auto it = m_projects.begin(); it != m_projects.end(); ++it) {
+        Project& project = it.value();
+        if (!serviceIds.contains(project.serviceId)
+            || (m_projectBusyCheck && m_projectBusyCheck(project.id))) {
+            continue;
+        }
+
+        // 从磁盘重新加载，避免在已合并过旧 schema 默认值的配置上再次合并
+        Project reloaded;
+        QString loadError;
+        if (ProjectManager::loadProject(projectsDir, project.id, reloaded, loadError)) {
+            (void)ProjectManager::validateProject(reloaded, m_services);
+        }
+        if (!projectChanged(project, reloaded)) {
+            continue;
+        }
+
+        // 有效性、调度定义或服务目录变化时重建调度；仅参数默认值变化时由下一次启动生效
+        const QString serviceDir = m_services.value(project.serviceId).serviceDir;
+        const bool rescheduled = project.valid != reloaded.valid
+                                 || project.toJson() != reloaded.toJson()
+                                 || (previousDirs.contains(project.serviceId)
+                                     && previousDirs.value(project.serviceId) != serviceDir);
+        project = reloaded;
+        ++m_projectsRevision;
+        if (rescheduled) {
+            m_scheduleEngine->startProject(project, m_services);
+        }
+        m_eventBus->publish(QStringLiteral("project.updated"), QJsonObject{
+            {"projectId", project.id},
+            {"valid", project.valid}
+        });
+    }
+}
+
+void ServerManager::applyProjectChanges(const QStringList& ids) {
+    const QString projectsDir = m_dataRoot + "/projects";
+    for (const QString& id : ids) {
+        if (!ProjectManager::isValidProjectId(id)) {
+            continue;
+        }
+        // HTTP 接口正在保存/删除该项目：等其完成后再按磁盘最终状态处理
+        if (m_projectBusyCheck && m_projectBusyCheck(id)) {
+            if (m_catalogWatcher) {
+                m_catalogWatcher->markDirty(CatalogWatcher::Category::Projects, id);
+            }
+            continue;
+        }
+
+        if (!QFileInfo(QDir(projectsDir).absoluteFilePath(id)).isDir()) {
+            if (m_projects.remove(id) > 0) {
+                ++m_projectsRevision;
+                m_scheduleEngine->stopProject(id);
+                m_instanceManager->terminateByProject(id);
+                m_eventBus->publish(QStringLiteral("project.removed"),
+                                    QJsonObject{{"projectId", id}});
+            }
+            continue;
+        }
+
+        Project project;
+        QString loadError;
+        if (ProjectManager::loadProject(projectsDir, id, project, loadError)) {
+            (void)ProjectManager::validateProject(project, m_services);
+        } else {
+            qWarning("ProjectManager: %s invalid: %s",
+                     qUtf8Printable(id),
+                     qUtf8Printable(loadError));
+        }
+
+        auto it = m_projects.find(id);
+        const bool added = it == m_projects.end();
+        if (!added && !projectChanged(it.value(), project)) {
+            continue;
+        }
+
+        m_projects.insert(id, project);
+        ++m_projectsRevision;
+        // 运行中的 daemon 实例不被打断，新配置在下一次启动时生效
+        m_scheduleEngine->startProject(project, m_services);
+        m_eventBus->publish(added ? QStringLiteral("project.added")
+                                  : QStringLiteral("project.updated"),
+                            QJsonObject{{"projectId", id}, {"valid", project.valid}});
+    }
+}
+
+void ServerManager::applyDriverChanges(const QStringList& dirNames) {
+    const QDir driversDir(m_dataRoot + "/drivers");
+    for (const QString& dirName : dirNames) {
+        // 全量扫描完成时会整体替换目录，期间的增量扫描推迟到其完成后再做，避免互相覆盖
+        if (m_driverFullScansInFlight > 0) {
+            m_driverDirsDeferred.insert(dirName);
+            continue;
+        }
+        // 同一目录同时只跑一个导出；期间再次变更则在完成后补扫一次
+        if (m_driverDirsInFlight.contains(dirName)) {
+            m_driverDirsDirty.insert(dirName);
+            continue;
+        }
+        m_driverDirsInFlight.insert(dirName);
+
+        const QString dirPath = normalizedPath(driversDir.absoluteFilePath(dirName));
+        const DriverManagerScanner scanner = m_driverScanner;
+        const quint64 scanSeq = m_latestDriverScanSeq;
+        QtConcurrent::run([scanner, dirPath]() {
+            DriverManagerScanner::ScanStats stats;
+            std::optional<stdiolink::DriverConfig> config = scanner.scanOne(dirPath, true, &stats);
+            return std::make_pair(config, stats.pending > 0);
+        }).then(this, [this, dirName, dirPath, scanSeq](
+                          std::pair<std::optional<stdiolink::DriverConfig>, bool> result) {
+            const auto& [config, pending] = result;
+            m_driverDirsInFlight.remove(dirName);
+            // 期间开始过全量扫描：它读取目录晚于本次，结果不比本次旧，丢弃本次结果；
+            // 全量扫描仍在进行时交给其完成后的补扫
+            if (scanSeq != m_latestDriverScanSeq) {
+                const bool dirty = m_driverDirsDirty.remove(dirName);
+                if (m_driverFullScansInFlight > 0) {
+                    m_driverDirsDeferred.insert(dirName);
+                } else if (dirty) {
+                    applyDriverChanges({dirName});
+                }
+                return;
+            }
+            applyDriverResult(dirPath, config);
+            // 目录可能仍在拷贝中：经监视器静默 debounceMs 后重试；超过次数后等下一次文件变更，
+            // 一直导出失败的目录由全量扫描标记 .failed
+            if (!pending) {
+                m_driverPendingRetries.remove(dirName);
+            } else if (m_catalogWatcher
+                       && m_driverPendingRetries[dirName]++ < kMaxDriverPendingRetries) {
+                m_catalogWatcher->markDirty(CatalogWatcher::Category::Drivers, dirName);
+            }
+            if (m_driverDirsDirty.remove(dirName)) {
+                applyDriverChanges({dirName});
+            }
+        });
+    }
+}
+
+void ServerManager::applyDriverResult(const QString& dirPath,
+                                      const std::optional<stdiolink::DriverConfig>& config) {
+    // 驱动 id 取自 meta，按可执行文件所在目录反查该目录原先提供的驱动
+    const QStringList ids = m_driverCatalog.listDrivers();
+    for (const QString& id : ids) {
+        if (config.has_value() && config->id == id) {
+            continue;
+        }
+        const QString program = m_driverCatalog.getConfig(id).program;
+        if (!program.isEmpty() && normalizedPath(QFileInfo(program).absolutePath()) == dirPath) {
+            m_driverCatalog.remove(id);
+            m_eventBus->publish(QStringLiteral("driver.removed"), QJsonObject{{"driverId", id}});
+        }
+    }
+    if (!config.has_value()) {
+        return;
+    }
+
+    const bool existed = m_driverCatalog.hasDriver(config->id);
+    if (existed) {
+        const stdiolink::DriverConfig prev = m_driverCatalog.getConfig(config->id);
+        if (prev.metaHash == config->metaHash && prev.program == config->program) {
+            return;
+        }
+    }
+    m_driverCatalog.upsert(*config);
+    m_eventBus->publish(existed ? QStringLiteral("driver.updated")
+                                : QStringLiteral("driver.added"),
+                        QJsonObject{{"driverId", config->id}});
+}
+
 } // namespace stdiolink_server
@@ -2,20 +2,27 @@
 
 #include <QDateTime>
 #include <QFuture>
+#include <QHash>
 #include <QMap>
 #include <QObject>
 #include <QString>
+#include <QSet>
 #include <QStringList>
+#include <functional>
 #include <memory>
+#include <optional>
 
 #include "config/server_config.h"
 #include "http/event_bus.h"
 #include "http/event_stream_handler.h"
+#include "http/log_stream_handler.h"
 #include "http/static_file_server.h"
 #include "manager/instance_manager.h"
 #include "manager/process_monitor.h"
+#include "manager/resource_sampler.h"
 #include "manager/project_manager.h"
 #include "manager/schedule_engine.h"
+#include "scanner/catalog_watcher.h"
 #include "scanner/driver_manager_scanner.h"
 #include "scanner/service_scanner.h"
 #include "stdiolink/host/driver_catalog.h"
@@ -79,6 +86,13 @@ public:
     QMap<QString, Project>& projects() { return m_projects; }
     const QMap<QString, Project>& projects() const { return m_projects; }
 
+    /// 服务 / 项目集合的修订号，每次修改后递增，供 HTTP 响应缓存判断是否过期。
+    /// 绕过本类接口直接修改集合的调用方须随后调用对应的 mark*Changed()
+    quint64 servicesRevision() const { return m_servicesRevision; }
+    quint64 projectsRevision() const { return m_projectsRevision; }
+    void markServicesChanged() { ++m_servicesRevision; }
+    void markProjectsChanged() { ++m_projectsRevision; }
+
     InstanceManager* instanceManager() { return m_instanceManager; }
     ScheduleEngine* scheduleEngine() { return m_scheduleEngine; }
     ProjectManager* projectManager() { return &m_projectManager; }
@@ -93,9 +107,25 @@ public:
                                       bool restartScheduling = true,
                                       bool stopInvalidProjects = false);
 
+    /// 文件监视触发的增量更新：只重新加载给定的条目（data_root 下的子目录名），
+    /// 并按结果发布 service./project./driver. added / updated / removed 事件
+    void applyServiceChanges(const QStringList& dirNames);
+    void applyProjectChanges(const QStringList& ids);
+    /// 驱动目录需导出 meta，在工作线程执行；rescanDriversAsync() 进行中时推迟到其完成后。
+    /// 尚无可执行文件或导出失败的新目录视为仍在安装，不标记 .failed，静默后有限次重试
+    void applyDriverChanges(const QStringList& dirNames);
+
+    /// 项目正被 HTTP 接口修改时返回 true；此期间该项目的文件变更延后处理
+    void setProjectBusyCheck(std::function<bool(const QString&)> check) {
+        m_projectBusyCheck = std::move(check);
+    }
+
+    CatalogWatcher* catalogWatcher() { return m_catalogWatcher; }
     ProcessMonitor* processMonitor() { return &m_processMonitor; }
+    ResourceSampler* resourceSampler() { return m_resourceSampler; }
     EventBus* eventBus() { return m_eventBus; }
     EventStreamHandler* eventStreamHandler() { return m_eventStreamHandler; }
+    LogStreamHandler* logStreamHandler() { return m_logStreamHandler; }
     EventLog* eventLog() { return m_eventLog; }
     StaticFileServer* staticFileServer() { return m_staticFileServer.get(); }
 
@@ -128,6 +158,13 @@ public:
     const ServerConfig& config() const { return m_config; }
 
 private:
+    static constexpr int kMaxDriverPendingRetries = 3;
+
+    void revalidateProjectsForServices(const QSet<QString>& serviceIds,
+                                       const QHash<QString, QString>& previousDirs);
+    void applyDriverResult(const QString& dirPath,
+                           const std::optional<stdiolink::DriverConfig>& config);
+
     QString m_dataRoot;
     ServerConfig m_config;
 
@@ -140,15 +177,26 @@ private:
 
     QMap<QString, ServiceInfo> m_services;
     QMap<QString, Project> m_projects;
+    quint64 m_servicesRevision = 0;
+    quint64 m_projectsRevision = 0;
     stdiolink::DriverCatalog m_driverCatalog;
     ProcessMonitor m_processMonitor;
+    ResourceSampler* m_resourceSampler = nullptr;
     EventBus* m_eventBus = nullptr;
     EventStreamHandler* m_eventStreamHandler = nullptr;
+    LogStreamHandler* m_logStreamHandler = nullptr;
     EventLog* m_eventLog = nullptr;
     QDateTime m_startedAt;
     DriverLabWsHandler* m_driverLabWsHandler = nullptr;
     std::unique_ptr<StaticFileServer> m_staticFileServer;
     quint64 m_latestDriverScanSeq = 0;
+    CatalogWatcher* m_catalogWatcher = nullptr;
+    std::function<bool(const QString&)> m_projectBusyCheck;
+    QSet<QString> m_driverDirsInFlight;
+    QSet<QString> m_driverDirsDirty;
+    QSet<QString> m_driverDirsDeferred;   // 全量扫描期间推迟的增量扫描
+    QHash<QString, int> m_driverPendingRetries;  // 尚未就绪的驱动目录 -> 已重试次数
+    int m_driverFullScansInFlight = 0;
 };
 
 } // namespace stdiolink_server
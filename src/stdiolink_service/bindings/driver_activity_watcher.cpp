@@ -0,0 +1,46 @@
+#include "driver_activity_watcher.h"
+
+#include <QProcess>
+
+#include "stdiolink/host/driver.h"
+
+DriverActivityWatcher::DriverActivityWatcher(std::function<void()> onActivity)
+    : m_onActivity(std::move(onActivity)) {}
+
+DriverActivityWatcher::~DriverActivityWatcher() {
+    sync({});
+}
+
+void DriverActivityWatcher::sync(const QSet<stdiolink::Driver*>& drivers) {
+    for (auto it = m_connections.begin(); it != m_connections.end();) {
+        // 进程对象销毁后连接自动失效；同地址上新建的 Driver 需要重新连接
+        if (drivers.contains(it.key()) && static_cast<bool>(it->output)) {
+            ++it;
+            continue;
+        }
+        QObject::disconnect(it->output);
+        QObject::disconnect(it->finished);
+        it = m_connections.erase(it);
+    }
+
+    for (stdiolink::Driver* driver : drivers) {
+        if (driver == nullptr || m_connections.contains(driver)) {
+            continue;
+        }
+        QProcess* proc = driver->process();
+        Connections conns;
+        conns.output = QObject::connect(proc, &QProcess::readyReadStandardOutput, &m_context,
+                                        [this, driver]() { onDriverActivity(driver); });
+        conns.finished = QObject::connect(
+            proc, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), &m_context,
+            [this, driver]() { onDriverActivity(driver); });
+        m_connections.insert(driver, conns);
+    }
+}
+
+void DriverActivityWatcher::onDriverActivity(stdiolink::Driver* driver) {
+    driver->pumpStdout();
+    if (m_onActivity) {
+        m_onActivity();
+    }
+}
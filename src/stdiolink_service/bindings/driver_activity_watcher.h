@@ -0,0 +1,44 @@
+/// @file driver_activity_watcher.h
+/// @brief 监听 Driver 进程 stdout 可读与退出信号，驱动异步调度器即时兑现 Promise
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <functional>
+
+namespace stdiolink {
+class Driver;
+}
+
+/// @brief Driver 活动监听器
+///
+/// 调度器把当前 pending Task 涉及的 Driver 集合交给 sync()，监听器只为这些 Driver
+/// 维持 readyReadStandardOutput / finished 连接；信号到达时先 pumpStdout()，
+/// 再回调调度器检查并兑现 Promise，不再依赖固定间隔轮询。
+class DriverActivityWatcher {
+public:
+    /// @brief 构造函数
+    /// @param onActivity 任一被监听 Driver 有新输出或退出时调用
+    explicit DriverActivityWatcher(std::function<void()> onActivity);
+    ~DriverActivityWatcher();
+
+    DriverActivityWatcher(const DriverActivityWatcher&) = delete;
+    DriverActivityWatcher& operator=(const DriverActivityWatcher&) = delete;
+
+    /// @brief 使监听集合与 drivers 一致：新增的建立连接，不再需要的断开
+    void sync(const QSet<stdiolink::Driver*>& drivers);
+
+private:
+    struct Connections {
+        QMetaObject::Connection output;
+        QMetaObject::Connection finished;
+    };
+
+    void onDriverActivity(stdiolink::Driver* driver);
+
+    std::function<void()> m_onActivity;
+    QObject m_context;                                     ///< 连接的接收方，析构时自动断开
+    QHash<stdiolink::Driver*, Connections> m_connections;
+};
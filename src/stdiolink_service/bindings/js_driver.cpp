@@ -5,12 +5,14 @@
 
 #include "js_task.h"
 #include "stdiolink/host/driver.h"
+#include "stdiolink/host/driver_pool.h"
 #include "utils/js_convert.h"
 
 namespace {
 
 struct JsDriverOpaque {
     std::unique_ptr<stdiolink::Driver> driver;
+    stdiolink::DriverPool* pool = nullptr;  // 非空表示从热进程池租出，回收时归还而非终止
 };
 
 QHash<quintptr, JSClassID> s_driverClassIds;
@@ -27,6 +29,8 @@ JSValue jsDriverQueryMeta(JSContext* ctx, JSValueConst thisVal, int argc, JSValu
 JSValue jsDriverTerminate(JSContext* ctx, JSValueConst thisVal, int argc, JSValueConst* argv);
 JSValue jsDriverGetRunning(JSContext* ctx, JSValueConst thisVal);
 JSValue jsDriverGetHasMeta(JSContext* ctx, JSValueConst thisVal);
+JSValue jsDriverGetPipelining(JSContext* ctx, JSValueConst thisVal);
+JSValue jsDriverSetPipelining(JSContext* ctx, JSValueConst thisVal, JSValueConst val);
 
 const JSCFunctionListEntry kDriverProtoFuncs[] = {
     JS_CFUNC_DEF("start", 2, jsDriverStart),
@@ -35,6 +39,7 @@ const JSCFunctionListEntry kDriverProtoFuncs[] = {
     JS_CFUNC_DEF("terminate", 0, jsDriverTerminate),
     JS_CGETSET_DEF("running", jsDriverGetRunning, nullptr),
     JS_CGETSET_DEF("hasMeta", jsDriverGetHasMeta, nullptr),
+    JS_CGETSET_DEF("pipelining", jsDriverGetPipelining, jsDriverSetPipelining),
 };
 
 JSClassID ensureDriverClass(JSContext* ctx) {
@@ -73,6 +78,18 @@ JsDriverOpaque* getDriverOpaque(JSContext* ctx, JSValueConst thisVal) {
     return static_cast<JsDriverOpaque*>(JS_GetOpaque2(ctx, thisVal, classId));
 }
 
+JsDriverOpaque* requireDriverOpaque(JSContext* ctx, JSValueConst thisVal) {
+    JsDriverOpaque* opaque = getDriverOpaque(ctx, thisVal);
+    if (!opaque) {
+        return nullptr;
+    }
+    if (!opaque->driver) {
+        JS_ThrowInternalError(ctx, "Driver has been released to the pool");
+        return nullptr;
+    }
+    return opaque;
+}
+
 void jsDriverFinalizer(JSRuntime* rt, JSValueConst val) {
     const JSClassID classId = classIdForRuntime(rt);
     if (classId == 0) {
@@ -82,7 +99,9 @@ void jsDriverFinalizer(JSRuntime* rt, JSValueConst val) {
     if (!opaque) {
         return;
     }
-    if (opaque->driver) {
+    if (opaque->driver && opaque->pool) {
+        opaque->pool->release(std::move(opaque->driver));
+    } else if (opaque->driver) {
         opaque->driver->terminate();
     }
     delete opaque;
@@ -106,8 +125,8 @@ JSValue jsDriverCtor(JSContext* ctx, JSValueConst, int, JSValueConst*) {
 }
 
 JSValue jsDriverStart(JSContext* ctx, JSValueConst thisVal, int argc, JSValueConst* argv) {
-    JsDriverOpaque* opaque = getDriverOpaque(ctx, thisVal);
-    if (!opaque || !opaque->driver) {
+    JsDriverOpaque* opaque = requireDriverOpaque(ctx, thisVal);
+    if (!opaque) {
         return JS_EXCEPTION;
     }
     if (argc < 1 || !JS_IsString(argv[0])) {
@@ -144,8 +163,8 @@ JSValue jsDriverStart(JSContext* ctx, JSValueConst thisVal, int argc, JSValueCon
 }
 
 JSValue jsDriverRequest(JSContext* ctx, JSValueConst thisVal, int argc, JSValueConst* argv) {
-    JsDriverOpaque* opaque = getDriverOpaque(ctx, thisVal);
-    if (!opaque || !opaque->driver) {
+    JsDriverOpaque* opaque = requireDriverOpaque(ctx, thisVal);
+    if (!opaque) {
         return JS_EXCEPTION;
     }
     if (argc < 1 || !JS_IsString(argv[0])) {
@@ -169,8 +188,8 @@ JSValue jsDriverRequest(JSContext* ctx, JSValueConst thisVal, int argc, JSValueC
 }
 
 JSValue jsDriverQueryMeta(JSContext* ctx, JSValueConst thisVal, int argc, JSValueConst* argv) {
-    JsDriverOpaque* opaque = getDriverOpaque(ctx, thisVal);
-    if (!opaque || !opaque->driver) {
+    JsDriverOpaque* opaque = requireDriverOpaque(ctx, thisVal);
+    if (!opaque) {
         return JS_EXCEPTION;
     }
 
@@ -187,8 +206,8 @@ JSValue jsDriverQueryMeta(JSContext* ctx, JSValueConst thisVal, int argc, JSValu
 }
 
 JSValue jsDriverTerminate(JSContext* ctx, JSValueConst thisVal, int, JSValueConst*) {
-    JsDriverOpaque* opaque = getDriverOpaque(ctx, thisVal);
-    if (!opaque || !opaque->driver) {
+    JsDriverOpaque* opaque = requireDriverOpaque(ctx, thisVal);
+    if (!opaque) {
         return JS_EXCEPTION;
     }
     opaque->driver->terminate();
@@ -196,21 +215,42 @@ JSValue jsDriverTerminate(JSContext* ctx, JSValueConst thisVal, int, JSValueCons
 }
 
 JSValue jsDriverGetRunning(JSContext* ctx, JSValueConst thisVal) {
-    JsDriverOpaque* opaque = getDriverOpaque(ctx, thisVal);
-    if (!opaque || !opaque->driver) {
+    JsDriverOpaque* opaque = requireDriverOpaque(ctx, thisVal);
+    if (!opaque) {
         return JS_EXCEPTION;
     }
     return JS_NewBool(ctx, opaque->driver->isRunning() ? 1 : 0);
 }
 
 JSValue jsDriverGetHasMeta(JSContext* ctx, JSValueConst thisVal) {
-    JsDriverOpaque* opaque = getDriverOpaque(ctx, thisVal);
-    if (!opaque || !opaque->driver) {
+    JsDriverOpaque* opaque = requireDriverOpaque(ctx, thisVal);
+    if (!opaque) {
         return JS_EXCEPTION;
     }
     return JS_NewBool(ctx, opaque->driver->hasMeta() ? 1 : 0);
 }
 
+JSValue jsDriverGetPipelining(JSContext* ctx, JSValueConst thisVal) {
+    JsDriverOpaque* opaque = requireDriverOpaque(ctx, thisVal);
+    if (!opaque) {
+        return JS_EXCEPTION;
+    }
+    return JS_NewBool(ctx, opaque->driver->isPipeliningEnabled() ? 1 : 0);
+}
+
+JSValue jsDriverSetPipelining(JSContext* ctx, JSValueConst thisVal, JSValueConst val) {
+    JsDriverOpaque* opaque = requireDriverOpaque(ctx, thisVal);
+    if (!opaque) {
+        return JS_EXCEPTION;
+    }
+    const int enabled = JS_ToBool(ctx, val);
+    if (enabled < 0) {
+        return JS_EXCEPTION;
+    }
+    opaque->driver->setPipeliningEnabled(enabled != 0);
+    return JS_UNDEFINED;
+}
+
 } // namespace
 
 void JsDriverBinding::registerClass(JSContext* ctx) {
@@ -233,6 +273,39 @@ JSValue JsDriverBinding::getConstructor(JSContext* ctx) {
     return ctor;
 }
 
+JSValue JsDriverBinding::createLeased(JSContext* ctx, std::unique_ptr<stdiolink::Driver> driver,
+                                      stdiolink::DriverPool* pool) {
+    const JSClassID classId = ensureDriverClass(ctx);
+    if (classId == 0) {
+        pool->release(std::move(driver));
+        return JS_ThrowInternalError(ctx, "failed to register Driver class");
+    }
+
+    JSValue obj = JS_NewObjectClass(ctx, classId);
+    if (JS_IsException(obj)) {
+        pool->release(std::move(driver));
+        return obj;
+    }
+
+    auto* opaque = new JsDriverOpaque();
+    opaque->driver = std::move(driver);
+    opaque->pool = pool;
+    JS_SetOpaque(obj, opaque);
+    return obj;
+}
+
+bool JsDriverBinding::releaseLease(JSContext* ctx, JSValueConst driverObj, bool discard) {
+    JsDriverOpaque* opaque = getDriverOpaque(ctx, driverObj);
+    if (!opaque || !opaque->pool || !opaque->driver) {
+        return false;
+    }
+    if (discard) {
+        opaque->driver->terminate();
+    }
+    opaque->pool->release(std::move(opaque->driver));
+    return true;
+}
+
 void JsDriverBinding::detachRuntime(JSRuntime* rt) {
     if (!rt) {
         return;
@@ -3,8 +3,14 @@
 
 #pragma once
 
+#include <memory>
 #include <quickjs.h>
 
+namespace stdiolink {
+class Driver;
+class DriverPool;
+} // namespace stdiolink
+
 /// @brief Driver 的 JS 绑定类
 ///
 /// 将 C++ 端的 stdiolink::Driver 注册为 JS 可构造的类，
@@ -20,6 +26,18 @@ public:
     /// @return Driver 构造函数的 JSValue
     static JSValue getConstructor(JSContext* ctx);
 
+    /// @brief 用热进程池租出的 Driver 创建 JS Driver 对象
+    /// @param driver 租出的 Driver（所有权转移）
+    /// @param pool 所属进程池，需比 JSRuntime 存活更久
+    /// @return Driver 对象；被 GC 回收且未归还时自动归还到池中
+    static JSValue createLeased(JSContext* ctx, std::unique_ptr<stdiolink::Driver> driver,
+                                stdiolink::DriverPool* pool);
+
+    /// @brief 归还 createLeased() 创建的 Driver 对象，之后该对象的方法调用会抛错
+    /// @param discard 为 true 时先终止进程，不再放回池中复用
+    /// @return 对象不是租出的 Driver 或已归还时返回 false
+    static bool releaseLease(JSContext* ctx, JSValueConst driverObj, bool discard);
+
     /// @brief 分离运行时，清理类 ID 关联的资源
     /// @param rt QuickJS 运行时
     /// @note 应在 JSRuntime 销毁前调用
@@ -0,0 +1,236 @@
+#include "js_driver_pool.h"
+
+#include <QHash>
+#include <QStringList>
+#include <cmath>
+#include <limits>
+
+#include "js_driver.h"
+#include "proxy/driver_proxy.h"
+#include "stdiolink/host/driver.h"
+#include "stdiolink/host/driver_pool.h"
+
+namespace stdiolink_service {
+
+namespace {
+
+QHash<quintptr, stdiolink::DriverPool*> s_pools;
+
+quintptr runtimeKey(JSContext* ctx) {
+    return reinterpret_cast<quintptr>(JS_GetRuntime(ctx));
+}
+
+stdiolink::DriverPool* requirePool(JSContext* ctx) {
+    stdiolink::DriverPool* pool = s_pools.value(runtimeKey(ctx), nullptr);
+    if (!pool) {
+        JS_ThrowInternalError(ctx, "driver pool is not installed");
+    }
+    return pool;
+}
+
+bool toProgram(JSContext* ctx, JSValueConst val, const char* fnName, QString& out) {
+    const char* s = JS_IsString(val) ? JS_ToCString(ctx, val) : nullptr;
+    if (s) {
+        out = QString::fromUtf8(s);
+        JS_FreeCString(ctx, s);
+    }
+    if (out.isEmpty()) {
+        JS_ThrowTypeError(ctx, "%s: program must be a non-empty string", fnName);
+        return false;
+    }
+    return true;
+}
+
+/// 与 openDriver 一致：池中实例必须常驻，强制 --profile=keepalive
+bool toStartArgs(JSContext* ctx, JSValueConst val, const char* fnName, QStringList& out) {
+    if (!JS_IsUndefined(val) && !JS_IsNull(val)) {
+        if (!JS_IsArray(val)) {
+            JS_ThrowTypeError(ctx, "%s: args must be an array", fnName);
+            return false;
+        }
+        JSValue lenVal = JS_GetPropertyStr(ctx, val, "length");
+        uint32_t len = 0;
+        JS_ToUint32(ctx, &len, lenVal);
+        JS_FreeValue(ctx, lenVal);
+        for (uint32_t i = 0; i < len; ++i) {
+            JSValue item = JS_GetPropertyUint32(ctx, val, i);
+            const char* s = JS_IsString(item) ? JS_ToCString(ctx, item) : nullptr;
+            JS_FreeValue(ctx, item);
+            if (!s) {
+                JS_ThrowTypeError(ctx, "%s: args item must be string", fnName);
+                return false;
+            }
+            const QString arg = QString::fromUtf8(s);
+            JS_FreeCString(ctx, s);
+            if (!arg.startsWith("--profile=")) {
+                out.push_back(arg);
+            }
+        }
+    }
+    out.push_back("--profile=keepalive");
+    return true;
+}
+
+bool readIntOption(JSContext* ctx, JSValueConst options, const char* key, int minValue,
+                   int& out) {
+    JSValue val = JS_GetPropertyStr(ctx, options, key);
+    if (JS_IsUndefined(val)) {
+        return true;
+    }
+    double d = 0;
+    const bool isNumber = JS_IsNumber(val) && JS_ToFloat64(ctx, &d, val) == 0;
+    JS_FreeValue(ctx, val);
+    if (!isNumber || std::trunc(d) != d || d < minValue
+        || d > std::numeric_limits<int>::max()) {
+        JS_ThrowRangeError(ctx, "configureDriverPool: %s must be an integer >= %d", key,
+                           minValue);
+        return false;
+    }
+    out = static_cast<int>(d);
+    return true;
+}
+
+bool toPoolOptions(JSContext* ctx, JSValueConst val, stdiolink::DriverPool::Options& out) {
+    if (JS_IsUndefined(val) || JS_IsNull(val)) {
+        return true;
+    }
+    if (!JS_IsObject(val) || JS_IsArray(val)) {
+        JS_ThrowTypeError(ctx, "configureDriverPool: options must be an object");
+        return false;
+    }
+
+    static const char* const kKeys[] = {"minWarm", "maxWarm", "idleTimeoutMs",
+                                        "healthCheckAfterIdleMs", "healthCheckTimeoutMs"};
+    JSPropertyEnum* props = nullptr;
+    uint32_t count = 0;
+    if (JS_GetOwnPropertyNames(ctx, &props, &count, val, JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY)
+        < 0) {
+        return false;
+    }
+    bool ok = true;
+    for (uint32_t i = 0; i < count && ok; ++i) {
+        const char* name = JS_AtomToCString(ctx, props[i].atom);
+        bool known = false;
+        for (const char* key : kKeys) {
+            known = known || (name && qstrcmp(name, key) == 0);
+        }
+        if (!known) {
+            JS_ThrowTypeError(ctx, "configureDriverPool: unknown option: %s", name ? name : "");
+            ok = false;
+        }
+        JS_FreeCString(ctx, name);
+    }
+    JS_FreePropertyEnum(ctx, props, count);
+    if (!ok) {
+        return false;
+    }
+
+    return readIntOption(ctx, val, "minWarm", 0, out.minWarm)
+           && readIntOption(ctx, val, "maxWarm", 0, out.maxWarm)
+           && readIntOption(ctx, val, "idleTimeoutMs", 0, out.idleTimeoutMs)
+           && readIntOption(ctx, val, "healthCheckAfterIdleMs", 0, out.healthCheckAfterIdleMs)
+           && readIntOption(ctx, val, "healthCheckTimeoutMs", 1, out.healthCheckTimeoutMs);
+}
+
+JSValue jsPoolAcquire(JSContext* ctx, JSValueConst, int argc, JSValueConst* argv) {
+    stdiolink::DriverPool* pool = requirePool(ctx);
+    QString program;
+    QStringList args;
+    if (!pool || !toProgram(ctx, argc > 0 ? argv[0] : JS_UNDEFINED, "acquireDriver", program)
+        || !toStartArgs(ctx, argc > 1 ? argv[1] : JS_UNDEFINED, "acquireDriver", args)) {
+        return JS_EXCEPTION;
+    }
+
+    QString error;
+    std::unique_ptr<stdiolink::Driver> driver = pool->acquire(program, args, &error);
+    if (!driver) {
+        return JS_ThrowInternalError(ctx, "%s", error.toUtf8().constData());
+    }
+    return JsDriverBinding::createLeased(ctx, std::move(driver), pool);
+}
+
+JSValue jsPoolRelease(JSContext* ctx, JSValueConst, int argc, JSValueConst* argv) {
+    if (argc < 1) {
+        return JS_FALSE;
+    }
+    const bool discard = argc > 1 && JS_ToBool(ctx, argv[1]) > 0;
+    return JS_NewBool(ctx, JsDriverBinding::releaseLease(ctx, argv[0], discard) ? 1 : 0);
+}
+
+JSValue jsConfigureDriverPool(JSContext* ctx, JSValueConst, int argc, JSValueConst* argv) {
+    stdiolink::DriverPool* pool = requirePool(ctx);
+    QString program;
+    QStringList args;
+    if (!pool
+        || !toProgram(ctx, argc > 0 ? argv[0] : JS_UNDEFINED, "configureDriverPool", program)
+        || !toStartArgs(ctx, argc > 1 ? argv[1] : JS_UNDEFINED, "configureDriverPool", args)) {
+        return JS_EXCEPTION;
+    }
+    stdiolink::DriverPool::Options options = pool->defaultOptions();
+    if (!toPoolOptions(ctx, argc > 2 ? argv[2] : JS_UNDEFINED, options)) {
+        return JS_EXCEPTION;
+    }
+    return JS_NewBool(ctx, pool->configure(program, args, options) ? 1 : 0);
+}
+
+JSValue jsDriverPoolStats(JSContext* ctx, JSValueConst, int argc, JSValueConst* argv) {
+    stdiolink::DriverPool* pool = requirePool(ctx);
+    QString program;
+    QStringList args;
+    if (!pool || !toProgram(ctx, argc > 0 ? argv[0] : JS_UNDEFINED, "driverPoolStats", program)
+        || !toStartArgs(ctx, argc > 1 ? argv[1] : JS_UNDEFINED, "driverPoolStats", args)) {
+        return JS_EXCEPTION;
+    }
+
+    const stdiolink::DriverPool::Stats stats = pool->stats(program, args);
+    JSValue obj = JS_NewObject(ctx);
+    JS_SetPropertyStr(ctx, obj, "idle", JS_NewInt32(ctx, stats.idle));
+    JS_SetPropertyStr(ctx, obj, "leased", JS_NewInt32(ctx, stats.leased));
+    JS_SetPropertyStr(ctx, obj, "created", JS_NewInt32(ctx, stats.created));
+    JS_SetPropertyStr(ctx, obj, "reused", JS_NewInt32(ctx, stats.reused));
+    JS_SetPropertyStr(ctx, obj, "discarded", JS_NewInt32(ctx, stats.discarded));
+    return obj;
+}
+
+} // namespace
+
+void JsDriverPoolBinding::detachRuntime(JSRuntime* rt) {
+    s_pools.remove(reinterpret_cast<quintptr>(rt));
+}
+
+void JsDriverPoolBinding::setPool(JSContext* ctx, stdiolink::DriverPool* pool) {
+    s_pools.insert(runtimeKey(ctx), pool);
+}
+
+int JsDriverPoolBinding::addModuleExports(JSContext* ctx, JSModuleDef* module) {
+    if (JS_AddModuleExport(ctx, module, "acquireDriver") < 0
+        || JS_AddModuleExport(ctx, module, "configureDriverPool") < 0
+        || JS_AddModuleExport(ctx, module, "driverPoolStats") < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+int JsDriverPoolBinding::setModuleExports(JSContext* ctx, JSModuleDef* module) {
+    JSValue poolObj = JS_NewObject(ctx);
+    JS_SetPropertyStr(ctx, poolObj, "acquire", JS_NewCFunction(ctx, jsPoolAcquire, "acquire", 2));
+    JS_SetPropertyStr(ctx, poolObj, "release", JS_NewCFunction(ctx, jsPoolRelease, "release", 2));
+    JSValue acquireFn = createAcquireDriverFunction(ctx, poolObj);
+    JS_FreeValue(ctx, poolObj);
+    if (JS_IsException(acquireFn)) {
+        return -1;
+    }
+
+    if (JS_SetModuleExport(ctx, module, "acquireDriver", acquireFn) < 0) {
+        return -1;
+    }
+    if (JS_SetModuleExport(ctx, module, "configureDriverPool",
+                           JS_NewCFunction(ctx, jsConfigureDriverPool, "configureDriverPool", 3))
+        < 0) {
+        return -1;
+    }
+    return JS_SetModuleExport(ctx, module, "driverPoolStats",
+                              JS_NewCFunction(ctx, jsDriverPoolStats, "driverPoolStats", 2));
+}
+
+} // namespace stdiolink_service
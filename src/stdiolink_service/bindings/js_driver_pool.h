@@ -0,0 +1,30 @@
+#pragma once
+
+#include <quickjs.h>
+
+namespace stdiolink {
+class DriverPool;
+}
+
+namespace stdiolink_service {
+
+/// @brief stdiolink/driver 模块中的热进程池导出
+///
+/// 提供 acquireDriver / configureDriverPool / driverPoolStats。
+/// 进程池由 main.cpp 持有并按 JSRuntime 注入，须在 JsEngine 之前构造、之后析构，
+/// 以便 GC 回收未归还的租约时仍能放回池中。
+class JsDriverPoolBinding {
+public:
+    static void detachRuntime(JSRuntime* rt);
+
+    /// 注入进程池；未注入时调用导出函数会抛 InternalError
+    static void setPool(JSContext* ctx, stdiolink::DriverPool* pool);
+
+    /// 在 JS_NewCModule 之后声明导出名
+    static int addModuleExports(JSContext* ctx, JSModuleDef* module);
+
+    /// 在模块初始化回调中设置导出值
+    static int setModuleExports(JSContext* ctx, JSModuleDef* module);
+};
+
+} // namespace stdiolink_service
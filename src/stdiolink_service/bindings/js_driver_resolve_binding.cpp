@@ -1,4 +1,5 @@
 #include "js_driver_resolve_binding.h"
+#include "js_driver_pool.h"
 #include "js_driver_resolve.h"
 #include "js_constants.h"
 
@@ -50,7 +51,9 @@ JSValue js_resolveDriver(JSContext* ctx, JSValueConst /*this_val*/,
 
 int driverModuleInit(JSContext* ctx, JSModuleDef* module) {
     JSValue fn = JS_NewCFunction(ctx, js_resolveDriver, "resolveDriver", 1);
-    return JS_SetModuleExport(ctx, module, "resolveDriver", fn);
+    if (JS_SetModuleExport(ctx, module, "resolveDriver", fn) < 0)
+        return -1;
+    return JsDriverPoolBinding::setModuleExports(ctx, module);
 }
 
 } // namespace
@@ -67,6 +70,8 @@ JSModuleDef* JsDriverResolveBinding::initModule(JSContext* ctx,
     JSModuleDef* module = JS_NewCModule(ctx, name, driverModuleInit);
     if (!module) return nullptr;
     JS_AddModuleExport(ctx, module, "resolveDriver");
+    if (JsDriverPoolBinding::addModuleExports(ctx, module) < 0)
+        return nullptr;
     return module;
 }
 
@@ -23,6 +23,7 @@ JSValue jsTaskGetDone(JSContext* ctx, JSValueConst thisVal);
 JSValue jsTaskGetExitCode(JSContext* ctx, JSValueConst thisVal);
 JSValue jsTaskGetErrorText(JSContext* ctx, JSValueConst thisVal);
 JSValue jsTaskGetFinalPayload(JSContext* ctx, JSValueConst thisVal);
+JSValue jsTaskGetFinalBlob(JSContext* ctx, JSValueConst thisVal);
 
 const JSCFunctionListEntry kTaskProtoFuncs[] = {
     JS_CFUNC_DEF("tryNext", 0, jsTaskTryNext),
@@ -31,6 +32,7 @@ const JSCFunctionListEntry kTaskProtoFuncs[] = {
     JS_CGETSET_DEF("exitCode", jsTaskGetExitCode, nullptr),
     JS_CGETSET_DEF("errorText", jsTaskGetErrorText, nullptr),
     JS_CGETSET_DEF("finalPayload", jsTaskGetFinalPayload, nullptr),
+    JS_CGETSET_DEF("finalBlob", jsTaskGetFinalBlob, nullptr),
 };
 
 JSClassID ensureTaskClass(JSContext* ctx) {
@@ -71,7 +73,10 @@ JSValue taskMessageToJs(JSContext* ctx, const stdiolink::Message& msg) {
     JSValue obj = JS_NewObject(ctx);
     JS_SetPropertyStr(ctx, obj, "status", JS_NewString(ctx, msg.status.toUtf8().constData()));
     JS_SetPropertyStr(ctx, obj, "code", JS_NewInt32(ctx, msg.code));
-    JS_SetPropertyStr(ctx, obj, "data", qjsonToJsValue(ctx, msg.payload));
+    JS_SetPropertyStr(ctx, obj, "data", jsonPayloadToJsValue(ctx, msg.payload));
+    if (!msg.blob.isEmpty()) {
+        JS_SetPropertyStr(ctx, obj, "blob", byteArrayToJsArrayBuffer(ctx, msg.blob));
+    }
     return obj;
 }
 
@@ -147,6 +152,18 @@ JSValue jsTaskGetFinalPayload(JSContext* ctx, JSValueConst thisVal) {
     return qjsonToJsValue(ctx, opaque->task.finalPayload());
 }
 
+JSValue jsTaskGetFinalBlob(JSContext* ctx, JSValueConst thisVal) {
+    JsTaskOpaque* opaque = getTaskOpaque(ctx, thisVal);
+    if (!opaque) {
+        return JS_EXCEPTION;
+    }
+    const QByteArray blob = opaque->task.finalBlob();
+    if (blob.isEmpty()) {
+        return JS_NULL;
+    }
+    return byteArrayToJsArrayBuffer(ctx, blob);
+}
+
 } // namespace
 
 void JsTaskBinding::registerClass(JSContext* ctx) {
@@ -1,10 +1,13 @@
 #include "js_task_scheduler.h"
 
+#include <QCoreApplication>
 #include <QHash>
+#include <QSet>
+#include <QTimer>
 
 #include "js_task.h"
+#include "stdiolink/host/driver.h"
 #include "utils/js_convert.h"
-#include "stdiolink/host/wait_any.h"
 
 namespace {
 
@@ -14,7 +17,10 @@ JSValue messageToJs(JSContext* ctx, const stdiolink::Message& msg) {
     JSValue obj = JS_NewObject(ctx);
     JS_SetPropertyStr(ctx, obj, "status", JS_NewString(ctx, msg.status.toUtf8().constData()));
     JS_SetPropertyStr(ctx, obj, "code", JS_NewInt32(ctx, msg.code));
-    JS_SetPropertyStr(ctx, obj, "data", qjsonToJsValue(ctx, msg.payload));
+    JS_SetPropertyStr(ctx, obj, "data", jsonPayloadToJsValue(ctx, msg.payload));
+    if (!msg.blob.isEmpty()) {
+        JS_SetPropertyStr(ctx, obj, "blob", byteArrayToJsArrayBuffer(ctx, msg.blob));
+    }
     return obj;
 }
 
@@ -44,7 +50,9 @@ JSValue jsScheduleTask(JSContext* ctx, JSValueConst, int argc, JSValueConst* arg
 
 } // namespace
 
-JsTaskScheduler::JsTaskScheduler(JSContext* ctx) : m_ctx(ctx) {}
+JsTaskScheduler::JsTaskScheduler(JSContext* ctx)
+    : m_ctx(ctx)
+    , m_watcher([this]() { dispatch(); }) {}
 
 JsTaskScheduler::~JsTaskScheduler() {
     s_schedulers.remove(reinterpret_cast<quintptr>(m_ctx));
@@ -65,41 +73,66 @@ void JsTaskScheduler::addTask(const stdiolink::Task& task, JSValue resolve, JSVa
     item.resolve = resolve;
     item.reject = reject;
     m_pending.push_back(item);
-}
 
-bool JsTaskScheduler::poll(int timeoutMs) {
-    if (!m_ctx || m_pending.isEmpty()) {
-        return false;
+    // 入队前到达的输出已错过 readyRead 信号（Driver 也可能已退出），先主动读一次
+    if (task.owner() != nullptr) {
+        task.owner()->pumpStdout();
     }
+    dispatch();
+}
 
-    QVector<stdiolink::Task> tasks;
-    tasks.reserve(m_pending.size());
-    for (const PendingTask& item : m_pending) {
-        tasks.push_back(item.task);
+void JsTaskScheduler::dispatch() {
+    if (!m_ctx) {
+        return;
     }
 
-    stdiolink::AnyItem anyItem;
-    const bool gotMessage = stdiolink::waitAnyNext(tasks, anyItem, timeoutMs);
-    if (gotMessage && anyItem.taskIndex >= 0 && anyItem.taskIndex < m_pending.size()) {
-        const int index = anyItem.taskIndex;
-        if (anyItem.msg.status == "done" || anyItem.msg.status == "error") {
-            JSValue msg = messageToJs(m_ctx, anyItem.msg);
-            settleTask(index, msg, false);
-        }
-        // Intermediate messages (e.g. "progress") are intentionally ignored.
+    for (int i = m_pending.size() - 1; i >= 0; --i) {
+        stdiolink::Task& task = m_pending[i].task;
+        stdiolink::Message msg;
+        bool settled = false;
+        // Intermediate messages (e.g. "progress") are intentionally consumed and ignored.
         // The Proxy layer only resolves on the final done/error response.
-    } else {
-        // No message in this round; finish any task that is already done.
-        for (int i = m_pending.size() - 1; i >= 0; --i) {
-            if (m_pending[i].task.isDone() && !m_pending[i].task.hasQueued()) {
-                settleTask(i, JS_NULL, false);
+        while (task.tryNext(msg)) {
+            if (msg.status == "done" || msg.status == "error") {
+                settleTask(i, messageToJs(m_ctx, msg), false);
+                settled = true;
+                break;
             }
         }
+        if (!settled && task.isDone()) {
+            settleTask(i, JS_NULL, false);
+        }
+    }
+
+    syncWatches();
+}
+
+bool JsTaskScheduler::poll(int timeoutMs) {
+    if (!m_ctx || m_pending.isEmpty()) {
+        return false;
     }
 
+    dispatch();
+    if (!m_pending.isEmpty() && timeoutMs > 0) {
+        // 信号驱动下这里只需让出事件循环；定时器保证最长等待 timeoutMs
+        QTimer wakeup;
+        wakeup.setSingleShot(true);
+        wakeup.start(timeoutMs);
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    }
     return !m_pending.isEmpty();
 }
 
+void JsTaskScheduler::syncWatches() {
+    QSet<stdiolink::Driver*> drivers;
+    for (const PendingTask& item : m_pending) {
+        if (item.task.owner() != nullptr) {
+            drivers.insert(item.task.owner());
+        }
+    }
+    m_watcher.sync(drivers);
+}
+
 bool JsTaskScheduler::hasPending() const {
     return !m_pending.isEmpty();
 }
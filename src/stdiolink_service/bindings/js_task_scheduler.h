@@ -6,13 +6,14 @@
 #include <QVector>
 
 #include <quickjs.h>
+#include "driver_activity_watcher.h"
 #include "stdiolink/host/task.h"
 
 /// @brief 异步任务调度器
 ///
 /// 管理 JS 端通过 Promise 发起的异步 Task。当 JS 调用异步命令时，
-/// 调度器保存对应的 resolve/reject 回调；通过 poll() 轮询 Task 完成状态，
-/// 自动调用相应的 resolve 或 reject 来兑现 Promise。
+/// 调度器保存对应的 resolve/reject 回调，并监听 Task 所属 Driver 的 stdout/退出信号；
+/// 信号到达即在 Qt 事件回调内直接兑现 Promise，无需主循环轮询。
 /// 不可拷贝，确保回调引用的唯一所有权。
 class JsTaskScheduler {
 public:
@@ -32,8 +33,13 @@ public:
     /// @param reject Promise 的 reject 回调（所有权转移给调度器）
     void addTask(const stdiolink::Task& task, JSValue resolve, JSValue reject);
 
-    /// @brief 轮询所有 pending Task，对已完成的调用 resolve/reject
-    /// @param timeoutMs 单次轮询的超时时间（毫秒），默认 50ms
+    /// @brief 检查所有 pending Task，对已收到终态消息的调用 resolve/reject
+    ///
+    /// 正常运行时由 Driver 信号触发，调用方无需主动调用。
+    void dispatch();
+
+    /// @brief 立即兑现已就绪的 Task；仍有 pending 时最多阻塞 timeoutMs 等待下一批事件
+    /// @param timeoutMs 最长等待时间（毫秒），默认 50ms
     /// @return 如果仍有未完成的 Task 返回 true
     bool poll(int timeoutMs = 50);
 
@@ -60,6 +66,10 @@ private:
     /// @param useReject 为 true 时调用 reject，否则调用 resolve
     void settleTask(int index, JSValue value, bool useReject);
 
+    /// @brief 按当前 pending 列表刷新 Driver 信号监听
+    void syncWatches();
+
     JSContext* m_ctx = nullptr;        ///< QuickJS 上下文
     QVector<PendingTask> m_pending;    ///< 待处理任务列表
+    DriverActivityWatcher m_watcher;   ///< pending Task 所属 Driver 的信号监听
 };
@@ -1,29 +1,27 @@
 #include "js_wait_any_scheduler.h"
 
-#include <algorithm>
+#include <QCoreApplication>
 #include <QHash>
 #include <QJsonObject>
 #include <QSet>
+#include <QTimer>
 
 #include "js_task.h"
 #include "utils/js_convert.h"
 #include "stdiolink/host/driver.h"
-#include "stdiolink/host/wait_any.h"
 
 namespace {
 
-struct TaskRef {
-    int groupIndex = -1;
-    int taskIndex = -1;
-};
-
 QHash<quintptr, WaitAnyScheduler*> s_schedulers;
 
 JSValue messageToJs(JSContext* ctx, const stdiolink::Message& msg) {
     JSValue obj = JS_NewObject(ctx);
     JS_SetPropertyStr(ctx, obj, "status", JS_NewString(ctx, msg.status.toUtf8().constData()));
     JS_SetPropertyStr(ctx, obj, "code", JS_NewInt32(ctx, msg.code));
-    JS_SetPropertyStr(ctx, obj, "data", qjsonToJsValue(ctx, msg.payload));
+    JS_SetPropertyStr(ctx, obj, "data", jsonPayloadToJsValue(ctx, msg.payload));
+    if (!msg.blob.isEmpty()) {
+        JS_SetPropertyStr(ctx, obj, "blob", byteArrayToJsArrayBuffer(ctx, msg.blob));
+    }
     return obj;
 }
 
@@ -103,7 +101,9 @@ JSValue jsWaitAny(JSContext* ctx, JSValueConst, int argc, JSValueConst* argv) {
 
 } // namespace
 
-WaitAnyScheduler::WaitAnyScheduler(JSContext* ctx) : m_ctx(ctx) {}
+WaitAnyScheduler::WaitAnyScheduler(JSContext* ctx)
+    : m_ctx(ctx)
+    , m_watcher([this]() { dispatch(); }) {}
 
 WaitAnyScheduler::~WaitAnyScheduler() {
     s_schedulers.remove(reinterpret_cast<quintptr>(m_ctx));
@@ -160,72 +160,93 @@ void WaitAnyScheduler::addGroup(const QVector<stdiolink::Task>& tasks, int timeo
     }
 
     PendingGroup item;
+    item.id = ++m_nextGroupId;
     item.tasks = tasks;
-    item.timeoutMs = timeoutMs;
-    item.elapsed.start();
     item.resolve = resolve;
     item.reject = reject;
+    if (timeoutMs >= 0) {
+        item.timeout = std::make_shared<QTimer>();
+        item.timeout->setSingleShot(true);
+        const quint64 id = item.id;
+        QObject::connect(item.timeout.get(), &QTimer::timeout, item.timeout.get(),
+                         [this, id]() { onGroupTimeout(id); });
+        item.timeout->start(timeoutMs);
+    }
     m_pending.push_back(item);
+
+    // 入队前到达的输出已错过 readyRead 信号（Driver 也可能已退出），先主动读一次
+    for (const stdiolink::Task& task : tasks) {
+        if (task.owner() != nullptr) {
+            task.owner()->pumpStdout();
+        }
+    }
+    dispatch();
 }
 
-bool WaitAnyScheduler::poll(int timeoutMs) {
-    if (!m_ctx || m_pending.isEmpty()) {
-        return false;
+void WaitAnyScheduler::dispatch() {
+    if (!m_ctx) {
+        return;
     }
 
-    int effectiveWaitMs = timeoutMs;
     for (int i = m_pending.size() - 1; i >= 0; --i) {
-        const PendingGroup& group = m_pending[i];
-        if (group.timeoutMs >= 0 && group.elapsed.hasExpired(group.timeoutMs)) {
-            settleGroup(i, JS_NULL, false);
-            continue;
-        }
-        if (group.timeoutMs >= 0) {
-            const int remainingMs = std::max(0, group.timeoutMs - static_cast<int>(group.elapsed.elapsed()));
-            if (effectiveWaitMs < 0 || remainingMs < effectiveWaitMs) {
-                effectiveWaitMs = remainingMs;
+        QVector<stdiolink::Task>& tasks = m_pending[i].tasks;
+        bool settled = false;
+        bool allDone = true;
+        for (int taskIndex = 0; taskIndex < tasks.size(); ++taskIndex) {
+            stdiolink::Message msg;
+            if (tasks[taskIndex].tryNext(msg)) {
+                settleGroup(i, waitAnyResultToJs(m_ctx, taskIndex, msg), false);
+                settled = true;
+                break;
+            }
+            if (tasks[taskIndex].isValid() && !tasks[taskIndex].isDone()) {
+                allDone = false;
             }
         }
+        if (!settled && allDone) {
+            settleGroup(i, JS_NULL, false);
+        }
     }
-    if (m_pending.isEmpty()) {
+
+    syncWatches();
+}
+
+bool WaitAnyScheduler::poll(int timeoutMs) {
+    if (!m_ctx || m_pending.isEmpty()) {
         return false;
     }
 
-    QVector<stdiolink::Task> allTasks;
-    QVector<TaskRef> refs;
-    for (int groupIndex = 0; groupIndex < m_pending.size(); ++groupIndex) {
-        const PendingGroup& group = m_pending[groupIndex];
-        for (int taskIndex = 0; taskIndex < group.tasks.size(); ++taskIndex) {
-            allTasks.push_back(group.tasks[taskIndex]);
-            refs.push_back(TaskRef{groupIndex, taskIndex});
-        }
+    dispatch();
+    if (!m_pending.isEmpty() && timeoutMs > 0) {
+        // 信号与组超时定时器都会唤醒事件循环；这里的定时器只限制最长等待
+        QTimer wakeup;
+        wakeup.setSingleShot(true);
+        wakeup.start(timeoutMs);
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
     }
+    return !m_pending.isEmpty();
+}
 
-    stdiolink::AnyItem anyItem;
-    const bool gotMessage = stdiolink::waitAnyNext(allTasks, anyItem, effectiveWaitMs);
-    if (gotMessage && anyItem.taskIndex >= 0 && anyItem.taskIndex < refs.size()) {
-        const TaskRef ref = refs[anyItem.taskIndex];
-        if (ref.groupIndex >= 0 && ref.groupIndex < m_pending.size()) {
-            settleGroup(ref.groupIndex,
-                        waitAnyResultToJs(m_ctx, ref.taskIndex, anyItem.msg),
-                        false);
+void WaitAnyScheduler::onGroupTimeout(quint64 id) {
+    for (int i = 0; i < m_pending.size(); ++i) {
+        if (m_pending[i].id == id) {
+            settleGroup(i, JS_NULL, false);
+            syncWatches();
+            return;
         }
-    } else {
-        for (int i = m_pending.size() - 1; i >= 0; --i) {
-            bool allDone = true;
-            for (const stdiolink::Task& task : m_pending[i].tasks) {
-                if (task.isValid() && !task.isDone()) {
-                    allDone = false;
-                    break;
-                }
-            }
-            if (allDone) {
-                settleGroup(i, JS_NULL, false);
+    }
+}
+
+void WaitAnyScheduler::syncWatches() {
+    QSet<stdiolink::Driver*> drivers;
+    for (const PendingGroup& group : m_pending) {
+        for (const stdiolink::Task& task : group.tasks) {
+            if (task.owner() != nullptr && !task.isDone()) {
+                drivers.insert(task.owner());
             }
         }
     }
-
-    return !m_pending.isEmpty();
+    m_watcher.sync(drivers);
 }
 
 bool WaitAnyScheduler::hasPending() const {
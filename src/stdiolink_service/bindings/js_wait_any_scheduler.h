@@ -3,16 +3,20 @@
 
 #pragma once
 
-#include <QElapsedTimer>
 #include <QVector>
 
+#include <memory>
 #include <quickjs.h>
+#include "driver_activity_watcher.h"
 #include "stdiolink/host/task.h"
 
+class QTimer;
+
 /// @brief waitAny 异步调度器
 ///
 /// 管理 JS 端通过 waitAny() 发起的监听组。每个监听组包含多个 Task，
-/// poll() 每轮至多兑现一个监听组，resolve 值为 { taskIndex, msg }。
+/// 组内任一 Task 有新消息时由 Driver 信号直接兑现，resolve 值为 { taskIndex, msg }；
+/// 超时由每组独立的单次定时器兑现为 null。
 class WaitAnyScheduler {
 public:
     explicit WaitAnyScheduler(JSContext* ctx);
@@ -29,8 +33,13 @@ public:
     void addGroup(const QVector<stdiolink::Task>& tasks, int timeoutMs,
                   JSValue resolve, JSValue reject);
 
-    /// @brief 驱动一轮调度
-    /// @param timeoutMs 调度超时，默认 50ms
+    /// @brief 兑现所有已有消息或已全部结束的监听组
+    ///
+    /// 正常运行时由 Driver 信号触发，调用方无需主动调用。
+    void dispatch();
+
+    /// @brief 立即兑现已就绪的监听组；仍有 pending 时最多阻塞 timeoutMs 等待下一批事件
+    /// @param timeoutMs 最长等待时间，默认 50ms
     /// @return 仍有 pending 组返回 true
     bool poll(int timeoutMs = 50);
 
@@ -42,15 +51,19 @@ public:
 
 private:
     struct PendingGroup {
+        quint64 id = 0;
         QVector<stdiolink::Task> tasks;
-        int timeoutMs = -1;
-        QElapsedTimer elapsed;
+        std::shared_ptr<QTimer> timeout;   ///< 超时定时器，无限等待时为空
         JSValue resolve = JS_UNDEFINED;
         JSValue reject = JS_UNDEFINED;
     };
 
     void settleGroup(int index, JSValue value, bool useReject);
+    void onGroupTimeout(quint64 id);
+    void syncWatches();
 
     JSContext* m_ctx = nullptr;
     QVector<PendingGroup> m_pending;
+    quint64 m_nextGroupId = 0;
+    DriverActivityWatcher m_watcher;
 };
@@ -9,6 +9,7 @@
 #include "bindings/js_time.h"
 #include "bindings/js_http.h"
 #include "bindings/js_driver.h"
+#include "bindings/js_driver_pool.h"
 #include "bindings/js_process_async.h"
 #include "bindings/js_task.h"
 #include "module_loader.h"
@@ -76,6 +77,7 @@ JsEngine::~JsEngine() {
     stdiolink_service::JsTimeBinding::detachRuntime(oldRt);
     stdiolink_service::JsHttpBinding::detachRuntime(oldRt);
     stdiolink_service::JsProcessAsyncBinding::detachRuntime(oldRt);
+    stdiolink_service::JsDriverPoolBinding::detachRuntime(oldRt);
     if (m_ctx) {
         JS_FreeContext(m_ctx);
         m_ctx = nullptr;
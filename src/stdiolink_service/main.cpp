@@ -14,12 +14,14 @@
 #include "bindings/js_log.h"
 #include "bindings/js_process_async.h"
 #include "bindings/js_stdiolink_module.h"
+#include "bindings/js_driver_pool.h"
 #include "bindings/js_driver_resolve_binding.h"
 #include "bindings/js_wait_any_scheduler.h"
 #include "bindings/js_task_scheduler.h"
 #include "config/service_args.h"
 #include "stdiolink/console/cli_schema_parser.h"
 #include "stdiolink/guard/process_guard_client.h"
+#include "stdiolink/host/driver_pool.h"
 #include "config/service_config_help.h"
 #include "config/service_config_schema.h"
 #include "config/service_config_validator.h"
@@ -211,6 +213,8 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // 须先于 engine 构造：JS 回收未归还的池化 Driver 时会放回池中
+    stdiolink::DriverPool driverPool;
     JsEngine engine;
     if (!engine.context()) {
         return 1;
@@ -225,6 +229,7 @@ int main(int argc, char* argv[]) {
     JsTimeBinding::attachRuntime(engine.runtime());
     JsHttpBinding::attachRuntime(engine.runtime());
     JsProcessAsyncBinding::attachRuntime(engine.runtime());
+    JsDriverPoolBinding::setPool(engine.context(), &driverPool);
     QString normalizedDataRoot = normalizeDataRoot(parsed.dataRoot);
 
     JsConstantsBinding::setPathContext(engine.context(), {
@@ -255,22 +260,20 @@ int main(int argc, char* argv[]) {
 
     int ret = engine.evalFile(svcDir.entryPath());
 
-    // Drain pending jobs (scheduler + waitAny + QuickJS jobs + async bindings)
-    while (scheduler.hasPending() || waitAnyScheduler.hasPending()
-           || engine.hasPendingJobs()
-           || JsTimeBinding::hasPending(engine.context())
-           || JsHttpBinding::hasPending(engine.context())
-           || JsProcessAsyncBinding::hasPending(engine.context())) {
-        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
-        if (scheduler.hasPending()) {
-            scheduler.poll(50);
-        }
-        if (waitAnyScheduler.hasPending()) {
-            waitAnyScheduler.poll(50);
-        }
+    // 事件驱动主循环：Driver 输出/退出、定时器、HTTP 应答与子进程事件都由 Qt 信号
+    // 直接兑现 Promise；这里只负责执行微任务，并在无事可做时阻塞等待下一批事件
+    while (true) {
         while (engine.hasPendingJobs()) {
             engine.executePendingJobs();
         }
+        const bool pending = scheduler.hasPending() || waitAnyScheduler.hasPending()
+                             || JsTimeBinding::hasPending(engine.context())
+                             || JsHttpBinding::hasPending(engine.context())
+                             || JsProcessAsyncBinding::hasPending(engine.context());
+        if (!pending) {
+            break;
+        }
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
     }
     if (ret == 0 && engine.hadJobError()) {
         engine.reportUnhandledPromiseRejections();
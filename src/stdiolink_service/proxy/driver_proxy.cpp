@@ -2,32 +2,39 @@
 
 #include <cstring>
 
-JSValue createOpenDriverFunction(JSContext* ctx, JSValueConst driverCtor) {
+namespace {
+
+/// 工厂脚本 (DriverCtor, pool)：传入 pool 时返回 acquireDriver，否则返回 openDriver
+JSValue createProxyFactoryFunction(JSContext* ctx, JSValueConst driverCtor, JSValueConst pool) {
     static const char kFactorySource[] =
-        "(function(DriverCtor){\n"
-        "  function normalizeOptions(options) {\n"
-        "    if (options == null) return { metaTimeoutMs: 5000 };\n"
+        "(function(DriverCtor, pool){\n"
+        "  function normalizeOptions(options, fnName) {\n"
+        "    if (options == null) return { metaTimeoutMs: 5000, pipeline: false };\n"
         "    if (typeof options !== 'object' || Array.isArray(options)) {\n"
-        "      throw new TypeError('openDriver: options must be an object');\n"
+        "      throw new TypeError(fnName + ': options must be an object');\n"
         "    }\n"
-        "    const allowed = new Set(['metaTimeoutMs']);\n"
+        "    const allowed = new Set(['metaTimeoutMs', 'pipeline']);\n"
         "    for (const k of Object.keys(options)) {\n"
         "      if (!allowed.has(k)) {\n"
-        "        throw new TypeError('openDriver: unknown option: ' + k);\n"
+        "        throw new TypeError(fnName + ': unknown option: ' + k);\n"
         "      }\n"
         "    }\n"
         "    let metaTimeoutMs = 5000;\n"
         "    if (options.metaTimeoutMs !== undefined) {\n"
         "      if (typeof options.metaTimeoutMs !== 'number') {\n"
-        "        throw new TypeError('openDriver: metaTimeoutMs must be a number');\n"
+        "        throw new TypeError(fnName + ': metaTimeoutMs must be a number');\n"
         "      }\n"
         "      if (!Number.isFinite(options.metaTimeoutMs) || options.metaTimeoutMs <= 0 ||\n"
         "          !Number.isInteger(options.metaTimeoutMs)) {\n"
-        "        throw new RangeError('openDriver: metaTimeoutMs must be a positive integer');\n"
+        "        throw new RangeError(fnName + ': metaTimeoutMs must be a positive integer');\n"
         "      }\n"
         "      metaTimeoutMs = options.metaTimeoutMs;\n"
         "    }\n"
-        "    return { metaTimeoutMs };\n"
+        "    const pipeline = options.pipeline ?? false;\n"
+        "    if (typeof pipeline !== 'boolean') {\n"
+        "      throw new TypeError(fnName + ': pipeline must be a boolean');\n"
+        "    }\n"
+        "    return { metaTimeoutMs, pipeline };\n"
         "  }\n"
         "\n"
         "  function normalizeCommandOptions(options) {\n"
@@ -79,6 +86,10 @@ JSValue createOpenDriverFunction(JSContext* ctx, JSValueConst driverCtor) {
         "        throw err;\n"
         "      }\n"
         "      if (msg.status === 'done') {\n"
+        "        if (msg.blob !== undefined && msg.data && typeof msg.data === 'object'\n"
+        "            && !('blob' in msg.data)) {\n"
+        "          msg.data.blob = msg.blob;\n"
+        "        }\n"
         "        return msg.data;\n"
         "      }\n"
         "\n"
@@ -103,58 +114,66 @@ JSValue createOpenDriverFunction(JSContext* ctx, JSValueConst driverCtor) {
         "    }\n"
         "  }\n"
         "\n"
-        "  function buildStartArgs(args) {\n"
+        "  function buildStartArgs(args, fnName) {\n"
         "    if (args !== undefined && args !== null && !Array.isArray(args)) {\n"
-        "      throw new TypeError('openDriver: args must be an array');\n"
+        "      throw new TypeError(fnName + ': args must be an array');\n"
         "    }\n"
         "    const src = Array.isArray(args) ? args : [];\n"
         "    for (const a of src) {\n"
-        "      if (typeof a !== 'string') throw new TypeError('openDriver: args item must be string');\n"
+        "      if (typeof a !== 'string') throw new TypeError(fnName + ': args item must be string');\n"
         "    }\n"
         "    const filtered = src.filter(a => !a.startsWith('--profile='));\n"
         "    filtered.push('--profile=keepalive');\n"
         "    return filtered;\n"
         "  }\n"
         "\n"
-        "  return async function openDriver(program, args, options) {\n"
-        "    if (typeof program !== 'string' || program.length === 0) {\n"
-        "      throw new TypeError('openDriver: program must be a non-empty string');\n"
-        "    }\n"
-        "    const opts = normalizeOptions(options);\n"
-        "    const startArgs = buildStartArgs(args);\n"
-        "    const driver = new DriverCtor();\n"
-        "    if (!driver.start(program, startArgs)) {\n"
-        "      throw new Error('Failed to start driver: ' + program);\n"
-        "    }\n"
-        "    const meta = driver.queryMeta(opts.metaTimeoutMs);\n"
-        "    if (!meta) {\n"
-        "      driver.terminate();\n"
-        "      throw new Error('Failed to query metadata from: ' + program +\n"
-        "        ' (timeoutMs=' + opts.metaTimeoutMs + ')');\n"
-        "    }\n"
+        "  function wrapDriver(driver, meta, opts, lease) {\n"
         "    const commands = new Set((meta.commands || []).map(c => c.name));\n"
-        "    let busy = false;\n"
+        "    let inflight = 0;\n"
+        "    let rawTasks = [];\n"
+        "    let released = false;\n"
+        "    function endLease(discard) {\n"
+        "      if (released) return;\n"
+        "      rawTasks = rawTasks.filter(t => !t.done);\n"
+        "      if (inflight > 0 || rawTasks.length > 0) {\n"
+        "        throw new Error('DriverBusyError: cannot release while a request is in flight');\n"
+        "      }\n"
+        "      released = true;\n"
+        "      pool.release(driver, discard);\n"
+        "    }\n"
         "    return new Proxy(driver, {\n"
         "      get(target, prop) {\n"
         "        if (prop === '$driver') return target;\n"
         "        if (prop === '$meta') return meta;\n"
-        "        if (prop === '$rawRequest') return (cmd, data) => target.request(cmd, data || {});\n"
-        "        if (prop === '$close') return () => target.terminate();\n"
+        "        if (prop === '$close') {\n"
+        "          return lease ? () => endLease(true) : () => target.terminate();\n"
+        "        }\n"
+        "        if (prop === '$release' && lease) return () => endLease(false);\n"
+        "        if (released && (prop === '$rawRequest' || commands.has(prop))) {\n"
+        "          throw new Error('Driver lease has been released: ' + prop);\n"
+        "        }\n"
+        "        if (prop === '$rawRequest') {\n"
+        "          return (cmd, data) => {\n"
+        "            const task = target.request(cmd, data || {});\n"
+        "            if (lease) rawTasks.push(task);\n"
+        "            return task;\n"
+        "          };\n"
+        "        }\n"
         "        if (typeof prop === 'string' && commands.has(prop)) {\n"
         "          return (params = {}, options) => {\n"
-        "            if (busy) {\n"
+        "            if (inflight > 0 && !opts.pipeline) {\n"
         "              throw new Error('DriverBusyError: request already in flight');\n"
         "            }\n"
         "            const cmdOptions = normalizeCommandOptions(options);\n"
-        "            busy = true;\n"
+        "            inflight++;\n"
         "            try {\n"
         "              const task = target.request(prop, params);\n"
         "              return waitTaskToTerminal(target, prop, task, cmdOptions.timeoutMs)\n"
         "                .finally(() => {\n"
-        "                  busy = false;\n"
+        "                  inflight--;\n"
         "                });\n"
         "            } catch (e) {\n"
-        "              busy = false;\n"
+        "              inflight--;\n"
         "              throw e;\n"
         "            }\n"
         "          };\n"
@@ -162,7 +181,47 @@ JSValue createOpenDriverFunction(JSContext* ctx, JSValueConst driverCtor) {
         "        return undefined;\n"
         "      }\n"
         "    });\n"
-        "  };\n"
+        "  }\n"
+        "\n"
+        "  async function openDriver(program, args, options) {\n"
+        "    if (typeof program !== 'string' || program.length === 0) {\n"
+        "      throw new TypeError('openDriver: program must be a non-empty string');\n"
+        "    }\n"
+        "    const opts = normalizeOptions(options, 'openDriver');\n"
+        "    const startArgs = buildStartArgs(args, 'openDriver');\n"
+        "    const driver = new DriverCtor();\n"
+        "    if (!driver.start(program, startArgs)) {\n"
+        "      throw new Error('Failed to start driver: ' + program);\n"
+        "    }\n"
+        "    driver.pipelining = opts.pipeline;\n"
+        "    const meta = driver.queryMeta(opts.metaTimeoutMs);\n"
+        "    if (!meta) {\n"
+        "      driver.terminate();\n"
+        "      throw new Error('Failed to query metadata from: ' + program +\n"
+        "        ' (timeoutMs=' + opts.metaTimeoutMs + ')');\n"
+        "    }\n"
+        "    return wrapDriver(driver, meta, opts, false);\n"
+        "  }\n"
+        "\n"
+        "  async function acquireDriver(program, args, options) {\n"
+        "    if (typeof program !== 'string' || program.length === 0) {\n"
+        "      throw new TypeError('acquireDriver: program must be a non-empty string');\n"
+        "    }\n"
+        "    const opts = normalizeOptions(options, 'acquireDriver');\n"
+        "    const startArgs = buildStartArgs(args, 'acquireDriver');\n"
+        "    const driver = pool.acquire(program, startArgs);\n"
+        "    driver.pipelining = opts.pipeline;\n"
+        "    // 复用的热实例已缓存元数据，这里不再与进程交互\n"
+        "    const meta = driver.queryMeta(opts.metaTimeoutMs);\n"
+        "    if (!meta) {\n"
+        "      pool.release(driver, true);\n"
+        "      throw new Error('Failed to query metadata from: ' + program +\n"
+        "        ' (timeoutMs=' + opts.metaTimeoutMs + ')');\n"
+        "    }\n"
+        "    return wrapDriver(driver, meta, opts, true);\n"
+        "  }\n"
+        "\n"
+        "  return pool ? acquireDriver : openDriver;\n"
         "})";
 
     JSValue factory = JS_Eval(ctx, kFactorySource, std::strlen(kFactorySource),
@@ -171,8 +230,18 @@ JSValue createOpenDriverFunction(JSContext* ctx, JSValueConst driverCtor) {
         return factory;
     }
 
-    JSValue args[1] = {driverCtor};
-    JSValue openDriver = JS_Call(ctx, factory, JS_UNDEFINED, 1, args);
+    JSValue args[2] = {driverCtor, pool};
+    JSValue fn = JS_Call(ctx, factory, JS_UNDEFINED, 2, args);
     JS_FreeValue(ctx, factory);
-    return openDriver;
+    return fn;
+}
+
+} // namespace
+
+JSValue createOpenDriverFunction(JSContext* ctx, JSValueConst driverCtor) {
+    return createProxyFactoryFunction(ctx, driverCtor, JS_UNDEFINED);
+}
+
+JSValue createAcquireDriverFunction(JSContext* ctx, JSValueConst pool) {
+    return createProxyFactoryFunction(ctx, JS_UNDEFINED, pool);
 }
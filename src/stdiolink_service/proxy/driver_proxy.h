@@ -15,3 +15,13 @@
 /// @param driverCtor Driver 类的构造函数对象
 /// @return openDriver 函数的 JSValue
 JSValue createOpenDriverFunction(JSContext* ctx, JSValueConst driverCtor);
+
+/// @brief 创建 acquireDriver() 函数
+///
+/// 与 openDriver() 返回相同的 Proxy，但 Driver 从热进程池租出：
+/// 额外提供 `$release()` 归还实例，`$close()` 终止实例且不再复用。
+///
+/// @param ctx QuickJS 上下文
+/// @param pool 原生池对象，提供 acquire(program, args) 与 release(driver, discard)
+/// @return acquireDriver 函数的 JSValue
+JSValue createAcquireDriverFunction(JSContext* ctx, JSValueConst pool);
@@ -50,6 +50,24 @@ JSValue qjsonToJsValue(JSContext* ctx, const QJsonValue& val) {
     return JS_NULL;
 }
 
+JSValue jsonPayloadToJsValue(JSContext* ctx, const stdiolink::JsonPayload& payload) {
+    if (payload.isRaw()) {
+        // QByteArray 保证以 '\0' 结尾，满足 JS_ParseJSON 的要求
+        const QByteArray& raw = payload.raw();
+        JSValue val = JS_ParseJSON(ctx, raw.constData(), static_cast<size_t>(raw.size()), "<payload>");
+        if (!JS_IsException(val)) {
+            return val;
+        }
+        JS_FreeValue(ctx, JS_GetException(ctx));
+    }
+    return qjsonToJsValue(ctx, payload.value());
+}
+
+JSValue byteArrayToJsArrayBuffer(JSContext* ctx, const QByteArray& bytes) {
+    return JS_NewArrayBufferCopy(ctx, reinterpret_cast<const uint8_t*>(bytes.constData()),
+                                 static_cast<size_t>(bytes.size()));
+}
+
 JSValue qjsonObjectToJsValue(JSContext* ctx, const QJsonObject& obj) {
     JSValue jsObj = JS_NewObject(ctx);
     for (auto it = obj.constBegin(); it != obj.constEnd(); ++it) {
@@ -3,9 +3,11 @@
 
 #pragma once
 
+#include <QByteArray>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <quickjs.h>
+#include "stdiolink/protocol/json_payload.h"
 
 /// @brief 将 QJsonValue 转换为 JSValue
 /// @param ctx QuickJS 上下文
@@ -13,6 +15,18 @@
 /// @return 对应的 JSValue，调用方负责释放
 JSValue qjsonToJsValue(JSContext* ctx, const QJsonValue& val);
 
+/// @brief 将 Driver 响应载荷转换为 JSValue
+/// @param ctx QuickJS 上下文
+/// @param payload 响应载荷；仍为原始字节时直接 JS_ParseJSON，不经过 QJsonValue
+/// @return 对应的 JSValue，调用方负责释放
+JSValue jsonPayloadToJsValue(JSContext* ctx, const stdiolink::JsonPayload& payload);
+
+/// @brief 将二进制数据拷贝为 JS ArrayBuffer
+/// @param ctx QuickJS 上下文
+/// @param bytes 源数据
+/// @return 新建的 ArrayBuffer，调用方负责释放
+JSValue byteArrayToJsArrayBuffer(JSContext* ctx, const QByteArray& bytes);
+
 /// @brief 将 QJsonObject 转换为 JS 对象
 /// @param ctx QuickJS 上下文
 /// @param obj 源 QJsonObject
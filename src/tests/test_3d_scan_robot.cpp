@@ -586,6 +586,38 @@ TEST_F(ThreeDScanRobotHandlerTest, T26_GetDataIndependentPull) {
     EXPECT_EQ(result["byte_count"].toInt(), 32);
 }
 
+// T26b — blob-capable host still gets data_base64 unless the request opts in
+TEST_F(ThreeDScanRobotHandlerTest, T26b_GetDataBlobIsOptInPerRequest) {
+    resp.blobFrames = true;
+    auto handler = makeHandlerBorrowing(&fake);
+
+    fake.enqueueReadRegisterSuccess(1, 0, RegId::SegmentSize, 32);
+    fake.enqueueScanSegments(1, {QByteArray(32, 'D')}, 32);
+    QJsonObject p = baseParams();
+    p["inter_command_delay_ms"] = 10;
+    p["total_bytes"] = 32;
+    handler.handle("get_data", p, resp);
+
+    ASSERT_FALSE(resp.responses.empty());
+    QJsonObject result = resp.responses.back().payload.toObject();
+    EXPECT_EQ(result["data_base64"].toString(),
+              QString::fromLatin1(QByteArray(32, 'D').toBase64()));
+    EXPECT_FALSE(result.contains("blob_base64"));
+
+    // MockResponder 的 doneBlob 回退为 blob_base64，据此确认走了附件路径
+    resp.clear();
+    fake.enqueueReadRegisterSuccess(1, 0, RegId::SegmentSize, 32);
+    fake.enqueueScanSegments(1, {QByteArray(32, 'E')}, 32);
+    p["blob"] = true;
+    handler.handle("get_data", p, resp);
+
+    ASSERT_FALSE(resp.responses.empty());
+    result = resp.responses.back().payload.toObject();
+    EXPECT_FALSE(result.contains("data_base64"));
+    EXPECT_EQ(result["blob_base64"].toString(),
+              QString::fromLatin1(QByteArray(32, 'E').toBase64()));
+}
+
 // T27 — scan_progress returns frame progress
 TEST_F(ThreeDScanRobotHandlerTest, T27_ScanProgressReturnsFrameProgress) {
     fake.enqueueInterruptProgress(1, 0, 50, 200);
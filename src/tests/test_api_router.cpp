@@ -15,6 +15,7 @@
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QTcpServer>
+#include <QTcpSocket>
 #include <QTemporaryDir>
 #include <QTextStream>
 #include <QTimer>
@@ -22,9 +23,11 @@
 #include <QUrlQuery>
 
 #include <functional>
+#include <memory>
 
 #include "stdiolink_server/http/api_router.h"
 #include "stdiolink_server/http/event_stream_handler.h"
+#include "stdiolink_server/http/response_cache.h"
 #include "stdiolink_server/manager/process_monitor.h"
 #include "stdiolink_server/server_manager.h"
 
@@ -171,6 +174,54 @@ bool sendRequest(const QString& method,
     return true;
 }
 
+/// 带自定义请求头的 GET；显式设置 Accept-Encoding 时 QNetworkAccessManager 不会自动解压
+bool sendGetWithHeaders(const QUrl& url,
+                        const QMap<QByteArray, QByteArray>& requestHeaders,
+                        int& statusCode,
+                        QMap<QByteArray, QByteArray>& responseHeaders,
+                        QByteArray& responseBody,
+                        QString& error) {
+    QNetworkAccessManager manager;
+    QNetworkRequest req(url);
+    for (auto it = requestHeaders.cbegin(); it != requestHeaders.cend(); ++it) {
+        req.setRawHeader(it.key(), it.value());
+    }
+
+    QNetworkReply* reply = manager.get(req);
+    QEventLoop loop;
+    QTimer timeout;
+    timeout.setSingleShot(true);
+
+    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+    QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+    timeout.start(3000);
+    loop.exec();
+    if (!timeout.isActive()) {
+        reply->abort();
+        error = "request timeout";
+        reply->deleteLater();
+        return false;
+    }
+    timeout.stop();
+
+    statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    responseHeaders.clear();
+    for (const auto& pair : reply->rawHeaderPairs()) {
+        responseHeaders.insert(pair.first.toLower(), pair.second);
+    }
+    responseBody = reply->readAll();
+    if (reply->error() != QNetworkReply::NoError && statusCode == 0) {
+        error = reply->errorString();
+        reply->deleteLater();
+        return false;
+    }
+
+    reply->deleteLater();
+    error.clear();
+    return true;
+}
+
 bool openStreamAndReadHeaders(const QUrl& url,
                               int& statusCode,
                               QMap<QByteArray, QByteArray>& headers,
@@ -734,6 +785,51 @@ TEST(ApiRouterTest, InstanceDetailReturns404ForMissing) {
     EXPECT_EQ(status, 404);
 }
 
+TEST(ApiRouterTest, LogStreamAndMetricsReturn404ForUnknownInstance) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    const QString root = tmp.path();
+    ASSERT_TRUE(QDir().mkpath(root + "/services"));
+    ASSERT_TRUE(QDir().mkpath(root + "/projects"));
+    ASSERT_TRUE(QDir().mkpath(root + "/workspaces"));
+    ASSERT_TRUE(QDir().mkpath(root + "/logs"));
+
+    ServerConfig cfg;
+    ServerManager manager(root, cfg);
+    QString initError;
+    ASSERT_TRUE(manager.initialize(initError));
+
+    QHttpServer server;
+    ApiRouter router(&manager);
+    router.registerRoutes(server);
+
+    QTcpServer tcpServer;
+    if (!tcpServer.listen(QHostAddress::AnyIPv4, 0)) {
+        GTEST_SKIP() << "Cannot listen";
+    }
+    if (!server.bind(&tcpServer)) {
+        GTEST_SKIP() << "Cannot bind";
+    }
+
+    const QString base = QString("http://127.0.0.1:%1").arg(tcpServer.serverPort());
+
+    int status = 0;
+    QByteArray body;
+    QString error;
+
+    ASSERT_TRUE(sendRequest("GET", QUrl(base + "/api/instances/nonexistent/logs/stream"),
+                            QByteArray(), status, body, error))
+        << qPrintable(error);
+    EXPECT_EQ(status, 404);
+    EXPECT_EQ(manager.logStreamHandler()->activeConnectionCount(), 0);
+
+    ASSERT_TRUE(sendRequest("GET", QUrl(base + "/api/instances/nonexistent/metrics"),
+                            QByteArray(), status, body, error))
+        << qPrintable(error);
+    EXPECT_EQ(status, ProcessMonitor::isSupported() ? 404 : 501);
+}
+
 TEST(ApiRouterTest, DriverDetailReturns404ForMissing) {
     QTemporaryDir tmp;
     ASSERT_TRUE(tmp.isValid());
@@ -825,6 +921,7 @@ TEST(ApiRouterTest, ServicePathsExposeOnlyDataRootRelativeDisplayPath) {
 
     auto& servicesMap = const_cast<QMap<QString, ServiceInfo>&>(manager.services());
     servicesMap["demo"].serviceDir = QDir::cleanPath(tmp.path() + "/../outside/demo");
+    manager.markServicesChanged();
 
     ASSERT_TRUE(sendRequest("GET", QUrl(base + "/api/services/demo"), QByteArray(), status, body, error))
         << qPrintable(error);
@@ -906,6 +1003,116 @@ TEST(ApiRouterTest, DriverPathsExposeOnlyDataRootRelativeDisplayPath) {
               QDir::cleanPath(tmp.path() + "/../outside/stdio.drv.driver_under_test" + exeSuffix()));
 }
 
+TEST(ApiRouterTest, ReadEndpointsUseETagAndRevalidate) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    const QString root = tmp.path();
+    ASSERT_TRUE(QDir().mkpath(root + "/services"));
+    ASSERT_TRUE(QDir().mkpath(root + "/projects"));
+    ASSERT_TRUE(QDir().mkpath(root + "/workspaces"));
+    ASSERT_TRUE(QDir().mkpath(root + "/logs"));
+    ASSERT_TRUE(QDir().mkpath(root + "/drivers/demo"));
+
+    const QString driverBinary = testBinaryPath("test_meta_driver");
+    ASSERT_TRUE(QFileInfo::exists(driverBinary));
+    ASSERT_TRUE(copyExecutable(driverBinary,
+                               root + "/drivers/demo/stdio.drv.driver_under_test" + exeSuffix()));
+    writeService(root, "demo");
+    writeProject(root, "p1", "demo");
+
+    ServerConfig cfg;
+    cfg.watchDataRoot = false;
+    ServerManager manager(root, cfg);
+    QString initError;
+    ASSERT_TRUE(manager.initialize(initError));
+
+    QHttpServer server;
+    ApiRouter router(&manager);
+    router.registerRoutes(server);
+
+    QTcpServer tcpServer;
+    if (!tcpServer.listen(QHostAddress::AnyIPv4, 0)) {
+        GTEST_SKIP() << "Cannot listen";
+    }
+    if (!server.bind(&tcpServer)) {
+        GTEST_SKIP() << "Cannot bind";
+    }
+
+    const QString base = QString("http://127.0.0.1:%1").arg(tcpServer.serverPort());
+
+    int status = 0;
+    QByteArray body;
+    QString error;
+    QMap<QByteArray, QByteArray> headers;
+    const QMap<QByteArray, QByteArray> identity{{"Accept-Encoding", "identity"}};
+
+    // 首次请求返回强 ETag
+    ASSERT_TRUE(sendGetWithHeaders(QUrl(base + "/api/projects"), identity, status, headers, body, error))
+        << qPrintable(error);
+    EXPECT_EQ(status, 200);
+    const QByteArray projectsETag = headers.value("etag");
+    ASSERT_TRUE(projectsETag.startsWith('"'));
+    EXPECT_EQ(headers.value("cache-control"), "no-cache");
+
+    // 数据未变时 If-None-Match 命中返回 304
+    QMap<QByteArray, QByteArray> conditional = identity;
+    conditional.insert("If-None-Match", projectsETag);
+    ASSERT_TRUE(sendGetWithHeaders(QUrl(base + "/api/projects"), conditional, status, headers, body, error))
+        << qPrintable(error);
+    EXPECT_EQ(status, 304);
+    EXPECT_EQ(headers.value("etag"), projectsETag);
+    EXPECT_TRUE(body.isEmpty());
+
+    // 通过接口修改项目后缓存失效
+    ASSERT_TRUE(sendRequest("PATCH", QUrl(base + "/api/projects/p1/enabled"),
+                            R"({"enabled":false})", status, body, error))
+        << qPrintable(error);
+    ASSERT_EQ(status, 200);
+    ASSERT_TRUE(sendGetWithHeaders(QUrl(base + "/api/projects"), conditional, status, headers, body, error))
+        << qPrintable(error);
+    EXPECT_EQ(status, 200);
+    EXPECT_NE(headers.value("etag"), projectsETag);
+    QJsonObject obj;
+    ASSERT_TRUE(parseJsonObject(body, obj));
+    EXPECT_FALSE(obj.value("projects").toArray().first().toObject().value("enabled").toBool());
+
+    // 大正文按 Accept-Encoding 返回 deflate，ETag 与未压缩版本不同
+    const QUrl docsUrl(base + "/api/drivers/test-meta-driver/docs?format=html");
+    ASSERT_TRUE(sendGetWithHeaders(docsUrl, identity, status, headers, body, error))
+        << qPrintable(error);
+    ASSERT_EQ(status, 200);
+    ASSERT_GT(body.size(), ResponseCache::kCompressThreshold);
+    EXPECT_FALSE(headers.contains("content-encoding"));
+    const QByteArray plainDocs = body;
+    const QByteArray plainETag = headers.value("etag");
+
+    ASSERT_TRUE(sendGetWithHeaders(docsUrl, {{"Accept-Encoding", "gzip, deflate"}},
+                                   status, headers, body, error))
+        << qPrintable(error);
+    EXPECT_EQ(status, 200);
+    EXPECT_EQ(headers.value("content-encoding"), "deflate");
+    EXPECT_NE(headers.value("etag"), plainETag);
+    EXPECT_LT(body.size(), plainDocs.size());
+
+    // 未显式指定编码时 QNetworkAccessManager 自动解压，内容应与未压缩版本一致
+    ASSERT_TRUE(sendRequest("GET", docsUrl, QByteArray(), status, body, error)) << qPrintable(error);
+    EXPECT_EQ(status, 200);
+    EXPECT_EQ(body, plainDocs);
+
+    // 驱动目录变化后重新生成
+    stdiolink::DriverConfig changed = manager.driverCatalog()->getConfig("test-meta-driver");
+    changed.meta = std::make_shared<stdiolink::meta::DriverMeta>(*changed.meta);
+    changed.meta->info.description += " (changed)";
+    manager.driverCatalog()->upsert(changed);
+    conditional = identity;
+    conditional.insert("If-None-Match", plainETag);
+    ASSERT_TRUE(sendGetWithHeaders(docsUrl, conditional, status, headers, body, error))
+        << qPrintable(error);
+    EXPECT_EQ(status, 200);
+    EXPECT_NE(headers.value("etag"), plainETag);
+}
+
 TEST(ApiRouterTest, ProjectListPaginationAndFiltering) {
     QTemporaryDir tmp;
     ASSERT_TRUE(tmp.isValid());
@@ -2847,6 +3054,87 @@ TEST(ApiRouterTest, M72_R14_SseConnectionLifecycle) {
     reply->deleteLater();
 }
 
+TEST(ApiRouterTest, SseStalledReaderDropsInsteadOfBuffering) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    const QString root = tmp.path();
+    ASSERT_TRUE(QDir().mkpath(root + "/services"));
+    ASSERT_TRUE(QDir().mkpath(root + "/projects"));
+    ASSERT_TRUE(QDir().mkpath(root + "/workspaces"));
+    ASSERT_TRUE(QDir().mkpath(root + "/logs"));
+
+    ServerConfig cfg;
+    ServerManager manager(root, cfg);
+    QString initError;
+    ASSERT_TRUE(manager.initialize(initError));
+
+    QHttpServer server;
+    ApiRouter router(&manager);
+    router.registerRoutes(server);
+
+    QTcpServer tcpServer;
+    if (!tcpServer.listen(QHostAddress::AnyIPv4, 0)) {
+        GTEST_SKIP() << "Cannot listen";
+    }
+    if (!server.bind(&tcpServer)) {
+        GTEST_SKIP() << "Cannot bind";
+    }
+
+    auto pump = [](int ms) {
+        QEventLoop loop;
+        QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+        loop.exec();
+    };
+
+    // 读缓冲限制为 1 字节：读到响应头后客户端不再从内核取数据，模拟卡住的读端
+    QTcpSocket client;
+    client.setReadBufferSize(1);
+    client.connectToHost(QHostAddress::LocalHost, tcpServer.serverPort());
+    client.write("GET /api/events/stream HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n");
+    for (int i = 0; i < 100 && manager.eventStreamHandler()->activeConnectionCount() == 0; ++i) {
+        pump(20);
+    }
+    ASSERT_EQ(manager.eventStreamHandler()->activeConnectionCount(), 1);
+
+    // 远超内核收发缓冲与连接队列容量的数据量
+    const QString pad(24 * 1024, QLatin1Char('x'));
+    for (int batch = 0; batch < 64; ++batch) {
+        for (int i = 0; i < 64; ++i) {
+            manager.eventBus()->publish("instance.output", QJsonObject{{"pad", pad}});
+        }
+        pump(EventStreamHandler::kFlushIntervalMs + 5);
+    }
+
+    QList<QTcpSocket*> accepted = tcpServer.findChildren<QTcpSocket*>();
+    ASSERT_EQ(accepted.size(), 1);
+    EXPECT_LE(accepted.front()->bytesToWrite(),
+              EventStreamHandler::kMaxSocketBacklogBytes + EventStreamHandler::kMaxFlushBytes + 1024);
+
+    // 只剩积压连接有待发帧时合并定时器停下，不再每 kFlushIntervalMs 空转
+    pump(EventStreamHandler::kFlushIntervalMs * 3);
+    EXPECT_GT(accepted.front()->bytesToWrite(), EventStreamHandler::kMaxSocketBacklogBytes);
+    EXPECT_FALSE(manager.eventStreamHandler()->isFlushScheduled());
+
+    // 恢复读取后由套接字 bytesWritten 重新排程写出，应看到 dropped 事件，而不是全部帧
+    client.setReadBufferSize(0);
+    QByteArray tail;
+    bool sawDropped = false;
+    QElapsedTimer timer;
+    timer.start();
+    while (!sawDropped && timer.elapsed() < 10000) {
+        pump(10);
+        tail += client.readAll();
+        sawDropped = tail.contains("event: dropped");
+        // 只保留可能跨读取边界的尾部
+        tail = tail.right(64);
+    }
+    EXPECT_TRUE(sawDropped);
+
+    manager.eventStreamHandler()->closeAllConnections();
+    client.abort();
+}
+
 // --- GET /api/events ---
 
 TEST(ApiRouterTest, GetEventsReturnsPublishedEvents) {
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+#include "stdiolink_server/scanner/catalog_watcher.h"
+
+using namespace stdiolink_server;
+
+namespace {
+
+constexpr int kDebounceMs = 50;
+constexpr int kWaitMs = 3000;
+
+bool writeText(const QString& path, const QByteArray& content) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(content) == content.size();
+}
+
+QStringList collected(const QSignalSpy& spy) {
+    QStringList all;
+    for (const QList<QVariant>& args : spy) {
+        all += args.at(0).toStringList();
+    }
+    return all;
+}
+
+} // namespace
+
+TEST(CatalogWatcherTest, StartFailsWithoutDataRoot) {
+    CatalogWatcher watcher("/path/does/not/exist", kDebounceMs);
+    EXPECT_FALSE(watcher.start());
+    EXPECT_FALSE(watcher.isActive());
+}
+
+TEST(CatalogWatcherTest, ReportsOnlyChangedEntries) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString root = tmp.path();
+    ASSERT_TRUE(QDir().mkpath(root + "/projects/p1"));
+    ASSERT_TRUE(QDir().mkpath(root + "/projects/p2"));
+    ASSERT_TRUE(writeText(root + "/projects/p1/config.json", "{}"));
+    ASSERT_TRUE(writeText(root + "/projects/p2/config.json", "{}"));
+
+    CatalogWatcher watcher(root, kDebounceMs);
+    ASSERT_TRUE(watcher.start());
+    EXPECT_GT(watcher.watchedPathCount(), 0);
+
+    QSignalSpy projects(&watcher, &CatalogWatcher::projectsChanged);
+    QSignalSpy services(&watcher, &CatalogWatcher::servicesChanged);
+
+    // 同一条目的连续写入合并为一次
+    ASSERT_TRUE(writeText(root + "/projects/p1/config.json", "{\"a\":1}"));
+    ASSERT_TRUE(writeText(root + "/projects/p1/param.json", "{}"));
+    ASSERT_TRUE(projects.wait(kWaitMs));
+    EXPECT_EQ(projects.count(), 1);
+    EXPECT_EQ(collected(projects), QStringList{"p1"});
+    EXPECT_EQ(services.count(), 0);
+}
+
+TEST(CatalogWatcherTest, ReportsAddedAndRemovedEntries) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString root = tmp.path();
+    ASSERT_TRUE(QDir().mkpath(root + "/services/old"));
+
+    CatalogWatcher watcher(root, kDebounceMs);
+    ASSERT_TRUE(watcher.start());
+    QSignalSpy services(&watcher, &CatalogWatcher::servicesChanged);
+
+    ASSERT_TRUE(QDir(root + "/services/old").removeRecursively());
+    ASSERT_TRUE(QDir().mkpath(root + "/services/new"));
+    ASSERT_TRUE(services.wait(kWaitMs));
+
+    QStringList entries = collected(services);
+    entries.sort();
+    EXPECT_EQ(entries, (QStringList{"new", "old"}));
+}
+
+TEST(CatalogWatcherTest, AttachesCategoryCreatedAfterStart) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString root = tmp.path();
+
+    CatalogWatcher watcher(root, kDebounceMs);
+    ASSERT_TRUE(watcher.start());
+    QSignalSpy drivers(&watcher, &CatalogWatcher::driversChanged);
+
+    ASSERT_TRUE(QDir().mkpath(root + "/drivers/d1"));
+    ASSERT_TRUE(drivers.wait(kWaitMs));
+    EXPECT_EQ(collected(drivers), QStringList{"d1"});
+}
+
+TEST(CatalogWatcherTest, MarkDirtyRequeuesEntry) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    CatalogWatcher watcher(tmp.path(), kDebounceMs);
+    ASSERT_TRUE(watcher.start());
+    QSignalSpy projects(&watcher, &CatalogWatcher::projectsChanged);
+
+    watcher.markDirty(CatalogWatcher::Category::Projects, "p9");
+    watcher.markDirty(CatalogWatcher::Category::Projects, "p9");
+    ASSERT_TRUE(projects.wait(kWaitMs));
+    EXPECT_EQ(collected(projects), QStringList{"p9"});
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+
+#include "stdiolink_server/model/cron_expression.h"
+
+using namespace stdiolink_server;
+
+namespace {
+
+QDateTime local(int y, int mo, int d, int h, int mi, int s = 0) {
+    return QDateTime(QDate(y, mo, d), QTime(h, mi, s));
+}
+
+CronExpression parseOk(const QString& text) {
+    QString error;
+    const CronExpression expr = CronExpression::parse(text, error);
+    EXPECT_TRUE(expr.isValid()) << qPrintable(text) << ": " << qPrintable(error);
+    return expr;
+}
+
+} // namespace
+
+TEST(CronExpressionTest, EveryMinuteIsStrictlyAfter) {
+    const CronExpression expr = parseOk("* * * * *");
+    EXPECT_EQ(expr.nextAfter(local(2026, 3, 10, 8, 15, 0)), local(2026, 3, 10, 8, 16));
+    EXPECT_EQ(expr.nextAfter(local(2026, 3, 10, 8, 15, 59)), local(2026, 3, 10, 8, 16));
+}
+
+TEST(CronExpressionTest, StepsAndRanges) {
+    const CronExpression expr = parseOk("*/15 9-17 * * MON-FRI");
+    // 2026-03-13 为周五
+    EXPECT_EQ(expr.nextAfter(local(2026, 3, 13, 9, 1)), local(2026, 3, 13, 9, 15));
+    EXPECT_EQ(expr.nextAfter(local(2026, 3, 13, 17, 45)), local(2026, 3, 16, 9, 0));
+}
+
+TEST(CronExpressionTest, ListsAndMonthNames) {
+    const CronExpression expr = parseOk("0,30 6 1 JAN,jul *");
+    EXPECT_EQ(expr.nextAfter(local(2026, 1, 1, 6, 0)), local(2026, 1, 1, 6, 30));
+    EXPECT_EQ(expr.nextAfter(local(2026, 1, 1, 6, 30)), local(2026, 7, 1, 6, 0));
+}
+
+TEST(CronExpressionTest, DayOfMonthOrDayOfWeekWhenBothRestricted) {
+    const CronExpression expr = parseOk("0 0 15 * 0");
+    // 2026-03-10 为周二：下一个周日 03-15 恰为 15 号，再下一个为周日 03-22
+    EXPECT_EQ(expr.nextAfter(local(2026, 3, 10, 12, 0)), local(2026, 3, 15, 0, 0));
+    EXPECT_EQ(expr.nextAfter(local(2026, 3, 15, 0, 0)), local(2026, 3, 22, 0, 0));
+}
+
+TEST(CronExpressionTest, SundayAsSevenAndMacros) {
+    EXPECT_EQ(parseOk("0 0 * * 7").nextAfter(local(2026, 3, 10, 0, 0)),
+              local(2026, 3, 15, 0, 0));
+    EXPECT_EQ(parseOk("@hourly").nextAfter(local(2026, 3, 10, 8, 15)),
+              local(2026, 3, 10, 9, 0));
+    EXPECT_EQ(parseOk("@monthly").nextAfter(local(2026, 3, 10, 8, 15)),
+              local(2026, 4, 1, 0, 0));
+}
+
+TEST(CronExpressionTest, ImpossibleDateYieldsInvalid) {
+    EXPECT_FALSE(parseOk("0 0 31 2 *").nextAfter(local(2026, 1, 1, 0, 0)).isValid());
+}
+
+TEST(CronExpressionTest, RejectsMalformedExpressions) {
+    const QStringList bad = {"", "* * * *", "60 * * * *", "* 24 * * *", "* * 0 * *",
+                             "* * * 13 *", "* * * * 8", "*/0 * * * *", "5-1 * * * *",
+                             "x * * * *"};
+    for (const QString& text : bad) {
+        QString error;
+        EXPECT_FALSE(CronExpression::parse(text, error).isValid()) << qPrintable(text);
+        EXPECT_FALSE(error.isEmpty()) << qPrintable(text);
+    }
+}
@@ -61,6 +61,42 @@ TEST_F(DriverCatalogTest, GetConfig) {
     EXPECT_EQ(retrieved.args.size(), 1);
 }
 
+TEST_F(DriverCatalogTest, UpsertAndRemoveSingleDriver) {
+    DriverConfig config;
+    config.id = "test.driver";
+    config.program = "/path/v1";
+    m_catalog.upsert(config);
+    EXPECT_TRUE(m_catalog.hasDriver("test.driver"));
+
+    config.program = "/path/v2";
+    m_catalog.upsert(config);
+    EXPECT_EQ(m_catalog.listDrivers().size(), 1);
+    EXPECT_EQ(m_catalog.getConfig("test.driver").program, "/path/v2");
+
+    EXPECT_TRUE(m_catalog.remove("test.driver"));
+    EXPECT_FALSE(m_catalog.hasDriver("test.driver"));
+    EXPECT_FALSE(m_catalog.remove("test.driver"));
+}
+
+TEST_F(DriverCatalogTest, RevisionAdvancesOnEveryChange) {
+    DriverConfig config;
+    config.id = "test.driver";
+
+    quint64 rev = m_catalog.revision();
+    m_catalog.upsert(config);
+    EXPECT_GT(m_catalog.revision(), rev);
+
+    rev = m_catalog.revision();
+    EXPECT_FALSE(m_catalog.remove("missing"));
+    EXPECT_EQ(m_catalog.revision(), rev);
+    EXPECT_TRUE(m_catalog.remove("test.driver"));
+    EXPECT_GT(m_catalog.revision(), rev);
+
+    rev = m_catalog.revision();
+    m_catalog.replaceAll({{config.id, config}});
+    EXPECT_GT(m_catalog.revision(), rev);
+}
+
 TEST_F(DriverCatalogTest, GetConfigNonExistent) {
     auto config = m_catalog.getConfig("nonexistent");
     EXPECT_TRUE(config.id.isEmpty());
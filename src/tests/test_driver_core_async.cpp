@@ -282,3 +282,45 @@ TEST_F(DriverCoreAsyncTest, R10_Console_NoTerminalResponseStaysAlive) {
         << "Console mode should keep event loop alive without done/error";
     EXPECT_EQ(proc->state(), QProcess::Running);
 }
+
+// R11: KeepAlive 下单次写入的多行请求按块读取后全部按序处理。
+TEST_F(DriverCoreAsyncTest, R11_KeepAlive_BatchedLinesAllProcessed) {
+    ProcessPtr proc(startDriver("keepalive"), cleanupProcess);
+    ASSERT_NE(proc, nullptr);
+
+    constexpr int kCount = 200;
+    QByteArray batch;
+    for (int i = 0; i < kCount; ++i) {
+        batch += QJsonDocument(QJsonObject{{"cmd", "echo"}, {"data", QJsonObject{{"n", i}}}})
+                     .toJson(QJsonDocument::Compact);
+        batch += (i % 2 == 0) ? "\r\n" : "\n";
+    }
+    proc->write(batch);
+    proc->waitForBytesWritten(1000);
+
+    for (int i = 0; i < kCount; ++i) {
+        QJsonObject resp;
+        ASSERT_TRUE(readResponse(proc.get(), resp, 3000)) << "missing response " << i;
+        EXPECT_EQ(resp["status"].toString(), "done");
+        EXPECT_EQ(resp["data"].toObject()["n"].toInt(), i);
+    }
+
+    proc->closeWriteChannel();
+    ASSERT_TRUE(proc->waitForFinished(5000));
+}
+
+// R12: 末行无换行符时 EOF 仍会处理该行。
+TEST_F(DriverCoreAsyncTest, R12_KeepAlive_FinalLineWithoutNewline) {
+    ProcessPtr proc(startDriver("keepalive"), cleanupProcess);
+    ASSERT_NE(proc, nullptr);
+
+    proc->write(R"({"cmd":"echo","data":{"tail":true}})");
+    proc->waitForBytesWritten(1000);
+    proc->closeWriteChannel();
+
+    QJsonObject resp;
+    ASSERT_TRUE(readResponse(proc.get(), resp, 3000));
+    EXPECT_EQ(resp["status"].toString(), "done");
+    EXPECT_TRUE(resp["data"].toObject()["tail"].toBool());
+    ASSERT_TRUE(proc->waitForFinished(5000));
+}
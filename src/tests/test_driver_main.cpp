@@ -35,6 +35,19 @@ public:
                                QJsonObject{{"source", "async_event_once"}});
                 delete evtResp;
             });
+        } else if (cmd == "blob") {
+            // 二进制侧信道帧：附件故意包含换行和花括号，验证 Host 按长度而不是按行读取。
+            const int size = data.toObject()["size"].toInt(16);
+            QByteArray blob(size, '\0');
+            for (int i = 0; i < size; ++i) {
+                blob[i] = "{\n}\r"[i % 4];
+            }
+            r.eventBlob(0, QJsonObject{{"part", 1}}, blob.left(size / 2));
+            r.doneBlob(0, QJsonObject{{"size", size}}, blob);
+        } else if (cmd == "env") {
+            // 回报指定环境变量在 Driver 进程内是否仍可见（即其子进程能否继承）
+            const QByteArray name = data.toObject()["name"].toString().toLocal8Bit();
+            r.done(0, QJsonObject{{"set", qEnvironmentVariableIsSet(name.constData())}});
         } else if (cmd == "noop") {
             // 空操作：故意不返回响应，用于 OneShot 多行截断测试。
         } else if (cmd == "exit_now") {
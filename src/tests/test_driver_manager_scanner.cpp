@@ -137,6 +137,33 @@ TEST_F(DriverManagerScannerTest, ExportFailureMarksDirectoryFailed) {
     EXPECT_TRUE(QFileInfo::exists(dir + ".failed"));
 }
 
+TEST_F(DriverManagerScannerTest, ScanOneLeavesUnreadyDirectoryInPlace) {
+    // 增量扫描可能在安装途中触发：空目录与导出失败的目录都不应被隔离
+    const QString emptyDir = driversDir + "/installing";
+    ASSERT_TRUE(QDir().mkpath(emptyDir));
+    const QString badDir = createDriverDirWithBinary("bad", failDriverPath);
+
+    DriverManagerScanner scanner;
+    DriverManagerScanner::ScanStats stats;
+    EXPECT_FALSE(scanner.scanOne(emptyDir, true, &stats).has_value());
+    EXPECT_FALSE(scanner.scanOne(badDir, true, &stats).has_value());
+
+    EXPECT_EQ(stats.pending, 2);
+    EXPECT_EQ(stats.newlyFailed, 0);
+    EXPECT_TRUE(QFileInfo(emptyDir).isDir());
+    EXPECT_TRUE(QFileInfo(badDir).isDir());
+    EXPECT_FALSE(QFileInfo::exists(emptyDir + ".failed"));
+    EXPECT_FALSE(QFileInfo::exists(badDir + ".failed"));
+    ASSERT_EQ(stats.drivers.size(), 2);
+    EXPECT_EQ(stats.drivers.at(0).action, "pending");
+    EXPECT_EQ(stats.drivers.at(1).action, "pending");
+
+    // 全量扫描仍负责隔离
+    DriverManagerScanner::ScanStats fullStats;
+    (void)scanner.scan(driversDir, false, &fullStats);
+    EXPECT_TRUE(QFileInfo::exists(badDir + ".failed"));
+}
+
 TEST_F(DriverManagerScannerTest, RefreshFailureKeepsOldMeta) {
     const QString dir = createDriverDirWithBinary("refresh", metaDriverPath);
 
@@ -206,6 +233,59 @@ TEST_F(DriverManagerScannerTest, ValidMetaButNonConformingExeIsSkipped) {
     EXPECT_TRUE(QFileInfo::exists(dir));
 }
 
+TEST_F(DriverManagerScannerTest, RefreshSkipsUnchangedExecutable) {
+    const QString dir = createDriverDirWithBinary("cached", metaDriverPath);
+
+    DriverManagerScanner scanner;
+    DriverManagerScanner::ScanStats firstStats;
+    ASSERT_EQ(scanner.scan(driversDir, true, &firstStats).size(), 1);
+    EXPECT_EQ(firstStats.exported, 1);
+    ASSERT_TRUE(QFileInfo::exists(dir + "/" + DriverManagerScanner::kStampFileName));
+    ASSERT_EQ(firstStats.drivers.size(), 1);
+    EXPECT_EQ(firstStats.drivers[0].name, "cached");
+    EXPECT_EQ(firstStats.drivers[0].action, "exported");
+
+    DriverManagerScanner::ScanStats secondStats;
+    const auto second = scanner.scan(driversDir, true, &secondStats);
+    ASSERT_EQ(second.size(), 1);
+    EXPECT_EQ(secondStats.exported, 0);
+    EXPECT_EQ(secondStats.cacheHits, 1);
+    ASSERT_EQ(secondStats.drivers.size(), 1);
+    EXPECT_EQ(secondStats.drivers[0].action, "cached");
+
+    // 删除 stamp 后强制重新导出
+    ASSERT_TRUE(QFile::remove(dir + "/" + DriverManagerScanner::kStampFileName));
+    DriverManagerScanner::ScanStats thirdStats;
+    (void)scanner.scan(driversDir, true, &thirdStats);
+    EXPECT_EQ(thirdStats.exported, 1);
+    ASSERT_EQ(thirdStats.drivers.size(), 1);
+    EXPECT_EQ(thirdStats.drivers[0].action, "refreshed");
+}
+
+TEST_F(DriverManagerScannerTest, ParallelExportHandlesMixedResults) {
+    for (int i = 0; i < 4; ++i) {
+        createDriverDirWithBinary(QString("good%1").arg(i), metaDriverPath);
+    }
+    createDriverDirWithBinary("bad", failDriverPath);
+
+    DriverManagerScanner scanner;
+    scanner.setMaxParallelExports(3);
+    DriverManagerScanner::ScanStats stats;
+    const auto result = scanner.scan(driversDir, false, &stats);
+
+    EXPECT_EQ(stats.scanned, 5);
+    EXPECT_EQ(stats.exported, 5);
+    EXPECT_EQ(stats.updated, 4);
+    EXPECT_EQ(stats.newlyFailed, 1);
+    EXPECT_EQ(result.size(), 1);  // 同一 meta id
+    EXPECT_TRUE(QFileInfo::exists(driversDir + "/bad.failed"));
+    ASSERT_EQ(stats.drivers.size(), 5);
+    for (const auto& timing : stats.drivers) {
+        EXPECT_GE(timing.elapsedMs, 0);
+        EXPECT_EQ(timing.action, timing.name == "bad" ? "failed" : "exported");
+    }
+}
+
 TEST_F(DriverManagerScannerTest, ExportMetaFor3DScanRobotDriver) {
     if (!QFileInfo::exists(scanRobotDriverPath)) {
         GTEST_SKIP() << "stdio.drv.3d_scan_robot binary is not available in the test output directory";
@@ -0,0 +1,175 @@
+#include <QJsonObject>
+#include <gtest/gtest.h>
+#include "stdiolink/host/driver.h"
+#include "stdiolink/host/driver_pool.h"
+#include "stdiolink/platform/platform_utils.h"
+
+using namespace stdiolink;
+
+namespace {
+
+const QString kTestDriver = PlatformUtils::executablePath(".", "test_driver");
+const QStringList kKeepalive{"--profile=keepalive"};
+
+bool echoOnce(Driver& driver) {
+    Task task = driver.request("echo", QJsonObject{{"v", 1}});
+    Message msg;
+    return task.waitNext(msg, 5000) && msg.status == "done";
+}
+
+} // namespace
+
+TEST(DriverPool, ReleasedDriverIsReused) {
+    DriverPool pool;
+    QString error;
+    std::unique_ptr<Driver> first = pool.acquire(kTestDriver, kKeepalive, &error);
+    ASSERT_NE(first, nullptr) << qPrintable(error);
+    ASSERT_TRUE(echoOnce(*first));
+    const Driver* firstPtr = first.get();
+    pool.release(std::move(first));
+
+    DriverPool::Stats stats = pool.stats(kTestDriver, kKeepalive);
+    EXPECT_EQ(stats.idle, 1);
+    EXPECT_EQ(stats.leased, 0);
+
+    std::unique_ptr<Driver> second = pool.acquire(kTestDriver, kKeepalive);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(second.get(), firstPtr);
+    EXPECT_TRUE(echoOnce(*second));
+
+    stats = pool.stats(kTestDriver, kKeepalive);
+    EXPECT_EQ(stats.created, 1);
+    EXPECT_EQ(stats.reused, 1);
+    EXPECT_EQ(stats.leased, 1);
+    pool.release(std::move(second));
+}
+
+TEST(DriverPool, ConfigurePrewarmsMinWarm) {
+    DriverPool pool;
+    DriverPool::Options options;
+    options.minWarm = 2;
+    ASSERT_TRUE(pool.configure(kTestDriver, kKeepalive, options));
+
+    DriverPool::Stats stats = pool.stats(kTestDriver, kKeepalive);
+    EXPECT_EQ(stats.idle, 2);
+    EXPECT_EQ(stats.created, 2);
+
+    std::unique_ptr<Driver> driver = pool.acquire(kTestDriver, kKeepalive);
+    ASSERT_NE(driver, nullptr);
+    EXPECT_TRUE(echoOnce(*driver));
+    stats = pool.stats(kTestDriver, kKeepalive);
+    EXPECT_EQ(stats.created, 2);
+    EXPECT_EQ(stats.reused, 1);
+    pool.release(std::move(driver));
+}
+
+TEST(DriverPool, BusyDriverIsDiscardedOnRelease) {
+    DriverPool pool;
+    std::unique_ptr<Driver> driver = pool.acquire(kTestDriver, kKeepalive);
+    ASSERT_NE(driver, nullptr);
+    // noop 不返回响应，归还时仍有在途请求
+    driver->request("noop", QJsonObject{});
+    pool.release(std::move(driver));
+
+    const DriverPool::Stats stats = pool.stats(kTestDriver, kKeepalive);
+    EXPECT_EQ(stats.idle, 0);
+    EXPECT_EQ(stats.discarded, 1);
+}
+
+TEST(DriverPool, ReleaseTerminatesOutstandingTask) {
+    DriverPool pool;
+    std::unique_ptr<Driver> driver = pool.acquire(kTestDriver, kKeepalive);
+    ASSERT_NE(driver, nullptr);
+    Task pending = driver->request("noop", QJsonObject{});
+    ASSERT_EQ(pending.owner(), driver.get());
+
+    // 归还后实例被丢弃（仍有在途请求），句柄不得再访问它
+    pool.release(std::move(driver));
+    EXPECT_EQ(pending.owner(), nullptr);
+    EXPECT_TRUE(pending.isDone());
+
+    Message msg;
+    ASSERT_TRUE(pending.tryNext(msg));
+    EXPECT_EQ(msg.status, "error");
+    EXPECT_EQ(msg.code, 1001);
+    EXPECT_EQ(pending.errorText(), "lease released");
+    EXPECT_FALSE(pending.waitNext(msg, 100));
+}
+
+TEST(DriverPool, TaskFromPreviousLeaseDoesNotTouchReusedDriver) {
+    DriverPool pool;
+    std::unique_ptr<Driver> driver = pool.acquire(kTestDriver, kKeepalive);
+    ASSERT_NE(driver, nullptr);
+    Task finished = driver->request("echo", QJsonObject{{"v", 1}});
+    Message msg;
+    ASSERT_TRUE(finished.waitNext(msg, 5000));
+    pool.release(std::move(driver));
+
+    std::unique_ptr<Driver> reused = pool.acquire(kTestDriver, kKeepalive);
+    ASSERT_NE(reused, nullptr);
+    EXPECT_EQ(finished.owner(), nullptr);
+    EXPECT_EQ(finished.exitCode(), 0);
+    EXPECT_FALSE(finished.tryNext(msg));
+    EXPECT_TRUE(echoOnce(*reused));
+    pool.release(std::move(reused));
+}
+
+TEST(DriverPool, ExitedDriverIsDiscardedOnRelease) {
+    DriverPool pool;
+    std::unique_ptr<Driver> driver = pool.acquire(kTestDriver, kKeepalive);
+    ASSERT_NE(driver, nullptr);
+    Task task = driver->request("exit_now", QJsonObject{});
+    Message msg;
+    task.waitNext(msg, 5000);
+    driver->process()->waitForFinished(2000);
+    pool.release(std::move(driver));
+
+    const DriverPool::Stats stats = pool.stats(kTestDriver, kKeepalive);
+    EXPECT_EQ(stats.idle, 0);
+    EXPECT_EQ(stats.discarded, 1);
+}
+
+TEST(DriverPool, StaleIdleDriverPassesHealthProbe) {
+    DriverPool pool;
+    DriverPool::Options options;
+    options.healthCheckAfterIdleMs = 0;  // 每次租出前都探活
+    pool.configure(kTestDriver, kKeepalive, options);
+
+    std::unique_ptr<Driver> driver = pool.acquire(kTestDriver, kKeepalive);
+    ASSERT_NE(driver, nullptr);
+    pool.release(std::move(driver));
+
+    // test_driver 未实现元数据，meta.describe 返回 error 也应视为健康
+    driver = pool.acquire(kTestDriver, kKeepalive);
+    ASSERT_NE(driver, nullptr);
+    EXPECT_TRUE(echoOnce(*driver));
+    EXPECT_EQ(pool.stats(kTestDriver, kKeepalive).reused, 1);
+    pool.release(std::move(driver));
+}
+
+TEST(DriverPool, MaxWarmCapsIdleInstances) {
+    DriverPool pool;
+    DriverPool::Options options;
+    options.maxWarm = 1;
+    pool.configure(kTestDriver, kKeepalive, options);
+
+    std::unique_ptr<Driver> a = pool.acquire(kTestDriver, kKeepalive);
+    std::unique_ptr<Driver> b = pool.acquire(kTestDriver, kKeepalive);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    pool.release(std::move(a));
+    pool.release(std::move(b));
+
+    const DriverPool::Stats stats = pool.stats(kTestDriver, kKeepalive);
+    EXPECT_EQ(stats.idle, 1);
+    EXPECT_EQ(stats.discarded, 1);
+}
+
+TEST(DriverPool, AcquireFailureReportsError) {
+    DriverPool pool;
+    QString error;
+    std::unique_ptr<Driver> driver =
+        pool.acquire("/nonexistent/stdio.drv.missing", kKeepalive, &error);
+    EXPECT_EQ(driver, nullptr);
+    EXPECT_FALSE(error.isEmpty());
+}
@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <QCoreApplication>
+#include <QHostAddress>
 #include <QJsonObject>
+#include <QStringList>
+#include <QTcpServer>
+#include <QTcpSocket>
 #include <QVector>
 
 #include "stdiolink_server/http/event_bus.h"
@@ -9,6 +13,18 @@
 
 using namespace stdiolink_server;
 
+namespace {
+
+QStringList s_warnings;
+
+void captureWarning(QtMsgType type, const QMessageLogContext&, const QString& msg) {
+    if (type == QtWarningMsg) {
+        s_warnings.append(msg);
+    }
+}
+
+} // namespace
+
 // ---------------------------------------------------------------------------
 // EventBus
 // ---------------------------------------------------------------------------
@@ -96,7 +112,13 @@ TEST(EventBusTest, HandlerInitialConnectionCountIsZero) {
 }
 
 TEST(EventBusTest, MaxSseConnectionsConstant) {
-    EXPECT_EQ(EventStreamHandler::kMaxSseConnections, 32);
+    EXPECT_EQ(EventStreamHandler::kMaxSseConnections, 512);
+}
+
+TEST(EventBusTest, HandlerMaxConnectionsConfigurable) {
+    EventBus bus;
+    EventStreamHandler handler(&bus, QStringLiteral("*"), 2048);
+    EXPECT_EQ(handler.maxConnections(), 2048);
 }
 
 // M72_R14 — SSE disconnect recovery: constant invariants
@@ -106,3 +128,125 @@ TEST(EventBusTest, M72_R14_SseTimeoutConstants) {
     EXPECT_GE(EventStreamHandler::kConnectionTimeoutMs,
               EventStreamHandler::kHeartbeatIntervalMs);
 }
+
+// ---------------------------------------------------------------------------
+// Shared frames, bounded queues and Last-Event-ID replay
+// ---------------------------------------------------------------------------
+
+TEST(EventBusTest, FormatFrameIncludesIdWhenGiven) {
+    const QByteArray frame = EventStreamConnection::formatFrame(
+        "instance.started", QJsonObject{{"instanceId", "abc"}}, "e-7");
+    EXPECT_EQ(frame, QByteArray("id: e-7\nevent: instance.started\n"
+                                "data: {\"instanceId\":\"abc\"}\n\n"));
+    EXPECT_FALSE(EventStreamConnection::formatFrame("reset", QJsonObject{}).contains("id:"));
+}
+
+TEST(EventBusTest, FrameQueueDropsOldestWhenFull) {
+    EventFrameQueue queue(2);
+    queue.push("a");
+    queue.push("b");
+    queue.push("c");
+    EXPECT_EQ(queue.size(), 2);
+    EXPECT_EQ(queue.takeDropped(), 1);
+    EXPECT_EQ(queue.takeDropped(), 0);
+    EXPECT_EQ(queue.totalDropped(), 1);
+    EXPECT_EQ(queue.takeUpTo(1024), QByteArray("bc"));
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.queuedBytes(), 0);
+}
+
+TEST(EventBusTest, FrameQueueTakeRespectsByteBudget) {
+    EventFrameQueue queue(8);
+    queue.push("aaaa");
+    queue.push("bbbb");
+    queue.push("cccc");
+    EXPECT_EQ(queue.takeUpTo(9), QByteArray("aaaabbbb"));
+    // 单帧超过上限时仍整帧取出，避免卡住
+    EXPECT_EQ(queue.takeUpTo(2), QByteArray("cccc"));
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(EventBusTest, FrameQueueSharesFrameData) {
+    const QByteArray frame("payload");
+    EventFrameQueue queue(4);
+    queue.push(frame);
+    const QByteArray out = queue.takeUpTo(1024);
+    EXPECT_EQ(out.constData(), frame.constData());
+}
+
+TEST(EventBusTest, ReplayReturnsFramesAfterLastEventId) {
+    EventBus bus;
+    EventStreamHandler handler(&bus);
+    bus.publish("instance.started", QJsonObject{{"instanceId", "a"}});
+    const QString firstId = handler.lastEventId();
+    bus.publish("schedule.triggered", QJsonObject{{"projectId", "p"}});
+    bus.publish("instance.finished", QJsonObject{{"instanceId", "a"}});
+
+    QVector<QByteArray> frames;
+    ASSERT_TRUE(handler.replayFramesSince(firstId, {}, frames));
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_TRUE(frames[0].contains("event: schedule.triggered"));
+    EXPECT_TRUE(frames[1].contains("event: instance.finished"));
+
+    ASSERT_TRUE(handler.replayFramesSince(firstId, {"instance"}, frames));
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_TRUE(frames[0].contains("id: " + handler.lastEventId().toUtf8()));
+
+    ASSERT_TRUE(handler.replayFramesSince(handler.lastEventId(), {}, frames));
+    EXPECT_TRUE(frames.isEmpty());
+}
+
+TEST(EventBusTest, ReplayRejectsForeignOrExpiredIds) {
+    EventBus bus;
+    EventStreamHandler handler(&bus);
+    bus.publish("instance.started", QJsonObject{});
+    const QString firstId = handler.lastEventId();
+
+    QVector<QByteArray> frames;
+    EXPECT_FALSE(handler.replayFramesSince("otherepoch-1", {}, frames));
+    EXPECT_FALSE(handler.replayFramesSince("garbage", {}, frames));
+
+    for (int i = 0; i < EventStreamHandler::kReplayBufferSize + 1; ++i) {
+        bus.publish("instance.started", QJsonObject{});
+    }
+    EXPECT_FALSE(handler.replayFramesSince(firstId, {}, frames));
+}
+
+TEST(EventBusTest, FindPeerSocketLocatesAcceptedConnection) {
+    QTcpServer listener;
+    ASSERT_TRUE(listener.listen(QHostAddress::LocalHost, 0));
+    QTcpSocket client;
+    client.connectToHost(QHostAddress::LocalHost, listener.serverPort());
+    ASSERT_TRUE(listener.waitForNewConnection(3000));
+    ASSERT_TRUE(client.waitForConnected(3000));
+
+    // 依赖接受的套接字是 QTcpServer 的直接子对象；Qt 改变该行为时此处失败
+    QAbstractSocket* socket = EventStreamHandler::findPeerSocket(
+        {&listener}, client.localAddress(), client.localPort());
+    ASSERT_NE(socket, nullptr);
+    EXPECT_EQ(socket->peerPort(), client.localPort());
+}
+
+TEST(EventBusTest, FindPeerSocketWarnsWhenLookupFails) {
+    QTcpServer listener;
+    ASSERT_TRUE(listener.listen(QHostAddress::LocalHost, 0));
+    QTcpSocket client;
+    client.connectToHost(QHostAddress::LocalHost, listener.serverPort());
+    ASSERT_TRUE(listener.waitForNewConnection(3000));
+    ASSERT_TRUE(client.waitForConnected(3000));
+
+    s_warnings.clear();
+    const QtMessageHandler previous = qInstallMessageHandler(captureWarning);
+    const quint16 otherPort = static_cast<quint16>(client.localPort() + 1);
+    QAbstractSocket* unknownPeer = EventStreamHandler::findPeerSocket(
+        {&listener}, client.localAddress(), otherPort);
+    QAbstractSocket* noListener = EventStreamHandler::findPeerSocket(
+        {}, client.localAddress(), client.localPort());
+    qInstallMessageHandler(previous);
+
+    // 找不到时退化为无背压，但必须留下日志
+    EXPECT_EQ(unknownPeer, nullptr);
+    EXPECT_EQ(noListener, nullptr);
+    ASSERT_EQ(s_warnings.size(), 2);
+    EXPECT_TRUE(s_warnings.front().contains("backpressure disabled"));
+}
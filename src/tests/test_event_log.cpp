@@ -11,6 +11,7 @@
 
 #include "stdiolink_server/http/event_bus.h"
 #include "stdiolink_server/http/event_log.h"
+#include "stdiolink_server/http/event_store.h"
 
 using namespace stdiolink_server;
 
@@ -158,3 +159,124 @@ TEST_F(EventLogTest, FileRotation) {
     EXPECT_TRUE(QFile::exists(rotatedPath))
         << "Rotated file should exist at: " << rotatedPath.toStdString();
 }
+
+TEST_F(EventLogTest, QueryResultsCarrySeqCursor) {
+    EventBus bus;
+    EventLog log(m_logPath, &bus);
+
+    for (int i = 0; i < 5; ++i) {
+        bus.publish("event.x", QJsonObject{{"i", i}});
+    }
+    EXPECT_EQ(log.latestSeq(), 5);
+
+    const QJsonArray page1 = log.query(2);
+    ASSERT_EQ(page1.size(), 2);
+    EXPECT_EQ(page1[0].toObject().value("seq").toInteger(), 5);
+    EXPECT_EQ(page1[1].toObject().value("seq").toInteger(), 4);
+
+    EventQuery q;
+    q.limit = 2;
+    q.before = page1[1].toObject().value("seq").toInteger();
+    const QJsonArray page2 = log.query(q);
+    ASSERT_EQ(page2.size(), 2);
+    EXPECT_EQ(page2[0].toObject().value("data").toObject().value("i").toInt(), 2);
+    EXPECT_EQ(page2[1].toObject().value("data").toObject().value("i").toInt(), 1);
+
+    EventQuery newer;
+    newer.since = 3;
+    const QJsonArray tail = log.query(newer);
+    ASSERT_EQ(tail.size(), 2);
+    EXPECT_EQ(tail[1].toObject().value("seq").toInteger(), 4);
+}
+
+// 超出内存环形缓冲的事件通过磁盘索引查询
+TEST_F(EventLogTest, StoreQueriesOlderEventsFromIndexedSegments) {
+    EventStore store(m_logPath, 5 * 1024 * 1024, 2, 8);
+    const QDateTime base = QDateTime::currentDateTimeUtc();
+    for (int i = 0; i < 300; ++i) {
+        const QString project = (i % 3 == 0) ? "pA" : "pB";
+        store.append(i % 2 == 0 ? "instance.started" : "schedule.triggered",
+                     QJsonObject{{"i", i}, {"projectId", project}}, base.addMSecs(i));
+    }
+
+    EventQuery q;
+    q.limit = 3;
+    q.before = 100;
+    q.projectId = "pA";
+    q.typePrefix = "instance";
+    const QJsonArray results = store.query(q);
+    ASSERT_EQ(results.size(), 3);
+    // seq = i + 1；满足 i%3==0 且 i%2==0 且 seq<100 的最新三条为 i=96,90,84
+    EXPECT_EQ(results[0].toObject().value("data").toObject().value("i").toInt(), 96);
+    EXPECT_EQ(results[1].toObject().value("data").toObject().value("i").toInt(), 90);
+    EXPECT_EQ(results[2].toObject().value("data").toObject().value("i").toInt(), 84);
+    EXPECT_EQ(results[0].toObject().value("seq").toInteger(), 97);
+
+    EventQuery window;
+    window.limit = 100;
+    window.fromMs = base.addMSecs(10).toMSecsSinceEpoch();
+    window.toMs = base.addMSecs(12).toMSecsSinceEpoch();
+    EXPECT_EQ(store.query(window).size(), 3);
+
+    EXPECT_TRUE(QFile::exists(m_logPath + ".idx"));
+}
+
+TEST_F(EventLogTest, StoreRecoversSeqAfterRestart) {
+    {
+        EventStore store(m_logPath, 5 * 1024 * 1024, 2);
+        for (int i = 0; i < 70; ++i) {
+            store.append("event.x", QJsonObject{{"i", i}}, QDateTime::currentDateTimeUtc());
+        }
+    }
+
+    EventStore reopened(m_logPath, 5 * 1024 * 1024, 2);
+    EXPECT_EQ(reopened.latestSeq(), 70);
+    EXPECT_EQ(reopened.append("event.y", QJsonObject{}, QDateTime::currentDateTimeUtc()), 71);
+
+    EventQuery q;
+    q.limit = 2;
+    q.before = 70;
+    const QJsonArray results = reopened.query(q);
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0].toObject().value("data").toObject().value("i").toInt(), 68);
+}
+
+// 旧版（spdlog 写出、无索引）的日志文件在启动时补建索引
+TEST_F(EventLogTest, StoreIndexesLegacyLogWithoutSidecar) {
+    {
+        QFile file(m_logPath);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        for (int i = 0; i < 3; ++i) {
+            QJsonObject record{{"type", "legacy.event"},
+                               {"data", QJsonObject{{"i", i}}},
+                               {"ts", QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs)}};
+            file.write(QJsonDocument(record).toJson(QJsonDocument::Compact) + "\n");
+        }
+        file.write("{\"type\":\"half");  // 崩溃留下的半行
+    }
+
+    EventStore store(m_logPath, 5 * 1024 * 1024, 2);
+    EXPECT_EQ(store.latestSeq(), 3);
+    store.append("event.new", QJsonObject{}, QDateTime::currentDateTimeUtc());
+
+    EventQuery q;
+    const QJsonArray results = store.query(q);
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_EQ(results[0].toObject().value("type").toString(), "event.new");
+    EXPECT_EQ(results[3].toObject().value("data").toObject().value("i").toInt(), 0);
+}
+
+TEST_F(EventLogTest, RotatedOutEventsAreNotReturned) {
+    EventStore store(m_logPath, 512, 1);
+    for (int i = 0; i < 40; ++i) {
+        store.append("event.x", QJsonObject{{"i", i}}, QDateTime::currentDateTimeUtc());
+    }
+    const qint64 oldest = store.oldestSeq();
+    EXPECT_GT(oldest, 1);
+
+    EventQuery q;
+    q.limit = 1000;
+    const QJsonArray results = store.query(q);
+    EXPECT_EQ(results.size(), store.latestSeq() - oldest + 1);
+    EXPECT_EQ(results.last().toObject().value("seq").toInteger(), oldest);
+}
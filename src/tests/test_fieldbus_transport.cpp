@@ -0,0 +1,237 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+#include <gtest/gtest.h>
+#include "stdiolink/driver/fieldbus_transport.h"
+
+using namespace stdiolink;
+
+namespace {
+
+struct FakeLink {
+    bool alive = true;
+    bool probeOk = true;
+    int probes = 0;
+};
+
+using FakePool = FieldbusPool<FakeLink>;
+
+FakePool::ClientOpener opener(int* opens, bool succeed = true) {
+    return [opens, succeed](QString& error) -> std::shared_ptr<FakeLink> {
+        ++*opens;
+        if (!succeed) {
+            error = "Failed to open fake";
+            return nullptr;
+        }
+        return std::make_shared<FakeLink>();
+    };
+}
+
+std::unique_ptr<FakePool> makePool(const FieldbusTransport::Options& options) {
+    auto pool = std::make_unique<FakePool>([](FakeLink& link) { return link.alive; }, options);
+    pool->setProbe([](FakeLink& link) {
+        ++link.probes;
+        return link.probeOk;
+    });
+    return pool;
+}
+
+void drainEvents(int rounds = 20) {
+    for (int i = 0; i < rounds; ++i) {
+        QCoreApplication::processEvents();
+    }
+}
+
+} // namespace
+
+TEST(FieldbusTransport, ReleasedLinkIsReused) {
+    auto pool = makePool({});
+    int opens = 0;
+    QString error;
+
+    FakeLink* first = nullptr;
+    {
+        auto lease = pool->acquire("dev", "9600", opener(&opens), error);
+        ASSERT_TRUE(lease) << qPrintable(error);
+        first = lease.get();
+    }
+    auto lease = pool->acquire("dev", "9600", opener(&opens), error);
+    ASSERT_TRUE(lease);
+    EXPECT_EQ(lease.get(), first);
+    EXPECT_EQ(opens, 1);
+    lease.release();
+
+    const FieldbusStats stats = pool->stats("dev");
+    EXPECT_EQ(stats.opens, 1);
+    EXPECT_EQ(stats.transactions, 2);
+    EXPECT_EQ(stats.rttBuckets[0], 2);
+}
+
+TEST(FieldbusTransport, DifferentSignatureIsRejectedWhileOpen) {
+    auto pool = makePool({});
+    int opens = 0;
+    QString error;
+
+    auto lease = pool->acquire("COM1", "9600,8,1,none", opener(&opens), error);
+    ASSERT_TRUE(lease);
+    auto other = pool->acquire("COM1", "19200,8,1,none", opener(&opens), error);
+    EXPECT_FALSE(other);
+    EXPECT_TRUE(error.contains("COM1"));
+    EXPECT_TRUE(error.contains("different parameters"));
+    EXPECT_EQ(opens, 1);
+}
+
+TEST(FieldbusTransport, DeadLinkIsReopenedAndCounted) {
+    auto pool = makePool({});
+    int opens = 0;
+    QString error;
+
+    {
+        auto lease = pool->acquire("dev", QString(), opener(&opens), error);
+        ASSERT_TRUE(lease);
+        lease->alive = false;  // 使用中断开，归还时丢弃
+    }
+    auto lease = pool->acquire("dev", QString(), opener(&opens), error);
+    ASSERT_TRUE(lease);
+    EXPECT_TRUE(lease->alive);
+    EXPECT_EQ(opens, 2);
+    EXPECT_EQ(pool->stats("dev").linkErrors, 1);
+}
+
+TEST(FieldbusTransport, IdleLinkIsProbedBeforeReuse) {
+    FieldbusTransport::Options options;
+    options.probeAfterIdleMs = 0;
+    auto pool = makePool(options);
+    int opens = 0;
+    QString error;
+
+    FakeLink* first = nullptr;
+    {
+        auto lease = pool->acquire("dev", QString(), opener(&opens), error);
+        ASSERT_TRUE(lease);
+        first = lease.get();
+        first->probeOk = false;
+    }
+    auto lease = pool->acquire("dev", QString(), opener(&opens), error);
+    ASSERT_TRUE(lease);
+    EXPECT_NE(lease.get(), first);
+    EXPECT_EQ(opens, 2);
+    EXPECT_EQ(pool->stats("dev").probeFailures, 1);
+}
+
+TEST(FieldbusTransport, FailedOpenBacksOffExponentially) {
+    FieldbusTransport::Options options;
+    options.reconnectBackoffMs = 50;
+    options.maxReconnectBackoffMs = 80;
+    auto pool = makePool(options);
+    int opens = 0;
+    QString error;
+
+    EXPECT_FALSE(pool->acquire("dev", QString(), opener(&opens, false), error));
+    EXPECT_EQ(error, "Failed to open fake");
+
+    // 退避期内不再调用 opener，错误文本保持原样（订阅按文本判断错误是否变化），
+    // 剩余退避单独查询
+    EXPECT_FALSE(pool->acquire("dev", QString(), opener(&opens, false), error));
+    EXPECT_EQ(error, "Failed to open fake");
+    EXPECT_EQ(opens, 1);
+    EXPECT_GT(pool->reconnectInMs("dev"), 0);
+    EXPECT_LE(pool->reconnectInMs("dev"), 50);
+    EXPECT_TRUE(pool->statsJson()["dev"].toObject().contains("reconnect_in_ms"));
+
+    QThread::msleep(60);
+    EXPECT_EQ(pool->reconnectInMs("dev"), 0);
+    EXPECT_FALSE(pool->acquire("dev", QString(), opener(&opens, false), error));
+    EXPECT_EQ(error, "Failed to open fake");
+    EXPECT_EQ(opens, 2);
+
+    // 第二次退避翻倍但受上限约束
+    QThread::msleep(90);
+    auto lease = pool->acquire("dev", QString(), opener(&opens), error);
+    EXPECT_TRUE(lease);
+    EXPECT_EQ(opens, 3);
+    EXPECT_EQ(pool->stats("dev").openFailures, 2);
+}
+
+TEST(FieldbusTransport, IdleLinksAreClosedButLeasedOnesAreKept) {
+    FieldbusTransport::Options options;
+    options.idleCloseMs = 20;
+    auto pool = makePool(options);
+    int opens = 0;
+    QString error;
+
+    pool->acquire("idle", QString(), opener(&opens), error).release();
+    auto busy = pool->acquire("busy", QString(), opener(&opens), error);
+    ASSERT_TRUE(busy);
+
+    QThread::msleep(30);
+    EXPECT_EQ(pool->closeIdle(), 1);
+    EXPECT_EQ(pool->stats("idle").idleCloses, 1);
+    EXPECT_EQ(pool->stats("busy").idleCloses, 0);
+
+    const QJsonObject json = pool->statsJson();
+    EXPECT_FALSE(json["idle"].toObject()["open"].toBool());
+    EXPECT_TRUE(json["busy"].toObject()["open"].toBool());
+    EXPECT_EQ(json["busy"].toObject()["leases"].toInt(), 1);
+}
+
+TEST(FieldbusTransport, PostedTasksRunByPriorityThenFifoAcrossEndpoints) {
+    auto pool = makePool({});
+    QStringList order;
+
+    pool->post("a", FieldbusTransport::Priority::Low, [&]() { order << "a-low"; });
+    pool->post("a", FieldbusTransport::Priority::Normal, [&]() { order << "a-n1"; });
+    pool->post("a", FieldbusTransport::Priority::Normal, [&]() { order << "a-n2"; });
+    pool->post("b", FieldbusTransport::Priority::Low, [&]() { order << "b-low"; });
+    pool->post("a", FieldbusTransport::Priority::High, [&]() { order << "a-high"; });
+    EXPECT_EQ(pool->queueDepth("a"), 4);
+    EXPECT_EQ(pool->queueDepth("b"), 1);
+
+    // 每次事件循环只执行一个任务
+    QCoreApplication::processEvents();
+    EXPECT_EQ(order.size(), 1);
+
+    drainEvents();
+    EXPECT_EQ(order, (QStringList{"a-high", "b-low", "a-n1", "a-n2", "a-low"}));
+    EXPECT_EQ(pool->queueDepth("a"), 0);
+    EXPECT_EQ(pool->stats("a").maxQueueDepth, 4);
+}
+
+TEST(FieldbusTransport, RoundTripHistogramBuckets) {
+    FieldbusStats stats;
+    stats.recordRoundTrip(500);        // <= 1ms
+    stats.recordRoundTrip(1000);       // <= 1ms（上界含等于）
+    stats.recordRoundTrip(7000);       // <= 10ms
+    stats.recordRoundTrip(5000000);    // > 2000ms
+
+    EXPECT_EQ(stats.transactions, 4);
+    EXPECT_EQ(stats.rttBuckets[0], 2);
+    EXPECT_EQ(stats.rttBuckets[3], 1);
+    EXPECT_EQ(stats.rttBuckets[FieldbusStats::kRttBucketCount - 1], 1);
+    EXPECT_EQ(stats.rttMaxUs, 5000000);
+
+    const QJsonObject json = stats.toJson();
+    const QJsonObject histogram = json["rtt_histogram_ms"].toObject();
+    EXPECT_EQ(histogram["le_1"].toInt(), 2);
+    EXPECT_EQ(histogram["gt_2000"].toInt(), 1);
+    EXPECT_EQ(json["rtt_avg_us"].toInteger(), (500 + 1000 + 7000 + 5000000) / 4);
+}
+
+TEST(FieldbusPacer, WaitsOnlyForRemainingGap) {
+    FieldbusPacer pacer(20000);
+
+    // 尚无上一帧时按完整间隔等待
+    QElapsedTimer timer;
+    timer.start();
+    EXPECT_EQ(pacer.waitForGap(), 20000);
+    EXPECT_GE(timer.elapsed(), 19);
+
+    pacer.markFrameEnd();
+    QThread::msleep(25);
+    EXPECT_EQ(pacer.waitForGap(), 0);
+
+    pacer.markFrameEnd();
+    const qint64 waited = pacer.waitForGap();
+    EXPECT_GT(waited, 0);
+    EXPECT_LE(waited, 20000);
+}
@@ -1,10 +1,14 @@
 #include <QCoreApplication>
+#include <QDir>
 #include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonArray>
 #include <QJsonObject>
 #include <gtest/gtest.h>
 #include "stdiolink/host/driver.h"
 #include "stdiolink/host/task.h"
 #include "stdiolink/platform/platform_utils.h"
+#include "stdiolink/protocol/jsonl_types.h"
 
 using namespace stdiolink;
 
@@ -249,3 +253,123 @@ TEST_F(DriverIntegrationTest, TryNextReturnsErrorWhenDriverAlreadyExited) {
     EXPECT_EQ(t.exitCode(), 1001);
     EXPECT_TRUE(msg.payload.toObject().value("message").toString().contains("program="));
 }
+
+TEST_F(DriverIntegrationTest, PipelinedRequestsCompleteOutOfOrder) {
+    Driver d;
+    ASSERT_TRUE(d.start(m_driverPath, {"--profile=keepalive"}));
+    d.setPipeliningEnabled(true);
+
+    Task slow = d.request("timer_echo", QJsonObject{{"delay", 300}});
+    Task fast = d.request("echo", QJsonObject{{"msg", "fast"}});
+    EXPECT_EQ(d.inFlightCount(), 2);
+
+    Message msg;
+    ASSERT_TRUE(fast.waitNext(msg, 5000));
+    EXPECT_EQ(msg.status, "done");
+    EXPECT_EQ(msg.payload.toObject().value("msg").toString(), "fast");
+    EXPECT_FALSE(slow.isDone());
+
+    ASSERT_TRUE(slow.waitNext(msg, 5000));
+    EXPECT_EQ(msg.status, "done");
+    EXPECT_TRUE(msg.payload.toObject().value("timer_fired").toBool());
+    EXPECT_EQ(d.inFlightCount(), 0);
+
+    d.terminate();
+}
+
+TEST_F(DriverIntegrationTest, NonPipelinedRequestSupersedesPrevious) {
+    Driver d;
+    ASSERT_TRUE(d.start(m_driverPath, {"--profile=keepalive"}));
+
+    Task first = d.request("noop");
+    Task second = d.request("echo", QJsonObject{{"msg", "x"}});
+    EXPECT_EQ(d.inFlightCount(), 1);
+
+    Message msg;
+    ASSERT_TRUE(second.waitNext(msg, 5000));
+    EXPECT_EQ(msg.status, "done");
+    // 终态消息必须是第二个请求自己的回显，而不是被取代请求的残留输出
+    EXPECT_EQ(msg.payload.toObject().value("msg").toString(), "x");
+    EXPECT_EQ(second.finalPayload().toObject().value("msg").toString(), "x");
+    EXPECT_FALSE(first.tryNext(msg));
+
+    d.terminate();
+}
+
+TEST_F(DriverIntegrationTest, BlobFramesCarryRawBytes) {
+    Driver d;
+    ASSERT_TRUE(d.start(m_driverPath, {"--profile=keepalive"}));
+
+    Task t = d.request("blob", QJsonObject{{"size", 200000}});
+
+    Message msg;
+    ASSERT_TRUE(t.waitNext(msg, 5000));
+    EXPECT_EQ(msg.status, "event");
+    EXPECT_EQ(msg.blob.size(), 100000);
+
+    ASSERT_TRUE(t.waitNext(msg, 5000));
+    EXPECT_EQ(msg.status, "done");
+    EXPECT_EQ(msg.payload.toObject().value("size").toInt(), 200000);
+    ASSERT_EQ(msg.blob.size(), 200000);
+    EXPECT_EQ(msg.blob.left(4), QByteArray("{\n}\r"));
+    EXPECT_FALSE(msg.payload.toObject().contains("blob_base64"));
+    EXPECT_EQ(t.finalBlob(), msg.blob);
+
+    // 附件之后的帧仍按行正常分帧
+    Task next = d.request("echo", QJsonObject{{"msg", "after"}});
+    ASSERT_TRUE(next.waitNext(msg, 5000));
+    EXPECT_EQ(msg.payload.toObject().value("msg").toString(), "after");
+    EXPECT_TRUE(msg.blob.isEmpty());
+
+    d.terminate();
+}
+
+TEST_F(DriverIntegrationTest, BlobFramesEnvIsNotInheritedByGrandchildren) {
+    Driver d;
+    ASSERT_TRUE(d.start(m_driverPath, {"--profile=keepalive"}));
+
+    Task t = d.request("env", QJsonObject{{"name", QString::fromLatin1(kBlobFramesEnvVar)}});
+    Message msg;
+    ASSERT_TRUE(t.waitNext(msg, 5000));
+    EXPECT_EQ(msg.status, "done");
+    EXPECT_FALSE(msg.payload.toObject().value("set").toBool(true));
+
+    // 变量已清除，但协商结果仍然有效
+    Task blob = d.request("blob", QJsonObject{{"size", 8}});
+    ASSERT_TRUE(blob.waitNext(msg, 5000));
+    EXPECT_EQ(msg.blob.size(), 4);
+
+    d.terminate();
+}
+
+TEST_F(DriverIntegrationTest, ModbusSubscribeRequiresRequestId) {
+    const QString modbusPath = PlatformUtils::executablePath(
+        QDir(QCoreApplication::applicationDirPath()).filePath("../data_root/drivers/stdio.drv.modbustcp"),
+        "stdio.drv.modbustcp");
+    if (!QFileInfo::exists(modbusPath)) {
+        GTEST_SKIP() << "stdio.drv.modbustcp not built";
+    }
+
+    Driver d;
+    ASSERT_TRUE(d.start(modbusPath, {"--profile=keepalive"}));
+    const QJsonObject params{
+        {"host", "127.0.0.1"}, {"port", 1}, {"timeout", 500},
+        {"tags", QJsonArray{QJsonObject{{"name", "t"}, {"address", 0}}}}};
+
+    // 非流水线模式请求不带 ID，订阅的事件帧无法归属，应直接拒绝且不建立连接
+    Task rejected = d.request("subscribe", params);
+    Message msg;
+    ASSERT_TRUE(rejected.waitNext(msg, 5000));
+    EXPECT_EQ(msg.status, "error");
+    EXPECT_EQ(msg.code, 3);
+    EXPECT_TRUE(msg.payload.toObject().value("message").toString().contains("request id"));
+
+    // 开启流水线后通过 ID 校验，进入连接阶段（端口不可达，返回连接错误）
+    d.setPipeliningEnabled(true);
+    Task accepted = d.request("subscribe", params);
+    ASSERT_TRUE(accepted.waitNext(msg, 5000));
+    EXPECT_EQ(msg.status, "error");
+    EXPECT_EQ(msg.code, 1);
+
+    d.terminate();
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <QFile>
+#include <QTemporaryDir>
+#include "stdiolink_server/manager/instance_log_reader.h"
+
+using namespace stdiolink_server;
+
+namespace {
+
+void writeLines(const QString& path, const QString& tag, int from, int to,
+                bool append = false) {
+    QFile file(path);
+    ASSERT_TRUE(file.open(append ? QIODevice::Append : QIODevice::WriteOnly));
+    for (int i = from; i < to; ++i) {
+        file.write(QString("%1 line %2\n").arg(tag).arg(i).toUtf8());
+    }
+}
+
+} // namespace
+
+TEST(InstanceLogReaderTest, RotatedPathMatchesSpdlogNaming) {
+    EXPECT_EQ(InstanceLogReader::rotatedPath("/logs/p1.log", 0), "/logs/p1.log");
+    EXPECT_EQ(InstanceLogReader::rotatedPath("/logs/p1.log", 2), "/logs/p1.2.log");
+}
+
+TEST(InstanceLogReaderTest, TailReturnsLastLinesInOrder) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString path = tmp.path() + "/p1.log";
+    writeLines(path, "a", 0, 10000);
+
+    const auto chunk = InstanceLogReader::readTail(path, 3);
+    ASSERT_EQ(chunk.lines.size(), 3);
+    EXPECT_EQ(chunk.lines[0], "a line 9997");
+    EXPECT_EQ(chunk.lines[2], "a line 9999");
+    EXPECT_EQ(chunk.next.offset, QFile(path).size());
+    EXPECT_FALSE(chunk.next.fileId.isEmpty());
+}
+
+TEST(InstanceLogReaderTest, TailSpansRotatedFiles) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString path = tmp.path() + "/p1.log";
+    writeLines(InstanceLogReader::rotatedPath(path, 1), "old", 0, 5);
+    writeLines(path, "new", 0, 2);
+
+    const auto chunk = InstanceLogReader::readTail(path, 4);
+    ASSERT_EQ(chunk.lines.size(), 4);
+    EXPECT_EQ(chunk.lines[0], "old line 3");
+    EXPECT_EQ(chunk.lines[1], "old line 4");
+    EXPECT_EQ(chunk.lines[3], "new line 1");
+}
+
+TEST(InstanceLogReaderTest, TailSkipsPartialLastLine) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString path = tmp.path() + "/p1.log";
+    writeLines(path, "a", 0, 2);
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::Append));
+        file.write("half");
+    }
+
+    const auto chunk = InstanceLogReader::readTail(path, 10);
+    ASSERT_EQ(chunk.lines.size(), 2);
+    EXPECT_EQ(chunk.next.offset, QFile(path).size() - 4);
+}
+
+TEST(InstanceLogReaderTest, ReadSinceReturnsOnlyNewLines) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString path = tmp.path() + "/p1.log";
+    writeLines(path, "a", 0, 3);
+    const auto first = InstanceLogReader::readTail(path, 100);
+
+    writeLines(path, "a", 3, 5, true);
+    const auto next = InstanceLogReader::readSince(path, first.next, 100);
+    EXPECT_FALSE(next.reset);
+    ASSERT_EQ(next.lines.size(), 2);
+    EXPECT_EQ(next.lines[0], "a line 3");
+    EXPECT_EQ(next.next.offset, QFile(path).size());
+
+    const auto idle = InstanceLogReader::readSince(path, next.next, 100);
+    EXPECT_TRUE(idle.lines.isEmpty());
+    EXPECT_EQ(idle.next.offset, next.next.offset);
+}
+
+TEST(InstanceLogReaderTest, ReadSinceFollowsRotation) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString path = tmp.path() + "/p1.log";
+    writeLines(path, "a", 0, 3);
+    const auto cursor = InstanceLogReader::readTail(path, 100).next;
+
+    // 模拟轮转：活动文件改名为 .1 并追加尾部，再写新的活动文件
+    writeLines(path, "a", 3, 4, true);
+    ASSERT_TRUE(QFile::rename(path, InstanceLogReader::rotatedPath(path, 1)));
+    writeLines(path, "b", 0, 2);
+
+    const auto chunk = InstanceLogReader::readSince(path, cursor, 100);
+    EXPECT_FALSE(chunk.reset);
+    ASSERT_EQ(chunk.lines.size(), 3);
+    EXPECT_EQ(chunk.lines[0], "a line 3");
+    EXPECT_EQ(chunk.lines[1], "b line 0");
+    EXPECT_EQ(chunk.next.offset, QFile(path).size());
+}
+
+TEST(InstanceLogReaderTest, ReadSincePagesByMaxLines) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString path = tmp.path() + "/p1.log";
+    writeLines(path, "a", 0, 5);
+
+    InstanceLogReader::Cursor cursor;
+    const auto page1 = InstanceLogReader::readSince(path, cursor, 2);
+    ASSERT_EQ(page1.lines.size(), 2);
+    EXPECT_EQ(page1.lines[1], "a line 1");
+    const auto page2 = InstanceLogReader::readSince(path, page1.next, 2);
+    ASSERT_EQ(page2.lines.size(), 2);
+    EXPECT_EQ(page2.lines[0], "a line 2");
+}
+
+TEST(InstanceLogReaderTest, UnknownCursorResetsToTail) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString path = tmp.path() + "/p1.log";
+    writeLines(path, "a", 0, 5);
+
+    InstanceLogReader::Cursor stale{"0123456789abcdef", 10};
+    const auto chunk = InstanceLogReader::readSince(path, stale, 2);
+    EXPECT_TRUE(chunk.reset);
+    ASSERT_EQ(chunk.lines.size(), 2);
+    EXPECT_EQ(chunk.lines[1], "a line 4");
+}
@@ -1,6 +1,8 @@
 #include <QJsonArray>
+#include <QJsonDocument>
 #include <QJsonObject>
 #include <gtest/gtest.h>
+#include "stdiolink/protocol/jsonl_envelope.h"
 #include "stdiolink/protocol/jsonl_serializer.h"
 
 using namespace stdiolink;
@@ -40,6 +42,14 @@ TEST(JsonlParser, ParseRequest_MissingCmd) {
     EXPECT_FALSE(ok);
 }
 
+TEST(JsonlParser, ParseRequest_WithId) {
+    Request req;
+    bool ok = parseRequest(R"({"cmd":"scan","data":{},"id":"42"})", req);
+
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(req.id, "42");
+}
+
 TEST(JsonlParser, ParseRequest_EmptyObject) {
     Request req;
     bool ok = parseRequest(R"({})", req);
@@ -163,6 +173,22 @@ TEST(JsonlParser, ParseResponse_Event) {
     EXPECT_EQ(msg.status, "event");
 }
 
+TEST(JsonlParser, ParseResponse_WithId) {
+    Message msg;
+    bool ok = parseResponse(R"({"status":"done","code":0,"data":{},"id":"7"})", msg);
+
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(msg.id, "7");
+}
+
+TEST(JsonlParser, ParseResponse_WithoutIdLeavesEmpty) {
+    Message msg;
+    bool ok = parseResponse(R"({"status":"done","code":0,"data":{}})", msg);
+
+    EXPECT_TRUE(ok);
+    EXPECT_TRUE(msg.id.isEmpty());
+}
+
 TEST(JsonlParser, ParseResponse_InvalidStatus) {
     Message msg;
     bool ok = parseResponse(R"({"status":"unknown","code":0,"data":{}})", msg);
@@ -174,3 +200,110 @@ TEST(JsonlParser, ParseResponse_MissingStatus) {
     bool ok = parseResponse(R"({"code":0,"data":{}})", msg);
     EXPECT_FALSE(ok);
 }
+
+TEST(JsonlParser, ParseResponse_PayloadStaysRawUntilAccessed) {
+    Message msg;
+    bool ok = parseResponse(R"({"status":"event","code":0,"data":{"frame":"QUJD","n":[1,2]}})", msg);
+
+    ASSERT_TRUE(ok);
+    EXPECT_TRUE(msg.payload.isRaw());
+    EXPECT_EQ(msg.payload.raw(), R"({"frame":"QUJD","n":[1,2]})");
+    EXPECT_TRUE(msg.payload.isObject());
+    EXPECT_TRUE(msg.payload.isRaw());
+
+    EXPECT_EQ(msg.payload.toObject()["frame"].toString(), "QUJD");
+    EXPECT_FALSE(msg.payload.isRaw());
+    EXPECT_TRUE(msg.payload.raw().isEmpty());
+}
+
+TEST(JsonlParser, ParseResponse_ScalarAndMissingData) {
+    Message msg;
+    ASSERT_TRUE(parseResponse(R"({"status":"done","code":0,"data":"text"})", msg));
+    EXPECT_EQ(msg.payload.toString(), "text");
+
+    ASSERT_TRUE(parseResponse(R"({"status":"done","code":0})", msg));
+    EXPECT_TRUE(msg.payload.isUndefined());
+}
+
+TEST(JsonlParser, ParseResponse_RejectsMalformedData) {
+    Message msg;
+    EXPECT_FALSE(parseResponse(R"({"status":"done","code":0,"data":{"a":}})", msg));
+    EXPECT_FALSE(parseResponse(R"({"status":"done","code":0,"data":[1,2})", msg));
+    EXPECT_FALSE(parseResponse(R"({"status":"done","code":0,"data":"unterminated})", msg));
+    EXPECT_FALSE(parseResponse(R"({"status":"done","code":0} trailing)", msg));
+}
+
+TEST(JsonlParser, ParseResponse_CodeFollowsQJsonToInt) {
+    Message msg;
+    ASSERT_TRUE(parseResponse(R"({"status":"error","code":1.0e3,"data":{}})", msg));
+    EXPECT_EQ(msg.code, 1000);
+
+    ASSERT_TRUE(parseResponse(R"({"status":"error","code":1.5,"data":{}})", msg));
+    EXPECT_EQ(msg.code, 0);
+
+    ASSERT_TRUE(parseResponse(R"({"status":"error","code":"7","data":{}})", msg));
+    EXPECT_EQ(msg.code, 0);
+}
+
+// ============================================
+// 信封扫描测试
+// ============================================
+
+TEST(JsonlEnvelope, ScanLocatesTopLevelFields) {
+    JsonlEnvelope env;
+    const QByteArray line = R"( {"data":{"status":"nested"},"code":3,"status":"event","id":"a\"b"} )";
+
+    ASSERT_TRUE(scanEnvelope(line, env));
+    EXPECT_EQ(env.data.toByteArray(), R"({"status":"nested"})");
+    EXPECT_EQ(env.code.toByteArray(), "3");
+    EXPECT_EQ(jsonTokenToString(env.status), "event");
+    EXPECT_EQ(jsonTokenToString(env.id), "a\"b");
+    EXPECT_TRUE(env.cmd.isNull());
+}
+
+TEST(JsonlEnvelope, EscapedKeyIsDecoded) {
+    JsonlEnvelope env;
+    ASSERT_TRUE(scanEnvelope(R"({"st\u0061tus":"done","code":0})", env));
+    EXPECT_EQ(jsonTokenToString(env.status), "done");
+}
+
+TEST(JsonlEnvelope, RejectsNonObjectTopLevel) {
+    JsonlEnvelope env;
+    EXPECT_FALSE(scanEnvelope("[1,2]", env));
+    EXPECT_FALSE(scanEnvelope("", env));
+    EXPECT_FALSE(scanEnvelope(R"({"a":01})", env));
+}
+
+TEST(JsonlEnvelope, RejectsExcessiveNesting) {
+    QByteArray line = R"({"data":)";
+    line.append(QByteArray(2000, '['));
+    line.append(QByteArray(2000, ']'));
+    line.append('}');
+
+    JsonlEnvelope env;
+    EXPECT_FALSE(scanEnvelope(line, env));
+}
+
+TEST(JsonlEnvelope, RejectsInvalidUtf8InStrings) {
+    JsonlEnvelope env;
+    // 合法的多字节字符（2/3/4 字节）
+    const QByteArray valid = "{\"status\":\"done\",\"code\":0,\"data\":\"\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80\"}";
+    ASSERT_TRUE(scanEnvelope(valid, env));
+    EXPECT_FALSE(QJsonDocument::fromJson(valid).isNull());
+
+    const QByteArray invalid[] = {
+        "\xFF",              // 非法首字节
+        "\xC3",              // 截断
+        "\xC0\xAF",          // 过长编码
+        "\xE0\x80\xAF",      // 过长编码
+        "\xED\xA0\x80",      // UTF-16 代理区
+        "\xF4\x90\x80\x80",  // 超出 U+10FFFF
+        "\x80",              // 孤立的后续字节
+    };
+    for (const QByteArray& bytes : invalid) {
+        const QByteArray line = "{\"status\":\"done\",\"code\":0,\"data\":{\"k\":\"" + bytes + "\"}}";
+        EXPECT_FALSE(scanEnvelope(line, env)) << line.toHex().constData();
+        // 与 QJsonDocument 的判定保持一致
+        EXPECT_TRUE(QJsonDocument::fromJson(line).isNull()) << line.toHex().constData();
+    }
+}
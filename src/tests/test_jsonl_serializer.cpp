@@ -69,3 +69,62 @@ TEST(JsonlSerializer, SerializeResponse_Event) {
     EXPECT_TRUE(result.contains("\"status\":\"event\""));
     EXPECT_TRUE(result.contains("\"data\":{\"progress\":0.5}"));
 }
+
+TEST(JsonlSerializer, SerializeResponse_EchoesRequestId) {
+    auto result = serializeResponse("done", 0, QJsonObject{}, "12");
+    EXPECT_TRUE(result.contains("\"id\":\"12\""));
+
+    auto legacy = serializeResponse("done", 0, QJsonObject{});
+    EXPECT_FALSE(legacy.contains("\"id\""));
+}
+
+TEST(JsonlSerializer, SerializeRequest_WithId) {
+    auto result = serializeRequest("scan", QJsonObject{{"fps", 10}}, "3");
+    EXPECT_TRUE(result.contains("\"id\":\"3\""));
+    EXPECT_TRUE(result.endsWith('\n'));
+}
+
+TEST(JsonlSerializer, AppendResponse_EnvelopeOrderAndAppend) {
+    QByteArray out = "prefix\n";
+    appendResponse(out, "event", 3, QJsonObject{{"k", 1}}, "9");
+
+    EXPECT_EQ(out, "prefix\n{\"status\":\"event\",\"code\":3,\"data\":{\"k\":1},\"id\":\"9\"}\n");
+}
+
+TEST(JsonlSerializer, AppendResponse_ScalarPayloadsRoundTrip) {
+    const QJsonValue payloads[] = {QJsonValue(QStringLiteral("quote\" \\ \né")),
+                                   QJsonValue(1.5), QJsonValue(42), QJsonValue(true),
+                                   QJsonValue(QJsonValue::Null)};
+    for (const QJsonValue& payload : payloads) {
+        QByteArray out;
+        appendResponse(out, "done", 0, payload);
+        ASSERT_TRUE(out.endsWith('\n'));
+
+        Message msg;
+        ASSERT_TRUE(parseResponse(out.chopped(1), msg)) << out.constData();
+        EXPECT_EQ(msg.payload, payload);
+    }
+}
+
+TEST(JsonlSerializer, AppendResponse_UndefinedPayloadOmitsData) {
+    QByteArray out;
+    appendResponse(out, "done", 0, QJsonValue(QJsonValue::Undefined));
+    EXPECT_FALSE(out.contains("\"data\""));
+}
+
+TEST(JsonlSerializer, AppendBlobHeader_RoundTripsBlobSize) {
+    QByteArray out;
+    appendBlobHeader(out, "done", 0, QJsonObject{{"n", 1}}, "4", 1024);
+    EXPECT_EQ(out, "{\"status\":\"done\",\"code\":0,\"data\":{\"n\":1},\"id\":\"4\",\"blob\":1024}\n");
+
+    Message msg;
+    qint64 blobSize = -1;
+    ASSERT_TRUE(parseResponse(out.chopped(1), msg, &blobSize));
+    EXPECT_EQ(blobSize, 1024);
+    EXPECT_EQ(msg.id, "4");
+
+    ASSERT_TRUE(parseResponse(R"({"status":"done","code":0})", msg, &blobSize));
+    EXPECT_EQ(blobSize, -1);
+    EXPECT_FALSE(parseResponse(R"({"status":"done","code":0,"blob":-1})", msg, &blobSize));
+    EXPECT_FALSE(parseResponse(R"({"status":"done","code":0,"blob":"8"})", msg, &blobSize));
+}
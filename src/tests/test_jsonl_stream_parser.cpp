@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "stdiolink/protocol/jsonl_parser.h"
+#include "stdiolink/protocol/line_framer.h"
 
 using namespace stdiolink;
 
@@ -87,3 +88,86 @@ TEST(JsonlStreamParser, BufferSize) {
     parser.tryReadLine(line);
     EXPECT_EQ(parser.bufferSize(), 0);
 }
+
+// ============================================
+// LineFramer 测试
+// ============================================
+
+TEST(LineFramer, NextLineReturnsViewsWithoutCopy) {
+    LineFramer framer;
+    framer.append("a\nbb\nccc");
+
+    QByteArrayView line;
+    ASSERT_TRUE(framer.nextLine(line));
+    EXPECT_EQ(line.toByteArray(), "a");
+    ASSERT_TRUE(framer.nextLine(line));
+    EXPECT_EQ(line.toByteArray(), "bb");
+    EXPECT_FALSE(framer.nextLine(line));
+    EXPECT_EQ(framer.pending().toByteArray(), "ccc");
+    EXPECT_EQ(framer.pendingSize(), 3);
+}
+
+TEST(LineFramer, PartialLineSurvivesCompaction) {
+    LineFramer framer;
+    framer.append("first\nsec");
+
+    QByteArrayView line;
+    ASSERT_TRUE(framer.nextLine(line));
+    EXPECT_FALSE(framer.nextLine(line));
+
+    framer.append("ond\n");
+    ASSERT_TRUE(framer.nextLine(line));
+    EXPECT_EQ(line.toByteArray(), "second");
+    EXPECT_EQ(framer.pendingSize(), 0);
+}
+
+TEST(LineFramer, FloodKeepsOrderAcrossManyAppends) {
+    LineFramer framer;
+    int expected = 0;
+    QByteArrayView line;
+    for (int chunk = 0; chunk < 200; ++chunk) {
+        QByteArray data;
+        for (int i = 0; i < 50; ++i) {
+            data += QByteArray::number(chunk * 50 + i) + '\n';
+        }
+        // 按不对齐的片段投递，覆盖跨 append 的半行
+        framer.append(data.left(7));
+        framer.append(data.mid(7));
+        while (framer.nextLine(line)) {
+            EXPECT_EQ(line.toByteArray().toInt(), expected);
+            ++expected;
+        }
+    }
+    EXPECT_EQ(expected, 200 * 50);
+    EXPECT_EQ(framer.pendingSize(), 0);
+}
+
+TEST(LineFramer, ClearDropsPendingBytes) {
+    LineFramer framer;
+    framer.append("abc");
+    framer.clear();
+    EXPECT_EQ(framer.pendingSize(), 0);
+
+    framer.append("x\n");
+    QByteArray line;
+    ASSERT_TRUE(framer.tryReadLine(line));
+    EXPECT_EQ(line, "x");
+}
+
+TEST(LineFramer, TakeBytesSkipsEmbeddedNewlines) {
+    LineFramer framer;
+    framer.append("head\nA\nB");
+
+    QByteArrayView view;
+    ASSERT_TRUE(framer.nextLine(view));
+    EXPECT_EQ(view.toByteArray(), "head");
+
+    EXPECT_FALSE(framer.takeBytes(5, view));
+    EXPECT_EQ(framer.pendingSize(), 3);
+
+    framer.append("\nCtail\n");
+    ASSERT_TRUE(framer.takeBytes(5, view));
+    EXPECT_EQ(view.toByteArray(), "A\nB\nC");
+    ASSERT_TRUE(framer.nextLine(view));
+    EXPECT_EQ(view.toByteArray(), "tail");
+}
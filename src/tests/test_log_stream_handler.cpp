@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <QFile>
+#include <QTemporaryDir>
+#include "stdiolink_server/http/log_stream_handler.h"
+#include "stdiolink_server/manager/instance_log_reader.h"
+#include "stdiolink_server/manager/instance_log_writer.h"
+
+using namespace stdiolink_server;
+
+TEST(LogLineQueueTest, DropsOldestWhenFull) {
+    LogLineQueue queue(3);
+    for (int i = 0; i < 5; ++i) {
+        queue.push(QString("line %1").arg(i));
+    }
+    EXPECT_EQ(queue.size(), 3);
+    EXPECT_EQ(queue.takeDropped(), 2);
+    EXPECT_EQ(queue.takeDropped(), 0);
+    EXPECT_EQ(queue.totalDropped(), 2);
+
+    const QStringList lines = queue.takeAll();
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_EQ(lines[0], "line 2");
+    EXPECT_EQ(lines[2], "line 4");
+    EXPECT_TRUE(queue.isEmpty());
+
+    for (int i = 0; i < 4; ++i) {
+        queue.push("x");
+    }
+    EXPECT_EQ(queue.takeDropped(), 1);
+    EXPECT_EQ(queue.totalDropped(), 3);
+}
+
+TEST(LogStreamConnectionTest, CursorRoundTrip) {
+    const InstanceLogReader::Cursor cursor{"0123456789abcdef", 4096};
+    const QString text = LogStreamConnection::formatCursor(cursor);
+    EXPECT_EQ(text, "0123456789abcdef:4096");
+
+    InstanceLogReader::Cursor parsed;
+    ASSERT_TRUE(LogStreamConnection::parseCursor(text, parsed));
+    EXPECT_EQ(parsed.fileId, cursor.fileId);
+    EXPECT_EQ(parsed.offset, cursor.offset);
+
+    // 尚无完整行的文件 fileId 为空
+    ASSERT_TRUE(LogStreamConnection::parseCursor(":0", parsed));
+    EXPECT_TRUE(parsed.fileId.isEmpty());
+
+    EXPECT_FALSE(LogStreamConnection::parseCursor("no-separator", parsed));
+    EXPECT_FALSE(LogStreamConnection::parseCursor("abc:-1", parsed));
+    EXPECT_FALSE(LogStreamConnection::parseCursor("abc:x", parsed));
+}
+
+TEST(LogStreamConnectionTest, WriterSinkMatchesFileAndCursor) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString path = tmp.path() + "/p1.log";
+
+    QStringList pushed;
+    {
+        InstanceLogWriter writer(path, 10 * 1024 * 1024, 3,
+                                 [&pushed](const QString& line) { pushed.append(line); });
+        writer.appendStdout("hello\nwor");
+        writer.appendStderr("oops\n");
+        ASSERT_EQ(pushed.size(), 2);
+
+        // 回调触发后文件末尾游标即为续传点，之后不应再读到已推送的行
+        const auto cursor = InstanceLogReader::endCursor(path);
+        EXPECT_EQ(cursor.offset, QFile(path).size());
+        EXPECT_TRUE(InstanceLogReader::readSince(path, cursor, 10).lines.isEmpty());
+    }
+    // 析构时补写的半行同样推送
+    ASSERT_EQ(pushed.size(), 3);
+
+    const auto tail = InstanceLogReader::readTail(path, 10);
+    EXPECT_EQ(tail.lines, pushed);
+    EXPECT_TRUE(pushed[0].endsWith(" | hello"));
+    EXPECT_TRUE(pushed[1].endsWith(" | [stderr] oops"));
+    EXPECT_TRUE(pushed[2].endsWith(" | wor"));
+}
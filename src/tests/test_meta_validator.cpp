@@ -1,3 +1,4 @@
+#include <QJsonDocument>
 #include <gtest/gtest.h>
 
 #include "stdiolink/protocol/meta_validator.h"
@@ -408,3 +409,130 @@ TEST_F(DefaultFillerTest, SkipNullDefaults) {
 
     EXPECT_FALSE(filled.contains("optional"));
 }
+
+// CommandValidationPlan 测试：结果须与 fillDefaults + validateParams 逐一一致
+
+class CommandValidationPlanTest : public ::testing::Test {
+protected:
+    static CommandMeta buildCommand() {
+        CommandMeta cmd;
+        cmd.name = "configure";
+
+        FieldMeta host;
+        host.name = "host";
+        host.type = FieldType::String;
+        host.required = true;
+        host.constraints.pattern = "^[a-z0-9.]+$";
+
+        FieldMeta port;
+        port.name = "port";
+        port.type = FieldType::Int;
+        port.defaultValue = 502;
+        port.constraints.min = 1;
+        port.constraints.max = 65535;
+
+        FieldMeta mode;
+        mode.name = "mode";
+        mode.type = FieldType::Enum;
+        mode.constraints.enumValues = QJsonArray{"rtu", "tcp"};
+        mode.defaultValue = "tcp";
+
+        FieldMeta retry;
+        retry.name = "retry";
+        retry.type = FieldType::Object;
+        FieldMeta count;
+        count.name = "count";
+        count.type = FieldType::Int;
+        count.defaultValue = 3;
+        FieldMeta delay;
+        delay.name = "delayMs";
+        delay.type = FieldType::Int;
+        delay.required = true;
+        delay.defaultValue = 100;
+        retry.fields = {count, delay};
+
+        FieldMeta tags;
+        tags.name = "tags";
+        tags.type = FieldType::Array;
+        tags.constraints.maxItems = 3;
+        tags.items = std::make_shared<FieldMeta>();
+        tags.items->name = "tag";
+        tags.items->type = FieldType::String;
+        tags.items->constraints.pattern = "^[A-Z]+$";
+
+        cmd.params = {host, port, mode, retry, tags};
+        return cmd;
+    }
+
+    static void expectSameAsLegacy(const CommandMeta& cmd, const QJsonObject& input,
+                                   bool allowUnknown = true) {
+        const QJsonObject legacyFilled = DefaultFiller::fillDefaults(input, cmd);
+        const auto legacy = MetaValidator::validateParams(legacyFilled, cmd, allowUnknown);
+
+        CommandValidationPlan plan(cmd);
+        QJsonObject filled = input;
+        const auto result = plan.fillAndValidate(filled, allowUnknown);
+
+        EXPECT_EQ(result.valid, legacy.valid);
+        EXPECT_EQ(result.errorField, legacy.errorField);
+        EXPECT_EQ(result.errorMessage, legacy.errorMessage);
+        if (legacy.valid) {
+            EXPECT_EQ(filled, legacyFilled);
+        }
+    }
+};
+
+TEST_F(CommandValidationPlanTest, FillsNestedDefaults) {
+    const CommandMeta cmd = buildCommand();
+    CommandValidationPlan plan(cmd);
+    QJsonObject params{{"host", "plc.local"}};
+    auto r = plan.fillAndValidate(params);
+    ASSERT_TRUE(r.valid) << qPrintable(r.toString());
+    EXPECT_EQ(params.value("port").toInt(), 502);
+    EXPECT_EQ(params.value("mode").toString(), "tcp");
+    EXPECT_EQ(params.value("retry").toObject().value("count").toInt(), 3);
+    EXPECT_EQ(params.value("retry").toObject().value("delayMs").toInt(), 100);
+    expectSameAsLegacy(cmd, QJsonObject{{"host", "plc.local"}});
+}
+
+TEST_F(CommandValidationPlanTest, MatchesLegacyErrors) {
+    const CommandMeta cmd = buildCommand();
+    const QList<QJsonObject> inputs = {
+        QJsonObject{},
+        QJsonObject{{"host", "PLC"}},
+        QJsonObject{{"host", "plc"}, {"port", 0}},
+        QJsonObject{{"host", "plc"}, {"port", "502"}},
+        QJsonObject{{"host", "plc"}, {"mode", "udp"}},
+        QJsonObject{{"host", "plc"}, {"retry", QJsonObject{{"count", "x"}}}},
+        QJsonObject{{"host", "plc"}, {"retry", "bad"}},
+        QJsonObject{{"host", "plc"}, {"tags", QJsonArray{"A", "b"}}},
+        QJsonObject{{"host", "plc"}, {"tags", QJsonArray{"A", "B", "C", "D"}}},
+        QJsonObject{{"host", "plc"}, {"tags", QJsonArray{"A", "B"}}, {"extra", 1}},
+    };
+    for (const auto& input : inputs) {
+        SCOPED_TRACE(QJsonDocument(input).toJson(QJsonDocument::Compact).toStdString());
+        expectSameAsLegacy(cmd, input);
+        expectSameAsLegacy(cmd, input, false);
+    }
+}
+
+TEST_F(CommandValidationPlanTest, ReportsNestedErrorPath) {
+    CommandValidationPlan plan(buildCommand());
+    QJsonObject params{{"host", "plc"}, {"tags", QJsonArray{"OK", "bad"}}};
+    auto r = plan.fillAndValidate(params);
+    EXPECT_FALSE(r.valid);
+    EXPECT_EQ(r.errorField, "tags[1]");
+
+    params = QJsonObject{{"host", "plc"}, {"retry", QJsonObject{{"count", 1.5}}}};
+    r = plan.fillAndValidate(params);
+    EXPECT_FALSE(r.valid);
+    EXPECT_EQ(r.errorField, "retry.count");
+}
+
+TEST_F(CommandValidationPlanTest, DriverPlanLooksUpCommands) {
+    DriverMeta meta;
+    meta.commands = {buildCommand()};
+    DriverValidationPlan plan(meta);
+    EXPECT_NE(plan.find("configure"), nullptr);
+    EXPECT_EQ(plan.find("missing"), nullptr);
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include "driver_modbusrtu/modbus_data_area.h"
+
+using namespace modbus;
+using BitTable = ModbusDataArea::BitTable;
+using RegisterTable = ModbusDataArea::RegisterTable;
+
+TEST(ModbusDataAreaTest, BitsRoundTripAcrossWordBoundary) {
+    ModbusDataArea area(200);
+
+    // 起始地址 60 非字节/字对齐，11 个位跨越第 0、1 个 64 位字
+    const QByteArray request("\xA5\x05", 2);
+    ASSERT_TRUE(area.writeBits(BitTable::Coils, 60, 11, request));
+
+    QByteArray packed;
+    ASSERT_TRUE(area.readBits(BitTable::Coils, 60, 11, packed));
+    EXPECT_EQ(packed, QByteArray("\xA5\x05", 2));
+
+    bool value = false;
+    EXPECT_TRUE(area.getBit(BitTable::Coils, 60, value));
+    EXPECT_TRUE(value);
+    EXPECT_TRUE(area.getBit(BitTable::Coils, 61, value));
+    EXPECT_FALSE(value);
+    EXPECT_TRUE(area.getBit(BitTable::Coils, 70, value));
+    EXPECT_TRUE(value);
+
+    // 相邻地址不受影响，离散输入是独立的表
+    EXPECT_TRUE(area.getBit(BitTable::Coils, 59, value));
+    EXPECT_FALSE(value);
+    EXPECT_TRUE(area.getBit(BitTable::Coils, 71, value));
+    EXPECT_FALSE(value);
+    ASSERT_TRUE(area.readBits(BitTable::DiscreteInputs, 60, 11, packed));
+    EXPECT_EQ(packed, QByteArray(2, '\0'));
+}
+
+TEST(ModbusDataAreaTest, ReadBitsPadsLastByteWithZeros) {
+    ModbusDataArea area(16);
+    ASSERT_TRUE(area.writeBits(BitTable::DiscreteInputs, 0, 16, QByteArray("\xFF\xFF", 2)));
+
+    QByteArray packed;
+    ASSERT_TRUE(area.readBits(BitTable::DiscreteInputs, 3, 5, packed));
+    EXPECT_EQ(packed, QByteArray(1, '\x1F'));
+}
+
+TEST(ModbusDataAreaTest, RegistersBulkAndBigEndian) {
+    ModbusDataArea area(100);
+
+    const quint16 values[] = {0x0001, 0x1234, 0xFFFF};
+    ASSERT_TRUE(area.writeRegisters(RegisterTable::Input, 97, 3, values));
+
+    QByteArray encoded;
+    ASSERT_TRUE(area.readRegistersBigEndian(RegisterTable::Input, 97, 3, encoded));
+    EXPECT_EQ(encoded, QByteArray("\x00\x01\x12\x34\xFF\xFF", 6));
+
+    ASSERT_TRUE(area.writeRegistersBigEndian(RegisterTable::Holding, 10, 2, "\xAB\xCD\x00\x07"));
+    quint16 out[2] = {};
+    ASSERT_TRUE(area.readRegisters(RegisterTable::Holding, 10, 2, out));
+    EXPECT_EQ(out[0], 0xABCD);
+    EXPECT_EQ(out[1], 0x0007);
+}
+
+TEST(ModbusDataAreaTest, OutOfRangeLeavesDataUntouched) {
+    ModbusDataArea area(100);
+    const quint64 before = area.version();
+
+    const quint16 values[] = {1, 2, 3};
+    EXPECT_FALSE(area.writeRegisters(RegisterTable::Holding, 98, 3, values));
+    EXPECT_FALSE(area.setRegister(RegisterTable::Holding, 100, 1));
+    EXPECT_FALSE(area.writeBits(BitTable::Coils, 95, 8, QByteArray(1, '\xFF')));
+    EXPECT_EQ(area.version(), before);
+
+    quint16 value = 0xFFFF;
+    EXPECT_TRUE(area.getRegister(RegisterTable::Holding, 98, value));
+    EXPECT_EQ(value, 0);
+    QByteArray packed;
+    EXPECT_FALSE(area.readBits(BitTable::Coils, 99, 2, packed));
+}
+
+TEST(ModbusDataAreaTest, BulkWriteIsOneVersionStep) {
+    ModbusDataArea area(100);
+    const QVector<quint16> values(50, 7);
+
+    ASSERT_TRUE(area.writeRegisters(RegisterTable::Holding, 0, 50, values.constData()));
+    EXPECT_EQ(area.version(), 1u);
+    ASSERT_TRUE(area.setBit(BitTable::Coils, 3, true));
+    EXPECT_EQ(area.version(), 2u);
+}
+
+TEST(ModbusDataAreaTest, ReaderNeverSeesTornBulkWrite) {
+    ModbusDataArea area(100);
+    std::atomic<bool> stop{false};
+
+    std::thread writer([&]() {
+        QVector<quint16> values(100);
+        for (int round = 0; round < 20000; ++round) {
+            values.fill(static_cast<quint16>(round));
+            area.writeRegisters(RegisterTable::Holding, 0, 100, values.constData());
+        }
+        stop = true;
+    });
+
+    int torn = 0;
+    quint16 snapshot[100];
+    while (!stop) {
+        area.readRegisters(RegisterTable::Holding, 0, 100, snapshot);
+        for (quint16 v : snapshot) {
+            if (v != snapshot[0]) {
+                ++torn;
+                break;
+            }
+        }
+    }
+    writer.join();
+    EXPECT_EQ(torn, 0);
+}
+
+TEST(ModbusUnitTableTest, AddRemoveAndLookup) {
+    ModbusUnitTable units;
+    EXPECT_TRUE(units.add(5, 10));
+    EXPECT_FALSE(units.add(5, 10));
+    EXPECT_TRUE(units.add(1, 20));
+    EXPECT_EQ(units.units(), (QList<quint8>{1, 5}));
+
+    // 已取得的数据区在单元移除后仍可安全使用
+    const auto held = units.find(5);
+    ASSERT_TRUE(held);
+    EXPECT_TRUE(units.remove(5));
+    EXPECT_FALSE(units.remove(5));
+    EXPECT_FALSE(units.contains(5));
+    EXPECT_EQ(units.find(5), nullptr);
+    EXPECT_TRUE(held->setRegister(RegisterTable::Holding, 9, 42));
+}
+
+TEST(ModbusUnitTableTest, ConcurrentLookupWhileUnitsChange) {
+    ModbusUnitTable units;
+    ASSERT_TRUE(units.add(1, 10));
+    std::atomic<bool> stop{false};
+
+    std::thread writer([&]() {
+        for (int round = 0; round < 5000; ++round) {
+            units.add(2, 10);
+            units.remove(2);
+        }
+        stop = true;
+    });
+
+    int missing = 0;
+    while (!stop) {
+        // 单元 1 从未移除，查找必须始终命中；单元 2 的结果可空但必须可用
+        if (!units.find(1)) {
+            ++missing;
+        }
+        if (const auto area = units.find(2)) {
+            area->setRegister(RegisterTable::Holding, 0, 1);
+        }
+    }
+    writer.join();
+    EXPECT_EQ(missing, 0);
+    EXPECT_EQ(units.units(), (QList<quint8>{1}));
+}
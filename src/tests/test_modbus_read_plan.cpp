@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "driver_modbusrtu/modbus_types.h"
+
+using namespace modbus;
+
+namespace {
+
+TagSpec holding(const QString& name, int address, DataType type = DataType::UInt16) {
+    TagSpec tag;
+    tag.name = name;
+    tag.area = TagArea::HoldingRegister;
+    tag.address = static_cast<uint16_t>(address);
+    tag.dataType = type;
+    return tag;
+}
+
+TagSpec coil(const QString& name, int address) {
+    TagSpec tag;
+    tag.name = name;
+    tag.area = TagArea::Coil;
+    tag.address = static_cast<uint16_t>(address);
+    return tag;
+}
+
+} // namespace
+
+TEST(ModbusReadPlanTest, MergesAdjacentAndOverlappingRanges) {
+    // 0..1 (float32)、1 与 0..1 重叠、2 紧邻 → 合并为 [0, 3)
+    const QVector<TagSpec> tags = {holding("b", 2), holding("a", 0, DataType::Float32),
+                                   holding("overlap", 1)};
+    const QVector<ReadBlock> blocks = planReadBlocks(tags);
+    ASSERT_EQ(blocks.size(), 1);
+    EXPECT_EQ(blocks[0].start, 0);
+    EXPECT_EQ(blocks[0].count, 3);
+    EXPECT_EQ(blocks[0].tagIndices.size(), 3);
+}
+
+TEST(ModbusReadPlanTest, GapsSplitUnlessAllowed) {
+    const QVector<TagSpec> tags = {holding("a", 0), holding("b", 5)};
+    EXPECT_EQ(planReadBlocks(tags).size(), 2);
+
+    const QVector<ReadBlock> merged = planReadBlocks(tags, 4);
+    ASSERT_EQ(merged.size(), 1);
+    EXPECT_EQ(merged[0].count, 6);
+}
+
+TEST(ModbusReadPlanTest, SeparatesAreasAndRespectsProtocolLimits) {
+    QVector<TagSpec> tags;
+    for (int i = 0; i < 300; ++i) {
+        tags.append(holding(QString("r%1").arg(i), i));
+    }
+    for (int i = 0; i < 2500; ++i) {
+        tags.append(coil(QString("c%1").arg(i), i));
+    }
+
+    const QVector<ReadBlock> blocks = planReadBlocks(tags);
+    int registerBlocks = 0;
+    int coilBlocks = 0;
+    int covered = 0;
+    for (const ReadBlock& block : blocks) {
+        if (block.area == TagArea::HoldingRegister) {
+            EXPECT_LE(block.count, kMaxReadRegisters);
+            ++registerBlocks;
+        } else {
+            EXPECT_EQ(block.area, TagArea::Coil);
+            EXPECT_LE(block.count, kMaxReadBits);
+            ++coilBlocks;
+        }
+        covered += block.tagIndices.size();
+    }
+    EXPECT_EQ(registerBlocks, 3);   // 125 + 125 + 50
+    EXPECT_EQ(coilBlocks, 2);       // 2000 + 500
+    EXPECT_EQ(covered, tags.size());
+}
+
+TEST(ModbusReadPlanTest, MultiRegisterTagIsNeverSplit) {
+    // 123 起的 float64 占 123..126，与 0 号合并会超过 125，整体移入下一块
+    const QVector<TagSpec> tags = {holding("first", 0), holding("wide", 123, DataType::Float64)};
+    const QVector<ReadBlock> blocks = planReadBlocks(tags, 200);
+    ASSERT_EQ(blocks.size(), 2);
+    EXPECT_EQ(blocks[0].start, 0);
+    EXPECT_EQ(blocks[0].count, 1);
+    EXPECT_EQ(blocks[1].start, 123);
+    EXPECT_EQ(blocks[1].count, 4);
+
+    // 恰好 125 个寄存器时仍合并为一块
+    const QVector<TagSpec> fits = {holding("first", 0), holding("wide", 121, DataType::Float64)};
+    const QVector<ReadBlock> merged = planReadBlocks(fits, 200);
+    ASSERT_EQ(merged.size(), 1);
+    EXPECT_EQ(merged[0].count, kMaxReadRegisters);
+}
+
+TEST(ModbusTagChangeTest, FirstValueAndTypeChangeAreAlwaysReported) {
+    const QJsonValue unset(QJsonValue::Undefined);
+    EXPECT_TRUE(tagValueChanged(unset, 1.0, 100.0));
+    EXPECT_TRUE(tagValueChanged(unset, false, 0.0));
+    EXPECT_TRUE(tagValueChanged(QJsonValue(1.0), QJsonValue(true), 100.0));
+}
+
+TEST(ModbusTagChangeTest, NumbersRespectDeadband) {
+    // 死区为 0：任何变化都上报，相同值不上报
+    EXPECT_FALSE(tagValueChanged(20.0, 20.0, 0.0));
+    EXPECT_TRUE(tagValueChanged(20.0, 20.1, 0.0));
+
+    // 与上次上报值之差须严格大于死区
+    EXPECT_FALSE(tagValueChanged(20.0, 20.5, 0.5));
+    EXPECT_FALSE(tagValueChanged(20.0, 19.6, 0.5));
+    EXPECT_TRUE(tagValueChanged(20.0, 20.6, 0.5));
+    EXPECT_TRUE(tagValueChanged(20.0, 19.4, 0.5));
+}
+
+TEST(ModbusTagChangeTest, BooleansIgnoreDeadband) {
+    EXPECT_FALSE(tagValueChanged(true, true, 10.0));
+    EXPECT_TRUE(tagValueChanged(true, false, 10.0));
+}
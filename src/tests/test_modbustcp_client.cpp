@@ -13,6 +13,7 @@
 #include <chrono>
 #include <future>
 #include <functional>
+#include <memory>
 
 #include "driver_modbustcp/modbus_client.h"
 
@@ -270,3 +271,112 @@ TEST_F(ModbusTcpClientFragmentedResponseTest, FragmentedWriteSingleRegisterWaits
     EXPECT_TRUE(result.success) << result.errorMessage.toStdString();
     EXPECT_TRUE(result.errorMessage.isEmpty());
 }
+
+namespace {
+
+// 读保持寄存器应答：每个寄存器的值等于其地址，便于核对结果与请求的对应关系
+QByteArray buildAddressEchoResponse(const QByteArray& request) {
+    const quint16 address = readUInt16BE(request, 8);
+    const quint16 count = readUInt16BE(request, 10);
+    QByteArray pdu;
+    pdu.append(request[7]);
+    pdu.append(static_cast<char>(count * 2));
+    for (quint16 i = 0; i < count; ++i) {
+        pdu = appendUInt16BE(pdu, static_cast<quint16>(address + i));
+    }
+    return buildModbusTcpResponse(request, pdu);
+}
+
+QVector<modbus::ReadRequest> holdingRequests(const QVector<uint16_t>& addresses) {
+    QVector<modbus::ReadRequest> requests;
+    for (uint16_t address : addresses) {
+        requests.append({modbus::FunctionCode::ReadHoldingRegisters, address, 2});
+    }
+    return requests;
+}
+
+} // namespace
+
+TEST_F(ModbusTcpClientFragmentedResponseTest, PipelinedBatchMatchesOutOfOrderResponses) {
+    // 攒齐一个窗口的请求后倒序应答：只有请求被连续写出且按事务 ID 匹配时才能全部成功
+    auto held = std::make_shared<QVector<QByteArray>>();
+    m_device.setResponseBuilder([held](const QByteArray& request) {
+        held->append(request);
+        ResponsePlan plan;
+        if (held->size() == 3) {
+            for (int i = held->size() - 1; i >= 0; --i) {
+                plan.firstChunk.append(buildAddressEchoResponse(held->at(i)));
+            }
+            held->clear();
+        }
+        return plan;
+    });
+
+    auto future = std::async(std::launch::async, [port = m_device.port()]() {
+        modbus::ModbusClient client(800);
+        client.setPipelineWindow(3);
+        if (!client.connectToServer(QStringLiteral("127.0.0.1"), port)) {
+            return QVector<modbus::ModbusResult>{};
+        }
+        return client.readBatch(holdingRequests({0, 10, 20, 30, 40, 50}));
+    });
+
+    ASSERT_TRUE(waitForFutureWithEvents(future, 3000));
+    const QVector<modbus::ModbusResult> results = future.get();
+    ASSERT_EQ(results.size(), 6);
+    for (int i = 0; i < results.size(); ++i) {
+        ASSERT_TRUE(results[i].success) << i << ": " << results[i].errorMessage.toStdString();
+        ASSERT_EQ(results[i].registers.size(), 2);
+        EXPECT_EQ(results[i].registers[0], i * 10);
+        EXPECT_EQ(results[i].registers[1], i * 10 + 1);
+    }
+}
+
+TEST_F(ModbusTcpClientFragmentedResponseTest, PipelinedBatchTimesOutTransactionsIndependently) {
+    // 地址 10 的请求永不应答，其余事务不受影响，之后的同步请求也能正常完成
+    m_device.setResponseBuilder([](const QByteArray& request) {
+        ResponsePlan plan;
+        if (readUInt16BE(request, 8) != 10) {
+            plan.firstChunk = buildAddressEchoResponse(request);
+        }
+        return plan;
+    });
+
+    auto future = std::async(std::launch::async, [port = m_device.port()]() {
+        modbus::ModbusClient client(300);
+        client.setPipelineWindow(4);
+        QVector<modbus::ModbusResult> results;
+        if (!client.connectToServer(QStringLiteral("127.0.0.1"), port)) {
+            return results;
+        }
+        results = client.readBatch(holdingRequests({0, 10, 20}));
+        results.append(client.readHoldingRegisters(30, 2));
+        return results;
+    });
+
+    ASSERT_TRUE(waitForFutureWithEvents(future, 3000));
+    const QVector<modbus::ModbusResult> results = future.get();
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_TRUE(results[0].success);
+    EXPECT_FALSE(results[1].success);
+    EXPECT_EQ(results[1].errorMessage, QStringLiteral("Read timeout"));
+    EXPECT_TRUE(results[2].success);
+    ASSERT_TRUE(results[3].success) << results[3].errorMessage.toStdString();
+    EXPECT_EQ(results[3].registers.value(0), 30);
+}
+
+TEST(ModbusTcpClientPipelineTest, WindowIsClampedAndBatchFailsWhenDisconnected) {
+    modbus::ModbusClient client(100);
+    EXPECT_EQ(client.pipelineWindow(), 1);
+    client.setPipelineWindow(0);
+    EXPECT_EQ(client.pipelineWindow(), 1);
+    client.setPipelineWindow(1000);
+    EXPECT_EQ(client.pipelineWindow(), modbus::ModbusClient::kMaxPipelineWindow);
+
+    const QVector<modbus::ModbusResult> results = client.readBatch(holdingRequests({0, 10}));
+    ASSERT_EQ(results.size(), 2);
+    for (const modbus::ModbusResult& result : results) {
+        EXPECT_FALSE(result.success);
+        EXPECT_EQ(result.errorMessage, QStringLiteral("Not connected"));
+    }
+}
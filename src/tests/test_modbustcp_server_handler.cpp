@@ -448,3 +448,20 @@ TEST_F(ModbusTcpServerHandlerTest, T36_RunStartsServerAndReturnsWithoutBlocking)
     EXPECT_EQ(resp.lastCode, 0);
     EXPECT_TRUE(resp.lastData["stopped"].toBool());
 }
+
+// T37 — set_registers_batch 越界时整批不写入，报告首个越界地址
+TEST_F(ModbusTcpServerHandlerTest, T37_SetRegistersBatchOutOfRangeWritesNothing) {
+    addUnit(1, 100);
+    resp.reset();
+    handler.handle("set_registers_batch", QJsonObject{
+        {"unit_id",1},{"area","holding"},{"address",98},
+        {"values", QJsonArray{1, 2, 3}}}, resp);
+    EXPECT_EQ(resp.lastCode, 3);
+    EXPECT_EQ(resp.lastData["message"].toString(), "Address 100 out of range");
+
+    resp.reset();
+    handler.handle("get_registers_batch", QJsonObject{
+        {"unit_id",1},{"area","holding"},{"address",98},{"count",2}}, resp);
+    EXPECT_EQ(resp.lastCode, 0);
+    EXPECT_EQ(resp.lastData["values"].toArray(), (QJsonArray{0, 0}));
+}
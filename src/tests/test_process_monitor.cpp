@@ -263,3 +263,49 @@ TEST(ProcessMonitorTest, ProcessTreeIncludesChild) {
 }
 
 #endif // Q_OS_MACOS || Q_OS_LINUX
+
+#if defined(Q_OS_LINUX)
+
+TEST(ProcessSnapshotTest, CaptureContainsSelfAndParent) {
+    const ProcessSnapshot snapshot = ProcessSnapshot::capture();
+    const qint64 myPid = QCoreApplication::applicationPid();
+
+    const ProcessSnapshot::Entry* self = snapshot.find(myPid);
+    ASSERT_NE(self, nullptr);
+    EXPECT_EQ(self->parentPid, static_cast<qint64>(getppid()));
+    EXPECT_FALSE(self->name.isEmpty());
+    EXPECT_GT(self->memoryRssBytes, 0);
+    EXPECT_GE(self->threadCount, 1);
+    EXPECT_TRUE(snapshot.children(self->parentPid).contains(myPid));
+    EXPECT_EQ(snapshot.find(999999999), nullptr);
+}
+
+TEST(ProcessSnapshotTest, FamilyAndTreeFromSnapshot) {
+    ProcessMonitor monitor;
+    const qint64 myPid = QCoreApplication::applicationPid();
+
+    QProcess child;
+    child.start("sleep", {"10"});
+    ASSERT_TRUE(child.waitForStarted(3000));
+
+    const ProcessSnapshot snapshot = ProcessSnapshot::capture();
+    const QVector<ProcessInfo> family = monitor.getProcessFamily(myPid, true, snapshot);
+    bool foundChild = false;
+    for (const auto& p : family) {
+        if (p.pid == child.processId()) {
+            foundChild = true;
+            EXPECT_EQ(p.parentPid, myPid);
+            EXPECT_TRUE(p.commandLine.contains("sleep"));
+        }
+    }
+    EXPECT_TRUE(foundChild);
+
+    const ProcessTreeNode tree = monitor.getProcessTree(myPid, snapshot);
+    EXPECT_EQ(tree.info.pid, myPid);
+    EXPECT_GE(ProcessMonitor::summarize(tree).totalProcesses, 2);
+
+    child.terminate();
+    child.waitForFinished(3000);
+}
+
+#endif // Q_OS_LINUX
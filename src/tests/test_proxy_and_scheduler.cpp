@@ -8,12 +8,15 @@
 #include <QTextStream>
 
 #include <quickjs.h>
+#include "bindings/js_driver_pool.h"
+#include "bindings/js_driver_resolve_binding.h"
 #include "bindings/js_stdiolink_module.h"
 #include "bindings/js_time.h"
 #include "bindings/js_task_scheduler.h"
 #include "bindings/js_wait_any_scheduler.h"
 #include "engine/console_bridge.h"
 #include "engine/js_engine.h"
+#include "stdiolink/host/driver_pool.h"
 #include "stdiolink/platform/platform_utils.h"
 
 namespace {
@@ -93,26 +96,26 @@ protected:
         ConsoleBridge::install(m_engine->context());
         m_engine->registerModule("stdiolink", jsInitStdiolinkModule);
         m_engine->registerModule("stdiolink/time", stdiolink_service::JsTimeBinding::initModule);
+        m_engine->registerModule("stdiolink/driver",
+                                 stdiolink_service::JsDriverResolveBinding::initModule);
         stdiolink_service::JsTimeBinding::attachRuntime(m_engine->runtime());
+        stdiolink_service::JsDriverPoolBinding::setPool(m_engine->context(), &m_driverPool);
         JsTaskScheduler::installGlobal(m_engine->context(), m_scheduler.get());
         WaitAnyScheduler::installGlobal(m_engine->context(), m_waitAnyScheduler.get());
     }
 
     int runScript(const QString& path) {
         int ret = m_engine->evalFile(path);
-        while (m_scheduler->hasPending() || m_waitAnyScheduler->hasPending()
-               || m_engine->hasPendingJobs()
-               || stdiolink_service::JsTimeBinding::hasPending(m_engine->context())) {
-            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
-            if (m_scheduler->hasPending()) {
-                m_scheduler->poll(50);
-            }
-            if (m_waitAnyScheduler->hasPending()) {
-                m_waitAnyScheduler->poll(50);
-            }
+        // 与 stdiolink_service 主循环一致：Promise 由信号兑现，这里只执行微任务并等待事件
+        while (true) {
             while (m_engine->hasPendingJobs()) {
                 m_engine->executePendingJobs();
             }
+            if (!m_scheduler->hasPending() && !m_waitAnyScheduler->hasPending()
+                && !stdiolink_service::JsTimeBinding::hasPending(m_engine->context())) {
+                break;
+            }
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
         }
         if (ret == 0 && m_engine->hadJobError()) {
             ret = 1;
@@ -120,6 +123,7 @@ protected:
         return ret;
     }
 
+    stdiolink::DriverPool m_driverPool;  // 先于 m_engine 声明，保证晚于 JS 运行时析构
     std::unique_ptr<JsEngine> m_engine;
     std::unique_ptr<JsTaskScheduler> m_scheduler;
     std::unique_ptr<WaitAnyScheduler> m_waitAnyScheduler;
@@ -190,6 +194,31 @@ TEST_F(JsProxyTest, WaitAnyPreservesEventAndDone) {
     EXPECT_EQ(readGlobalInt(m_engine->context(), "ok"), 1);
 }
 
+TEST_F(JsProxyTest, WaitAnyTimeoutSettlesWithoutDriverActivity) {
+    const QString driverPath = slowCommandDriverPath();
+    ASSERT_TRUE(QFileInfo::exists(driverPath));
+
+    const QString scriptPath = writeScript(
+        m_tmpDir, "wait_any_timeout.js",
+        QString("import { openDriver, waitAny } from 'stdiolink';\n"
+                "(async () => {\n"
+                "  const drv = await openDriver('%1');\n"
+                "  const task = drv.$rawRequest('delayed_done', { delayMs: 2000 });\n"
+                "  const started = Date.now();\n"
+                "  const first = await waitAny([task], 30);\n"
+                "  const elapsed = Date.now() - started;\n"
+                "  globalThis.timedOut = (first === null) ? 1 : 0;\n"
+                "  globalThis.fast = (elapsed < 1000) ? 1 : 0;\n"
+                "  drv.$close();\n"
+                "})();\n")
+            .arg(escapeJsString(driverPath)));
+    ASSERT_FALSE(scriptPath.isEmpty());
+
+    EXPECT_EQ(runScript(scriptPath), 0);
+    EXPECT_EQ(readGlobalInt(m_engine->context(), "timedOut"), 1);
+    EXPECT_EQ(readGlobalInt(m_engine->context(), "fast"), 1);
+}
+
 TEST_F(JsProxyTest, WaitAnyConflictRejectsSamePendingTask) {
     const QString driverPath = calculatorDriverPath();
     ASSERT_TRUE(QFileInfo::exists(driverPath));
@@ -223,6 +252,65 @@ TEST_F(JsProxyTest, WaitAnyConflictRejectsSamePendingTask) {
     EXPECT_EQ(readGlobalInt(m_engine->context(), "ok"), 1);
 }
 
+TEST_F(JsProxyTest, AcquireDriverReusesWarmInstance) {
+    const QString driverPath = calculatorDriverPath();
+    ASSERT_TRUE(QFileInfo::exists(driverPath));
+
+    const QString scriptPath = writeScript(
+        m_tmpDir, "acquire_driver_reuse.js",
+        QString("import { acquireDriver, driverPoolStats } from 'stdiolink/driver';\n"
+                "(async () => {\n"
+                "  const first = await acquireDriver('%1');\n"
+                "  await first.add({ a: 1, b: 2 });\n"
+                "  first.$release();\n"
+                "  let releasedThrows = 0;\n"
+                "  try { first.$rawRequest('add', {}); } catch (e) { releasedThrows = 1; }\n"
+                "  const second = await acquireDriver('%1');\n"
+                "  const r = await second.add({ a: 2, b: 3 });\n"
+                "  second.$release();\n"
+                "  const stats = driverPoolStats('%1');\n"
+                "  globalThis.releasedThrows = releasedThrows;\n"
+                "  globalThis.created = stats.created;\n"
+                "  globalThis.reused = stats.reused;\n"
+                "  globalThis.sum = r.result;\n"
+                "})();\n")
+            .arg(escapeJsString(driverPath)));
+    ASSERT_FALSE(scriptPath.isEmpty());
+
+    EXPECT_EQ(runScript(scriptPath), 0);
+    EXPECT_EQ(readGlobalInt(m_engine->context(), "releasedThrows"), 1);
+    EXPECT_EQ(readGlobalInt(m_engine->context(), "created"), 1);
+    EXPECT_EQ(readGlobalInt(m_engine->context(), "reused"), 1);
+    EXPECT_EQ(readGlobalInt(m_engine->context(), "sum"), 5);
+}
+
+TEST_F(JsProxyTest, ReleaseWithOutstandingRawRequestThrowsBusy) {
+    const QString driverPath = calculatorDriverPath();
+    ASSERT_TRUE(QFileInfo::exists(driverPath));
+
+    const QString scriptPath = writeScript(
+        m_tmpDir, "acquire_driver_raw_busy.js",
+        QString("import { acquireDriver } from 'stdiolink/driver';\n"
+                "(async () => {\n"
+                "  const calc = await acquireDriver('%1');\n"
+                "  const task = calc.$rawRequest('add', { a: 1, b: 2 });\n"
+                "  let busyCaught = 0;\n"
+                "  try { calc.$release(); } catch (e) {\n"
+                "    if (String(e).includes('DriverBusyError')) busyCaught = 1;\n"
+                "  }\n"
+                "  while (!task.done) task.waitNext(1000);\n"
+                "  calc.$release();\n"
+                "  globalThis.busyCaught = busyCaught;\n"
+                "  globalThis.exitCode = task.exitCode;\n"
+                "})();\n")
+            .arg(escapeJsString(driverPath)));
+    ASSERT_FALSE(scriptPath.isEmpty());
+
+    EXPECT_EQ(runScript(scriptPath), 0);
+    EXPECT_EQ(readGlobalInt(m_engine->context(), "busyCaught"), 1);
+    EXPECT_EQ(readGlobalInt(m_engine->context(), "exitCode"), 0);
+}
+
 TEST_F(JsProxyTest, ImportOpenDriver) {
     const QString scriptPath =
         writeScript(m_tmpDir, "import_open_driver.js",
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QThread>
+
+#include "stdiolink_server/manager/resource_sampler.h"
+
+using namespace stdiolink_server;
+
+namespace {
+
+qint64 selfPid() {
+    return QCoreApplication::applicationPid();
+}
+
+} // namespace
+
+TEST(ResourceSamplerTest, UntrackedInstanceHasNoSamples) {
+    ResourceSampler sampler(0, 10);
+    sampler.sampleOnce();
+    EXPECT_FALSE(sampler.isTracked("inst_x"));
+    EXPECT_TRUE(sampler.query("inst_x", 0, 10).isEmpty());
+}
+
+TEST(ResourceSamplerTest, SamplesSelfProcess) {
+    if (!ProcessMonitor::isSupported()) {
+        GTEST_SKIP() << "Process monitoring not supported";
+    }
+    ResourceSampler sampler(0, 10);
+    sampler.track("inst_a", selfPid());
+    sampler.sampleOnce();
+    QThread::msleep(20);
+    sampler.sampleOnce();
+
+    const auto samples = sampler.query("inst_a", 0, 10);
+    ASSERT_EQ(samples.size(), 2);
+    EXPECT_LE(samples[0].timestampMs, samples[1].timestampMs);
+    EXPECT_GT(samples[1].memoryRssBytes, 0);
+    EXPECT_GE(samples[1].threadCount, 1);
+    EXPECT_GE(samples[1].processCount, 1);
+    EXPECT_GE(samples[1].cpuPercent, 0.0);
+}
+
+TEST(ResourceSamplerTest, RingKeepsNewestAndFiltersBySince) {
+    if (!ProcessMonitor::isSupported()) {
+        GTEST_SKIP() << "Process monitoring not supported";
+    }
+    ResourceSampler sampler(0, 3);
+    sampler.track("inst_a", selfPid());
+    for (int i = 0; i < 5; ++i) {
+        sampler.sampleOnce();
+        QThread::msleep(2);
+    }
+
+    const auto all = sampler.query("inst_a", 0, 100);
+    ASSERT_EQ(all.size(), 3);
+
+    const auto newer = sampler.query("inst_a", all[0].timestampMs, 100);
+    ASSERT_EQ(newer.size(), 2);
+    EXPECT_EQ(newer.last().timestampMs, all.last().timestampMs);
+
+    const auto limited = sampler.query("inst_a", 0, 1);
+    ASSERT_EQ(limited.size(), 1);
+    EXPECT_EQ(limited[0].timestampMs, all.last().timestampMs);
+}
+
+TEST(ResourceSamplerTest, UntrackDropsHistory) {
+    ResourceSampler sampler(0, 10);
+    sampler.track("inst_a", selfPid());
+    sampler.sampleOnce();
+    sampler.untrack("inst_a");
+    EXPECT_FALSE(sampler.isTracked("inst_a"));
+    EXPECT_TRUE(sampler.query("inst_a", 0, 10).isEmpty());
+}
+
+TEST(ResourceSamplerTest, BackgroundThreadCollectsSamples) {
+    if (!ProcessMonitor::isSupported()) {
+        GTEST_SKIP() << "Process monitoring not supported";
+    }
+    ResourceSampler sampler(200, 10);
+    sampler.track("inst_a", selfPid());
+    sampler.start();
+    ASSERT_TRUE(sampler.isRunning());
+
+    for (int i = 0; i < 50 && sampler.query("inst_a", 0, 10).size() < 2; ++i) {
+        QThread::msleep(20);
+    }
+    sampler.stop();
+    EXPECT_FALSE(sampler.isRunning());
+    EXPECT_GE(sampler.query("inst_a", 0, 10).size(), 2);
+}
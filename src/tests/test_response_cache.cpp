@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include "stdiolink_server/http/response_cache.h"
+
+using namespace stdiolink_server;
+
+TEST(ResponseCacheTest, ETagIsQuotedAndContentAddressed) {
+    const QByteArray a = ResponseCache::computeETag("{\"a\":1}");
+    EXPECT_TRUE(a.startsWith('"'));
+    EXPECT_TRUE(a.endsWith('"'));
+    EXPECT_EQ(a, ResponseCache::computeETag("{\"a\":1}"));
+    EXPECT_NE(a, ResponseCache::computeETag("{\"a\":2}"));
+}
+
+TEST(ResponseCacheTest, IfNoneMatchUsesWeakComparison) {
+    const QByteArray etag = ResponseCache::computeETag("body");
+    QByteArray deflated = etag;
+    deflated.insert(deflated.size() - 1, "-deflate");
+
+    EXPECT_TRUE(ResponseCache::matchesIfNoneMatch(etag, etag));
+    EXPECT_TRUE(ResponseCache::matchesIfNoneMatch("W/" + etag, etag));
+    EXPECT_TRUE(ResponseCache::matchesIfNoneMatch("\"other\", " + deflated, etag));
+    EXPECT_TRUE(ResponseCache::matchesIfNoneMatch(" * ", etag));
+    EXPECT_FALSE(ResponseCache::matchesIfNoneMatch("", etag));
+    EXPECT_FALSE(ResponseCache::matchesIfNoneMatch("\"other\"", etag));
+    EXPECT_FALSE(ResponseCache::matchesIfNoneMatch(etag.mid(1, etag.size() - 2), etag));
+}
+
+TEST(ResponseCacheTest, AcceptEncodingHonoursQuality) {
+    EXPECT_TRUE(ResponseCache::acceptsDeflate("gzip, deflate, br"));
+    EXPECT_TRUE(ResponseCache::acceptsDeflate("DEFLATE;q=0.5"));
+    EXPECT_TRUE(ResponseCache::acceptsDeflate("*"));
+    EXPECT_FALSE(ResponseCache::acceptsDeflate(""));
+    EXPECT_FALSE(ResponseCache::acceptsDeflate("identity"));
+    EXPECT_FALSE(ResponseCache::acceptsDeflate("gzip, deflate;q=0"));
+}
@@ -53,7 +53,7 @@ TEST(ScheduleTest, Daemon) {
 }
 
 TEST(ScheduleTest, UnknownType) {
-    const QJsonObject obj{{"type", "cron"}};
+    const QJsonObject obj{{"type", "calendar"}};
     QString error;
     (void)Schedule::fromJson(obj, error);
 
@@ -102,3 +102,58 @@ TEST(ScheduleTest, T04_ProjectToJsonIncludesRunTimeoutMs) {
     const QJsonObject obj = project.toJson();
     EXPECT_EQ(obj.value("schedule").toObject().value("runTimeoutMs").toInt(), 3000);
 }
+
+TEST(ScheduleTest, CronRoundTrips) {
+    const QJsonObject obj{
+        {"type", "cron"},
+        {"cron", "*/5 * * * *"},
+        {"jitterMs", 20000},
+        {"maxConcurrent", 2},
+    };
+    QString error;
+    const Schedule schedule = Schedule::fromJson(obj, error);
+
+    EXPECT_TRUE(error.isEmpty()) << qPrintable(error);
+    EXPECT_EQ(schedule.type, ScheduleType::Cron);
+    EXPECT_TRUE(schedule.cron.isValid());
+    EXPECT_EQ(schedule.jitterMs, 20000);
+    EXPECT_EQ(schedule.maxConcurrent, 2);
+
+    const QJsonObject out = schedule.toJson();
+    EXPECT_EQ(out.value("type").toString(), "cron");
+    EXPECT_EQ(out.value("cron").toString(), "*/5 * * * *");
+    EXPECT_EQ(out.value("jitterMs").toInt(), 20000);
+}
+
+TEST(ScheduleTest, CronMissingOrInvalidExpressionRejected) {
+    QString error;
+    (void)Schedule::fromJson(QJsonObject{{"type", "cron"}}, error);
+    EXPECT_TRUE(error.contains("schedule.cron"));
+
+    (void)Schedule::fromJson(QJsonObject{{"type", "cron"}, {"cron", "61 * * * *"}}, error);
+    EXPECT_TRUE(error.contains("schedule.cron"));
+}
+
+TEST(ScheduleTest, FixedRateAlignmentAndJitter) {
+    const QJsonObject obj{
+        {"type", "fixed_rate"},
+        {"intervalMs", 60000},
+        {"alignToInterval", true},
+        {"jitterMs", 5000},
+    };
+    QString error;
+    const Schedule schedule = Schedule::fromJson(obj, error);
+
+    EXPECT_TRUE(error.isEmpty()) << qPrintable(error);
+    EXPECT_TRUE(schedule.alignToInterval);
+    EXPECT_EQ(schedule.jitterMs, 5000);
+    EXPECT_TRUE(schedule.toJson().value("alignToInterval").toBool());
+}
+
+TEST(ScheduleTest, FixedRateJitterMustBeBelowInterval) {
+    const QJsonObject obj{{"type", "fixed_rate"}, {"intervalMs", 1000}, {"jitterMs", 1000}};
+    QString error;
+    (void)Schedule::fromJson(obj, error);
+
+    EXPECT_TRUE(error.contains("jitterMs"));
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <QCoreApplication>
+#include <QDateTime>
 #include <QDir>
 #include <QElapsedTimer>
 #include <QFileInfo>
@@ -12,6 +13,7 @@
 #include "stdiolink_server/config/server_config.h"
 #include "stdiolink_server/manager/instance_manager.h"
 #include "stdiolink_server/manager/schedule_engine.h"
+#include "stdiolink_server/model/cron_expression.h"
 
 using namespace stdiolink_server;
 
@@ -228,3 +230,75 @@ TEST_F(ScheduleEngineTest, ResumeProjectAllowsDaemonRestartAgain) {
 
     ASSERT_TRUE(waitUntil([&]() { return startCount >= stoppedAt + 2; }, 2500));
 }
+
+TEST(ScheduleEngineNextFireTest, FixedRateAlignsAndSkipsMissedPeriods) {
+    Schedule schedule;
+    schedule.type = ScheduleType::FixedRate;
+    schedule.intervalMs = 1000;
+
+    EXPECT_EQ(ScheduleEngine::nextNominalFireMs(schedule, 10250), 11250);
+    EXPECT_EQ(ScheduleEngine::nextNominalFireMs(schedule, 10250, 10000), 11000);
+    // 落后 3 个周期时直接跳到 now 之后的下一个周期
+    EXPECT_EQ(ScheduleEngine::nextNominalFireMs(schedule, 13500, 10000), 14000);
+
+    schedule.alignToInterval = true;
+    EXPECT_EQ(ScheduleEngine::nextNominalFireMs(schedule, 10250), 11000);
+}
+
+TEST(ScheduleEngineNextFireTest, CronUsesExpression) {
+    Schedule schedule;
+    schedule.type = ScheduleType::Cron;
+    QString error;
+    schedule.cron = CronExpression::parse("0 * * * *", error);
+    ASSERT_TRUE(schedule.cron.isValid());
+
+    const QDateTime now(QDate(2026, 3, 10), QTime(8, 15));
+    const qint64 next = ScheduleEngine::nextNominalFireMs(schedule, now.toMSecsSinceEpoch());
+    EXPECT_EQ(QDateTime::fromMSecsSinceEpoch(next), QDateTime(QDate(2026, 3, 10), QTime(9, 0)));
+}
+
+TEST_F(ScheduleEngineTest, TimedProjectsShareOneQueueAndReportNextFire) {
+    QMap<QString, Project> projects;
+    for (const QString& id : {QStringLiteral("a"), QStringLiteral("b")}) {
+        Project p = makeProject(id, ScheduleType::FixedRate, 0, 0);
+        p.schedule.intervalMs = 60000;
+        projects.insert(id, p);
+    }
+    scheduleEngine->startAll(projects, services);
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (const QString& id : {QStringLiteral("a"), QStringLiteral("b")}) {
+        const auto state = scheduleEngine->projectRuntimeState(id);
+        EXPECT_TRUE(state.timerActive);
+        EXPECT_GT(state.nextFireMs, now);
+    }
+
+    scheduleEngine->stopProject("a");
+    EXPECT_FALSE(scheduleEngine->projectRuntimeState("a").timerActive);
+    EXPECT_TRUE(scheduleEngine->projectRuntimeState("b").timerActive);
+}
+
+TEST_F(ScheduleEngineTest, GlobalLimitQueuesStartsAcrossProjects) {
+    scheduleEngine->setGlobalMaxConcurrent(1);
+
+    QMap<QString, Project> projects;
+    for (const QString& id : {QStringLiteral("a"), QStringLiteral("b")}) {
+        Project p = makeProject(id, ScheduleType::FixedRate, 0, 400);
+        p.schedule.intervalMs = 100;
+        projects.insert(id, p);
+    }
+
+    int maxRunning = 0;
+    QSet<QString> startedProjects;
+    QObject::connect(instanceMgr.get(), &InstanceManager::instanceStarted,
+                     [&](const QString&, const QString& projectId) {
+                         startedProjects.insert(projectId);
+                         maxRunning = qMax(maxRunning, instanceMgr->instanceCount());
+                     });
+
+    scheduleEngine->startAll(projects, services);
+
+    ASSERT_TRUE(waitUntil([&]() { return startedProjects.size() == 2; }, 5000));
+    EXPECT_EQ(maxRunning, 1);
+    EXPECT_LE(scheduleEngine->scheduledRunningCount(), 1);
+}
@@ -217,3 +217,115 @@ TEST(ServerConfigTest, LogFieldsDefaultValues) {
     EXPECT_EQ(cfg.logMaxFiles, 3);
 }
 
+
+// --- metricsIntervalMs / metricsHistorySize ---
+
+TEST(ServerConfigTest, MetricsFieldsParsed) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filePath = dir.path() + "/config.json";
+    const QJsonObject obj{{"metricsIntervalMs", 0}, {"metricsHistorySize", 60}};
+    ASSERT_TRUE(writeFile(filePath, QJsonDocument(obj).toJson(QJsonDocument::Compact)));
+
+    QString error;
+    const auto cfg = ServerConfig::loadFromFile(filePath, error);
+    EXPECT_TRUE(error.isEmpty()) << qPrintable(error);
+    EXPECT_EQ(cfg.metricsIntervalMs, 0);
+    EXPECT_EQ(cfg.metricsHistorySize, 60);
+}
+
+TEST(ServerConfigTest, MetricsIntervalTooSmallRejected) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filePath = dir.path() + "/config.json";
+    const QJsonObject obj{{"metricsIntervalMs", 50}};
+    ASSERT_TRUE(writeFile(filePath, QJsonDocument(obj).toJson(QJsonDocument::Compact)));
+
+    QString error;
+    (void)ServerConfig::loadFromFile(filePath, error);
+    EXPECT_FALSE(error.isEmpty());
+}
+
+TEST(ServerConfigTest, MetricsHistorySizeZeroRejected) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filePath = dir.path() + "/config.json";
+    const QJsonObject obj{{"metricsHistorySize", 0}};
+    ASSERT_TRUE(writeFile(filePath, QJsonDocument(obj).toJson(QJsonDocument::Compact)));
+
+    QString error;
+    (void)ServerConfig::loadFromFile(filePath, error);
+    EXPECT_FALSE(error.isEmpty());
+}
+
+// --- sseMaxConnections ---
+
+TEST(ServerConfigTest, SseMaxConnectionsParsed) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filePath = dir.path() + "/config.json";
+    const QJsonObject obj{{"sseMaxConnections", 2000}};
+    ASSERT_TRUE(writeFile(filePath, QJsonDocument(obj).toJson(QJsonDocument::Compact)));
+
+    QString error;
+    const auto cfg = ServerConfig::loadFromFile(filePath, error);
+    EXPECT_TRUE(error.isEmpty()) << qPrintable(error);
+    EXPECT_EQ(cfg.sseMaxConnections, 2000);
+}
+
+TEST(ServerConfigTest, SseMaxConnectionsOutOfRangeRejected) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filePath = dir.path() + "/config.json";
+    const QJsonObject obj{{"sseMaxConnections", 0}};
+    ASSERT_TRUE(writeFile(filePath, QJsonDocument(obj).toJson(QJsonDocument::Compact)));
+
+    QString error;
+    (void)ServerConfig::loadFromFile(filePath, error);
+    EXPECT_FALSE(error.isEmpty());
+}
+
+// --- scheduleMaxConcurrent ---
+
+TEST(ServerConfigTest, ScheduleMaxConcurrentParsed) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filePath = dir.path() + "/config.json";
+    const QJsonObject obj{{"scheduleMaxConcurrent", 16}};
+    ASSERT_TRUE(writeFile(filePath, QJsonDocument(obj).toJson(QJsonDocument::Compact)));
+
+    QString error;
+    const auto cfg = ServerConfig::loadFromFile(filePath, error);
+    EXPECT_TRUE(error.isEmpty()) << qPrintable(error);
+    EXPECT_EQ(cfg.scheduleMaxConcurrent, 16);
+}
+
+// --- watchDataRoot / watchDebounceMs ---
+
+TEST(ServerConfigTest, WatchOptionsParsed) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filePath = dir.path() + "/config.json";
+    const QJsonObject obj{{"watchDataRoot", false}, {"watchDebounceMs", 1500}};
+    ASSERT_TRUE(writeFile(filePath, QJsonDocument(obj).toJson(QJsonDocument::Compact)));
+
+    QString error;
+    const auto cfg = ServerConfig::loadFromFile(filePath, error);
+    EXPECT_TRUE(error.isEmpty()) << qPrintable(error);
+    EXPECT_FALSE(cfg.watchDataRoot);
+    EXPECT_EQ(cfg.watchDebounceMs, 1500);
+}
+
+TEST(ServerConfigTest, WatchOptionsInvalidRejected) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filePath = dir.path() + "/config.json";
+
+    for (const QJsonObject& obj : {QJsonObject{{"watchDataRoot", 1}},
+                                   QJsonObject{{"watchDebounceMs", 10}}}) {
+        ASSERT_TRUE(writeFile(filePath, QJsonDocument(obj).toJson(QJsonDocument::Compact)));
+        QString error;
+        (void)ServerConfig::loadFromFile(filePath, error);
+        EXPECT_FALSE(error.isEmpty());
+    }
+}
@@ -3,12 +3,16 @@
 #include <QCoreApplication>
 #include <QDir>
 #include <QElapsedTimer>
+#include <QEventLoop>
 #include <QFile>
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QSignalSpy>
 #include <QTemporaryDir>
 #include <QTextStream>
+#include <QThreadPool>
+#include <functional>
 
 #include "stdiolink_server/server_manager.h"
 
@@ -188,6 +192,206 @@ TEST(ServerManagerTest, RescanServicesRevalidatesProjects) {
     EXPECT_FALSE(manager.projects().value("p1").valid);
 }
 
+TEST(ServerManagerTest, ApplyServiceChangesTouchesOnlyGivenEntries) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    const QString root = tmp.path();
+    ASSERT_TRUE(QDir().mkpath(root + "/projects"));
+    writeService(root, "demo");
+    writeService(root, "other");
+    writeProject(root, "p1", "demo");
+
+    ServerConfig cfg;
+    cfg.serviceProgram = testBinaryPath("test_service_stub");
+    cfg.watchDataRoot = false;
+
+    ServerManager manager(root, cfg);
+    QString error;
+    ASSERT_TRUE(manager.initialize(error));
+    ASSERT_EQ(manager.catalogWatcher(), nullptr);
+
+    QStringList events;
+    QObject::connect(manager.eventBus(), &EventBus::eventPublished,
+                     [&events](const ServerEvent& event) {
+                         events << event.type + ":" + event.data.value("serviceId").toString()
+                                       + event.data.value("projectId").toString();
+                     });
+
+    // other 的变更不在本次条目中，不应被处理
+    ASSERT_TRUE(writeText(root + "/services/other/manifest.json",
+                          "{\"manifestVersion\":\"1\",\"id\":\"other\",\"name\":\"X\",\"version\":\"2.0.0\"}"));
+    ASSERT_TRUE(QDir(root + "/services/demo").removeRecursively());
+    writeService(root, "fresh");
+
+    manager.applyServiceChanges({"demo", "fresh"});
+    EXPECT_FALSE(manager.services().contains("demo"));
+    EXPECT_TRUE(manager.services().contains("fresh"));
+    EXPECT_EQ(manager.services().value("other").version, "1.0.0");
+    EXPECT_FALSE(manager.projects().value("p1").valid);
+    EXPECT_EQ(events, (QStringList{"service.removed:demo", "service.added:fresh",
+                                   "project.updated:p1"}));
+
+    // 未变化的条目不产生事件
+    events.clear();
+    manager.applyServiceChanges({"fresh"});
+    EXPECT_TRUE(events.isEmpty());
+}
+
+TEST(ServerManagerTest, ApplyProjectChangesReloadsSingleProject) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    const QString root = tmp.path();
+    writeService(root, "demo");
+    writeProject(root, "p1", "demo");
+
+    ServerConfig cfg;
+    cfg.serviceProgram = testBinaryPath("test_service_stub");
+    cfg.watchDataRoot = false;
+
+    ServerManager manager(root, cfg);
+    QString error;
+    ASSERT_TRUE(manager.initialize(error));
+
+    QStringList events;
+    QObject::connect(manager.eventBus(), &EventBus::eventPublished,
+                     [&events](const ServerEvent& event) {
+                         events << event.type + ":" + event.data.value("projectId").toString();
+                     });
+
+    writeProject(root, "p2", "demo");
+    manager.applyProjectChanges({"p1", "p2"});
+    EXPECT_TRUE(manager.projects().value("p2").valid);
+    EXPECT_EQ(events, QStringList{"project.added:p2"});
+
+    // HTTP 接口修改中的项目暂不处理
+    events.clear();
+    manager.setProjectBusyCheck([](const QString& id) { return id == "p2"; });
+    ASSERT_TRUE(QDir(root + "/projects/p2").removeRecursively());
+    ASSERT_TRUE(QDir(root + "/projects/p1").removeRecursively());
+    manager.applyProjectChanges({"p1", "p2"});
+    EXPECT_FALSE(manager.projects().contains("p1"));
+    EXPECT_TRUE(manager.projects().contains("p2"));
+    EXPECT_EQ(events, QStringList{"project.removed:p1"});
+}
+
+TEST(ServerManagerTest, ApplyDriverChangesExportsSingleDriver) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    const QString root = tmp.path();
+    ASSERT_TRUE(QDir().mkpath(root + "/drivers"));
+
+    ServerConfig cfg;
+    cfg.serviceProgram = testBinaryPath("test_service_stub");
+    cfg.watchDataRoot = false;
+
+    ServerManager manager(root, cfg);
+    QString error;
+    ASSERT_TRUE(manager.initialize(error));
+    ASSERT_FALSE(manager.driverCatalog()->hasDriver("test-meta-driver"));
+
+    const QString metaDriver = testBinaryPath("test_meta_driver");
+    ASSERT_TRUE(QFileInfo::exists(metaDriver));
+    ASSERT_TRUE(QDir().mkpath(root + "/drivers/good"));
+    ASSERT_TRUE(copyExecutable(metaDriver, root + "/drivers/good/stdio.drv.driver_under_test" + exeSuffix()));
+
+    QSignalSpy spy(manager.eventBus(), &EventBus::eventPublished);
+    manager.applyDriverChanges({"good"});
+    ASSERT_TRUE(spy.wait(15000));
+    EXPECT_EQ(spy.at(0).at(0).value<ServerEvent>().type, "driver.added");
+    EXPECT_TRUE(manager.driverCatalog()->hasDriver("test-meta-driver"));
+    EXPECT_TRUE(QFileInfo::exists(root + "/drivers/good/driver.meta.json"));
+
+    ASSERT_TRUE(QDir(root + "/drivers/good").removeRecursively());
+    manager.applyDriverChanges({"good"});
+    ASSERT_TRUE(spy.wait(5000));
+    EXPECT_EQ(spy.last().at(0).value<ServerEvent>().type, "driver.removed");
+    EXPECT_FALSE(manager.driverCatalog()->hasDriver("test-meta-driver"));
+}
+
+TEST(ServerManagerTest, ApplyDriverChangesWaitsForFullRescan) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    const QString root = tmp.path();
+    const QString metaDriver = testBinaryPath("test_meta_driver");
+    ASSERT_TRUE(QFileInfo::exists(metaDriver));
+    ASSERT_TRUE(QDir().mkpath(root + "/drivers/good"));
+    ASSERT_TRUE(copyExecutable(metaDriver, root + "/drivers/good/stdio.drv.driver_under_test" + exeSuffix()));
+
+    ServerConfig cfg;
+    cfg.serviceProgram = testBinaryPath("test_service_stub");
+    cfg.watchDataRoot = false;
+
+    ServerManager manager(root, cfg);
+    QString error;
+    ASSERT_TRUE(manager.initialize(error));
+    ASSERT_TRUE(manager.driverCatalog()->hasDriver("test-meta-driver"));
+
+    auto waitUntil = [](const std::function<bool()>& done, int timeoutMs) {
+        QElapsedTimer timer;
+        timer.start();
+        while (!done() && timer.elapsed() < timeoutMs) {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 20);
+        }
+        return done();
+    };
+
+    // 全量扫描可能在目录删除前已读到该驱动；删除触发的增量扫描若与其并行，
+    // 会被随后完成的全量结果覆盖。推迟到全量扫描之后执行，最终状态必须是已删除
+    QFuture<DriverManagerScanner::ScanStats> scan = manager.rescanDriversAsync();
+    ASSERT_TRUE(QDir(root + "/drivers/good").removeRecursively());
+    manager.applyDriverChanges({"good"});
+
+    ASSERT_TRUE(waitUntil([&scan]() { return scan.isFinished(); }, 15000));
+    EXPECT_TRUE(waitUntil([&manager]() {
+        return !manager.driverCatalog()->hasDriver("test-meta-driver");
+    }, 5000));
+    // 推迟的补扫完成后不会再被任何在途结果改回
+    waitUntil([]() { return false; }, 300);
+    EXPECT_FALSE(manager.driverCatalog()->hasDriver("test-meta-driver"));
+}
+
+TEST(ServerManagerTest, ApplyDriverChangesKeepsDirectoryBeingInstalled) {
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    const QString root = tmp.path();
+    ASSERT_TRUE(QDir().mkpath(root + "/drivers"));
+
+    ServerConfig cfg;
+    cfg.serviceProgram = testBinaryPath("test_service_stub");
+    cfg.watchDataRoot = false;
+
+    ServerManager manager(root, cfg);
+    QString error;
+    ASSERT_TRUE(manager.initialize(error));
+
+    // 监视器在目录刚创建、可执行文件尚未拷入时就会触发增量扫描
+    ASSERT_TRUE(QDir().mkpath(root + "/drivers/foo"));
+    QSignalSpy spy(manager.eventBus(), &EventBus::eventPublished);
+    manager.applyDriverChanges({"foo"});
+    ASSERT_TRUE(QThreadPool::globalInstance()->waitForDone(5000));
+    QCoreApplication::processEvents();
+    EXPECT_TRUE(QFileInfo(root + "/drivers/foo").isDir());
+    EXPECT_FALSE(QFileInfo::exists(root + "/drivers/foo.failed"));
+    EXPECT_EQ(spy.count(), 0);
+
+    // 拷入可执行文件后的下一次变更正常导出
+    const QString metaDriver = testBinaryPath("test_meta_driver");
+    ASSERT_TRUE(QFileInfo::exists(metaDriver));
+    ASSERT_TRUE(copyExecutable(metaDriver, root + "/drivers/foo/stdio.drv.driver_under_test" + exeSuffix()));
+    manager.applyDriverChanges({"foo"});
+
+    ASSERT_TRUE(spy.wait(15000));
+    EXPECT_EQ(spy.at(0).at(0).value<ServerEvent>().type, "driver.added");
+    EXPECT_TRUE(QFileInfo(root + "/drivers/foo").isDir());
+    EXPECT_FALSE(QFileInfo::exists(root + "/drivers/foo.failed"));
+    EXPECT_TRUE(manager.driverCatalog()->hasDriver("test-meta-driver"));
+}
+
 TEST(ServerManagerTest, InitializeFailsWhenDataRootMissing) {
     ServerConfig cfg;
     ServerManager manager("/path/does/not/exist", cfg);
@@ -110,6 +110,9 @@ describe('EventStream', () => {
       'instance.finished',
       'schedule.triggered',
       'schedule.suppressed',
+      'service.added',
+      'project.updated',
+      'driver.removed',
     ];
     for (const type of types) {
       const cb = vi.fn();
@@ -119,6 +122,22 @@ describe('EventStream', () => {
     }
   });
 
+  it('emits resync on dropped and reset notices', () => {
+    const resyncCb = vi.fn();
+    const eventCb = vi.fn();
+    stream.on('resync', resyncCb);
+    stream.on('event', eventCb);
+    stream.connect();
+    lastEs().simulateEvent('dropped', { dropped: 3, totalDropped: 3, lastEventId: 'k-9' });
+    lastEs().simulateEvent('reset', { lastEventId: 'k-9' });
+    expect(resyncCb).toHaveBeenNthCalledWith(1, {
+      type: 'dropped',
+      data: { dropped: 3, totalDropped: 3, lastEventId: 'k-9' },
+    });
+    expect(resyncCb).toHaveBeenNthCalledWith(2, { type: 'reset', data: { lastEventId: 'k-9' } });
+    expect(eventCb).not.toHaveBeenCalled();
+  });
+
   it('close() closes EventSource', () => {
     stream.connect();
     const es = lastEs();
@@ -0,0 +1,73 @@
+import { describe, it, expect, vi, beforeEach, afterEach } from 'vitest';
+import { LogStream } from '../log-stream';
+
+class MockEventSource {
+  static instances: MockEventSource[] = [];
+
+  url: string;
+  closed = false;
+  private eventListeners = new Map<string, ((e: Event) => void)[]>();
+
+  constructor(url: string) {
+    this.url = url;
+    MockEventSource.instances.push(this);
+  }
+
+  addEventListener(type: string, listener: (e: Event) => void) {
+    if (!this.eventListeners.has(type)) this.eventListeners.set(type, []);
+    this.eventListeners.get(type)!.push(listener);
+  }
+
+  close() {
+    this.closed = true;
+  }
+
+  simulateEvent(type: string, data: unknown, lastEventId = '') {
+    const listeners = this.eventListeners.get(type) || [];
+    const event = { data: JSON.stringify(data), lastEventId } as unknown as Event;
+    listeners.forEach((l) => l(event));
+  }
+}
+
+function lastEs(): MockEventSource {
+  return MockEventSource.instances[MockEventSource.instances.length - 1]!;
+}
+
+describe('LogStream', () => {
+  const originalEventSource = globalThis.EventSource;
+
+  beforeEach(() => {
+    MockEventSource.instances = [];
+    (globalThis as any).EventSource = MockEventSource as any;
+  });
+
+  afterEach(() => {
+    (globalThis as any).EventSource = originalEventSource;
+  });
+
+  it('connect() builds tail and resume URLs', () => {
+    const stream = new LogStream(vi.fn());
+    stream.connect('inst-1', { lines: 200 });
+    expect(lastEs().url).toBe('/api/instances/inst-1/logs/stream?lines=200');
+
+    stream.connect('inst-1', { fileId: 'abc', offset: 42, lines: 200 });
+    expect(MockEventSource.instances[0]!.closed).toBe(true);
+    expect(lastEs().url).toBe('/api/instances/inst-1/logs/stream?offset=42&fileId=abc');
+  });
+
+  it('delivers log batches with cursor and reset flag', () => {
+    const onLines = vi.fn();
+    const stream = new LogStream(onLines);
+    stream.connect('inst-1');
+    lastEs().simulateEvent('log', { lines: ['a', 'b'], reset: true }, 'abc:10');
+    expect(onLines).toHaveBeenCalledWith({ lines: ['a', 'b'], cursor: 'abc:10', reset: true });
+  });
+
+  it('reports dropped lines', () => {
+    const onDropped = vi.fn();
+    const stream = new LogStream(vi.fn(), onDropped);
+    stream.connect('inst-1');
+    lastEs().simulateEvent('dropped', { dropped: 5, totalDropped: 7 });
+    expect(onDropped).toHaveBeenCalledWith({ dropped: 5, totalDropped: 7 });
+  });
+});
@@ -17,6 +17,15 @@ export class EventStream {
       'instance.finished',
       'schedule.triggered',
       'schedule.suppressed',
+      'service.added',
+      'service.updated',
+      'service.removed',
+      'project.added',
+      'project.updated',
+      'project.removed',
+      'driver.added',
+      'driver.updated',
+      'driver.removed',
     ];
 
     for (const type of eventTypes) {
@@ -27,6 +36,14 @@ export class EventStream {
         this.emit(type, event);
       });
     }
+
+    // 服务端无法补齐断线/积压期间的事件时，提示订阅者重新拉取状态
+    for (const type of ['dropped', 'reset']) {
+      this.es.addEventListener(type, (e: Event) => {
+        const me = e as MessageEvent;
+        this.emit('resync', { type, data: JSON.parse(me.data) });
+      });
+    }
   }
 
   close(): void {
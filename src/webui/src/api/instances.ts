@@ -1,5 +1,10 @@
 import apiClient from './client';
-import type { Instance, ProcessTreeResponse, ResourcesResponse } from '@/types/instance';
+import type {
+  Instance,
+  MetricsResponse,
+  ProcessTreeResponse,
+  ResourcesResponse,
+} from '@/types/instance';
 
 export const instancesApi = {
   list: (params?: { projectId?: string }) =>
@@ -16,8 +21,17 @@ export const instancesApi = {
   resources: (id: string, params?: { includeChildren?: boolean }) =>
     apiClient.get<ResourcesResponse>(`/instances/${id}/resources`, { params }).then((r) => r.data),
 
-  logs: (id: string, params?: { lines?: number }) =>
+  metrics: (id: string, params?: { since?: number | string; limit?: number }) =>
+    apiClient.get<MetricsResponse>(`/instances/${id}/metrics`, { params }).then((r) => r.data),
+
+  logs: (id: string, params?: { lines?: number; offset?: number; fileId?: string }) =>
     apiClient
-      .get<{ projectId: string; lines: string[] }>(`/instances/${id}/logs`, { params })
+      .get<{
+        projectId: string;
+        lines: string[];
+        fileId: string;
+        nextOffset: number;
+        reset?: boolean;
+      }>(`/instances/${id}/logs`, { params })
       .then((r) => r.data),
 };
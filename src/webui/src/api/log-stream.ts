@@ -0,0 +1,58 @@
+export interface LogStreamBatch {
+  lines: string[];
+  /** 续传游标 `<fileId>:<offset>`，断线后可作为 Last-Event-ID 或拆成 offset/fileId 使用 */
+  cursor: string;
+  /** 游标失效或积压过多，lines 为日志尾部，调用方应清空已显示内容 */
+  reset: boolean;
+}
+
+export interface LogStreamDropped {
+  dropped: number;
+  totalDropped: number;
+}
+
+export interface LogStreamOptions {
+  /** 首次连接补发的尾部行数（0-5000，默认 100） */
+  lines?: number;
+  /** 从指定游标续传，优先于 lines */
+  fileId?: string;
+  offset?: number;
+}
+
+/** 订阅 /api/instances/{id}/logs/stream（SSE），浏览器自动重连时经 Last-Event-ID 续传 */
+export class LogStream {
+  private es: EventSource | null = null;
+
+  constructor(
+    private readonly onLines: (batch: LogStreamBatch) => void,
+    private readonly onDropped?: (info: LogStreamDropped) => void,
+  ) {}
+
+  connect(instanceId: string, options: LogStreamOptions = {}): void {
+    this.close();
+    const params = new URLSearchParams();
+    if (options.offset !== undefined) {
+      params.set('offset', String(options.offset));
+      params.set('fileId', options.fileId ?? '');
+    } else if (options.lines !== undefined) {
+      params.set('lines', String(options.lines));
+    }
+
+    this.es = new EventSource(
+      `/api/instances/${encodeURIComponent(instanceId)}/logs/stream?${params}`,
+    );
+    this.es.addEventListener('log', (e: Event) => {
+      const me = e as MessageEvent;
+      const data = JSON.parse(me.data) as { lines: string[]; reset?: boolean };
+      this.onLines({ lines: data.lines, cursor: me.lastEventId, reset: data.reset === true });
+    });
+    this.es.addEventListener('dropped', (e: Event) => {
+      this.onDropped?.(JSON.parse((e as MessageEvent).data) as LogStreamDropped);
+    });
+  }
+
+  close(): void {
+    this.es?.close();
+    this.es = null;
+  }
+}
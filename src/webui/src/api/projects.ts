@@ -43,8 +43,15 @@ export const projectsApi = {
   setEnabled: (id: string, enabled: boolean) =>
     apiClient.patch<Project>(`/projects/${id}/enabled`, { enabled }).then((r) => r.data),
 
-  logs: (id: string, params?: { lines?: number }) =>
+  logs: (id: string, params?: { lines?: number; offset?: number; fileId?: string }) =>
     apiClient
-      .get<{ projectId: string; lines: string[]; logPath: string }>(`/projects/${id}/logs`, { params })
+      .get<{
+        projectId: string;
+        lines: string[];
+        logPath: string;
+        fileId: string;
+        nextOffset: number;
+        reset?: boolean;
+      }>(`/projects/${id}/logs`, { params })
       .then((r) => r.data),
 };
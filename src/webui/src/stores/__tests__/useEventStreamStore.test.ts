@@ -151,6 +151,17 @@ describe('useEventStreamStore', () => {
     expect(state.recentEvents).toHaveLength(1);
   });
 
+  it('catalog change events refetch the matching list', () => {
+    useEventStreamStore.getState().connect();
+    const eventCb = mockOnCallbacks.get('event');
+    eventCb!({ type: 'service.updated', data: { serviceId: 's1' } });
+    eventCb!({ type: 'project.removed', data: { projectId: 'p1' } });
+    eventCb!({ type: 'driver.added', data: { driverId: 'd1' } });
+    expect(storeSpies.servicesFetchServices).toHaveBeenCalledTimes(1);
+    expect(storeSpies.projectsFetchProjects).toHaveBeenCalledTimes(1);
+    expect(storeSpies.driversFetchDrivers).toHaveBeenCalledTimes(1);
+  });
+
   it('recentEvents caps at 50', () => {
     const events = Array.from({ length: 50 }, (_, i) => ({
       type: 'instance.started',
@@ -69,7 +69,12 @@ describe('useInstancesStore', () => {
   });
 
   it('fetchLogs updates logs', async () => {
-    vi.mocked(instancesApi.logs).mockResolvedValue({ projectId: 'p1', lines: ['[INFO] started', '[ERROR] fail'] });
+    vi.mocked(instancesApi.logs).mockResolvedValue({
+      projectId: 'p1',
+      lines: ['[INFO] started', '[ERROR] fail'],
+      fileId: 'f1',
+      nextOffset: 32,
+    });
     await useInstancesStore.getState().fetchLogs('inst-1');
     expect(useInstancesStore.getState().logs).toHaveLength(2);
   });
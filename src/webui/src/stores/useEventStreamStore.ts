@@ -49,6 +49,21 @@ export function dispatchEvent(event: ServerEvent): void {
     case 'schedule.suppressed':
       useDashboardStore.getState().addEvent(event);
       break;
+    case 'service.added':
+    case 'service.updated':
+    case 'service.removed':
+      useServicesStore.getState().fetchServices();
+      break;
+    case 'project.added':
+    case 'project.updated':
+    case 'project.removed':
+      useProjectsStore.getState().fetchProjects();
+      break;
+    case 'driver.added':
+    case 'driver.updated':
+    case 'driver.removed':
+      useDriversStore.getState().fetchDrivers();
+      break;
     case 'project.status_changed':
       // Backend pending - branch reserved
       useProjectsStore.getState().fetchProjects();
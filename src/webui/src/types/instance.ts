@@ -61,3 +61,22 @@ export interface ProcessInfo {
   ioReadBytes: number;
   ioWriteBytes: number;
 }
+
+export interface ResourceSample {
+  ts: number;
+  cpuPercent: number;
+  memoryRssBytes: number;
+  ioReadBytes: number;
+  ioWriteBytes: number;
+  threadCount: number;
+  processCount: number;
+}
+
+export interface MetricsResponse {
+  instanceId: string;
+  pid: number;
+  intervalMs: number;
+  historySize: number;
+  samples: ResourceSample[];
+  nextSince: number;
+}
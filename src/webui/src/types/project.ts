@@ -13,12 +13,15 @@ export interface Project {
   status: string;
 }
 
-export type ScheduleType = 'manual' | 'fixed_rate' | 'daemon';
+export type ScheduleType = 'manual' | 'fixed_rate' | 'daemon' | 'cron';
 
 export interface Schedule {
   type: ScheduleType;
   intervalMs?: number;
   maxConcurrent?: number;
+  alignToInterval?: boolean;
+  jitterMs?: number;
+  cron?: string;
   restartDelayMs?: number;
   maxConsecutiveFailures?: number;
   runTimeoutMs?: number;
@@ -35,6 +38,8 @@ export interface ProjectRuntime {
   schedule: {
     type: string;
     timerActive: boolean;
+    startPending?: boolean;
+    nextFireAt?: string;
     restartSuppressed: boolean;
     consecutiveFailures: number;
     shuttingDown: boolean;